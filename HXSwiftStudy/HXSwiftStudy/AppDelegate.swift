@@ -16,6 +16,7 @@ class AppDelegate: UIResponder, UIApplicationDelegate {
         // Override point for customization after application launch.
         //NSLog(@"89757 isiOSAppOnMac:%d", [NSProcessInfo processInfo].isiOSAppOnMac);
         //print("89757 isiOSAppOnMac:\(ProcessInfo.processInfo.isiOSAppOnMac)")
+        RestaurantImageStore.collectGarbage()
         return true
     }
 
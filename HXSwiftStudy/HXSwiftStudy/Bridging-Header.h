@@ -12,3 +12,4 @@
 #endif /* Bridging_Header_h */
 
 #import <MJRefresh/MJRefresh.h>
+#import "BNRBlobStore.h"
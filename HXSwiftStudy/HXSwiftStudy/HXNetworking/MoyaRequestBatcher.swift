@@ -0,0 +1,297 @@
+//
+//  MoyaRequestBatcher.swift
+//  HXSwiftStudy
+//
+//  Created by HuXin on 2026/10/18.
+//
+
+import Foundation
+import Moya
+
+/// 批量请求的编解码，服务端批量协议不一样时替换这个
+protocol MoyaBatchCoding {
+    /// 把多个请求编码成批量请求的请求体
+    func encode(_ requests: [URLRequest]) throws -> Data
+    /// 把批量响应拆回每个请求自己的响应，顺序和 requests 一致
+    func decode(_ response: Moya.Response, for requests: [URLRequest]) throws -> [Moya.Response]
+    /// 用每个 target 的 sampleData 拼一个批量响应，stub 时用
+    func sampleResponse(for bodies: [Data]) -> Data
+}
+
+/// 默认的 JSON 批量格式，body 用 base64：
+/// 请求 {"requests":[{"method":"GET","path":"/a?b=c","headers":{},"body":null}]}
+/// 响应 {"responses":[{"status":200,"headers":{},"body":"..."}]}
+struct JSONBatchCoding: MoyaBatchCoding {
+    struct BatchError: Error {}
+
+    private struct RequestItem: Codable {
+        let method: String
+        let path: String
+        let headers: [String: String]
+        let body: Data?
+    }
+
+    private struct ResponseItem: Codable {
+        let status: Int
+        let headers: [String: String]?
+        let body: Data?
+    }
+
+    private struct RequestEnvelope: Codable {
+        let requests: [RequestItem]
+    }
+
+    private struct ResponseEnvelope: Codable {
+        let responses: [ResponseItem]
+    }
+
+    func encode(_ requests: [URLRequest]) throws -> Data {
+        let items = try requests.map { request -> RequestItem in
+            guard let url = request.url else { throw BatchError() }
+            let path = url.path + (url.query.map { "?" + $0 } ?? "")
+            return RequestItem(method: request.httpMethod ?? "GET",
+                               path: path,
+                               headers: request.allHTTPHeaderFields ?? [:],
+                               body: request.httpBody)
+        }
+        return try JSONEncoder().encode(RequestEnvelope(requests: items))
+    }
+
+    func decode(_ response: Moya.Response, for requests: [URLRequest]) throws -> [Moya.Response] {
+        let envelope = try JSONDecoder().decode(ResponseEnvelope.self, from: response.data)
+        guard envelope.responses.count == requests.count else { throw BatchError() }
+
+        return zip(envelope.responses, requests).map { item, request in
+            let httpResponse = request.url.flatMap {
+                HTTPURLResponse(url: $0, statusCode: item.status, httpVersion: nil, headerFields: item.headers)
+            }
+            return Moya.Response(statusCode: item.status, data: item.body ?? Data(), request: request, response: httpResponse)
+        }
+    }
+
+    func sampleResponse(for bodies: [Data]) -> Data {
+        let envelope = ResponseEnvelope(responses: bodies.map { ResponseItem(status: 200, headers: nil, body: $0) })
+        return (try? JSONEncoder().encode(envelope)) ?? Data()
+    }
+}
+
+struct MoyaBatchConfiguration {
+    /// 批量接口的地址
+    var baseURL: URL
+    var path = "/batch"
+    /// 第一个请求进来后等多久再发，这段时间内的请求合成一批
+    var window: TimeInterval = 0.01
+    var maximumBatchSize = 20
+    var coding: MoyaBatchCoding = JSONBatchCoding()
+    /// 哪些 target 可以合并，默认只合并同一个 baseURL 下的普通 GET 请求
+    var canBatch: (TargetType) -> Bool
+
+    init(baseURL: URL, canBatch: ((TargetType) -> Bool)? = nil) {
+        self.baseURL = baseURL
+        self.canBatch = canBatch ?? { target in
+            guard target.baseURL == baseURL, target.method == .get else { return false }
+            switch target.task {
+            case .requestPlain, .requestParameters:
+                return true
+            default:
+                return false
+            }
+        }
+    }
+}
+
+/// 批量请求本身对应的 target
+struct MoyaBatchTarget: TargetType {
+    let baseURL: URL
+    let path: String
+    let body: Data
+    let sampleData: Data
+
+    var method: Moya.Method { .post }
+
+    var task: Task { .requestData(body) }
+
+    var headers: [String: String]? { ["Content-Type": "application/json"] }
+
+    var validationType: ValidationType { .successCodes }
+}
+
+/// 把短时间内发出的多个小请求合并成一个批量请求，再把响应拆回给各自的调用方。
+/// 所有请求都经过同一个 MoyaProvider<MultiTarget>，批量请求走完整的插件链；
+/// 被合并的每个 target 会经过插件的 prepare、didReceive 和 process，但没有 willSend。
+/// 每个 target 的 prepare 只执行一次：单独发送时由 provider 执行，合并时在编码前执行
+final class MoyaRequestBatcher {
+    let provider: MoyaProvider<MultiTarget>
+    let configuration: MoyaBatchConfiguration
+
+    /// 调用方发起的请求数
+    var requestedCount: Int { queue.sync { requested } }
+    /// 实际发出去的 HTTP 请求数，和 requestedCount 对比就是合并的效果
+    var sentCount: Int { queue.sync { sent } }
+
+    /// 待发送队列和计数都只在这个串行队列上访问
+    private let queue = DispatchQueue(label: "com.huxin.moyaRequestBatcher")
+    private var pending: [PendingRequest] = []
+    private var isFlushScheduled = false
+    private var requested = 0
+    private var sent = 0
+
+    init(provider: MoyaProvider<MultiTarget>, configuration: MoyaBatchConfiguration) {
+        self.provider = provider
+        self.configuration = configuration
+    }
+
+    @discardableResult
+    func request(_ target: TargetType, callbackQueue: DispatchQueue? = nil, completion: @escaping Moya.Completion) -> Cancellable {
+        let multiTarget = MultiTarget(target)
+        guard configuration.canBatch(target), let urlRequest = try? provider.endpoint(multiTarget).urlRequest() else {
+            queue.async {
+                self.requested += 1
+                self.sent += 1
+            }
+            return provider.request(multiTarget, callbackQueue: callbackQueue, completion: completion)
+        }
+
+        let pendingRequest = PendingRequest(target: multiTarget, urlRequest: urlRequest, callbackQueue: callbackQueue, completion: completion)
+        queue.async { self.enqueue(pendingRequest) }
+        return pendingRequest
+    }
+
+    private func enqueue(_ request: PendingRequest) {
+        requested += 1
+        pending.append(request)
+
+        if pending.count >= configuration.maximumBatchSize {
+            flush()
+        } else if !isFlushScheduled {
+            isFlushScheduled = true
+            queue.asyncAfter(deadline: .now() + configuration.window) { self.flush() }
+        }
+    }
+
+    private func flush() {
+        isFlushScheduled = false
+        let batch = pending.filter { !$0.isCancelled }
+        pending.removeAll()
+
+        switch batch.count {
+        case 0:
+            return
+        case 1:
+            sendAlone(batch[0])
+        default:
+            sendBatch(batch)
+        }
+    }
+
+    /// 只有一个请求时没必要走批量接口
+    private func sendAlone(_ request: PendingRequest) {
+        sent += 1
+        let cancellable = provider.request(request.target, callbackQueue: queue) { result in
+            request.finish(with: result)
+        }
+        request.forwardCancellation(to: cancellable)
+    }
+
+    private func sendBatch(_ batch: [PendingRequest]) {
+        let coding = configuration.coding
+        let plugins = provider.plugins
+        let requests = batch.map { request in
+            plugins.reduce(request.urlRequest) { $1.prepare($0, target: request.target) }
+        }
+
+        guard let body = try? coding.encode(requests) else {
+            batch.forEach { sendAlone($0) }
+            return
+        }
+
+        let batchTarget = MoyaBatchTarget(baseURL: configuration.baseURL,
+                                          path: configuration.path,
+                                          body: body,
+                                          sampleData: coding.sampleResponse(for: batch.map { $0.target.sampleData }))
+        sent += 1
+        provider.request(MultiTarget(batchTarget), callbackQueue: queue) { result in
+            let responses: Result<[Moya.Response], MoyaError> = result.flatMap { response -> Result<[Moya.Response], MoyaError> in
+                do {
+                    return .success(try coding.decode(response, for: requests))
+                } catch {
+                    return .failure(.underlying(error, response))
+                }
+            }
+
+            for (index, request) in batch.enumerated() {
+                let result = responses.flatMap { MoyaRequestBatcher.validate($0[index], for: request.target) }
+                self.provider.plugins.forEach { $0.didReceive(result, target: request.target) }
+                let processedResult = self.provider.plugins.reduce(result) { $1.process($0, target: request.target) }
+                request.finish(with: processedResult)
+            }
+        }
+    }
+
+    /// 和 Moya 对 stub 响应做的校验一致
+    private static func validate(_ response: Moya.Response, for target: TargetType) -> Result<Moya.Response, MoyaError> {
+        let validCodes = target.validationType.statusCodes
+        guard !validCodes.isEmpty, !validCodes.contains(response.statusCode) else { return .success(response) }
+        return .failure(.underlying(MoyaError.statusCode(response), response))
+    }
+}
+
+extension MoyaRequestBatcher {
+    /// 调用方拿到的取消句柄，结果或取消只会回调一次
+    final class PendingRequest: Cancellable {
+        let target: MultiTarget
+        /// endpoint 生成的请求，还没经过插件的 prepare
+        let urlRequest: URLRequest
+        private let callbackQueue: DispatchQueue?
+        private var completion: Moya.Completion?
+        private var cancelled = false
+        /// 单独发送时 provider 返回的句柄，取消时一起取消
+        private var sentRequest: Cancellable?
+        private let lock = NSLock()
+
+        init(target: MultiTarget, urlRequest: URLRequest, callbackQueue: DispatchQueue?, completion: @escaping Moya.Completion) {
+            self.target = target
+            self.urlRequest = urlRequest
+            self.callbackQueue = callbackQueue
+            self.completion = completion
+        }
+
+        var isCancelled: Bool {
+            lock.lock(); defer { lock.unlock() }
+            return cancelled
+        }
+
+        func cancel() {
+            lock.lock()
+            cancelled = true
+            let sentRequest = self.sentRequest
+            lock.unlock()
+
+            sentRequest?.cancel()
+            let error = NSError(domain: NSURLErrorDomain, code: NSURLErrorCancelled, userInfo: nil)
+            finish(with: .failure(.underlying(error, nil)))
+        }
+
+        func forwardCancellation(to cancellable: Cancellable) {
+            lock.lock()
+            sentRequest = cancellable
+            let cancelled = self.cancelled
+            lock.unlock()
+
+            // 在 flush 之后、拿到句柄之前被取消的
+            if cancelled {
+                cancellable.cancel()
+            }
+        }
+
+        func finish(with result: Result<Moya.Response, MoyaError>) {
+            lock.lock()
+            let completion = self.completion
+            self.completion = nil
+            lock.unlock()
+
+            guard let callback = completion else { return }
+            (callbackQueue ?? .main).async { callback(result) }
+        }
+    }
+}
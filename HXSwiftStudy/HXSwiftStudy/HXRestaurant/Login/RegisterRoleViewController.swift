@@ -24,7 +24,11 @@ class User: NSObject, NSSecureCoding {
     var name: String?
     var phoneNumber: String?
     var role: UserType?
-    var avatar: UIImage?
+    var storedAvatar: StoredImage
+    var avatar: UIImage? {
+        get { storedAvatar.image }
+        set { storedAvatar = StoredImage(newValue) }
+    }
     var account: String?
     
     init(name: String, phoneNumber: String, account: String, role: UserType, avatar: UIImage) {
@@ -32,23 +36,23 @@ class User: NSObject, NSSecureCoding {
         self.phoneNumber = phoneNumber
         self.account = account
         self.role = role
-        self.avatar = avatar
+        self.storedAvatar = StoredImage(avatar)
     }
     
     func encode(with coder: NSCoder) {
         coder.encode(name, forKey: "name")
         coder.encode(phoneNumber, forKey: "phoneNumber")
         coder.encode(role?.rawValue, forKey: "role")
-        coder.encode(avatar, forKey: "avatar")
+        storedAvatar.encode(with: coder, forKey: "avatar")
         coder.encode(account, forKey: "account")
     }
     
     required init?(coder: NSCoder) {
+        storedAvatar = StoredImage(coder: coder, forKey: "avatar")
         super.init()
         name = coder.decodeObject(forKey: "name") as? String
         phoneNumber = coder.decodeObject(forKey: "phoneNumber") as? String
         role = UserType(rawValue: (coder.decodeObject(forKey: "role") as? String) ?? "waiter")
-        avatar = coder.decodeObject(forKey: "avatar") as? UIImage
         account = coder.decodeObject(forKey: "account") as? String
     }
 }
@@ -59,27 +63,31 @@ class Restaurant: NSObject, NSSecureCoding {
     }
     
     var name: String?
-    var photo: UIImage?
+    var storedPhoto: StoredImage
+    var photo: UIImage? {
+        get { storedPhoto.image }
+        set { storedPhoto = StoredImage(newValue) }
+    }
     var restaurantDescription: String?
     var menu = [Food]()
     
     init(name: String, restaurantDescription: String, photo: UIImage) {
         self.name = name
         self.restaurantDescription = restaurantDescription
-        self.photo = photo
+        self.storedPhoto = StoredImage(photo)
     }
     
     func encode(with coder: NSCoder) {
         coder.encode(name, forKey: "name")
         coder.encode(restaurantDescription, forKey: "restaurantDescription")
-        coder.encode(photo, forKey: "photo")
+        storedPhoto.encode(with: coder, forKey: "photo")
         coder.encode(menu, forKey: "menu")
     }
     
     required init?(coder: NSCoder) {
         name = coder.decodeObject(forKey: "name") as? String
         restaurantDescription = coder.decodeObject(forKey: "restaurantDescription") as? String
-        photo = coder.decodeObject(forKey: "photo") as? UIImage
+        storedPhoto = StoredImage(coder: coder, forKey: "photo")
         menu = (coder.decodeObject(forKey: "menu") as? [Food]) ?? [Food]()
     }
 }
@@ -16,7 +16,11 @@ class Food: NSObject, NSSecureCoding {
     }
     
     var name: String?
-    var photo: UIImage?
+    var storedPhoto: StoredImage
+    var photo: UIImage? {
+        get { storedPhoto.image }
+        set { storedPhoto = StoredImage(newValue) }
+    }
     var price: String?
     var foodDescription: String?
     var foodCount: Int64
@@ -26,13 +30,13 @@ class Food: NSObject, NSSecureCoding {
         self.name = name
         self.price = price
         self.foodCount = count
-        self.photo = photo
+        self.storedPhoto = StoredImage(photo)
         self.foodDescription = foodDescription
     }
     
     func encode(with coder: NSCoder) {
         coder.encode(name, forKey: "name")
-        coder.encode(photo, forKey: "photo")
+        storedPhoto.encode(with: coder, forKey: "photo")
         coder.encode(price, forKey: "price")
         coder.encode(foodDescription, forKey: "foodDescription")
         coder.encode(foodCount, forKey: "foodCount")
@@ -41,7 +45,7 @@ class Food: NSObject, NSSecureCoding {
     
     required init?(coder: NSCoder) {
         name = coder.decodeObject(forKey: "name") as? String
-        photo = coder.decodeObject(forKey: "photo") as? UIImage
+        storedPhoto = StoredImage(coder: coder, forKey: "photo")
         price = coder.decodeObject(forKey: "price") as? String
         foodDescription = coder.decodeObject(forKey: "foodDescription") as? String
         foodCount = coder.decodeInt64(forKey: "foodCount")
@@ -0,0 +1,169 @@
+//
+//  RestaurantImageStore.swift
+//  HXSwiftStudy
+//
+//  Created by HuXin on 2026/10/18.
+//
+
+import Foundation
+import UIKit
+
+/// 头像、餐厅照片、菜品照片存在 BNRBlobStore 里（和 HypnoNerd 共用的实现），归档里只保存 key。
+/// 按内容存储，默认的占位图、被多个菜单引用的同一道菜只存一份
+enum RestaurantImageStore {
+    static let keyPrefix = "restaurant/"
+
+    /// 解码好的图片，按内容哈希缓存，同样内容的图片只解码一次
+    private static let cache = NSCache<NSString, UIImage>()
+
+    /// 编码、算哈希、写索引都在这个串行队列上做，不占主线程
+    private static let queue = DispatchQueue(label: "com.huxin.restaurantImageStore", qos: .utility)
+    private static let lock = NSLock()
+    /// 还没写完的图片，写完就移除，保证写盘期间 image(forKey:) 也能拿到
+    private static var pendingImages: [String: UIImage] = [:]
+    /// 存进来或读出去的图片对象对应的 key。界面上拿到的图片原样再存一次时直接复用 key，不用重新编码
+    private static let keysByImage = NSMapTable<UIImage, NSString>(keyOptions: [.weakMemory, .objectPointerPersonality],
+                                                                   valueOptions: .strongMemory)
+
+    /// 实际占用的字节数。会等 BNRBlobStore 正在进行的写入，不要在主线程调用
+    static var storedBytes: UInt64 { BNRBlobStore.shared().storedBytes }
+
+    /// 去重省下的字节数。会等 BNRBlobStore 正在进行的写入，不要在主线程调用
+    static var bytesSaved: UInt64 { BNRBlobStore.shared().bytesSaved }
+
+    /// 存一张图片，立即返回 key，编码和写盘在后台完成。
+    /// 从这里读出来的图片再存时返回原来的 key；其他图片每次都生成新 key，已经归档的旧对象还指向原来的图片
+    static func store(_ image: UIImage?) -> String? {
+        guard let image = image else { return nil }
+
+        lock.lock()
+        defer { lock.unlock() }
+        if let key = keysByImage.object(forKey: image) {
+            return key as String
+        }
+
+        let key = keyPrefix + UUID().uuidString
+        keysByImage.setObject(key as NSString, forKey: image)
+        pendingImages[key] = image
+
+        queue.async {
+            let data = image.jpegData(compressionQuality: 0.8)
+            if let data = data {
+                let hash = BNRBlobStore.shared().setData(data, forKey: key)
+                cache.setObject(image, forKey: hash as NSString)
+            }
+
+            lock.lock()
+            pendingImages[key] = nil
+            if data == nil {
+                keysByImage.removeObject(forKey: image)
+            }
+            lock.unlock()
+        }
+        return key
+    }
+
+    static func image(forKey key: String?) -> UIImage? {
+        guard let key = key else { return nil }
+
+        lock.lock()
+        let pendingImage = pendingImages[key]
+        lock.unlock()
+        if let pendingImage = pendingImage {
+            return pendingImage
+        }
+
+        guard let hash = BNRBlobStore.shared().contentHash(forKey: key) else { return nil }
+        if let image = cache.object(forKey: hash as NSString) {
+            remember(image, forKey: key)
+            return image
+        }
+
+        guard let data = BNRBlobStore.shared().data(forKey: key), let image = UIImage(data: data) else { return nil }
+        cache.setObject(image, forKey: hash as NSString)
+        remember(image, forKey: key)
+        return image
+    }
+
+    /// 阻塞到已经提交的图片都写完，BNRBlobStore 延迟写盘的索引也一起写下去
+    static func synchronize() {
+        queue.sync {}
+        BNRBlobStore.shared().synchronize()
+    }
+
+    /// 启动时调用：从归档里收集还在用的 key，其余的连同没人引用的图片一起删掉。
+    /// 对象被替换、删除时没有逐个释放 key，靠这里统一回收。completion 在主线程回调
+    static func collectGarbage(completion: (() -> Void)? = nil) {
+        let startDate = Date()
+        DispatchQueue.global(qos: .utility).async {
+            var liveKeys = Set<String>()
+            collectKeys(in: MyAppearence.restaurantUserInfo, into: &liveKeys)
+
+            let store = BNRBlobStore.shared()
+            store.removeKeys(withPrefix: keyPrefix, notIn: liveKeys, setBefore: startDate)
+            store.collectGarbage()
+
+            if let completion = completion {
+                DispatchQueue.main.async(execute: completion)
+            }
+        }
+    }
+
+    /// 同样内容的图片可能对应多个 key，记住任意一个都能找回同一份数据
+    private static func remember(_ image: UIImage, forKey key: String) {
+        lock.lock()
+        if keysByImage.object(forKey: image) == nil {
+            keysByImage.setObject(key as NSString, forKey: image)
+        }
+        lock.unlock()
+    }
+
+    private static func collectKeys(in object: Any, into keys: inout Set<String>) {
+        switch object {
+        case let user as User:
+            user.storedAvatar.key.map { _ = keys.insert($0) }
+        case let restaurant as Restaurant:
+            restaurant.storedPhoto.key.map { _ = keys.insert($0) }
+            restaurant.menu.forEach { collectKeys(in: $0, into: &keys) }
+        case let food as Food:
+            food.storedPhoto.key.map { _ = keys.insert($0) }
+        case let order as Order:
+            order.menu.forEach { collectKeys(in: $0, into: &keys) }
+        case let dictionary as [String: Any]:
+            dictionary.values.forEach { collectKeys(in: $0, into: &keys) }
+        case let array as [Any]:
+            array.forEach { collectKeys(in: $0, into: &keys) }
+        default:
+            break
+        }
+    }
+}
+
+/// 归档时只写 key 的图片。旧版本的归档里直接存了 UIImage，读出来先留在内存里，下次归档时再转存
+struct StoredImage {
+    private(set) var key: String?
+    private var legacyImage: UIImage?
+
+    init(_ image: UIImage?) {
+        key = RestaurantImageStore.store(image)
+    }
+
+    init(coder: NSCoder, forKey codingKey: String) {
+        key = coder.decodeObject(forKey: codingKey + "Key") as? String
+        if key == nil {
+            legacyImage = coder.decodeObject(forKey: codingKey) as? UIImage
+        }
+    }
+
+    var image: UIImage? {
+        legacyImage ?? RestaurantImageStore.image(forKey: key)
+    }
+
+    mutating func encode(with coder: NSCoder, forKey codingKey: String) {
+        if key == nil, let legacyImage = legacyImage {
+            key = RestaurantImageStore.store(legacyImage)
+            self.legacyImage = nil
+        }
+        coder.encode(key, forKey: codingKey + "Key")
+    }
+}
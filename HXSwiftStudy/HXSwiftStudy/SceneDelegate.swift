@@ -52,6 +52,8 @@ class SceneDelegate: UIResponder, UIWindowSceneDelegate {
         // Called as the scene transitions from the foreground to the background.
         // Use this method to save data, release shared resources, and store enough scene-specific state information
         // to restore the scene back to its current state.
+        // 归档里已经写了图片的 key，进后台前把还在后台编码的图片写完
+        RestaurantImageStore.synchronize()
     }
 
 
@@ -0,0 +1,238 @@
+//
+//  AuthenticationInterceptorProactiveRefreshTests.swift
+//  HXSwiftStudyTests
+//
+//  Created by HuXin on 2026/10/18.
+//
+
+import XCTest
+import Alamofire
+
+/// 带着 "Bearer initial" 的请求返回 401, 其余返回 200
+final class UnauthorizedStubProtocol: URLProtocol {
+    override class func canInit(with request: URLRequest) -> Bool { true }
+
+    override class func canonicalRequest(for request: URLRequest) -> URLRequest { request }
+
+    override func startLoading() {
+        let statusCode = request.headers["Authorization"] == "Bearer initial" ? 401 : 200
+        let response = HTTPURLResponse(url: request.url!, statusCode: statusCode, httpVersion: "HTTP/1.1", headerFields: nil)!
+        client?.urlProtocol(self, didReceive: response, cacheStoragePolicy: .notAllowed)
+        client?.urlProtocol(self, didLoad: Data())
+        client?.urlProtocolDidFinishLoading(self)
+    }
+
+    override func stopLoading() {}
+}
+
+/// 验证 proactiveRefreshInterval 在凭证过期前后台刷新, 包括 init 时传入的凭证
+class AuthenticationInterceptorProactiveRefreshTests: XCTestCase {
+
+    struct TokenCredential: AuthenticationCredential {
+        var token: String
+        var expirationDate: Date?
+
+        var requiresRefresh: Bool { expirationDate.map { $0 <= Date() } ?? false }
+    }
+
+    final class TokenAuthenticator: Authenticator {
+        /// 每次刷新开始时回调
+        var onRefresh: (() -> Void)?
+        /// 刷新出的新凭证多久后过期
+        var lifetime: TimeInterval = 3600
+        /// 为 true 时刷新一直挂着, 直到 completePendingRefresh()
+        var holdsRefresh = false
+        private(set) var refreshCount = 0
+        private var pendingRefresh: (() -> Void)?
+
+        func apply(_ credential: TokenCredential, to urlRequest: inout URLRequest) {
+            urlRequest.headers.add(.authorization(bearerToken: credential.token))
+        }
+
+        func refresh(_ credential: TokenCredential, for session: Session, completion: @escaping (Result<TokenCredential, Error>) -> Void) {
+            refreshCount += 1
+            let refreshed = TokenCredential(token: "token-\(refreshCount)", expirationDate: Date(timeIntervalSinceNow: lifetime))
+            if holdsRefresh {
+                pendingRefresh = { completion(.success(refreshed)) }
+            } else {
+                completion(.success(refreshed))
+            }
+            onRefresh?()
+        }
+
+        func completePendingRefresh() {
+            pendingRefresh?()
+            pendingRefresh = nil
+        }
+
+        func didRequest(_ urlRequest: URLRequest, with response: HTTPURLResponse, failDueToAuthenticationError error: Error) -> Bool {
+            response.statusCode == 401
+        }
+
+        func isRequest(_ urlRequest: URLRequest, authenticatedWith credential: TokenCredential) -> Bool {
+            urlRequest.headers["Authorization"] == HTTPHeader.authorization(bearerToken: credential.token).value
+        }
+    }
+
+    let urlRequest = URLRequest(url: URL(string: "https://api.hxswiftstudy.test/restaurants")!)
+    let session = Session(startRequestsImmediately: false)
+
+    func adapt(with interceptor: AuthenticationInterceptor<TokenAuthenticator>) throws -> URLRequest {
+        var result: Result<URLRequest, Error>?
+        interceptor.adapt(urlRequest, for: session) { result = $0 }
+
+        return try XCTUnwrap(result).get()
+    }
+
+    /// adapt 可能要等刷新完成才回调
+    func adaptEventually(with interceptor: AuthenticationInterceptor<TokenAuthenticator>) throws -> URLRequest {
+        let adapted = expectation(description: "adapted")
+        var result: Result<URLRequest, Error>?
+        interceptor.adapt(urlRequest, for: session) {
+            result = $0
+            adapted.fulfill()
+        }
+        wait(for: [adapted], timeout: 5)
+
+        return try XCTUnwrap(result).get()
+    }
+
+    // MARK: - Tests
+
+    func testCredentialFromInitIsRefreshedBeforeItExpires() throws {
+        let authenticator = TokenAuthenticator()
+        let refreshed = expectation(description: "proactive refresh")
+        authenticator.onRefresh = { refreshed.fulfill() }
+
+        // 凭证 1 秒后过期, 提前 0.7 秒刷新; 第一次 adapt 时还不在刷新窗口内
+        let credential = TokenCredential(token: "initial", expirationDate: Date(timeIntervalSinceNow: 1))
+        let interceptor = AuthenticationInterceptor(authenticator: authenticator, credential: credential, proactiveRefreshInterval: 0.7)
+
+        XCTAssertEqual(try adapt(with: interceptor).headers["Authorization"], "Bearer initial")
+        XCTAssertEqual(authenticator.refreshCount, 0)
+
+        // 之后没有新的请求, 定时器也会在过期前刷新
+        wait(for: [refreshed], timeout: 1)
+        XCTAssertEqual(interceptor.credential?.token, "token-1")
+        XCTAssertEqual(interceptor.refreshMetrics.proactiveRefreshCount, 1)
+        XCTAssertEqual(try adapt(with: interceptor).headers["Authorization"], "Bearer token-1")
+    }
+
+    func testCredentialWithoutExpirationDateIsNotRefreshed() throws {
+        let authenticator = TokenAuthenticator()
+        let refreshed = expectation(description: "no refresh")
+        refreshed.isInverted = true
+        authenticator.onRefresh = { refreshed.fulfill() }
+
+        let interceptor = AuthenticationInterceptor(authenticator: authenticator,
+                                                    credential: TokenCredential(token: "initial", expirationDate: nil),
+                                                    proactiveRefreshInterval: 0.7)
+
+        XCTAssertEqual(try adapt(with: interceptor).headers["Authorization"], "Bearer initial")
+        wait(for: [refreshed], timeout: 0.5)
+        XCTAssertEqual(authenticator.refreshCount, 0)
+    }
+
+    // MARK: - 凭证有效期不长于提前量
+
+    func testRefreshedCredentialInsideWindowIsNotRefreshedAgain() throws {
+        // 新凭证只有 0.5 秒有效期, 比 0.7 秒的提前量还短, 也没有 refreshWindow 限制刷新次数
+        let authenticator = TokenAuthenticator()
+        authenticator.lifetime = 0.5
+        let refreshed = expectation(description: "proactive refresh")
+        refreshed.assertForOverFulfill = false
+        authenticator.onRefresh = { refreshed.fulfill() }
+
+        let credential = TokenCredential(token: "initial", expirationDate: Date(timeIntervalSinceNow: 0.5))
+        let interceptor = AuthenticationInterceptor(authenticator: authenticator,
+                                                    credential: credential,
+                                                    refreshWindow: nil,
+                                                    proactiveRefreshInterval: 0.7)
+
+        // 第一次 adapt 时已经在提前刷新的窗口内, 后台刷新一次
+        XCTAssertEqual(try adapt(with: interceptor).headers["Authorization"], "Bearer initial")
+        wait(for: [refreshed], timeout: 1)
+
+        // 刷新出的凭证一拿到就在窗口内: 不再定时刷新, adapt 也不再触发刷新
+        for _ in 0..<10 {
+            XCTAssertEqual(try adapt(with: interceptor).headers["Authorization"], "Bearer token-1")
+        }
+        Thread.sleep(forTimeInterval: 0.3)
+        XCTAssertEqual(authenticator.refreshCount, 1)
+        XCTAssertEqual(interceptor.refreshMetrics.proactiveRefreshCount, 1)
+
+        // 等它真的过期了, 照常在 requiresRefresh 时刷新
+        Thread.sleep(forTimeInterval: 0.3)
+        XCTAssertEqual(try adaptEventually(with: interceptor).headers["Authorization"], "Bearer token-2")
+        XCTAssertEqual(interceptor.refreshMetrics.proactiveRefreshCount, 1)
+    }
+
+    func testRefreshedCredentialOutsideWindowIsScheduledAgain() {
+        // 新凭证 1 秒后过期, 提前 0.7 秒刷新: 每个凭证拿到 0.3 秒后都会再刷新一次
+        let authenticator = TokenAuthenticator()
+        authenticator.lifetime = 1
+        let refreshed = expectation(description: "two proactive refreshes")
+        refreshed.expectedFulfillmentCount = 2
+        refreshed.assertForOverFulfill = false
+        authenticator.onRefresh = { refreshed.fulfill() }
+
+        let credential = TokenCredential(token: "initial", expirationDate: Date(timeIntervalSinceNow: 1))
+        let interceptor = AuthenticationInterceptor(authenticator: authenticator,
+                                                    credential: credential,
+                                                    refreshWindow: nil,
+                                                    proactiveRefreshInterval: 0.7)
+
+        XCTAssertEqual(try adapt(with: interceptor).headers["Authorization"], "Bearer initial")
+        wait(for: [refreshed], timeout: 2)
+        XCTAssertGreaterThanOrEqual(interceptor.refreshMetrics.proactiveRefreshCount, 2)
+    }
+
+    // MARK: - 后台刷新时收到 401
+
+    func testUnauthorizedResponseDuringProactiveRefreshWaitsForIt() throws {
+        let authenticator = TokenAuthenticator()
+        authenticator.holdsRefresh = true
+        let refreshStarted = expectation(description: "proactive refresh started")
+        authenticator.onRefresh = { refreshStarted.fulfill() }
+
+        // 凭证 5 秒后过期, 已经在 10 秒的提前量内: 请求带着它发出, 同时开始后台刷新
+        let credential = TokenCredential(token: "initial", expirationDate: Date(timeIntervalSinceNow: 5))
+        let interceptor = AuthenticationInterceptor(authenticator: authenticator, credential: credential, proactiveRefreshInterval: 10)
+        let configuration = URLSessionConfiguration.af.default
+        configuration.protocolClasses = [UnauthorizedStubProtocol.self]
+        let stubSession = Session(configuration: configuration)
+
+        let finished = expectation(description: "request finished")
+        var statusCode: Int?
+        stubSession.request("https://api.hxswiftstudy.test/restaurants", interceptor: interceptor)
+            .validate()
+            .response { response in
+                statusCode = response.response?.statusCode
+                finished.fulfill()
+            }
+        wait(for: [refreshStarted], timeout: 5)
+
+        // 服务端拒绝了旧凭证: 重试等着这次刷新, 不会再开一次
+        let retryDeferred = XCTNSPredicateExpectation(predicate: NSPredicate { _, _ in interceptor.refreshMetrics.deferredRetryCount == 1 },
+                                                      object: nil)
+        wait(for: [retryDeferred], timeout: 5)
+
+        // 之后的请求也不再用旧凭证
+        let adapted = expectation(description: "deferred adapt")
+        var deferredResult: Result<URLRequest, Error>?
+        interceptor.adapt(urlRequest, for: stubSession) {
+            deferredResult = $0
+            adapted.fulfill()
+        }
+        XCTAssertEqual(interceptor.refreshMetrics.deferredAdaptCount, 1)
+
+        authenticator.completePendingRefresh()
+        wait(for: [finished, adapted], timeout: 5)
+
+        XCTAssertEqual(statusCode, 200)
+        XCTAssertEqual(try XCTUnwrap(deferredResult).get().headers["Authorization"], "Bearer token-1")
+        XCTAssertEqual(authenticator.refreshCount, 1)
+        XCTAssertEqual(interceptor.refreshMetrics.refreshCount, 1)
+        XCTAssertEqual(interceptor.refreshMetrics.proactiveRefreshCount, 1)
+    }
+}
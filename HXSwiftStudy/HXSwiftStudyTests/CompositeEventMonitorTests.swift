@@ -0,0 +1,261 @@
+//
+//  CompositeEventMonitorTests.swift
+//  HXSwiftStudyTests
+//
+//  Created by HuXin on 2026/10/18.
+//
+
+import XCTest
+@testable import Alamofire
+
+/// 记下收到的事件, 收齐 expectedFinishes 个 requestDidFinish 后 fulfill
+final class RecordingEventMonitor: EventMonitor {
+    let queue: DispatchQueue
+    let subscribedEvents: EventMonitorEvents
+
+    /// 只在 queue 上访问
+    private(set) var events: [String] = []
+    var recordsNames = true
+    var expectedFinishes = 0
+    var finished: XCTestExpectation?
+    private var finishes = 0
+
+    init(queue: DispatchQueue, subscribedEvents: EventMonitorEvents = .all) {
+        self.queue = queue
+        self.subscribedEvents = subscribedEvents
+    }
+
+    private func record(_ name: String) {
+        if recordsNames { events.append(name) }
+    }
+
+    func requestDidResume(_ request: Request) { record("resume") }
+    func request(_ request: Request, didCreateInitialURLRequest urlRequest: URLRequest) { record("initialURLRequest") }
+    func request(_ request: Request, didCreateURLRequest urlRequest: URLRequest) { record("urlRequest") }
+    func request(_ request: Request, didCreateTask task: URLSessionTask) { record("task") }
+    func request(_ request: Request, didResumeTask task: URLSessionTask) { record("resumeTask") }
+    func urlSession(_ session: URLSession, dataTask: URLSessionDataTask, didReceive data: Data) { record("data") }
+    func urlSession(_ session: URLSession, task: URLSessionTask, didCompleteWithError error: Error?) { record("sessionComplete") }
+    func request(_ request: Request, didCompleteTask task: URLSessionTask, with error: AFError?) { record("complete") }
+    func request(_ request: DataRequest,
+                 didValidateRequest urlRequest: URLRequest?,
+                 response: HTTPURLResponse,
+                 data: Data?,
+                 withResult result: Request.ValidationResult) { record("validate") }
+    func request(_ request: DataRequest, didParseResponse response: DataResponse<Data?, AFError>) { record("parse") }
+
+    func requestDidFinish(_ request: Request) {
+        record("finish")
+        finishes += 1
+        if finishes == expectedFinishes {
+            finishes = 0
+            finished?.fulfill()
+        }
+    }
+}
+
+/// 原来的 CompositeEventMonitor: 每个事件先 async 到自己的队列, 再给每个 monitor 各 async 一次
+final class PerEventCompositeMonitor: EventMonitor {
+    let queue = DispatchQueue(label: "PerEventCompositeMonitor", qos: .utility)
+    let monitors: [EventMonitor]
+
+    init(monitors: [EventMonitor]) {
+        self.monitors = monitors
+    }
+
+    private func performEvent(_ event: @escaping (EventMonitor) -> Void) {
+        queue.async {
+            for monitor in self.monitors {
+                monitor.queue.async { event(monitor) }
+            }
+        }
+    }
+
+    func requestDidResume(_ request: Request) { performEvent { $0.requestDidResume(request) } }
+    func request(_ request: Request, didCreateInitialURLRequest urlRequest: URLRequest) { performEvent { $0.request(request, didCreateInitialURLRequest: urlRequest) } }
+    func request(_ request: Request, didCreateURLRequest urlRequest: URLRequest) { performEvent { $0.request(request, didCreateURLRequest: urlRequest) } }
+    func request(_ request: Request, didCreateTask task: URLSessionTask) { performEvent { $0.request(request, didCreateTask: task) } }
+    func request(_ request: Request, didResumeTask task: URLSessionTask) { performEvent { $0.request(request, didResumeTask: task) } }
+    func urlSession(_ session: URLSession, dataTask: URLSessionDataTask, didReceive data: Data) { performEvent { $0.urlSession(session, dataTask: dataTask, didReceive: data) } }
+    func urlSession(_ session: URLSession, task: URLSessionTask, didCompleteWithError error: Error?) { performEvent { $0.urlSession(session, task: task, didCompleteWithError: error) } }
+    func request(_ request: Request, didCompleteTask task: URLSessionTask, with error: AFError?) { performEvent { $0.request(request, didCompleteTask: task, with: error) } }
+    func request(_ request: DataRequest,
+                 didValidateRequest urlRequest: URLRequest?,
+                 response: HTTPURLResponse,
+                 data: Data?,
+                 withResult result: Request.ValidationResult) {
+        performEvent { $0.request(request, didValidateRequest: urlRequest, response: response, data: data, withResult: result) }
+    }
+    func request(_ request: DataRequest, didParseResponse response: DataResponse<Data?, AFError>) { performEvent { $0.request(request, didParseResponse: response) } }
+    func requestDidFinish(_ request: Request) { performEvent { $0.requestDidFinish(request) } }
+}
+
+class CompositeEventMonitorTests: XCTestCase {
+
+    /// 一个请求收到的数据块数, 加上其余事件一共 20 个事件
+    static let chunksPerRequest = 10
+    static let requestCount = 1000
+
+    static let eventsPerRequest = ["resume", "initialURLRequest", "urlRequest", "task", "resumeTask"]
+        + Array(repeating: "data", count: chunksPerRequest)
+        + ["sessionComplete", "complete", "validate", "parse", "finish"]
+    static let lifecycleEventsPerRequest = ["resume", "initialURLRequest", "urlRequest", "task", "resumeTask", "complete", "finish"]
+
+    var urlSession: URLSession!
+    var session: Session!
+    var request: DataRequest!
+    var task: URLSessionDataTask!
+    var urlRequest: URLRequest!
+    var response: HTTPURLResponse!
+    let chunk = Data(repeating: 0x2A, count: 16 * 1024)
+
+    override func setUp() {
+        let url = URL(string: "https://events.hxswiftstudy.test/foods")!
+        urlRequest = URLRequest(url: url)
+        urlSession = URLSession(configuration: .ephemeral)
+        task = urlSession.dataTask(with: urlRequest)
+        session = Session(startRequestsImmediately: false)
+        request = session.request(urlRequest)
+        response = HTTPURLResponse(url: url, statusCode: 200, httpVersion: "HTTP/1.1", headerFields: nil)
+    }
+
+    override func tearDown() {
+        urlSession.invalidateAndCancel()
+        urlSession = nil
+        session = nil
+        request = nil
+        task = nil
+    }
+
+    // MARK: - Helpers
+
+    /// 按 Session 处理一个请求时的顺序发出事件
+    func replayRequest(on monitor: EventMonitor) {
+        monitor.requestDidResume(request)
+        monitor.request(request, didCreateInitialURLRequest: urlRequest)
+        monitor.request(request, didCreateURLRequest: urlRequest)
+        monitor.request(request, didCreateTask: task)
+        monitor.request(request, didResumeTask: task)
+        for _ in 0..<Self.chunksPerRequest {
+            monitor.urlSession(urlSession, dataTask: task, didReceive: chunk)
+        }
+        monitor.urlSession(urlSession, task: task, didCompleteWithError: nil)
+        monitor.request(request, didCompleteTask: task, with: nil)
+        monitor.request(request, didValidateRequest: urlRequest, response: response, data: chunk, withResult: .success(()))
+        monitor.request(request, didParseResponse: DataResponse<Data?, AFError>(request: urlRequest,
+                                                                                response: response,
+                                                                                data: chunk,
+                                                                                metrics: nil,
+                                                                                serializationDuration: 0,
+                                                                                result: .success(chunk)))
+        monitor.requestDidFinish(request)
+    }
+
+    /// 五个 monitor: 三个共用一个队列, 两个各自一个队列, 其中两个只关心请求生命周期, 像 AlamofireNotifications
+    func makeMonitors(count: Int) -> [RecordingEventMonitor] {
+        let sharedQueue = DispatchQueue(label: "CompositeEventMonitorTests.shared")
+        let subscriptions: [EventMonitorEvents] = [.all, .requestLifecycle, .all, .requestLifecycle, .all]
+
+        return (0..<count).map { index in
+            let queue = index < 3 ? sharedQueue : DispatchQueue(label: "CompositeEventMonitorTests.\(index)")
+            return RecordingEventMonitor(queue: queue, subscribedEvents: subscriptions[index])
+        }
+    }
+
+    func events(of monitor: RecordingEventMonitor) -> [String] {
+        monitor.queue.sync { monitor.events }
+    }
+
+    /// 发出 requestCount 个请求的事件, 等每个 monitor 都处理完
+    func measureOverhead(monitorCount: Int, makeComposite: ([EventMonitor]) -> EventMonitor) {
+        let monitors = makeMonitors(count: monitorCount)
+        monitors.forEach {
+            $0.recordsNames = false
+            $0.expectedFinishes = Self.requestCount
+        }
+        let composite = makeComposite(monitors)
+
+        measure {
+            let finished = monitors.map { monitor -> XCTestExpectation in
+                let finished = expectation(description: "monitor finished")
+                monitor.queue.sync { monitor.finished = finished }
+                return finished
+            }
+            for _ in 0..<Self.requestCount {
+                replayRequest(on: composite)
+            }
+            wait(for: finished, timeout: 30)
+            // 没有 monitor 时也算上组合 monitor 自己队列上的工作
+            composite.queue.sync {}
+        }
+    }
+
+    // MARK: - 订阅和顺序
+
+    func testEachMonitorReceivesItsEventsInOrder() {
+        let monitors = makeMonitors(count: 5)
+        let composite = CompositeEventMonitor(monitors: monitors)
+        let finished = monitors.map { monitor -> XCTestExpectation in
+            monitor.expectedFinishes = 3
+            monitor.finished = expectation(description: "monitor finished")
+            return monitor.finished!
+        }
+
+        for _ in 0..<3 {
+            replayRequest(on: composite)
+        }
+        wait(for: finished, timeout: 5)
+
+        for monitor in monitors {
+            let expected = monitor.subscribedEvents == .all ? Self.eventsPerRequest : Self.lifecycleEventsPerRequest
+            XCTAssertEqual(events(of: monitor), Array([[String]](repeating: expected, count: 3).joined()))
+        }
+    }
+
+    func testUnsubscribedEventsAreDroppedBeforeDispatch() {
+        let monitor = RecordingEventMonitor(queue: DispatchQueue(label: "CompositeEventMonitorTests.lifecycle"),
+                                            subscribedEvents: .requestLifecycle)
+        let composite = CompositeEventMonitor(monitors: [monitor])
+
+        XCTAssertEqual(composite.subscribedEvents, .requestLifecycle)
+        // 没人订阅的事件直接丢掉, 不会有排队
+        for _ in 0..<100 {
+            composite.urlSession(urlSession, dataTask: task, didReceive: chunk)
+        }
+        composite.queue.sync {}
+        monitor.queue.sync {}
+        XCTAssertEqual(events(of: monitor), [])
+    }
+
+    func testMonitorWithoutSubscriptionsIsSkipped() {
+        let composite = CompositeEventMonitor(monitors: [RecordingEventMonitor(queue: .main, subscribedEvents: [])])
+
+        XCTAssertEqual(composite.subscribedEvents, [])
+    }
+
+    // MARK: - 每个请求的开销
+
+    func testPerformanceNoMonitors() {
+        measureOverhead(monitorCount: 0) { CompositeEventMonitor(monitors: $0) }
+    }
+
+    func testPerformanceNoMonitorsPerEvent() {
+        measureOverhead(monitorCount: 0) { PerEventCompositeMonitor(monitors: $0) }
+    }
+
+    func testPerformanceOneMonitor() {
+        measureOverhead(monitorCount: 1) { CompositeEventMonitor(monitors: $0) }
+    }
+
+    func testPerformanceOneMonitorPerEvent() {
+        measureOverhead(monitorCount: 1) { PerEventCompositeMonitor(monitors: $0) }
+    }
+
+    func testPerformanceFiveMonitors() {
+        measureOverhead(monitorCount: 5) { CompositeEventMonitor(monitors: $0) }
+    }
+
+    func testPerformanceFiveMonitorsPerEvent() {
+        measureOverhead(monitorCount: 5) { PerEventCompositeMonitor(monitors: $0) }
+    }
+}
@@ -0,0 +1,306 @@
+//
+//  DataStreamRecordTests.swift
+//  HXSwiftStudyTests
+//
+//  Created by HuXin on 2026/10/18.
+//
+
+import XCTest
+@testable import Alamofire
+
+/// 模拟分块传输的服务端: 响应体按固定大小切块, 每块之间隔一段时间再发
+final class ChunkedStubProtocol: URLProtocol {
+    struct Reply {
+        var body = Data()
+        var chunkLength = 64
+        var interval: TimeInterval = 0
+    }
+
+    private static let lock = NSLock()
+    private static var reply = Reply()
+
+    static func respond(with reply: Reply) {
+        lock.lock(); defer { lock.unlock() }
+        self.reply = reply
+    }
+
+    private let queue = DispatchQueue(label: "ChunkedStubProtocol")
+    private var isStopped = false
+
+    override class func canInit(with request: URLRequest) -> Bool { true }
+
+    override class func canonicalRequest(for request: URLRequest) -> URLRequest { request }
+
+    override func startLoading() {
+        ChunkedStubProtocol.lock.lock()
+        let reply = ChunkedStubProtocol.reply
+        ChunkedStubProtocol.lock.unlock()
+
+        let response = HTTPURLResponse(url: request.url!, statusCode: 200, httpVersion: "HTTP/1.1",
+                                       headerFields: ["Transfer-Encoding": "chunked", "Content-Type": "application/x-ndjson"])!
+        client?.urlProtocol(self, didReceive: response, cacheStoragePolicy: .notAllowed)
+        sendChunk(from: 0, of: reply)
+    }
+
+    private func sendChunk(from offset: Int, of reply: Reply) {
+        queue.asyncAfter(deadline: .now() + (offset == 0 ? 0 : reply.interval)) {
+            guard !self.isStopped else { return }
+            guard offset < reply.body.count else {
+                self.client?.urlProtocolDidFinishLoading(self)
+                return
+            }
+
+            let end = min(offset + reply.chunkLength, reply.body.count)
+            self.client?.urlProtocol(self, didLoad: reply.body.subdata(in: offset..<end))
+            self.sendChunk(from: end, of: reply)
+        }
+    }
+
+    override func stopLoading() {
+        queue.async { self.isStopped = true }
+    }
+}
+
+class DataStreamRecordTests: XCTestCase {
+
+    struct Record: Codable, Equatable {
+        let id: Int
+        let text: String
+    }
+
+    var session: Session!
+
+    override func setUp() {
+        let configuration = URLSessionConfiguration.af.default
+        configuration.protocolClasses = [ChunkedStubProtocol.self]
+        session = Session(configuration: configuration)
+    }
+
+    override func tearDown() {
+        session = nil
+    }
+
+    // MARK: - Helpers
+
+    /// 文本里故意放上分隔符和转义, 切块时会落在字符串中间
+    func records(count: Int) -> [Record] {
+        (0..<count).map { Record(id: $0, text: "line \($0), with [brackets] {braces} \"quotes\" \\ and\nnewline") }
+    }
+
+    func body(for records: [Record], framing: DataStreamRecordFraming) -> Data {
+        let encoder = JSONEncoder()
+        switch framing {
+        case .newlineDelimited:
+            return records.reduce(into: Data()) { body, record in
+                body.append(try! encoder.encode(record))
+                body.append(UInt8(ascii: "\n"))
+            }
+        case .jsonArray:
+            return try! encoder.encode(records)
+        }
+    }
+
+    /// 逐块喂给 framer, 收集解出的记录
+    func frame(_ body: Data, framing: DataStreamRecordFraming, chunkLength: Int) throws -> [Data] {
+        var framer = DataStreamRecordFramer(framing: framing)
+        var records: [Data] = []
+        for offset in stride(from: 0, to: body.count, by: chunkLength) {
+            records += try framer.append(body.subdata(in: offset..<min(offset + chunkLength, body.count)))
+        }
+        records += try framer.finish()
+
+        return records
+    }
+
+    func decode(_ records: [Data]) throws -> [Record] {
+        try records.map { try JSONDecoder().decode(Record.self, from: $0) }
+    }
+
+    /// 通过 Session 收一条记录流, 返回收到的记录和结束时的错误
+    func stream(framing: DataStreamRecordFraming,
+                maximumPendingDeliveries: Int = 8,
+                onRecords: @escaping ([Record]) -> Void = { _ in }) -> (records: [Record], error: AFError?) {
+        let completed = expectation(description: "stream completed")
+        var received: [Record] = []
+        var completionError: AFError?
+        session.streamRequest("https://stream.hxswiftstudy.test/records")
+            .responseStreamRecords(of: Record.self, framing: framing, maximumPendingDeliveries: maximumPendingDeliveries) { stream in
+                switch stream.event {
+                case let .stream(result):
+                    if case let .success(batch) = result {
+                        received += batch
+                        onRecords(batch)
+                    } else if case let .failure(error) = result {
+                        completionError = error
+                    }
+                case let .complete(completion):
+                    completionError = completionError ?? completion.error
+                    completed.fulfill()
+                }
+            }
+        wait(for: [completed], timeout: 30)
+
+        return (received, completionError)
+    }
+
+    // MARK: - 分帧
+
+    func testRecordsSplitAtEveryByteAreFramed() throws {
+        let expected = records(count: 20)
+        for framing in [DataStreamRecordFraming.newlineDelimited, .jsonArray] {
+            let body = self.body(for: expected, framing: framing)
+            for chunkLength in [1, 2, 7, 64, body.count] {
+                XCTAssertEqual(try decode(frame(body, framing: framing, chunkLength: chunkLength)), expected,
+                               "\(framing) in \(chunkLength) byte chunks")
+            }
+        }
+    }
+
+    func testTrailingLineWithoutNewlineIsFramedOnFinish() throws {
+        var framer = DataStreamRecordFramer(framing: .newlineDelimited)
+        XCTAssertEqual(try framer.append(Data("{\"id\":1,\"text\":\"a\"}\n\n  \n{\"id\":2,".utf8)).count, 1)
+        XCTAssertEqual(try framer.append(Data("\"text\":\"b\"}".utf8)), [])
+
+        XCTAssertEqual(try decode(framer.finish()), [Record(id: 2, text: "b")])
+    }
+
+    func testScalarArrayElementsAreFramed() throws {
+        let records = try frame(Data("[1, \"a,]\",  true,null,{\"k\":[2]}]".utf8), framing: .jsonArray, chunkLength: 3)
+
+        XCTAssertEqual(records.map { String(decoding: $0, as: UTF8.self) }, ["1", "\"a,]\"", "true", "null", "{\"k\":[2]}"])
+    }
+
+    func testEmptyArrayHasNoRecords() throws {
+        XCTAssertEqual(try frame(Data(" [ ] ".utf8), framing: .jsonArray, chunkLength: 1), [])
+    }
+
+    func testUnclosedArrayFailsOnFinish() throws {
+        var framer = DataStreamRecordFramer(framing: .jsonArray)
+        XCTAssertEqual(try framer.append(Data("[{\"id\":1,\"text\":\"a\"},{\"id\"".utf8)).count, 1)
+
+        XCTAssertThrowsError(try framer.finish())
+    }
+
+    func testContentOutsideArrayIsRejected() {
+        var framer = DataStreamRecordFramer(framing: .jsonArray)
+        XCTAssertThrowsError(try framer.append(Data("{\"id\":1}".utf8)))
+
+        var closed = DataStreamRecordFramer(framing: .jsonArray)
+        XCTAssertThrowsError(try closed.append(Data("[1] 2".utf8)))
+    }
+
+    func testFramerOnlyKeepsPartialRecord() throws {
+        // 缓冲区只留没收完的记录, 收了多少完整记录都不影响
+        var framer = DataStreamRecordFramer(framing: .newlineDelimited)
+        let line = body(for: records(count: 1), framing: .newlineDelimited)
+        for _ in 0..<10_000 {
+            XCTAssertEqual(try framer.append(line).count, 1)
+        }
+        XCTAssertEqual(try framer.append(line.prefix(10)), [])
+
+        XCTAssertThrowsError(try decode(framer.finish()), "only the 10 byte partial record is left")
+    }
+
+    // MARK: - 分块传输的服务端
+
+    func testNewlineDelimitedStreamFromChunkedServer() {
+        let expected = records(count: 200)
+        ChunkedStubProtocol.respond(with: .init(body: body(for: expected, framing: .newlineDelimited), chunkLength: 97))
+
+        let result = stream(framing: .newlineDelimited)
+
+        XCTAssertNil(result.error)
+        XCTAssertEqual(result.records, expected)
+    }
+
+    func testJSONArrayStreamFromChunkedServer() {
+        let expected = records(count: 200)
+        ChunkedStubProtocol.respond(with: .init(body: body(for: expected, framing: .jsonArray), chunkLength: 97))
+
+        let result = stream(framing: .jsonArray)
+
+        XCTAssertNil(result.error)
+        XCTAssertEqual(result.records, expected)
+    }
+
+    func testFirstRecordsArriveBeforeTheBodyEnds() {
+        let expected = records(count: 20)
+        let body = self.body(for: expected, framing: .newlineDelimited)
+        ChunkedStubProtocol.respond(with: .init(body: body, chunkLength: body.count / expected.count, interval: 0.05))
+
+        var countAtFirstDelivery: Int?
+        let result = stream(framing: .newlineDelimited) { batch in
+            countAtFirstDelivery = countAtFirstDelivery ?? batch.count
+        }
+
+        XCTAssertEqual(result.records, expected)
+        XCTAssertLessThan(countAtFirstDelivery ?? expected.count, expected.count)
+    }
+
+    func testMalformedRecordFailsTheStream() {
+        ChunkedStubProtocol.respond(with: .init(body: Data("{\"id\":1,\"text\":\"a\"}\nnot json\n{\"id\":3,\"text\":\"c\"}\n".utf8)))
+
+        let result = stream(framing: .newlineDelimited)
+
+        XCTAssertEqual(result.records, [Record(id: 1, text: "a")])
+        XCTAssertNotNil(result.error)
+    }
+
+    func testSlowConsumerStillReceivesEveryRecordInOrder() {
+        // 处理得比网络慢, 触发挂起和恢复
+        let expected = records(count: 300)
+        ChunkedStubProtocol.respond(with: .init(body: body(for: expected, framing: .newlineDelimited), chunkLength: 50))
+
+        let result = stream(framing: .newlineDelimited, maximumPendingDeliveries: 2) { _ in
+            Thread.sleep(forTimeInterval: 0.001)
+        }
+
+        XCTAssertNil(result.error)
+        XCTAssertEqual(result.records, expected)
+    }
+
+    // MARK: - 首条记录耗时
+
+    /// 10000 条记录分 100 块发, 每块间隔 10 毫秒
+    func respondWithSlowBody(framing: DataStreamRecordFraming) {
+        let body = self.body(for: records(count: 10_000), framing: framing)
+        ChunkedStubProtocol.respond(with: .init(body: body, chunkLength: body.count / 100 + 1, interval: 0.01))
+    }
+
+    func testPerformanceTimeToFirstRecordStreaming() {
+        respondWithSlowBody(framing: .jsonArray)
+
+        measureMetrics([.wallClockTime], automaticallyStartMeasuring: false) {
+            let firstRecord = expectation(description: "first record")
+            var request: DataStreamRequest?
+            startMeasuring()
+            request = session.streamRequest("https://stream.hxswiftstudy.test/records")
+                .responseStreamRecords(of: Record.self, framing: .jsonArray) { stream in
+                    guard case .stream(.success(_)) = stream.event, request != nil else { return }
+
+                    self.stopMeasuring()
+                    request = nil
+                    stream.cancel()
+                    firstRecord.fulfill()
+                }
+            wait(for: [firstRecord], timeout: 30)
+        }
+    }
+
+    func testPerformanceTimeToFirstRecordDecodingWholeBody() {
+        // 原来的做法: 整个响应收完再用 JSONDecoder 解一遍
+        respondWithSlowBody(framing: .jsonArray)
+
+        measureMetrics([.wallClockTime], automaticallyStartMeasuring: false) {
+            let firstRecord = expectation(description: "first record")
+            startMeasuring()
+            session.request("https://stream.hxswiftstudy.test/records")
+                .responseDecodable(of: [Record].self) { response in
+                    XCTAssertNotNil(response.value?.first)
+                    self.stopMeasuring()
+                    firstRecord.fulfill()
+                }
+            wait(for: [firstRecord], timeout: 30)
+        }
+    }
+}
@@ -0,0 +1,195 @@
+//
+//  HTTPHeadersTests.swift
+//  HXSwiftStudyTests
+//
+//  Created by HuXin on 2026/10/18.
+//
+
+import XCTest
+@testable import Alamofire
+
+class HTTPHeadersTests: XCTestCase {
+
+    /// 原来的 HTTPHeaders: 每次查找都把每个名字 lowercased() 一遍再比较
+    struct LinearHeaders {
+        private(set) var headers: [HTTPHeader] = []
+
+        mutating func update(name: String, value: String) {
+            let lowercasedName = name.lowercased()
+            if let index = headers.firstIndex(where: { $0.name.lowercased() == lowercasedName }) {
+                headers[index] = HTTPHeader(name: name, value: value)
+            } else {
+                headers.append(HTTPHeader(name: name, value: value))
+            }
+        }
+
+        func value(for name: String) -> String? {
+            let lowercasedName = name.lowercased()
+            return headers.first { $0.name.lowercased() == lowercasedName }?.value
+        }
+    }
+
+    /// 一个请求上常见的头, 大约是 Session 默认头加上业务接口会带的那些
+    static let requestHeaders: [(String, String)] = [
+        ("Accept", "application/json"),
+        ("Accept-Encoding", "br;q=1.0, gzip;q=0.9, deflate;q=0.8"),
+        ("Accept-Language", "zh-Hans-CN;q=1.0, en-CN;q=0.9"),
+        ("User-Agent", "HXSwiftStudy/1.0 (com.huxin.HXSwiftStudy; build:1; iOS 14.5.0) Alamofire/5.4.3"),
+        ("Content-Type", "application/json"),
+        ("X-Request-ID", "6F9619FF-8B86-D011-B42D-00C04FC964FF"),
+        ("X-Client-Version", "1.0.0"),
+        ("X-Device-ID", "A1B2C3D4"),
+        ("X-Timezone", "Asia/Shanghai"),
+        ("X-Locale", "zh_CN"),
+        ("If-None-Match", "\"v1\""),
+        ("Cache-Control", "no-cache"),
+    ]
+
+    /// 每个请求适配器和插件大致做的事: 查几个头, 再设几个头
+    static let lookedUpNames = ["authorization", "Content-Type", "X-REQUEST-ID", "accept", "X-Trace-ID", "cache-control"]
+    static let updatedNames = ["Authorization", "X-Trace-ID", "x-request-id", "Content-Length"]
+
+    static let requestCount = 10_000
+
+    // MARK: - 语义
+
+    func testLookupsIgnoreCase() {
+        let headers: HTTPHeaders = ["Content-Type": "application/json"]
+
+        XCTAssertEqual(headers["content-type"], "application/json")
+        XCTAssertEqual(headers.value(for: "CONTENT-TYPE"), "application/json")
+        XCTAssertNil(headers["Content-Length"])
+    }
+
+    func testUpdateReplacesInPlaceWithNewName() {
+        var headers: HTTPHeaders = [.accept("a"), .contentType("b"), .authorization("c")]
+        headers.update(name: "content-TYPE", value: "d")
+
+        XCTAssertEqual(headers.map { $0.name }, ["Accept", "content-TYPE", "Authorization"])
+        XCTAssertEqual(headers["Content-Type"], "d")
+        XCTAssertEqual(headers.count, 3)
+    }
+
+    func testRemoveKeepsLaterHeadersFindable() {
+        var headers: HTTPHeaders = [.accept("a"), .contentType("b"), .authorization("c"), .userAgent("d")]
+        headers.remove(name: "CONTENT-type")
+        headers["accept"] = nil
+        headers.remove(name: "Missing")
+
+        XCTAssertEqual(headers.map { $0.name }, ["Authorization", "User-Agent"])
+        XCTAssertEqual(headers["authorization"], "c")
+        XCTAssertEqual(headers["user-agent"], "d")
+        XCTAssertNil(headers["Content-Type"])
+
+        headers.add(name: "Content-Type", value: "e")
+        XCTAssertEqual(headers.map { $0.name }, ["Authorization", "User-Agent", "Content-Type"])
+    }
+
+    func testSortReindexes() {
+        var headers: HTTPHeaders = [.userAgent("a"), .authorization("b"), .accept("c")]
+        headers.sort()
+        headers.update(name: "accept", value: "d")
+
+        XCTAssertEqual(headers.map { $0.name }, ["accept", "Authorization", "User-Agent"])
+        XCTAssertEqual(headers["Authorization"], "b")
+        XCTAssertEqual(headers.sorted().map { $0.name }, ["accept", "Authorization", "User-Agent"])
+    }
+
+    func testDuplicateNamesCollapseIntoLast() {
+        let headers = HTTPHeaders([HTTPHeader(name: "X-Value", value: "1"), HTTPHeader(name: "x-value", value: "2")])
+
+        XCTAssertEqual(headers.count, 1)
+        XCTAssertEqual(headers.first?.name, "x-value")
+        XCTAssertEqual(headers["X-VALUE"], "2")
+    }
+
+    func testNonASCIINamesUseUnicodeCaseMapping() {
+        var headers = HTTPHeaders()
+        headers["X-Ünïcode"] = "1"
+        headers["x-ÜNÏCODE"] = "2"
+
+        XCTAssertEqual(headers.count, 1)
+        XCTAssertEqual(headers["X-üNïcode"], "2")
+        XCTAssertNil(headers["X-Unicode"])
+    }
+
+    func testFoldedNamesHashAlike() {
+        let names = ["content-type", "Content-Type", "CONTENT-TYPE"]
+        let hashes = Set(names.map { CaseInsensitiveHeaderName($0).hashValue })
+
+        XCTAssertEqual(hashes.count, 1)
+        XCTAssertNotEqual(CaseInsensitiveHeaderName("Content-Type"), CaseInsensitiveHeaderName("Content-Typf"))
+    }
+
+    func testMatchesLinearImplementation() {
+        var headers = HTTPHeaders()
+        var linear = LinearHeaders()
+        for (name, value) in Self.requestHeaders {
+            headers.update(name: name, value: value)
+            linear.update(name: name, value: value)
+        }
+        for name in Self.updatedNames {
+            headers.update(name: name, value: name)
+            linear.update(name: name, value: name)
+        }
+
+        XCTAssertEqual(Array(headers), linear.headers)
+        for name in Self.lookedUpNames + Self.updatedNames.map({ $0.uppercased() }) {
+            XCTAssertEqual(headers[name], linear.value(for: name), name)
+        }
+    }
+
+    // MARK: - 每个请求的头处理
+
+    func testPerformanceIndexedHeaders() {
+        measure {
+            var found = 0
+            for _ in 0..<Self.requestCount {
+                var headers = HTTPHeaders()
+                for (name, value) in Self.requestHeaders {
+                    headers.update(name: name, value: value)
+                }
+                for name in Self.lookedUpNames where headers[name] != nil {
+                    found += 1
+                }
+                for name in Self.updatedNames {
+                    headers.update(name: name, value: "value")
+                }
+            }
+            XCTAssertGreaterThan(found, 0)
+        }
+    }
+
+    func testPerformanceLinearHeaders() {
+        measure {
+            var found = 0
+            for _ in 0..<Self.requestCount {
+                var headers = LinearHeaders()
+                for (name, value) in Self.requestHeaders {
+                    headers.update(name: name, value: value)
+                }
+                for name in Self.lookedUpNames where headers.value(for: name) != nil {
+                    found += 1
+                }
+                for name in Self.updatedNames {
+                    headers.update(name: name, value: "value")
+                }
+            }
+            XCTAssertGreaterThan(found, 0)
+        }
+    }
+
+    func testPerformanceLookupsOnly() {
+        // 头已经建好, 只看查找: 不应该有内存分配
+        let headers = HTTPHeaders(Self.requestHeaders.map { HTTPHeader(name: $0.0, value: $0.1) })
+        measure(metrics: [XCTClockMetric(), XCTMemoryMetric()]) {
+            var found = 0
+            for _ in 0..<Self.requestCount * 10 {
+                for name in Self.lookedUpNames where headers[name] != nil {
+                    found += 1
+                }
+            }
+            XCTAssertGreaterThan(found, 0)
+        }
+    }
+}
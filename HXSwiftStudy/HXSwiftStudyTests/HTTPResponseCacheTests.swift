@@ -0,0 +1,213 @@
+//
+//  HTTPResponseCacheTests.swift
+//  HXSwiftStudyTests
+//
+//  Created by HuXin on 2026/10/18.
+//
+
+import XCTest
+import Alamofire
+
+/// 用 URLProtocol 模拟源站, 统计每个 URL 实际打到源站的次数
+final class OriginStubProtocol: URLProtocol {
+    struct Reply {
+        var statusCode = 200
+        var headers: [String: String] = [:]
+        var body = Data()
+    }
+
+    private static let lock = NSLock()
+    private static var hitCounts: [URL: Int] = [:]
+    private static var replyHandler: ((URLRequest) -> Reply)?
+    private static var requestHandler: ((URLRequest) -> Void)?
+
+    /// 设置源站的应答, 同时清空计数
+    static func respond(with replyHandler: @escaping (URLRequest) -> Reply, onRequest requestHandler: ((URLRequest) -> Void)? = nil) {
+        lock.lock(); defer { lock.unlock() }
+        hitCounts = [:]
+        self.replyHandler = replyHandler
+        self.requestHandler = requestHandler
+    }
+
+    static func hits(for url: URL) -> Int {
+        lock.lock(); defer { lock.unlock() }
+        return hitCounts[url] ?? 0
+    }
+
+    override class func canInit(with request: URLRequest) -> Bool { true }
+
+    override class func canonicalRequest(for request: URLRequest) -> URLRequest { request }
+
+    override func startLoading() {
+        let url = request.url!
+
+        OriginStubProtocol.lock.lock()
+        OriginStubProtocol.hitCounts[url, default: 0] += 1
+        let reply = OriginStubProtocol.replyHandler?(request) ?? Reply(statusCode: 404)
+        let requestHandler = OriginStubProtocol.requestHandler
+        OriginStubProtocol.lock.unlock()
+
+        let response = HTTPURLResponse(url: url, statusCode: reply.statusCode, httpVersion: "HTTP/1.1", headerFields: reply.headers)!
+        client?.urlProtocol(self, didReceive: response, cacheStoragePolicy: .notAllowed)
+        client?.urlProtocol(self, didLoad: reply.body)
+        client?.urlProtocolDidFinishLoading(self)
+
+        requestHandler?(request)
+    }
+
+    override func stopLoading() {}
+}
+
+class HTTPResponseCacheTests: XCTestCase {
+
+    let url = URL(string: "https://origin.hxswiftstudy.test/restaurants")!
+    let body = Data("restaurants".utf8)
+
+    var directory: URL!
+    var cache: HTTPResponseCache!
+    var session: Session!
+
+    override func setUp() {
+        directory = FileManager.default.temporaryDirectory.appendingPathComponent(UUID().uuidString, isDirectory: true)
+        cache = HTTPResponseCache(directory: directory)
+
+        let configuration = URLSessionConfiguration.af.default
+        configuration.protocolClasses = [OriginStubProtocol.self]
+        session = Session(configuration: configuration)
+    }
+
+    override func tearDown() {
+        try? FileManager.default.removeItem(at: directory)
+        cache = nil
+        session = nil
+    }
+
+    // MARK: - Helpers
+
+    /// 源站返回带 ETag 的响应, 带上匹配的 If-None-Match 时返回 304
+    func respond(cacheControl: String, onRequest requestHandler: ((URLRequest) -> Void)? = nil) {
+        let body = self.body
+        OriginStubProtocol.respond(with: { request in
+            let headers = ["Cache-Control": cacheControl, "ETag": "\"v1\""]
+            if request.value(forHTTPHeaderField: "If-None-Match") == "\"v1\"" {
+                return OriginStubProtocol.Reply(statusCode: 304, headers: headers)
+            }
+            return OriginStubProtocol.Reply(statusCode: 200, headers: headers, body: body)
+        }, onRequest: requestHandler)
+    }
+
+    @discardableResult
+    func load() -> AFDataResponse<Data> {
+        let loaded = expectation(description: "load")
+        var result: AFDataResponse<Data>!
+        cache.load(url, using: session) { response in
+            result = response
+            loaded.fulfill()
+        }
+        wait(for: [loaded], timeout: 5)
+
+        return result
+    }
+
+    // MARK: - Tests
+
+    func testFreshEntryIsServedWithoutHittingOrigin() {
+        respond(cacheControl: "max-age=60")
+
+        let first = load()
+        let second = load()
+
+        XCTAssertEqual(first.value, body)
+        XCTAssertEqual(second.value, body)
+        XCTAssertNotNil(first.metrics)
+        XCTAssertNil(second.metrics, "served from the cache")
+        XCTAssertEqual(OriginStubProtocol.hits(for: url), 1)
+    }
+
+    func testExpiredEntryIsRevalidatedWithValidator() {
+        respond(cacheControl: "max-age=0")
+
+        load()
+        let second = load()
+
+        // 第二次带 If-None-Match, 源站回 304, 仍然返回缓存的内容
+        XCTAssertEqual(second.response?.statusCode, 304)
+        XCTAssertEqual(second.value, body)
+        XCTAssertEqual(OriginStubProtocol.hits(for: url), 2)
+    }
+
+    func testNoCacheIgnoresStaleWhileRevalidate() throws {
+        respond(cacheControl: "no-cache, max-age=60, stale-while-revalidate=60")
+
+        load()
+        let entry = try XCTUnwrap(cache.entry(for: url))
+        XCTAssertEqual(entry.staleUntil, entry.freshUntil)
+
+        // no-cache 的响应每次都要先向源站确认, 不能先返回旧数据
+        let second = load()
+        XCTAssertNotNil(second.metrics, "revalidated with the origin before being served")
+        XCTAssertEqual(second.value, body)
+        XCTAssertEqual(OriginStubProtocol.hits(for: url), 2)
+    }
+
+    func testStaleEntryIsServedWhileRevalidatingInBackground() {
+        let revalidated = expectation(description: "background revalidation")
+        revalidated.expectedFulfillmentCount = 2
+        respond(cacheControl: "max-age=0, stale-while-revalidate=60") { _ in revalidated.fulfill() }
+
+        load()
+        let second = load()
+
+        XCTAssertNil(second.metrics, "served from the cache")
+        XCTAssertEqual(second.value, body)
+        wait(for: [revalidated], timeout: 5)
+        XCTAssertEqual(OriginStubProtocol.hits(for: url), 2)
+    }
+
+    func testConcurrentLoadsShareOneOriginRequest() {
+        respond(cacheControl: "max-age=60")
+
+        let loaded = expectation(description: "loads")
+        loaded.expectedFulfillmentCount = 5
+        for _ in 0..<5 {
+            cache.load(url, using: session) { response in
+                XCTAssertEqual(response.value, self.body)
+                loaded.fulfill()
+            }
+        }
+        wait(for: [loaded], timeout: 5)
+
+        XCTAssertEqual(OriginStubProtocol.hits(for: url), 1)
+    }
+
+    func testNoStoreResponseIsNotCached() {
+        respond(cacheControl: "no-store, max-age=60")
+
+        load()
+        load()
+
+        XCTAssertNil(cache.entry(for: url))
+        XCTAssertEqual(OriginStubProtocol.hits(for: url), 2)
+    }
+
+    func testEntryCanBeReadFromCacheQueue() {
+        respond(cacheControl: "max-age=60")
+
+        // 回调在 cache.queue 上时读 entry 不能死锁
+        let loaded = expectation(description: "load")
+        cache.load(url, using: session, queue: cache.queue) { response in
+            XCTAssertEqual(self.cache.entry(for: self.url)?.data, response.value)
+            loaded.fulfill()
+        }
+        wait(for: [loaded], timeout: 5)
+    }
+
+    func testMalformedDirectivesAreIgnored() {
+        respond(cacheControl: "=, ,max-age=60,=")
+
+        load()
+        load()
+
+        XCTAssertEqual(OriginStubProtocol.hits(for: url), 1)
+    }
+}
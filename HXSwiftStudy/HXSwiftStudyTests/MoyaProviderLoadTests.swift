@@ -0,0 +1,307 @@
+//
+//  MoyaProviderLoadTests.swift
+//  HXSwiftStudyTests
+//
+//  Created by HuXin on 2026/10/18.
+//
+
+import XCTest
+import Moya
+
+/// 压测用的 target, 每个请求自带注入的延迟和响应体大小
+enum LoadTestAPI {
+    case sample(index: Int, latency: TimeInterval, payloadSize: Int)
+}
+
+extension LoadTestAPI: TargetType {
+    var baseURL: URL { URL(string: "https://loadtest.hxswiftstudy.test")! }
+
+    var path: String {
+        switch self {
+        case let .sample(index, _, _):
+            return "/sample/\(index)"
+        }
+    }
+
+    var method: Moya.Method { .get }
+
+    var sampleData: Data {
+        switch self {
+        case let .sample(_, _, payloadSize):
+            return LoadTestAPI.payload(size: payloadSize)
+        }
+    }
+
+    var task: Moya.Task { .requestPlain }
+
+    var headers: [String: String]? { nil }
+
+    var index: Int {
+        switch self {
+        case let .sample(index, _, _):
+            return index
+        }
+    }
+
+    var latency: TimeInterval {
+        switch self {
+        case let .sample(_, latency, _):
+            return latency
+        }
+    }
+
+    private static var payloads: [Int: Data] = [:]
+    private static let payloadLock = NSLock()
+
+    /// 生成指定大小的 JSON 数组, 同样大小的只生成一次, 不把造数据的时间算进去
+    static func payload(size: Int) -> Data {
+        payloadLock.lock(); defer { payloadLock.unlock() }
+        if let payload = payloads[size] { return payload }
+
+        var text = "["
+        var index = 0
+        while text.utf8.count < size - 32 {
+            text += (index == 0 ? "" : ",") + "{\"id\":\(index),\"name\":\"item\(index)\"}"
+            index += 1
+        }
+        text += "]"
+
+        let payload = Data(text.utf8)
+        payloads[size] = payload
+        return payload
+    }
+}
+
+/// 测 MoyaProvider 和插件链本身的开销: 只算 provider 里的代码, 不算注入的延迟, 回调队列上的排队和 mapJSON
+class MoyaProviderLoadTests: XCTestCase {
+
+    /// 模拟的服务端延迟分布
+    enum Latency {
+        case constant(TimeInterval)
+        case uniform(ClosedRange<TimeInterval>)
+        /// 指数分布, 参数为平均值, 模拟长尾
+        case exponential(mean: TimeInterval)
+
+        func sample() -> TimeInterval {
+            switch self {
+            case let .constant(value):
+                return value
+            case let .uniform(range):
+                return TimeInterval.random(in: range)
+            case let .exponential(mean):
+                return -mean * log(1 - Double.random(in: 0..<1))
+            }
+        }
+    }
+
+    /// 给请求加一个头, 像业务里常见的公共参数插件
+    struct HeaderPlugin: PluginType {
+        let name: String
+
+        func prepare(_ request: URLRequest, target: TargetType) -> URLRequest {
+            var request = request
+            request.setValue(name, forHTTPHeaderField: name)
+            return request
+        }
+    }
+
+    /// 一个请求各阶段的时间点
+    final class Timing {
+        var issued: UInt64 = 0
+        var returned: UInt64 = 0
+        var stubFired: UInt64 = 0
+        var completed: UInt64 = 0
+
+        /// request 调用本身, 加上 stub 触发到回调的时间, 中间等待延迟的那段不算
+        var overhead: TimeInterval {
+            TimeInterval((returned - issued) + (completed - stubFired)) / 1_000_000_000
+        }
+    }
+
+    struct LoadReport: CustomStringConvertible {
+        let requestCount: Int
+        let failureCount: Int
+        let duration: TimeInterval
+        /// 每个请求在 provider 和插件链上的耗时, 已排序
+        let overheads: [TimeInterval]
+        /// 压测期间堆内存净增长除以请求数
+        let heapBytesPerRequest: Int
+
+        var throughput: Double { duration > 0 ? Double(requestCount) / duration : 0 }
+
+        func percentile(_ p: Double) -> TimeInterval {
+            guard !overheads.isEmpty else { return 0 }
+            return overheads[Int((p * Double(overheads.count - 1)).rounded())]
+        }
+
+        var description: String {
+            func ms(_ value: TimeInterval) -> String { String(format: "%.3fms", value * 1000) }
+
+            return [
+                "requests: \(requestCount), failures: \(failureCount), duration: \(String(format: "%.3fs", duration))",
+                "throughput: \(String(format: "%.1f", throughput)) req/s",
+                "overhead p50 \(ms(percentile(0.5))) p95 \(ms(percentile(0.95))) p99 \(ms(percentile(0.99)))",
+                "heap growth: \(heapBytesPerRequest) bytes/request",
+            ].joined(separator: "\n")
+        }
+    }
+
+    static let requestsPerRun = 2000
+    static let smallPayload = 1024
+    static let largePayload = 256 * 1024
+    static let plugins: [PluginType] = ["X-Client-Version", "X-Device-ID", "X-Locale"].map { HeaderPlugin(name: $0) }
+
+    // MARK: - Helpers
+
+    static func now() -> UInt64 { DispatchTime.now().uptimeNanoseconds }
+
+    static func heapBytesInUse() -> Int {
+        var statistics = malloc_statistics_t()
+        malloc_zone_statistics(nil, &statistics)
+        return Int(statistics.size_in_use)
+    }
+
+    /// 在并发的回调队列上跑一轮延迟 stub, 同时在途 concurrency 个请求
+    func runLoad(totalRequests: Int,
+                 concurrency: Int,
+                 latency: Latency,
+                 payloadSize: Int = MoyaProviderLoadTests.smallPayload,
+                 plugins: [PluginType] = []) -> LoadReport {
+        let timings = (0..<totalRequests).map { _ in Timing() }
+        let endpointClosure = { (target: LoadTestAPI) -> Endpoint in
+            Endpoint(url: URL(target: target).absoluteString,
+                     sampleResponseClosure: {
+                         timings[target.index].stubFired = Self.now()
+                         return .networkResponse(200, target.sampleData)
+                     },
+                     method: target.method,
+                     task: target.task,
+                     httpHeaderFields: target.headers)
+        }
+        // 回调直接在全局并发队列上执行, 不会排在别的请求的回调后面
+        let provider = MoyaProvider<LoadTestAPI>(endpointClosure: endpointClosure,
+                                                 stubClosure: { .delayed(seconds: $0.latency) },
+                                                 callbackQueue: .global(qos: .userInitiated),
+                                                 plugins: plugins)
+
+        let lock = NSLock()
+        var nextIndex = 0
+        var failureCount = 0
+        // request 返回和回调各算一次, 两个时间点都记下才算完
+        let finished = expectation(description: "load finished")
+        finished.expectedFulfillmentCount = 2 * totalRequests
+
+        func startNext() {
+            lock.lock()
+            guard nextIndex < totalRequests else { return lock.unlock() }
+            let index = nextIndex
+            nextIndex += 1
+            lock.unlock()
+
+            let timing = timings[index]
+            timing.issued = Self.now()
+            provider.request(.sample(index: index, latency: latency.sample(), payloadSize: payloadSize)) { result in
+                timing.completed = Self.now()
+                if case .failure = result {
+                    lock.lock()
+                    failureCount += 1
+                    lock.unlock()
+                }
+                finished.fulfill()
+                startNext()
+            }
+            timing.returned = Self.now()
+            finished.fulfill()
+        }
+
+        let startHeapBytes = Self.heapBytesInUse()
+        let start = Self.now()
+        (0..<min(concurrency, totalRequests)).forEach { _ in startNext() }
+        wait(for: [finished], timeout: 60)
+
+        return LoadReport(requestCount: totalRequests,
+                          failureCount: failureCount,
+                          duration: TimeInterval(Self.now() - start) / 1_000_000_000,
+                          overheads: timings.map { $0.overhead }.sorted(),
+                          heapBytesPerRequest: (Self.heapBytesInUse() - startHeapBytes) / totalRequests)
+    }
+
+    func attach(_ report: LoadReport, name: String) {
+        let attachment = XCTAttachment(string: report.description)
+        attachment.name = name
+        attachment.lifetime = .keepAlways
+        add(attachment)
+    }
+
+    /// 立即返回的 stub 没有回调队列时在 request 里同步回调, 测到的就只有 provider 和插件链
+    func measureRequests(payloadSize: Int, plugins: [PluginType] = [], threads: Int = 1) {
+        let provider = MoyaProvider<LoadTestAPI>(stubClosure: MoyaProvider.immediatelyStub, plugins: plugins)
+        let requestsPerThread = Self.requestsPerRun / threads
+
+        measure(metrics: [XCTClockMetric(), XCTMemoryMetric()]) {
+            DispatchQueue.concurrentPerform(iterations: threads) { thread in
+                var failureCount = 0
+                for index in 0..<requestsPerThread {
+                    let target = LoadTestAPI.sample(index: thread * requestsPerThread + index, latency: 0, payloadSize: payloadSize)
+                    provider.request(target) { result in
+                        if case .failure = result { failureCount += 1 }
+                    }
+                }
+                XCTAssertEqual(failureCount, 0)
+            }
+        }
+    }
+
+    // MARK: - 延迟分布下的开销报告
+
+    func testReportCoversEveryRequest() {
+        let report = runLoad(totalRequests: 200, concurrency: 8, latency: .uniform(0...0.002), plugins: Self.plugins)
+
+        XCTAssertEqual(report.failureCount, 0)
+        XCTAssertEqual(report.overheads.count, 200)
+        XCTAssertGreaterThan(report.throughput, 0)
+        XCTAssertLessThanOrEqual(report.percentile(0.5), report.percentile(0.99))
+    }
+
+    func testOverheadExcludesInjectedLatency() {
+        // 每个请求等 20 毫秒, 算出来的开销不应该包含这段
+        let report = runLoad(totalRequests: 64, concurrency: 16, latency: .constant(0.02))
+
+        XCTAssertEqual(report.failureCount, 0)
+        XCTAssertGreaterThanOrEqual(report.duration, 0.02 * 64 / 16)
+        XCTAssertLessThan(report.percentile(0.5), 0.02)
+        attach(report, name: "constant 20ms")
+    }
+
+    func testReportsForLatencyDistributions() {
+        let distributions: [(String, Latency)] = [
+            ("constant 1ms", .constant(0.001)),
+            ("uniform 0-5ms", .uniform(0...0.005)),
+            ("exponential mean 2ms", .exponential(mean: 0.002)),
+        ]
+        for (name, latency) in distributions {
+            let report = runLoad(totalRequests: Self.requestsPerRun, concurrency: 32, latency: latency, plugins: Self.plugins)
+
+            XCTAssertEqual(report.failureCount, 0, name)
+            attach(report, name: name)
+        }
+    }
+
+    // MARK: - provider 和插件链
+
+    func testPerformanceSmallPayload() {
+        measureRequests(payloadSize: Self.smallPayload)
+    }
+
+    func testPerformanceLargePayload() {
+        measureRequests(payloadSize: Self.largePayload)
+    }
+
+    func testPerformanceSmallPayloadWithPlugins() {
+        measureRequests(payloadSize: Self.smallPayload, plugins: Self.plugins)
+    }
+
+    func testPerformanceSmallPayloadFromEightThreads() {
+        measureRequests(payloadSize: Self.smallPayload, plugins: Self.plugins, threads: 8)
+    }
+}
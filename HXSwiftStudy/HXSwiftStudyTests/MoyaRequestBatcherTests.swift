@@ -0,0 +1,286 @@
+//
+//  MoyaRequestBatcherTests.swift
+//  HXSwiftStudyTests
+//
+//  Created by HuXin on 2026/10/18.
+//
+
+import XCTest
+import Moya
+@testable import HXSwiftStudy
+
+class MoyaRequestBatcherTests: XCTestCase {
+
+    /// 课堂页面上常见的小请求
+    enum ClassroomAPI: TargetType {
+        case rollCall
+        case quizState(Int)
+        case survey
+        case submitAnswer(String)
+
+        var baseURL: URL { URL(string: "https://classroom.hxswiftstudy.test")! }
+        var path: String {
+            switch self {
+            case .rollCall:
+                return "/roll-call"
+            case let .quizState(id):
+                return "/quizzes/\(id)"
+            case .survey:
+                return "/survey"
+            case .submitAnswer:
+                return "/answers"
+            }
+        }
+        var method: Moya.Method {
+            switch self {
+            case .submitAnswer:
+                return .post
+            default:
+                return .get
+            }
+        }
+        var sampleData: Data { Data("{\"path\":\"\(path)\"}".utf8) }
+        var task: Moya.Task {
+            switch self {
+            case let .submitAnswer(answer):
+                return .requestParameters(parameters: ["answer": answer], encoding: JSONEncoding.default)
+            default:
+                return .requestPlain
+            }
+        }
+        var headers: [String: String]? { nil }
+    }
+
+    /// 记下每个路径上插件各个回调被调了几次
+    final class CountingPlugin: PluginType {
+        private let lock = NSLock()
+        private var prepares: [String: Int] = [:]
+        private var successes: [String: Int] = [:]
+        private var failures: [String: Int] = [:]
+
+        func prepare(_ request: URLRequest, target: TargetType) -> URLRequest {
+            lock.lock(); defer { lock.unlock() }
+            prepares[target.path, default: 0] += 1
+            var request = request
+            request.setValue("token", forHTTPHeaderField: "Authorization")
+            return request
+        }
+
+        func didReceive(_ result: Result<Moya.Response, MoyaError>, target: TargetType) {
+            lock.lock(); defer { lock.unlock() }
+            switch result {
+            case .success:
+                successes[target.path, default: 0] += 1
+            case .failure:
+                failures[target.path, default: 0] += 1
+            }
+        }
+
+        func prepareCount(_ path: String) -> Int {
+            lock.lock(); defer { lock.unlock() }
+            return prepares[path] ?? 0
+        }
+
+        func successCount(_ path: String) -> Int {
+            lock.lock(); defer { lock.unlock() }
+            return successes[path] ?? 0
+        }
+
+        func failureCount(_ path: String) -> Int {
+            lock.lock(); defer { lock.unlock() }
+            return failures[path] ?? 0
+        }
+    }
+
+    static let baseURL = URL(string: "https://classroom.hxswiftstudy.test")!
+
+    var plugin: CountingPlugin!
+
+    override func setUp() {
+        plugin = CountingPlugin()
+    }
+
+    override func tearDown() {
+        plugin = nil
+    }
+
+    // MARK: - Helpers
+
+    /// stub 的批量接口: 响应由各个 target 的 sampleData 拼成, latency 模拟一次往返
+    func makeBatcher(latency: TimeInterval = 0, window: TimeInterval = 0.05) -> MoyaRequestBatcher {
+        let provider = MoyaProvider<MultiTarget>(stubClosure: { _ in latency > 0 ? .delayed(seconds: latency) : .immediate },
+                                                 plugins: [plugin])
+        var configuration = MoyaBatchConfiguration(baseURL: Self.baseURL)
+        configuration.window = window
+
+        return MoyaRequestBatcher(provider: provider, configuration: configuration)
+    }
+
+    /// 发出一组请求, 等所有回调回来, 结果按发出的顺序返回
+    func send(_ targets: [ClassroomAPI], through batcher: MoyaRequestBatcher) -> [Result<Moya.Response, MoyaError>] {
+        var results = [Result<Moya.Response, MoyaError>?](repeating: nil, count: targets.count)
+        let finished = expectation(description: "all requests finished")
+        finished.expectedFulfillmentCount = max(targets.count, 1)
+        if targets.isEmpty { finished.fulfill() }
+
+        for (index, target) in targets.enumerated() {
+            batcher.request(target) { result in
+                results[index] = result
+                finished.fulfill()
+            }
+        }
+        wait(for: [finished], timeout: 10)
+
+        return results.compactMap { $0 }
+    }
+
+    func isCancelled(_ result: Result<Moya.Response, MoyaError>?) -> Bool {
+        guard case let .failure(.underlying(error, _))? = result else { return false }
+        return (error as NSError).code == NSURLErrorCancelled
+    }
+
+    // MARK: - 合并
+
+    func testRequestsInOneWindowShareOneBatch() throws {
+        let batcher = makeBatcher()
+        let targets: [ClassroomAPI] = [.rollCall, .quizState(1), .quizState(2), .survey]
+
+        let results = send(targets, through: batcher)
+
+        XCTAssertEqual(try results.map { try $0.get().data }, targets.map { $0.sampleData })
+        XCTAssertEqual(try results.map { try $0.get().request?.url?.path }, targets.map { $0.path })
+        XCTAssertEqual(batcher.requestedCount, 4)
+        XCTAssertEqual(batcher.sentCount, 1)
+    }
+
+    func testBatchIsSplitAtMaximumBatchSize() {
+        var configuration = MoyaBatchConfiguration(baseURL: Self.baseURL)
+        configuration.maximumBatchSize = 5
+        let batcher = MoyaRequestBatcher(provider: MoyaProvider<MultiTarget>(stubClosure: MoyaProvider.immediatelyStub),
+                                         configuration: configuration)
+
+        let results = send((0..<12).map { .quizState($0) }, through: batcher)
+
+        XCTAssertEqual(results.filter { (try? $0.get()) != nil }.count, 12)
+        XCTAssertEqual(batcher.sentCount, 3)
+    }
+
+    func testUnbatchableRequestsGoStraightThrough() {
+        let batcher = makeBatcher()
+
+        let results = send([.submitAnswer("A"), .submitAnswer("B")], through: batcher)
+
+        XCTAssertEqual(results.count, 2)
+        XCTAssertEqual(batcher.requestedCount, 2)
+        XCTAssertEqual(batcher.sentCount, 2)
+    }
+
+    // MARK: - 插件
+
+    func testLoneRequestIsPreparedOnce() {
+        let batcher = makeBatcher()
+
+        _ = send([.survey], through: batcher)
+
+        XCTAssertEqual(batcher.sentCount, 1)
+        XCTAssertEqual(plugin.prepareCount("/survey"), 1)
+        XCTAssertEqual(plugin.successCount("/survey"), 1)
+        XCTAssertEqual(plugin.prepareCount("/batch"), 0)
+    }
+
+    func testBatchedRequestsArePreparedOnceAndEncodedWithPluginHeaders() {
+        let batcher = makeBatcher()
+
+        let results = send([.rollCall, .survey], through: batcher)
+
+        XCTAssertEqual(plugin.prepareCount("/roll-call"), 1)
+        XCTAssertEqual(plugin.prepareCount("/survey"), 1)
+        XCTAssertEqual(plugin.prepareCount("/batch"), 1)
+        XCTAssertEqual(plugin.successCount("/roll-call"), 1)
+        XCTAssertEqual(plugin.successCount("/survey"), 1)
+        // 拆回来的响应带着 prepare 过的请求
+        XCTAssertEqual(results.compactMap { try? $0.get().request?.value(forHTTPHeaderField: "Authorization") }, ["token", "token"])
+    }
+
+    // MARK: - 取消
+
+    func testCancelledRequestIsLeftOutOfTheBatch() {
+        let batcher = makeBatcher()
+        var results: [String: Result<Moya.Response, MoyaError>] = [:]
+        let finished = expectation(description: "all requests finished")
+        finished.expectedFulfillmentCount = 3
+
+        for target in [ClassroomAPI.rollCall, .survey] {
+            batcher.request(target) { result in
+                results[target.path] = result
+                finished.fulfill()
+            }
+        }
+        batcher.request(ClassroomAPI.quizState(1)) { result in
+            results["/quizzes/1"] = result
+            finished.fulfill()
+        }.cancel()
+        wait(for: [finished], timeout: 10)
+
+        XCTAssertTrue(isCancelled(results["/quizzes/1"]))
+        XCTAssertNotNil(try results["/roll-call"]?.get())
+        XCTAssertNotNil(try results["/survey"]?.get())
+        XCTAssertEqual(plugin.prepareCount("/quizzes/1"), 0)
+    }
+
+    func testCancellingLoneRequestCancelsTheProviderRequest() {
+        // 窗口结束后请求已经交给 provider, 服务端还要 0.5 秒才回
+        let batcher = makeBatcher(latency: 0.5, window: 0.01)
+        var result: Result<Moya.Response, MoyaError>?
+        let finished = expectation(description: "cancelled")
+
+        let cancellable = batcher.request(ClassroomAPI.survey) {
+            result = $0
+            finished.fulfill()
+        }
+        Thread.sleep(forTimeInterval: 0.1)
+        XCTAssertEqual(batcher.sentCount, 1)
+        cancellable.cancel()
+        wait(for: [finished], timeout: 5)
+
+        // provider 那边的 stub 被取消, 插件收到的是取消而不是响应
+        let stubCancelled = XCTNSPredicateExpectation(predicate: NSPredicate { _, _ in self.plugin.failureCount("/survey") == 1 }, object: nil)
+        wait(for: [stubCancelled], timeout: 2)
+        XCTAssertTrue(isCancelled(result))
+        XCTAssertEqual(plugin.successCount("/survey"), 0)
+    }
+
+    // MARK: - 请求数和尾延迟
+
+    /// 一节课里同时刷新 40 个小组件, 每个往返 50 毫秒
+    static let widgetTargets: [ClassroomAPI] = (0..<40).map { $0 % 4 == 0 ? .rollCall : .quizState($0) }
+
+    func testBatchingReducesRequestCount() {
+        let batcher = makeBatcher(latency: 0.05, window: 0.01)
+
+        _ = send(Self.widgetTargets, through: batcher)
+
+        XCTAssertEqual(batcher.requestedCount, 40)
+        XCTAssertEqual(batcher.sentCount, 2)
+    }
+
+    func testPerformanceBatched() {
+        let batcher = makeBatcher(latency: 0.05, window: 0.01)
+        measure {
+            XCTAssertEqual(send(Self.widgetTargets, through: batcher).count, Self.widgetTargets.count)
+        }
+    }
+
+    func testPerformanceUnbatched() {
+        // 对照: 不合并, 每个请求各自走一次往返
+        let provider = MoyaProvider<MultiTarget>(stubClosure: { _ in .delayed(seconds: 0.05) })
+        measure {
+            let finished = expectation(description: "all requests finished")
+            finished.expectedFulfillmentCount = Self.widgetTargets.count
+            Self.widgetTargets.forEach { target in
+                provider.request(MultiTarget(target)) { _ in finished.fulfill() }
+            }
+            wait(for: [finished], timeout: 10)
+        }
+    }
+}
@@ -0,0 +1,183 @@
+//
+//  MoyaSingleFlightTests.swift
+//  HXSwiftStudyTests
+//
+//  Created by HuXin on 2026/10/18.
+//
+
+import XCTest
+import Moya
+
+/// 用 stubClosure 驱动 trackInflights, 验证同一个 Endpoint 的并发请求只发出一次, 取消和失败各自分发给每个调用方
+class MoyaSingleFlightTests: XCTestCase {
+
+    enum RestaurantAPI: TargetType {
+        case list
+
+        var baseURL: URL { URL(string: "https://api.hxswiftstudy.test")! }
+        var path: String { "/restaurants" }
+        var method: Moya.Method { .get }
+        var sampleData: Data { Data("[]".utf8) }
+        var task: Moya.Task { .requestPlain }
+        var headers: [String: String]? { nil }
+    }
+
+    let delay: TimeInterval = 0.2
+
+    /// stub 真正返回响应的次数, 即打到"服务器"的请求数
+    var hits = 0
+
+    override func setUp() {
+        hits = 0
+    }
+
+    // MARK: - Helpers
+
+    func makeProvider(trackInflights: Bool = true,
+                      requestClosure: @escaping MoyaProvider<RestaurantAPI>.RequestClosure = MoyaProvider<RestaurantAPI>.defaultRequestMapping) -> MoyaProvider<RestaurantAPI> {
+        let endpointClosure = { [unowned self] (target: RestaurantAPI) -> Endpoint in
+            Endpoint(url: URL(target: target).absoluteString,
+                     sampleResponseClosure: {
+                         self.hits += 1
+                         return .networkResponse(200, target.sampleData)
+                     },
+                     method: target.method,
+                     task: target.task,
+                     httpHeaderFields: target.headers)
+        }
+
+        return MoyaProvider<RestaurantAPI>(endpointClosure: endpointClosure,
+                                           requestClosure: requestClosure,
+                                           stubClosure: MoyaProvider.delayedStub(delay),
+                                           trackInflights: trackInflights)
+    }
+
+    /// 等到 stub 的延迟过去, 确认被取消的请求之后也不会再回调
+    func waitForStubs() {
+        let drained = expectation(description: "stub delay elapsed")
+        DispatchQueue.main.asyncAfter(deadline: .now() + delay * 2) { drained.fulfill() }
+        wait(for: [drained], timeout: 5)
+    }
+
+    func isCancellation(_ result: Result<Moya.Response, MoyaError>) -> Bool {
+        guard case let .failure(.underlying(error as NSError, _)) = result else { return false }
+        return error.domain == NSURLErrorDomain && error.code == NSURLErrorCancelled
+    }
+
+    // MARK: - Tests
+
+    func testConcurrentCallersJoinOneRequest() {
+        let provider = makeProvider()
+
+        let completed = expectation(description: "callers")
+        completed.expectedFulfillmentCount = 3
+        for _ in 0..<3 {
+            provider.request(.list) { result in
+                XCTAssertEqual(try? result.get().data, Data("[]".utf8))
+                completed.fulfill()
+            }
+        }
+        XCTAssertEqual(provider.inflightRequests.count, 1)
+        XCTAssertEqual(provider.inflightRequests.values.first?.count, 3)
+
+        wait(for: [completed], timeout: 5)
+        XCTAssertEqual(hits, 1)
+        XCTAssertTrue(provider.inflightRequests.isEmpty)
+
+        // 完成后的请求重新发出
+        let again = expectation(description: "again")
+        provider.request(.list) { _ in again.fulfill() }
+        wait(for: [again], timeout: 5)
+        XCTAssertEqual(hits, 2)
+    }
+
+    func testWithoutTrackingEveryCallerSendsItsOwnRequest() {
+        let provider = makeProvider(trackInflights: false)
+
+        let completed = expectation(description: "callers")
+        completed.expectedFulfillmentCount = 3
+        for _ in 0..<3 {
+            provider.request(.list) { _ in completed.fulfill() }
+        }
+
+        wait(for: [completed], timeout: 5)
+        XCTAssertEqual(hits, 3)
+    }
+
+    func testCancellingOneCallerOnlyCancelsThatCaller() {
+        let provider = makeProvider()
+
+        let cancelled = expectation(description: "cancelled caller")
+        let first = provider.request(.list) { result in
+            XCTAssertTrue(self.isCancellation(result), "\(result)")
+            cancelled.fulfill()
+        }
+
+        let completed = expectation(description: "remaining caller")
+        let second = provider.request(.list) { result in
+            XCTAssertEqual(try? result.get().statusCode, 200)
+            completed.fulfill()
+        }
+
+        first.cancel()
+        wait(for: [cancelled], timeout: 1)
+        XCTAssertTrue(first.isCancelled)
+        XCTAssertFalse(second.isCancelled)
+        XCTAssertEqual(provider.inflightRequests.values.first?.count, 1)
+
+        // 重复取消不会再回调
+        first.cancel()
+
+        wait(for: [completed], timeout: 5)
+        XCTAssertEqual(hits, 1)
+    }
+
+    func testLastCallerCancellingCancelsSharedRequest() {
+        let provider = makeProvider()
+
+        let cancelled = expectation(description: "cancelled callers")
+        cancelled.expectedFulfillmentCount = 2
+        let tokens = (0..<2).map { _ in
+            provider.request(.list) { result in
+                XCTAssertTrue(self.isCancellation(result), "\(result)")
+                cancelled.fulfill()
+            }
+        }
+
+        tokens[0].cancel()
+        XCTAssertEqual(provider.inflightRequests.count, 1, "one caller is still waiting")
+        tokens[1].cancel()
+        XCTAssertTrue(provider.inflightRequests.isEmpty)
+
+        wait(for: [cancelled], timeout: 1)
+        waitForStubs()
+        XCTAssertEqual(hits, 0, "the shared stub was cancelled before it responded")
+    }
+
+    func testRequestClosureFailureIsDeliveredToEveryCaller() {
+        // requestClosure 异步完成, 让后来的调用方先加入同一个请求
+        var pending: [MoyaProvider<RestaurantAPI>.RequestResultClosure] = []
+        let provider = makeProvider { _, done in pending.append(done) }
+
+        let failed = expectation(description: "callers")
+        failed.expectedFulfillmentCount = 3
+        for _ in 0..<3 {
+            provider.request(.list) { result in
+                guard case .failure(.requestMapping("broken")) = result else {
+                    return XCTFail("\(result)")
+                }
+                failed.fulfill()
+            }
+        }
+        XCTAssertEqual(pending.count, 1)
+
+        pending.removeFirst()(.failure(.requestMapping("broken")))
+        wait(for: [failed], timeout: 1)
+        XCTAssertTrue(provider.inflightRequests.isEmpty)
+        XCTAssertEqual(hits, 0)
+
+        // 失败的请求不会留在表里, 下一次调用重新走 requestClosure
+        provider.request(.list) { _ in }
+        XCTAssertEqual(pending.count, 1)
+    }
+}
@@ -0,0 +1,248 @@
+//
+//  MultipartFormDataStreamTests.swift
+//  HXSwiftStudyTests
+//
+//  Created by HuXin on 2026/10/18.
+//
+
+import XCTest
+@testable import Alamofire
+
+/// 模拟上传接口: 把收到的请求体原样返回; holdsBody 时一个字节都不读, 也不回应
+final class UploadEchoProtocol: URLProtocol {
+    private static let lock = NSLock()
+    private static var _holdsBody = false
+
+    static var holdsBody: Bool {
+        get { lock.lock(); defer { lock.unlock() }; return _holdsBody }
+        set { lock.lock(); defer { lock.unlock() }; _holdsBody = newValue }
+    }
+
+    override class func canInit(with request: URLRequest) -> Bool { true }
+
+    override class func canonicalRequest(for request: URLRequest) -> URLRequest { request }
+
+    override func startLoading() {
+        guard !UploadEchoProtocol.holdsBody else { return }
+
+        DispatchQueue.global().async {
+            let body = self.request.httpBodyStream.map(MultipartFormDataStreamTests.readAll) ?? self.request.httpBody ?? Data()
+            let response = HTTPURLResponse(url: self.request.url!, statusCode: 200, httpVersion: "HTTP/1.1", headerFields: nil)!
+            self.client?.urlProtocol(self, didReceive: response, cacheStoragePolicy: .notAllowed)
+            self.client?.urlProtocol(self, didLoad: body)
+            self.client?.urlProtocolDidFinishLoading(self)
+        }
+    }
+
+    override func stopLoading() {}
+}
+
+class MultipartFormDataStreamTests: XCTestCase {
+
+    static let megabyte = 1024 * 1024
+
+    var directory: URL!
+    var session: Session!
+
+    override func setUp() {
+        directory = FileManager.default.temporaryDirectory.appendingPathComponent(UUID().uuidString, isDirectory: true)
+        try? FileManager.default.createDirectory(at: directory, withIntermediateDirectories: true)
+
+        UploadEchoProtocol.holdsBody = false
+        let configuration = URLSessionConfiguration.af.default
+        configuration.protocolClasses = [UploadEchoProtocol.self]
+        session = Session(configuration: configuration)
+    }
+
+    override func tearDown() {
+        try? FileManager.default.removeItem(at: directory)
+        session = nil
+    }
+
+    // MARK: - Helpers
+
+    /// 读到流结束, 读出错返回已读到的部分
+    static func readAll(_ stream: InputStream) -> Data {
+        var data = Data()
+        var buffer = [UInt8](repeating: 0, count: 16 * 1024)
+        stream.open()
+        defer { stream.close() }
+        while true {
+            let bytesRead = stream.read(&buffer, maxLength: buffer.count)
+            guard bytesRead > 0 else { break }
+
+            data.append(buffer, count: bytesRead)
+        }
+
+        return data
+    }
+
+    /// 读到流结束, 只数字节数, 内存占用只有一个缓冲区
+    static func countBytes(of stream: InputStream) -> Int {
+        var count = 0
+        var buffer = [UInt8](repeating: 0, count: 64 * 1024)
+        stream.open()
+        defer { stream.close() }
+        while true {
+            let bytesRead = stream.read(&buffer, maxLength: buffer.count)
+            guard bytesRead > 0 else { break }
+
+            count += bytesRead
+        }
+
+        return count
+    }
+
+    /// 像一批菜品照片: 几个文件加一个小字段
+    func photoFiles(count: Int, length: Int) throws -> [URL] {
+        try (0..<count).map { index in
+            let url = directory.appendingPathComponent("food-\(index).jpg")
+            try Data((0..<length).map { UInt8(truncatingIfNeeded: $0 &* 31 &+ index) }).write(to: url)
+            return url
+        }
+    }
+
+    func formData(files: [URL]) -> MultipartFormData {
+        let formData = MultipartFormData(boundary: "hxswiftstudy.boundary")
+        formData.append(Data("蛋炒饭".utf8), withName: "name")
+        files.forEach { formData.append($0, withName: "photos") }
+        formData.streamsEncodedBody = true
+
+        return formData
+    }
+
+    /// 等 writer 的线程退出, 线程一退出就不再持有 writer
+    func waitUntilReleased(_ writer: inout MultipartFormData.StreamWriter?, file: StaticString = #filePath, line: UInt = #line) {
+        weak var released = writer
+        writer = nil
+        let expectation = XCTNSPredicateExpectation(predicate: NSPredicate { _, _ in released == nil }, object: nil)
+        XCTAssertEqual(XCTWaiter.wait(for: [expectation], timeout: 5), .completed, "writer thread still running", file: file, line: line)
+    }
+
+    // MARK: - 正确性
+
+    func testStreamMatchesInMemoryEncoding() throws {
+        let formData = self.formData(files: try photoFiles(count: 3, length: 300 * 1024 + 7))
+
+        let expected = try formData.encode()
+        let streamed = Self.readAll(try formData.encodedInputStream(bufferSize: 1024))
+
+        XCTAssertEqual(UInt64(streamed.count), formData.encodedContentLength)
+        XCTAssertEqual(streamed, expected)
+    }
+
+    func testEmptyFormDataStreamsNothing() throws {
+        XCTAssertEqual(Self.readAll(try MultipartFormData().encodedInputStream()), Data())
+    }
+
+    func testWriterIsReleasedOnceStreamIsRead() throws {
+        var writer: MultipartFormData.StreamWriter? = try formData(files: photoFiles(count: 1, length: Self.megabyte)).encodedStreamWriter()
+        _ = Self.countBytes(of: writer!.inputStream)
+
+        waitUntilReleased(&writer)
+    }
+
+    func testCancellingUnreadStreamReleasesWriter() throws {
+        // 没人读的流, writer 写满缓冲区后一直等着, 只有 cancel 能让它退出
+        var writer: MultipartFormData.StreamWriter? = try formData(files: photoFiles(count: 1, length: Self.megabyte)).encodedStreamWriter(bufferSize: 1024)
+        Thread.sleep(forTimeInterval: 0.1)
+        XCTAssertFalse(writer!.isFinished)
+
+        writer?.cancel()
+        writer?.cancel()
+
+        waitUntilReleased(&writer)
+    }
+
+    func testEachAttemptGetsAFreshStream() throws {
+        let formData = self.formData(files: try photoFiles(count: 2, length: Self.megabyte))
+        let upload = MultipartUpload(encodingMemoryThreshold: 0,
+                                     request: URLRequest(url: URL(string: "https://upload.hxswiftstudy.test/foods")!),
+                                     multipartFormData: formData)
+        let expected = try formData.encode()
+
+        guard case let .stream(first) = try upload.createUploadable(),
+              case let .stream(second) = try upload.createUploadable() else {
+            return XCTFail("streamed upload expected")
+        }
+
+        // 新流建好时, 旧的 writer 已经被拆掉, 旧流只能读到它被拆之前写进缓冲区的部分
+        XCTAssertNotIdentical(first, second)
+        XCTAssertLessThan(Self.readAll(first).count, expected.count)
+        XCTAssertEqual(Self.readAll(second), expected)
+    }
+
+    // MARK: - UploadRequest
+
+    func testStreamedUploadSendsTheEncodedBody() throws {
+        let formData = self.formData(files: try photoFiles(count: 2, length: Self.megabyte))
+        let expected = try formData.encode()
+
+        let uploaded = expectation(description: "upload")
+        var echoed: Data?
+        session.upload(multipartFormData: formData, to: "https://upload.hxswiftstudy.test/foods", usingThreshold: 0)
+            .responseData { response in
+                echoed = response.value
+                uploaded.fulfill()
+            }
+        wait(for: [uploaded], timeout: 10)
+
+        XCTAssertEqual(echoed, expected)
+    }
+
+    func testCancelledUploadTearsDownItsWriter() throws {
+        UploadEchoProtocol.holdsBody = true
+        let formData = self.formData(files: try photoFiles(count: 2, length: Self.megabyte))
+
+        let finished = expectation(description: "cancelled")
+        let request = session.upload(multipartFormData: formData, to: "https://upload.hxswiftstudy.test/foods", usingThreshold: 0)
+            .responseData { _ in finished.fulfill() }
+        Thread.sleep(forTimeInterval: 0.2)
+        request.cancel()
+        wait(for: [finished], timeout: 5)
+
+        // writer 还在等的话这里会一直读不到结尾
+        guard case let .stream(stream)? = request.uploadable else {
+            return XCTFail("streamed upload expected")
+        }
+        let drained = expectation(description: "stream ends")
+        DispatchQueue.global().async {
+            _ = Self.countBytes(of: stream)
+            drained.fulfill()
+        }
+        wait(for: [drained], timeout: 5)
+    }
+
+    // MARK: - 内存和吞吐
+
+    /// 8 张 4MB 的照片, 32MB 的请求体
+    func measureEncoding(_ encode: @escaping (MultipartFormData) throws -> Void) throws {
+        let files = try photoFiles(count: 8, length: 4 * Self.megabyte)
+        measure(metrics: [XCTMemoryMetric(), XCTClockMetric()]) {
+            autoreleasepool {
+                XCTAssertNoThrow(try encode(formData(files: files)))
+            }
+        }
+    }
+
+    func testPerformanceEncodeInMemory() throws {
+        try measureEncoding { formData in
+            XCTAssertEqual(UInt64(try formData.encode().count), formData.encodedContentLength)
+        }
+    }
+
+    func testPerformanceEncodeToTemporaryFile() throws {
+        // 超过 10MB 时原来的做法: 先整个写到临时文件
+        let fileURL = directory.appendingPathComponent("multipart.form.data")
+        try measureEncoding { formData in
+            try? FileManager.default.removeItem(at: fileURL)
+            try formData.writeEncodedData(to: fileURL)
+        }
+    }
+
+    func testPerformanceEncodedInputStream() throws {
+        try measureEncoding { formData in
+            XCTAssertEqual(UInt64(Self.countBytes(of: try formData.encodedInputStream())), formData.encodedContentLength)
+        }
+    }
+}
@@ -0,0 +1,162 @@
+//
+//  NetworkLoggerRecorderTests.swift
+//  HXSwiftStudyTests
+//
+//  Created by HuXin on 2026/10/18.
+//
+
+import XCTest
+import Moya
+
+/// 验证 Recorder 采样时请求和它的响应总是一起被记录或一起被丢弃, 并对比各种日志方式每个请求的开销
+class NetworkLoggerRecorderTests: XCTestCase {
+
+    enum ItemAPI: TargetType {
+        case item(Int)
+
+        var baseURL: URL { URL(string: "https://api.hxswiftstudy.test")! }
+        var path: String {
+            switch self {
+            case let .item(id):
+                return "/items/\(id)"
+            }
+        }
+        var method: Moya.Method { .get }
+        var sampleData: Data { Data("{}".utf8) }
+        var task: Moya.Task { .requestPlain }
+        var headers: [String: String]? { nil }
+    }
+
+    var directory: URL!
+
+    override func setUp() {
+        directory = FileManager.default.temporaryDirectory.appendingPathComponent(UUID().uuidString, isDirectory: true)
+    }
+
+    override func tearDown() {
+        try? FileManager.default.removeItem(at: directory)
+    }
+
+    // MARK: - Helpers
+
+    func makeProvider(recorder: NetworkLoggerPlugin.Recorder, failing: Bool = false) -> MoyaProvider<ItemAPI> {
+        makeProvider(plugins: [NetworkLoggerPlugin(configuration: .init(recorder: recorder))], failing: failing)
+    }
+
+    func makeProvider(plugins: [PluginType], failing: Bool = false, body: Data? = nil) -> MoyaProvider<ItemAPI> {
+        let endpointClosure = { (target: ItemAPI) -> Endpoint in
+            Endpoint(url: URL(target: target).absoluteString,
+                     sampleResponseClosure: {
+                         failing ? .networkError(NSError(domain: NSURLErrorDomain, code: NSURLErrorTimedOut, userInfo: nil))
+                                 : .networkResponse(200, body ?? target.sampleData)
+                     },
+                     method: target.method,
+                     task: target.task,
+                     httpHeaderFields: target.headers)
+        }
+
+        return MoyaProvider<ItemAPI>(endpointClosure: endpointClosure, stubClosure: MoyaProvider.immediatelyStub, plugins: plugins)
+    }
+
+    /// 立即返回的 stub 同步回调, 每个请求后写盘, 避免缓冲区满了丢记录
+    func send(_ ids: Range<Int>, through provider: MoyaProvider<ItemAPI>, recorder: NetworkLoggerPlugin.Recorder) {
+        for id in ids {
+            provider.request(.item(id)) { _ in }
+            recorder.flushSynchronously()
+        }
+    }
+
+    func records(of recorder: NetworkLoggerPlugin.Recorder) throws -> [NetworkLoggerPlugin.Record] {
+        let data = try Data(contentsOf: recorder.currentFileURL)
+        return try NetworkLoggerPlugin.Recorder.decodeRecords(from: data)
+    }
+
+    // MARK: - 正确性
+
+    func testRequestAndResponseAreSampledTogether() throws {
+        let recorder = NetworkLoggerPlugin.Recorder(directory: directory, sampleRate: 0.5, bufferCapacity: 16)
+        send(0..<400, through: makeProvider(recorder: recorder), recorder: recorder)
+
+        let records = try self.records(of: recorder)
+        let requests = records.filter { $0.kind == .request }.map { $0.path }
+        let responses = records.filter { $0.kind == .response }.map { $0.path }
+
+        XCTAssertEqual(requests, responses)
+        XCTAssertGreaterThan(requests.count, 100)
+        XCTAssertLessThan(requests.count, 300)
+        XCTAssertEqual(recorder.droppedRecordCount, 0)
+    }
+
+    func testFailuresWithoutResponseDoNotStarveLaterResponses() throws {
+        let recorder = NetworkLoggerPlugin.Recorder(directory: directory, sampleRate: 0.5, bufferCapacity: 16)
+
+        // 没有响应的失败远多于 bufferCapacity, 之后的响应仍然和请求一起记录
+        send(0..<200, through: makeProvider(recorder: recorder, failing: true), recorder: recorder)
+        let failureRecords = try records(of: recorder).count
+        send(200..<400, through: makeProvider(recorder: recorder), recorder: recorder)
+
+        let records = try self.records(of: recorder).dropFirst(failureRecords)
+        let requests = records.filter { $0.kind == .request }.map { $0.path }
+        let responses = records.filter { $0.kind == .response }.map { $0.path }
+
+        XCTAssertFalse(responses.isEmpty)
+        XCTAssertEqual(requests, responses)
+    }
+
+    func testUnsampledRequestsAreNotTagged() {
+        // sampleRate 为 1 时全部记录, 不需要给请求打标记
+        let plugin = NetworkLoggerPlugin(configuration: .init(recorder: NetworkLoggerPlugin.Recorder(directory: directory)))
+        let request = URLRequest(url: URL(string: "https://api.hxswiftstudy.test/items/1")!)
+
+        XCTAssertEqual(plugin.prepare(request, target: ItemAPI.item(1)), request)
+    }
+
+    // MARK: - 每个请求的开销
+
+    /// 大约 4KB 的响应体, 详细日志会把它整个格式化成字符串
+    static let responseBody = Data(("[" + (0..<100).map { "{\"id\":\($0),\"name\":\"item\($0)\"}" }.joined(separator: ",") + "]").utf8)
+    static let requestsPerRun = 2000
+
+    /// 立即返回的 stub 在 request 里同步回调, 只计发请求的线程上花的时间; 写盘在计时之外
+    func measureRequests(plugins: [PluginType], recorder: NetworkLoggerPlugin.Recorder? = nil) {
+        let provider = makeProvider(plugins: plugins, body: Self.responseBody)
+
+        measureMetrics([.wallClockTime], automaticallyStartMeasuring: false) {
+            startMeasuring()
+            for id in 0..<Self.requestsPerRun {
+                provider.request(.item(id)) { _ in }
+            }
+            stopMeasuring()
+            recorder?.flushSynchronously()
+        }
+        XCTAssertEqual(recorder?.droppedRecordCount ?? 0, 0)
+    }
+
+    func recordingPlugin(_ recorder: NetworkLoggerPlugin.Recorder) -> NetworkLoggerPlugin {
+        NetworkLoggerPlugin(configuration: .init(logOptions: .verbose, recorder: recorder))
+    }
+
+    func testPerformanceWithoutLogger() {
+        measureRequests(plugins: [])
+    }
+
+    func testPerformanceFormattingLogger() {
+        // 原来的做法: 同步格式化成字符串, 输出直接丢掉, 只算格式化
+        measureRequests(plugins: [NetworkLoggerPlugin(configuration: .init(output: { _, _ in }, logOptions: .verbose))])
+    }
+
+    func testPerformanceRecorderJSONLines() {
+        let recorder = NetworkLoggerPlugin.Recorder(directory: directory, format: .jsonLines, bufferCapacity: 2 * Self.requestsPerRun)
+        measureRequests(plugins: [recordingPlugin(recorder)], recorder: recorder)
+    }
+
+    func testPerformanceRecorderBinary() {
+        let recorder = NetworkLoggerPlugin.Recorder(directory: directory, bufferCapacity: 2 * Self.requestsPerRun)
+        measureRequests(plugins: [recordingPlugin(recorder)], recorder: recorder)
+    }
+
+    func testPerformanceRecorderSampled() {
+        let recorder = NetworkLoggerPlugin.Recorder(directory: directory, sampleRate: 0.1, bufferCapacity: 2 * Self.requestsPerRun)
+        measureRequests(plugins: [recordingPlugin(recorder)], recorder: recorder)
+    }
+}
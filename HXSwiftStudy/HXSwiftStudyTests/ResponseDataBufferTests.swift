@@ -0,0 +1,174 @@
+//
+//  ResponseDataBufferTests.swift
+//  HXSwiftStudyTests
+//
+//  Created by HuXin on 2026/10/18.
+//
+
+import XCTest
+@testable import Alamofire
+
+/// 对比 DataRequest 收响应体的两种做法: 原来每个分片都追加到一个 Data 上, 现在用 ResponseDataBuffer
+class ResponseDataBufferTests: XCTestCase {
+
+    /// URLSession 一次回调大约给 16KB
+    static let chunkLength = 16 * 1024
+
+    static let kilobyte = 1024
+    static let megabyte = 1024 * 1024
+
+    // MARK: - Helpers
+
+    /// 把响应体切成 URLSession 那样的分片, 内容按位置填, 方便检查拼接顺序
+    func chunks(forBodyLength length: Int) -> [Data] {
+        stride(from: 0, to: length, by: Self.chunkLength).map { offset in
+            let count = min(Self.chunkLength, length - offset)
+            return Data((offset..<offset + count).map { UInt8(truncatingIfNeeded: $0 / Self.chunkLength) })
+        }
+    }
+
+    /// 和 DataRequest.didReceive(data:) 一样收完整个响应体, 每个分片后都读一次 count 更新进度
+    @discardableResult
+    func receive(_ chunks: [Data], expectedLength: Int64) -> Data {
+        var buffer = ResponseDataBuffer(expectedLength: expectedLength)
+        var received = 0
+        for chunk in chunks {
+            buffer.append(chunk)
+            received = buffer.count
+        }
+        XCTAssertEqual(received, buffer.count)
+
+        return buffer.contiguousData()
+    }
+
+    /// 原来的做法
+    @discardableResult
+    func receiveIntoData(_ chunks: [Data]) -> Data {
+        var data: Data?
+        for chunk in chunks {
+            if data == nil {
+                data = chunk
+            } else {
+                data?.append(chunk)
+            }
+        }
+
+        return data ?? Data()
+    }
+
+    func measureBuffer(bodyLength: Int, knowsLength: Bool) {
+        let chunks = self.chunks(forBodyLength: bodyLength)
+        let expectedLength = knowsLength ? Int64(bodyLength) : NSURLSessionTransferSizeUnknown
+        measure {
+            XCTAssertEqual(receive(chunks, expectedLength: expectedLength).count, bodyLength)
+        }
+    }
+
+    func measureData(bodyLength: Int) {
+        let chunks = self.chunks(forBodyLength: bodyLength)
+        measure {
+            XCTAssertEqual(receiveIntoData(chunks).count, bodyLength)
+        }
+    }
+
+    // MARK: - 正确性
+
+    func testJoinedDataMatchesAppendedChunks() {
+        let chunks = self.chunks(forBodyLength: Self.megabyte + 123)
+        let expected = receiveIntoData(chunks)
+
+        XCTAssertEqual(receive(chunks, expectedLength: Int64(expected.count)), expected)
+        XCTAssertEqual(receive(chunks, expectedLength: NSURLSessionTransferSizeUnknown), expected)
+        // Content-Length 报少了, 多出来的分片也不能丢
+        XCTAssertEqual(receive(chunks, expectedLength: Int64(Self.chunkLength)), expected)
+    }
+
+    func testEmptyBodyIsEmptyData() {
+        var buffer = ResponseDataBuffer(expectedLength: 0)
+        buffer.append(Data())
+
+        XCTAssertEqual(buffer.count, 0)
+        XCTAssertTrue(buffer.contiguousData().isEmpty)
+    }
+
+    func testReadingTwiceDoesNotJoinAgain() {
+        var buffer = ResponseDataBuffer(expectedLength: NSURLSessionTransferSizeUnknown)
+        chunks(forBodyLength: Self.megabyte).forEach { buffer.append($0) }
+
+        let first = buffer.contiguousData()
+        let second = buffer.contiguousData()
+        first.withUnsafeBytes { firstBytes in
+            second.withUnsafeBytes { secondBytes in
+                XCTAssertEqual(firstBytes.baseAddress, secondBytes.baseAddress)
+            }
+        }
+    }
+
+    func testDataReadBeforeMoreArrivesIsUnchanged() {
+        let chunks = self.chunks(forBodyLength: 4 * Self.chunkLength)
+        var buffer = ResponseDataBuffer(expectedLength: NSURLSessionTransferSizeUnknown)
+        chunks[0..<2].forEach { buffer.append($0) }
+
+        let partial = buffer.contiguousData()
+        chunks[2...].forEach { buffer.append($0) }
+
+        XCTAssertEqual(partial, receiveIntoData(Array(chunks[0..<2])))
+        XCTAssertEqual(buffer.contiguousData(), receiveIntoData(chunks))
+    }
+
+    // MARK: - 1KB
+
+    func testPerformance1KBWithContentLength() {
+        measureBuffer(bodyLength: Self.kilobyte, knowsLength: true)
+    }
+
+    func testPerformance1KBWithoutContentLength() {
+        measureBuffer(bodyLength: Self.kilobyte, knowsLength: false)
+    }
+
+    func testPerformance1KBAppendingToData() {
+        measureData(bodyLength: Self.kilobyte)
+    }
+
+    // MARK: - 1MB
+
+    func testPerformance1MBWithContentLength() {
+        measureBuffer(bodyLength: Self.megabyte, knowsLength: true)
+    }
+
+    func testPerformance1MBWithoutContentLength() {
+        measureBuffer(bodyLength: Self.megabyte, knowsLength: false)
+    }
+
+    func testPerformance1MBAppendingToData() {
+        measureData(bodyLength: Self.megabyte)
+    }
+
+    // MARK: - 10MB
+
+    func testPerformance10MBWithContentLength() {
+        measureBuffer(bodyLength: 10 * Self.megabyte, knowsLength: true)
+    }
+
+    func testPerformance10MBWithoutContentLength() {
+        measureBuffer(bodyLength: 10 * Self.megabyte, knowsLength: false)
+    }
+
+    func testPerformance10MBAppendingToData() {
+        measureData(bodyLength: 10 * Self.megabyte)
+    }
+
+    // MARK: - 50MB
+
+    func testPerformance50MBWithContentLength() {
+        measureBuffer(bodyLength: 50 * Self.megabyte, knowsLength: true)
+    }
+
+    func testPerformance50MBWithoutContentLength() {
+        measureBuffer(bodyLength: 50 * Self.megabyte, knowsLength: false)
+    }
+
+    func testPerformance50MBAppendingToData() {
+        measureData(bodyLength: 50 * Self.megabyte)
+    }
+}
@@ -0,0 +1,105 @@
+//
+//  RestaurantImageStoreTests.swift
+//  HXSwiftStudyTests
+//
+//  Created by HuXin on 2026/10/18.
+//
+
+import XCTest
+@testable import HXSwiftStudy
+
+/// 验证图片原样再存时复用 key, 编码写盘不在调用线程上
+class RestaurantImageStoreTests: XCTestCase {
+
+    var keys: [String] = []
+
+    override func tearDown() {
+        RestaurantImageStore.synchronize()
+        keys.forEach { BNRBlobStore.shared().removeData(forKey: $0) }
+        keys = []
+    }
+
+    // MARK: - Helpers
+
+    func photo(hue: CGFloat, side: CGFloat = 1024) -> UIImage {
+        let format = UIGraphicsImageRendererFormat.default()
+        format.scale = 1
+        return UIGraphicsImageRenderer(size: CGSize(width: side, height: side), format: format).image { context in
+            UIColor(hue: hue, saturation: 0.6, brightness: 0.9, alpha: 1).setFill()
+            context.fill(CGRect(x: 0, y: 0, width: side, height: side))
+        }
+    }
+
+    func store(_ image: UIImage) throws -> String {
+        let key = try XCTUnwrap(RestaurantImageStore.store(image))
+        keys.append(key)
+        return key
+    }
+
+    // MARK: - Tests
+
+    func testImageIsAvailableBeforeAndAfterWrite() throws {
+        let image = photo(hue: 0.1)
+        let key = try store(image)
+
+        XCTAssertTrue(RestaurantImageStore.image(forKey: key) === image, "served from memory while the write is pending")
+
+        RestaurantImageStore.synchronize()
+        XCTAssertNotNil(BNRBlobStore.shared().contentHash(forKey: key))
+        XCTAssertTrue(RestaurantImageStore.image(forKey: key) === image)
+    }
+
+    func testStoringImageFromStoreReusesKey() throws {
+        let key = try store(photo(hue: 0.2))
+        RestaurantImageStore.synchronize()
+
+        // 界面拿到的图片原样重建对象, 比如 Restaurant(photo: restaruantImageView.image!)
+        let displayed = try XCTUnwrap(RestaurantImageStore.image(forKey: key))
+        XCTAssertEqual(RestaurantImageStore.store(displayed), key)
+        XCTAssertEqual(StoredImage(displayed).key, key)
+    }
+
+    func testStoringSameImageTwiceReusesKey() throws {
+        let image = photo(hue: 0.3)
+        let key = try store(image)
+
+        XCTAssertEqual(RestaurantImageStore.store(image), key)
+    }
+
+    func testEqualContentIsStoredOnce() throws {
+        let first = try store(photo(hue: 0.4))
+        let second = try store(photo(hue: 0.4))
+        RestaurantImageStore.synchronize()
+
+        XCTAssertNotEqual(first, second)
+        XCTAssertEqual(BNRBlobStore.shared().contentHash(forKey: first), BNRBlobStore.shared().contentHash(forKey: second))
+    }
+
+    func testPerformanceStoreOnCallingThread() {
+        let images = (0..<10).map { photo(hue: CGFloat($0) / 10) }
+
+        // 只计调用线程上的耗时, 编码和写盘在后台
+        measureMetrics(XCTestCase.defaultPerformanceMetrics, automaticallyStartMeasuring: false) {
+            let copies = images.map { UIImage(cgImage: $0.cgImage!) }
+
+            startMeasuring()
+            let keys = copies.compactMap { RestaurantImageStore.store($0) }
+            stopMeasuring()
+
+            self.keys += keys
+            RestaurantImageStore.synchronize()
+        }
+    }
+
+    func testPerformanceRestoringDisplayedImage() throws {
+        let key = try store(photo(hue: 0.5))
+        RestaurantImageStore.synchronize()
+        let displayed = try XCTUnwrap(RestaurantImageStore.image(forKey: key))
+
+        measure {
+            for _ in 0..<100 {
+                _ = RestaurantImageStore.store(displayed)
+            }
+        }
+    }
+}
@@ -0,0 +1,194 @@
+//
+//  RetryPolicyCircuitBreakerTests.swift
+//  HXSwiftStudyTests
+//
+//  Created by HuXin on 2026/10/18.
+//
+
+import XCTest
+@testable import Alamofire
+
+/// 用注入的时钟模拟一波 503, 逐个请求走 adapt -> 失败 -> retry(_:for:dueTo:completion:), 统计重试次数和熔断状态
+class RetryPolicyCircuitBreakerTests: XCTestCase {
+
+    /// 只返回固定响应的任务, 让 Request.response 拿到 503
+    final class StubDataTask: URLSessionDataTask {
+        private let stubbedResponse: URLResponse?
+
+        init(response: URLResponse?) {
+            stubbedResponse = response
+            super.init()
+        }
+
+        override var response: URLResponse? { stubbedResponse }
+    }
+
+    enum Outcome: Equatable {
+        /// 被打开的熔断器在 adapt 阶段拒绝
+        case rejected
+        /// 发出后策略不再重试
+        case gaveUp
+    }
+
+    let host = "api.hxswiftstudy.test"
+    lazy var url = URL(string: "https://\(host)/restaurants")!
+    let queue = DispatchQueue(label: "HXSwiftStudyTests.RetryPolicy")
+    var session: Session!
+
+    /// 模拟的当前时间, 由测试推进
+    var now: TimeInterval = 0
+    /// 策略给出的 retryWithDelay 次数
+    var retries = 0
+    /// 真正发出的请求次数, 包括重试
+    var attempts = 0
+
+    override func setUp() {
+        session = Session(startRequestsImmediately: false)
+        now = 0
+        retries = 0
+        attempts = 0
+    }
+
+    override func tearDown() {
+        session = nil
+    }
+
+    // MARK: - Simulation
+
+    /// 发起一个请求, 每次都收到 503, 按策略重试直到放弃或被熔断拒绝
+    func send(through policy: RetryPolicy, statusCode: Int = 503) -> Outcome {
+        let urlRequest = try! URLRequest(url: url, method: .get)
+        let request = DataRequest(convertible: urlRequest,
+                                  underlyingQueue: queue,
+                                  serializationQueue: queue,
+                                  eventMonitor: nil,
+                                  interceptor: nil,
+                                  delegate: session)
+        let response = HTTPURLResponse(url: url, statusCode: statusCode, httpVersion: "HTTP/1.1", headerFields: nil)
+        let error = AFError.responseValidationFailed(reason: .unacceptableStatusCode(code: statusCode))
+
+        while true {
+            var adaptResult: Result<URLRequest, Error>?
+            policy.adapt(urlRequest, for: session) { adaptResult = $0 }
+            guard case let .success(adaptedRequest) = adaptResult else {
+                XCTAssertTrue((adaptResult?.failure as? CircuitBreaker.OpenCircuitError)?.host == host)
+                return .rejected
+            }
+
+            attempts += 1
+            queue.sync {
+                request.didCreateInitialURLRequest(adaptedRequest)
+                request.didCreateTask(StubDataTask(response: response))
+            }
+
+            var retryResult: RetryResult?
+            policy.retry(request, for: session, dueTo: error) { retryResult = $0 }
+            guard case .retryWithDelay = retryResult else { return .gaveUp }
+
+            retries += 1
+            queue.sync { request.prepareForRetry() }
+        }
+    }
+
+    // MARK: - Tests
+
+    func testServiceUnavailableBurstOpensCircuitAndStopsRetries() {
+        let breaker = CircuitBreaker(failureThreshold: 5, failureWindow: 10, cooldown: 30, maximumProbes: 1) { [unowned self] in self.now }
+        let policy = RetryPolicy(retryLimit: 2, circuitBreaker: breaker)
+
+        XCTAssertEqual(breaker.state(for: host), .closed)
+
+        // 第 1 个请求: 失败 3 次, 重试 2 次后达到 retryLimit
+        XCTAssertEqual(send(through: policy), .gaveUp)
+        XCTAssertEqual(retries, 2)
+        XCTAssertEqual(breaker.state(for: host), .closed)
+
+        // 第 2 个请求: 第 5 次失败打开熔断器, 不再重试
+        XCTAssertEqual(send(through: policy), .gaveUp)
+        XCTAssertEqual(retries, 3)
+        XCTAssertEqual(breaker.state(for: host), .open)
+
+        // 同一波剩下的请求都在 adapt 阶段被拒绝, 不会再打到服务器
+        for _ in 0..<18 {
+            XCTAssertEqual(send(through: policy), .rejected)
+        }
+        XCTAssertEqual(retries, 3)
+        XCTAssertEqual(attempts, 5)
+
+        // 冷却结束后半开, 只放一个探测请求; 探测失败立即重新打开
+        now += 30
+        XCTAssertEqual(breaker.state(for: host), .halfOpen)
+        XCTAssertEqual(send(through: policy), .gaveUp)
+        XCTAssertEqual(breaker.state(for: host), .open)
+        XCTAssertEqual(send(through: policy), .rejected)
+        XCTAssertEqual(retries, 3)
+        XCTAssertEqual(attempts, 6)
+
+        // 再次半开, 探测期内没有新的失败, 冷却结束后关闭
+        now += 30
+        XCTAssertEqual(breaker.state(for: host), .halfOpen)
+        XCTAssertTrue(breaker.allowsRequest(to: host))
+        XCTAssertFalse(breaker.allowsRequest(to: host))
+        now += 30
+        XCTAssertEqual(breaker.state(for: host), .closed)
+        XCTAssertTrue(breaker.allowsRequest(to: host))
+    }
+
+    func testFailuresOutsideWindowDoNotOpenCircuit() {
+        let breaker = CircuitBreaker(failureThreshold: 3, failureWindow: 10, cooldown: 30) { [unowned self] in self.now }
+        let policy = RetryPolicy(retryLimit: 0, circuitBreaker: breaker)
+
+        for _ in 0..<6 {
+            XCTAssertEqual(send(through: policy), .gaveUp)
+            now += 6
+        }
+
+        XCTAssertEqual(breaker.state(for: host), .closed)
+        XCTAssertEqual(retries, 0)
+        XCTAssertEqual(attempts, 6)
+    }
+
+    func testRetryBudgetBoundsRetriesDuringBurst() {
+        // 初始 2 个令牌, 每次请求存 0.25, 不随时间补充
+        let budget = RetryBudget(capacity: 2, depositPerAttempt: 0.25, minimumRetriesPerSecond: 0) { [unowned self] in self.now }
+        let policy = RetryPolicy(retryLimit: 3, retryBudget: budget)
+
+        for _ in 0..<10 {
+            XCTAssertEqual(send(through: policy), .gaveUp)
+        }
+
+        // 重试次数不超过 初始令牌 + 每次请求存入的令牌
+        XCTAssertEqual(retries, 5)
+        XCTAssertEqual(attempts, 15)
+        XCTAssertLessThanOrEqual(Double(retries), budget.capacity + budget.depositPerAttempt * Double(attempts))
+
+        // 没有预算时, 同样的请求每个都会重试到 retryLimit
+        retries = 0
+        for _ in 0..<10 {
+            XCTAssertEqual(send(through: RetryPolicy(retryLimit: 3)), .gaveUp)
+        }
+        XCTAssertEqual(retries, 30)
+    }
+
+    func testRetryBudgetRefillsOverTime() {
+        let budget = RetryBudget(capacity: 1, depositPerAttempt: 0, minimumRetriesPerSecond: 0.5) { [unowned self] in self.now }
+        let policy = RetryPolicy(retryLimit: 1, retryBudget: budget)
+
+        XCTAssertEqual(send(through: policy), .gaveUp)
+        XCTAssertEqual(send(through: policy), .gaveUp)
+        XCTAssertEqual(retries, 1)
+
+        now += 2
+        XCTAssertEqual(send(through: policy), .gaveUp)
+        XCTAssertEqual(retries, 2)
+    }
+
+    func testNonRetryableStatusDoesNotCountTowardsCircuit() {
+        let breaker = CircuitBreaker(failureThreshold: 1) { [unowned self] in self.now }
+        let policy = RetryPolicy(circuitBreaker: breaker)
+
+        XCTAssertEqual(send(through: policy, statusCode: 404), .gaveUp)
+        XCTAssertEqual(breaker.state(for: host), .closed)
+        XCTAssertEqual(retries, 0)
+    }
+}
@@ -0,0 +1,224 @@
+//
+//  URLEncodedFormFlatEncoderTests.swift
+//  HXSwiftStudyTests
+//
+//  Created by HuXin on 2026/10/18.
+//
+
+import XCTest
+@testable import Alamofire
+
+/// 对比 URLEncodedFormEncoder 的扁平快速路径和通用的 `_URLEncodedFormEncoder`, 两者对同一个值必须输出相同的查询串
+class URLEncodedFormFlatEncoderTests: XCTestCase {
+
+    enum Sort: String, Encodable {
+        case newest
+        case hottest = "hot est"
+    }
+
+    enum Level: Int, Encodable {
+        case low = 1
+        case high = 9
+    }
+
+    /// 典型的分页查询模型, 可选值由合成的 encode(to:) 通过 encodeIfPresent 编码
+    struct PageQuery: Encodable {
+        var page = 2
+        var pageSize = 20
+        var keyword: String? = "swift & moya"
+        var sort: Sort? = .hottest
+        var level: Level? = .high
+        var since: Date? = Date(timeIntervalSince1970: 1_627_354_203.275)
+        var onlyFree = true
+        var price = 12.5
+        var ratio: Float = 0.25
+        var amount = Decimal(string: "19.99")!
+        var small: Int8 = -8
+        var big = UInt64.max
+        var token = Data([0xDE, 0xAD, 0xBE, 0xEF])
+    }
+
+    /// 可选值不经 encodeIfPresent 直接编码, 值会以 Optional 的形式进入编码器
+    struct ExplicitOptionals: Encodable {
+        var int: Int? = 5
+        var int8: Int8? = 8
+        var int16: Int16? = 16
+        var int32: Int32? = 32
+        var int64: Int64? = 64
+        var uint: UInt? = 5
+        var uint8: UInt8? = 8
+        var uint16: UInt16? = 16
+        var uint32: UInt32? = 32
+        var uint64: UInt64? = 64
+        var double: Double? = 1.5
+        var float: Float? = 2.5
+        var bool: Bool? = false
+        var string: String? = "text"
+        var sort: Sort? = .newest
+        var level: Level? = .low
+        var date: Date? = Date(timeIntervalSince1970: 0)
+        var decimal: Decimal? = Decimal(string: "3.14")
+
+        enum CodingKeys: String, CodingKey {
+            case int, int8, int16, int32, int64, uint, uint8, uint16, uint32, uint64, double, float, bool, string, sort, level, date, decimal
+        }
+
+        func encode(to encoder: Encoder) throws {
+            var container = encoder.container(keyedBy: CodingKeys.self)
+            try container.encode(int, forKey: .int)
+            try container.encode(int8, forKey: .int8)
+            try container.encode(int16, forKey: .int16)
+            try container.encode(int32, forKey: .int32)
+            try container.encode(int64, forKey: .int64)
+            try container.encode(uint, forKey: .uint)
+            try container.encode(uint8, forKey: .uint8)
+            try container.encode(uint16, forKey: .uint16)
+            try container.encode(uint32, forKey: .uint32)
+            try container.encode(uint64, forKey: .uint64)
+            try container.encode(double, forKey: .double)
+            try container.encode(float, forKey: .float)
+            try container.encode(bool, forKey: .bool)
+            try container.encode(string, forKey: .string)
+            try container.encode(sort, forKey: .sort)
+            try container.encode(level, forKey: .level)
+            try container.encode(date, forKey: .date)
+            try container.encode(decimal, forKey: .decimal)
+        }
+    }
+
+    struct ExplicitNil: Encodable {
+        var page: Int? = nil
+
+        enum CodingKeys: String, CodingKey {
+            case page
+        }
+
+        func encode(to encoder: Encoder) throws {
+            var container = encoder.container(keyedBy: CodingKeys.self)
+            try container.encode(page, forKey: .page)
+        }
+    }
+
+    struct NestedQuery: Encodable {
+        var page = 1
+        var ids = [1, 2, 3]
+        var filter = ["city": "beijing"]
+    }
+
+    let encoders: [URLEncodedFormEncoder] = [
+        URLEncodedFormEncoder(),
+        URLEncodedFormEncoder(alphabetizeKeyValuePairs: false),
+        URLEncodedFormEncoder(boolEncoding: .literal, dateEncoding: .secondsSince1970),
+        URLEncodedFormEncoder(dateEncoding: .millisecondsSince1970, keyEncoding: .convertToSnakeCase),
+        URLEncodedFormEncoder(dataEncoding: .custom { $0.map { String(format: "%02x", $0) }.joined() }, dateEncoding: .iso8601, spaceEncoding: .plusReplaced),
+        URLEncodedFormEncoder(alphabetizeKeyValuePairs: false, dateEncoding: .custom { "\(Int($0.timeIntervalSince1970))" }, keyEncoding: .convertToKebabCase),
+    ]
+
+    // MARK: - Helpers
+
+    /// 只走扁平快速路径, 需要通用编码器时返回 nil
+    func flatQuery<T: Encodable>(_ value: T, with encoder: URLEncodedFormEncoder) throws -> String? {
+        guard let pairs = try encoder.encodeFlat(value) else { return nil }
+
+        return serializer(for: encoder).serialize(pairs)
+    }
+
+    /// 只走通用的 `_URLEncodedFormEncoder`
+    func generalQuery<T: Encodable>(_ value: T, with encoder: URLEncodedFormEncoder) throws -> String {
+        let component: URLEncodedFormComponent = try encoder.encode(value)
+        guard case let .object(object) = component else {
+            XCTFail("\(T.self) did not encode to an object")
+            return ""
+        }
+
+        return serializer(for: encoder).serialize(object)
+    }
+
+    func serializer(for encoder: URLEncodedFormEncoder) -> URLEncodedFormSerializer {
+        URLEncodedFormSerializer(alphabetizeKeyValuePairs: encoder.alphabetizeKeyValuePairs,
+                                 arrayEncoding: encoder.arrayEncoding,
+                                 keyEncoding: encoder.keyEncoding,
+                                 spaceEncoding: encoder.spaceEncoding,
+                                 allowedCharacters: encoder.allowedCharacters)
+    }
+
+    func assertFlatMatchesGeneral<T: Encodable>(_ value: T, file: StaticString = #filePath, line: UInt = #line) throws {
+        for encoder in encoders {
+            let general = try generalQuery(value, with: encoder)
+            let flat = try XCTUnwrap(try flatQuery(value, with: encoder), "\(T.self) should take the flat path", file: file, line: line)
+
+            XCTAssertEqual(flat, general, file: file, line: line)
+            XCTAssertEqual(try encoder.encode(value) as String, general, file: file, line: line)
+        }
+    }
+
+    // MARK: - Tests
+
+    func testTypicalQueryModelMatchesGeneralEncoder() throws {
+        try assertFlatMatchesGeneral(PageQuery())
+    }
+
+    func testQueryModelWithoutOptionalValuesMatchesGeneralEncoder() throws {
+        try assertFlatMatchesGeneral(PageQuery(keyword: nil, sort: nil, level: nil, since: nil))
+    }
+
+    func testExplicitlyEncodedOptionalsMatchGeneralEncoder() throws {
+        try assertFlatMatchesGeneral(ExplicitOptionals())
+
+        let query = try XCTUnwrap(try flatQuery(ExplicitOptionals(), with: URLEncodedFormEncoder()))
+        XCTAssertFalse(query.contains("Optional"), query)
+    }
+
+    func testExplicitNilFallsBackToGeneralEncoder() throws {
+        // 扁平路径不处理 nil, 交给通用编码器, 通用编码器不支持 nil 值, 两条路径都要抛出同样的错误
+        for encoder in encoders {
+            XCTAssertNil(try flatQuery(ExplicitNil(), with: encoder))
+            XCTAssertThrowsError(try encoder.encode(ExplicitNil()) as String) { error in
+                assertInvalidValue(error)
+            }
+            XCTAssertThrowsError(try generalQuery(ExplicitNil(), with: encoder)) { error in
+                assertInvalidValue(error)
+            }
+        }
+    }
+
+    func assertInvalidValue(_ error: Error, file: StaticString = #filePath, line: UInt = #line) {
+        guard case EncodingError.invalidValue = error else {
+            return XCTFail("expected EncodingError.invalidValue, got \(error)", file: file, line: line)
+        }
+    }
+
+    func testNestedValuesFallBackToGeneralEncoder() throws {
+        for encoder in encoders {
+            XCTAssertNil(try flatQuery(NestedQuery(), with: encoder))
+            XCTAssertEqual(try encoder.encode(NestedQuery()) as String, try generalQuery(NestedQuery(), with: encoder))
+        }
+    }
+
+    func testDeferredDataFallsBackToGeneralEncoder() throws {
+        // Data 自身编码成数组, 只能交给通用编码器
+        let encoder = URLEncodedFormEncoder(dataEncoding: .deferredToData)
+        XCTAssertNil(try flatQuery(PageQuery(), with: encoder))
+        XCTAssertEqual(try encoder.encode(PageQuery()) as String, try generalQuery(PageQuery(), with: encoder))
+    }
+
+    func testPerformanceFlatEncoding() {
+        let encoder = URLEncodedFormEncoder()
+        let query = PageQuery()
+        measure {
+            for _ in 0..<1000 {
+                _ = try? encoder.encode(query) as String
+            }
+        }
+    }
+
+    func testPerformanceGeneralEncoding() {
+        let encoder = URLEncodedFormEncoder()
+        let query = PageQuery()
+        measure {
+            for _ in 0..<1000 {
+                _ = try? generalQuery(query, with: encoder)
+            }
+        }
+    }
+}
@@ -38,6 +38,15 @@ public protocol AuthenticationCredential {
     /// credential is only valid for 5 minutes or less. That ensures the credential will not expire as it is passed
     /// around backend services.
     var requiresRefresh: Bool { get }
+
+    /// The date at which the credential expires, if known. When available, an `AuthenticationInterceptor` configured
+    /// with a `proactiveRefreshInterval` refreshes the credential that long before this date, in the background, while
+    /// requests keep using the still valid credential. `nil` by default.
+    var expirationDate: Date? { get }
+}
+
+extension AuthenticationCredential {
+    public var expirationDate: Date? { nil }
 }
 
 // MARK: -
@@ -190,10 +199,27 @@ public class AuthenticationInterceptor<AuthenticatorType>: RequestInterceptor wh
         }
     }
 
+    /// Counters describing how refreshes affected requests.
+    public struct RefreshMetrics {
+        /// Total refreshes started, proactive ones included.
+        public internal(set) var refreshCount = 0
+        /// Refreshes started ahead of `requiresRefresh` by the proactive refresh schedule.
+        public internal(set) var proactiveRefreshCount = 0
+        /// Refreshes which failed.
+        public internal(set) var failedRefreshCount = 0
+        /// Adapt operations which had to wait for a refresh to complete.
+        public internal(set) var deferredAdaptCount = 0
+        /// Requests which failed authentication and were retried after a refresh.
+        public internal(set) var deferredRetryCount = 0
+        /// Total time, in seconds, deferred adapt operations spent waiting for a refresh.
+        public internal(set) var totalAdaptDeferral: TimeInterval = 0
+    }
+
     private struct AdaptOperation {
         let urlRequest: URLRequest
         let session: Session
         let completion: (Result<URLRequest, Error>) -> Void
+        let deferredAt = ProcessInfo.processInfo.systemUptime
     }
 
     private enum AdaptResult {
@@ -206,9 +232,22 @@ public class AuthenticationInterceptor<AuthenticatorType>: RequestInterceptor wh
         var credential: Credential?
 
         var isRefreshing = false
+        /// Whether the refresh in flight was started ahead of `requiresRefresh`, in which case requests keep being
+        /// adapted with the current credential until it requires a refresh.
+        var isRefreshingProactively = false
         var refreshTimestamps: [TimeInterval] = []
         var refreshWindow: RefreshWindow?
 
+        /// Last `Session` seen, used by scheduled proactive refreshes.
+        weak var session: Session?
+        /// Incremented whenever the proactive refresh schedule changes, invalidating earlier schedules.
+        var proactiveRefreshGeneration = 0
+        /// Whether the current credential can still be refreshed proactively. A refreshed credential that is already
+        /// inside the proactive refresh window is left to `requiresRefresh`, since refreshing it again would only
+        /// return another credential inside the window, in a loop.
+        var allowsProactiveRefresh = true
+        var metrics = RefreshMetrics()
+
         var adaptOperations: [AdaptOperation] = []
         var requestsToRetry: [(RetryResult) -> Void] = []
     }
@@ -218,9 +257,23 @@ public class AuthenticationInterceptor<AuthenticatorType>: RequestInterceptor wh
     /// The `Credential` used to authenticate requests.
     public var credential: Credential? {
         get { mutableState.credential }
-        set { mutableState.credential = newValue }
+        set {
+            $mutableState.write { mutableState in
+                mutableState.credential = newValue
+                mutableState.allowsProactiveRefresh = true
+                scheduleProactiveRefresh(insideLock: &mutableState)
+            }
+        }
     }
 
+    /// Counters describing how refreshes affected requests.
+    public var refreshMetrics: RefreshMetrics { mutableState.metrics }
+
+    /// How long before the credential's `expirationDate` it is refreshed in the background. `nil` disables proactive
+    /// refreshes. A refresh returning a credential that already expires within this interval is not followed by
+    /// another proactive refresh: that credential is refreshed once it `requiresRefresh`.
+    public let proactiveRefreshInterval: TimeInterval?
+
     let authenticator: AuthenticatorType
     let queue = DispatchQueue(label: "org.alamofire.authentication.inspector")
 
@@ -238,10 +291,14 @@ public class AuthenticationInterceptor<AuthenticatorType>: RequestInterceptor wh
     ///   - authenticator: The `Authenticator` type.
     ///   - credential:    The `Credential` if it exists. `nil` by default.
     ///   - refreshWindow: The `RefreshWindow` used to identify excessive refresh calls. `RefreshWindow()` by default.
+    ///   - proactiveRefreshInterval: How long before the credential's `expirationDate` to refresh it in the
+    ///                               background. `nil` by default, which only refreshes once `requiresRefresh`.
     public init(authenticator: AuthenticatorType,
                 credential: Credential? = nil,
-                refreshWindow: RefreshWindow? = RefreshWindow()) {
+                refreshWindow: RefreshWindow? = RefreshWindow(),
+                proactiveRefreshInterval: TimeInterval? = nil) {
         self.authenticator = authenticator
+        self.proactiveRefreshInterval = proactiveRefreshInterval
         mutableState.credential = credential
         mutableState.refreshWindow = refreshWindow
     }
@@ -249,11 +306,36 @@ public class AuthenticationInterceptor<AuthenticatorType>: RequestInterceptor wh
     // MARK: Adapt
 
     public func adapt(_ urlRequest: URLRequest, for session: Session, completion: @escaping (Result<URLRequest, Error>) -> Void) {
+        // Fast path: a read-only snapshot, with `requiresRefresh` evaluated outside the lock, adapts the vast majority
+        // of requests without mutating the shared state.
+        let snapshot = $mutableState.read { mutableState in
+            (mutableState.credential,
+             mutableState.isRefreshing && !mutableState.isRefreshingProactively,
+             mutableState.session === session,
+             mutableState.allowsProactiveRefresh)
+        }
+        if let credential = snapshot.0, !snapshot.1, snapshot.2, !credential.requiresRefresh,
+           !(snapshot.3 && isWithinProactiveRefreshWindow(credential)) {
+            var authenticatedRequest = urlRequest
+            authenticator.apply(credential, to: &authenticatedRequest)
+            completion(.success(authenticatedRequest))
+            return
+        }
+
         let adaptResult: AdaptResult = $mutableState.write { mutableState in
-            // Queue the adapt operation if a refresh is already in place.
-            guard !mutableState.isRefreshing else {
+            // A credential provided before any session was seen, such as the one passed to `init`, gets its proactive
+            // refresh scheduled once the first session arrives.
+            let isNewSession = mutableState.session !== session
+            mutableState.session = session
+            if isNewSession, !mutableState.isRefreshing {
+                scheduleProactiveRefresh(insideLock: &mutableState)
+            }
+
+            // Queue the adapt operation if a refresh invalidating the current credential is already in place.
+            guard !mutableState.isRefreshing || mutableState.isRefreshingProactively else {
                 let operation = AdaptOperation(urlRequest: urlRequest, session: session, completion: completion)
                 mutableState.adaptOperations.append(operation)
+                mutableState.metrics.deferredAdaptCount += 1
                 return .adaptDeferred
             }
 
@@ -263,14 +345,25 @@ public class AuthenticationInterceptor<AuthenticatorType>: RequestInterceptor wh
                 return .doNotAdapt(error)
             }
 
-            // Queue the adapt operation and trigger refresh operation if credential requires refresh.
+            // Queue the adapt operation and trigger refresh operation if credential requires refresh. A proactive
+            // refresh already in flight is joined instead.
             guard !credential.requiresRefresh else {
                 let operation = AdaptOperation(urlRequest: urlRequest, session: session, completion: completion)
                 mutableState.adaptOperations.append(operation)
-                refresh(credential, for: session, insideLock: &mutableState)
+                mutableState.metrics.deferredAdaptCount += 1
+                if mutableState.isRefreshing {
+                    mutableState.isRefreshingProactively = false
+                } else {
+                    refresh(credential, for: session, insideLock: &mutableState)
+                }
                 return .adaptDeferred
             }
 
+            // Refresh in the background when the credential is about to expire.
+            if !mutableState.isRefreshing, mutableState.allowsProactiveRefresh, isWithinProactiveRefreshWindow(credential) {
+                refresh(credential, for: session, proactively: true, insideLock: &mutableState)
+            }
+
             return .adapt(credential)
         }
 
@@ -319,8 +412,14 @@ public class AuthenticationInterceptor<AuthenticatorType>: RequestInterceptor wh
 
         $mutableState.write { mutableState in
             mutableState.requestsToRetry.append(completion)
+            mutableState.metrics.deferredRetryCount += 1
 
-            guard !mutableState.isRefreshing else { return }
+            // The rejected credential invalidates any proactive refresh in flight: join it, but stop adapting with
+            // the current credential.
+            guard !mutableState.isRefreshing else {
+                mutableState.isRefreshingProactively = false
+                return
+            }
 
             refresh(credential, for: session, insideLock: &mutableState)
         }
@@ -328,8 +427,14 @@ public class AuthenticationInterceptor<AuthenticatorType>: RequestInterceptor wh
 
     // MARK: Refresh
 
-    private func refresh(_ credential: Credential, for session: Session, insideLock mutableState: inout MutableState) {
+    private func refresh(_ credential: Credential,
+                         for session: Session,
+                         proactively: Bool = false,
+                         insideLock mutableState: inout MutableState) {
         guard !isRefreshExcessive(insideLock: &mutableState) else {
+            // Proactive refreshes are an optimization: skip them rather than failing requests.
+            guard !proactively else { return }
+
             let error = AuthenticationError.excessiveRefresh
             handleRefreshFailure(error, insideLock: &mutableState)
             return
@@ -337,6 +442,10 @@ public class AuthenticationInterceptor<AuthenticatorType>: RequestInterceptor wh
 
         mutableState.refreshTimestamps.append(ProcessInfo.processInfo.systemUptime)
         mutableState.isRefreshing = true
+        mutableState.isRefreshingProactively = proactively
+        mutableState.proactiveRefreshGeneration += 1
+        mutableState.metrics.refreshCount += 1
+        if proactively { mutableState.metrics.proactiveRefreshCount += 1 }
 
         // Dispatch to queue to hop out of the lock in case authenticator.refresh is implemented synchronously.
         queue.async {
@@ -370,14 +479,18 @@ public class AuthenticationInterceptor<AuthenticatorType>: RequestInterceptor wh
 
     private func handleRefreshSuccess(_ credential: Credential, insideLock mutableState: inout MutableState) {
         mutableState.credential = credential
+        mutableState.allowsProactiveRefresh = !isWithinProactiveRefreshWindow(credential)
 
         let adaptOperations = mutableState.adaptOperations
         let requestsToRetry = mutableState.requestsToRetry
 
         mutableState.adaptOperations.removeAll()
         mutableState.requestsToRetry.removeAll()
+        recordDeferrals(of: adaptOperations, insideLock: &mutableState)
 
         mutableState.isRefreshing = false
+        mutableState.isRefreshingProactively = false
+        scheduleProactiveRefresh(insideLock: &mutableState)
 
         // Dispatch to queue to hop out of the mutable state lock
         queue.async {
@@ -392,8 +505,11 @@ public class AuthenticationInterceptor<AuthenticatorType>: RequestInterceptor wh
 
         mutableState.adaptOperations.removeAll()
         mutableState.requestsToRetry.removeAll()
+        recordDeferrals(of: adaptOperations, insideLock: &mutableState)
 
         mutableState.isRefreshing = false
+        mutableState.isRefreshingProactively = false
+        mutableState.metrics.failedRefreshCount += 1
 
         // Dispatch to queue to hop out of the mutable state lock
         queue.async {
@@ -401,4 +517,49 @@ public class AuthenticationInterceptor<AuthenticatorType>: RequestInterceptor wh
             requestsToRetry.forEach { $0(.doNotRetryWithError(error)) }
         }
     }
+
+    private func recordDeferrals(of adaptOperations: [AdaptOperation], insideLock mutableState: inout MutableState) {
+        let now = ProcessInfo.processInfo.systemUptime
+        mutableState.metrics.totalAdaptDeferral += adaptOperations.reduce(0) { $0 + (now - $1.deferredAt) }
+    }
+
+    // MARK: Proactive Refresh
+
+    private func isWithinProactiveRefreshWindow(_ credential: Credential) -> Bool {
+        guard let interval = proactiveRefreshInterval, let expirationDate = credential.expirationDate else { return false }
+
+        return expirationDate.timeIntervalSinceNow <= interval
+    }
+
+    /// Schedules a background refresh `proactiveRefreshInterval` before the credential expires, replacing any earlier
+    /// schedule. Requires a `Session` to have been seen by `adapt`, and a credential that still allows proactive
+    /// refreshes.
+    private func scheduleProactiveRefresh(insideLock mutableState: inout MutableState) {
+        mutableState.proactiveRefreshGeneration += 1
+
+        guard
+            let interval = proactiveRefreshInterval,
+            mutableState.allowsProactiveRefresh,
+            let expirationDate = mutableState.credential?.expirationDate,
+            mutableState.session != nil
+        else { return }
+
+        let generation = mutableState.proactiveRefreshGeneration
+        let delay = max(0, expirationDate.timeIntervalSinceNow - interval)
+
+        queue.asyncAfter(deadline: .now() + delay) { [weak self] in
+            guard let self = self else { return }
+
+            self.$mutableState.write { mutableState in
+                guard
+                    mutableState.proactiveRefreshGeneration == generation,
+                    !mutableState.isRefreshing,
+                    let credential = mutableState.credential,
+                    let session = mutableState.session
+                else { return }
+
+                self.refresh(credential, for: session, proactively: true, insideLock: &mutableState)
+            }
+        }
+    }
 }
@@ -30,6 +30,9 @@ public protocol EventMonitor {
     /// The `DispatchQueue` onto which Alamofire's root `CompositeEventMonitor` will dispatch events. `.main` by default.
     var queue: DispatchQueue { get }
 
+    /// The kinds of events the `CompositeEventMonitor` will deliver to this monitor. `.all` by default.
+    var subscribedEvents: EventMonitorEvents { get }
+
     // MARK: - URLSession Events
 
     // MARK: URLSessionDelegate Events
@@ -224,6 +227,9 @@ extension EventMonitor {
     /// The default queue on which `CompositeEventMonitor`s will call the `EventMonitor` methods. `.main` by default.
     public var queue: DispatchQueue { .main }
 
+    /// By default, `CompositeEventMonitor`s deliver every event.
+    public var subscribedEvents: EventMonitorEvents { .all }
+
     // MARK: Default Implementations
 
     public func urlSession(_ session: URLSession, didBecomeInvalidWithError error: Error?) {}
@@ -308,32 +314,118 @@ extension EventMonitor {
     public func request<Value>(_ request: DownloadRequest, didParseResponse response: DownloadResponse<Value, AFError>) {}
 }
 
+/// Kinds of `EventMonitor` events, used by monitors to subscribe to only the events they handle.
+public struct EventMonitorEvents: OptionSet {
+    public let rawValue: UInt
+
+    public init(rawValue: UInt) {
+        self.rawValue = rawValue
+    }
+
+    /// `URLSessionDelegate` events, such as the session becoming invalid.
+    public static let session = EventMonitorEvents(rawValue: 1 << 0)
+    /// `URLSessionTaskDelegate`, `URLSessionDataDelegate` and `URLSessionDownloadDelegate` events other than transfer
+    /// progress and metrics, such as challenges, redirects and task completion.
+    public static let task = EventMonitorEvents(rawValue: 1 << 1)
+    /// High frequency transfer events: body data sent, data received and download data written.
+    public static let transferProgress = EventMonitorEvents(rawValue: 1 << 2)
+    /// `URLSessionTaskMetrics` events, from both the `URLSession` and `Request`s.
+    public static let metrics = EventMonitorEvents(rawValue: 1 << 3)
+    /// `Request` lifecycle events, such as `URLRequest` creation and adaptation, task creation, retry, resume, suspend,
+    /// cancel and finish, including `UploadRequest` and `DownloadRequest` specific lifecycle events.
+    public static let requestLifecycle = EventMonitorEvents(rawValue: 1 << 4)
+    /// `Request` validation events.
+    public static let validation = EventMonitorEvents(rawValue: 1 << 5)
+    /// Response and stream serialization events.
+    public static let serialization = EventMonitorEvents(rawValue: 1 << 6)
+
+    /// All events.
+    public static let all: EventMonitorEvents = [.session, .task, .transferProgress, .metrics, .requestLifecycle,
+                                                 .validation, .serialization]
+}
+
 /// An `EventMonitor` which can contain multiple `EventMonitor`s and calls their methods on their queues.
+///
+/// Events are buffered and delivered in batches: the first event enqueued after a delivery schedules a single hop to
+/// `queue`, which hands every buffered event to each group of monitors sharing a `DispatchQueue` in one further hop.
+/// Events are only buffered for, and delivered to, monitors whose `subscribedEvents` include them.
 public final class CompositeEventMonitor: EventMonitor {
+    /// Monitors sharing a `DispatchQueue`, which receive their events together.
+    private struct MonitorGroup {
+        let queue: DispatchQueue
+        var monitors: [EventMonitor]
+        var subscribedEvents: EventMonitorEvents
+    }
+
+    private typealias PendingEvent = (kind: EventMonitorEvents, event: (EventMonitor) -> Void)
+
     public let queue = DispatchQueue(label: "org.alamofire.compositeEventMonitor", qos: .utility)
+    public let subscribedEvents: EventMonitorEvents
 
     let monitors: [EventMonitor]
 
+    private let groups: [MonitorGroup]
+
+    @Protected
+    private var pendingEvents: [PendingEvent] = []
+
     init(monitors: [EventMonitor]) {
         self.monitors = monitors
+
+        var groups: [MonitorGroup] = []
+        for monitor in monitors where !monitor.subscribedEvents.isEmpty {
+            if let index = groups.firstIndex(where: { $0.queue === monitor.queue }) {
+                groups[index].monitors.append(monitor)
+                groups[index].subscribedEvents.formUnion(monitor.subscribedEvents)
+            } else {
+                groups.append(MonitorGroup(queue: monitor.queue, monitors: [monitor], subscribedEvents: monitor.subscribedEvents))
+            }
+        }
+        self.groups = groups
+        subscribedEvents = groups.reduce([]) { $0.union($1.subscribedEvents) }
     }
 
-    func performEvent(_ event: @escaping (EventMonitor) -> Void) {
-        queue.async {
-            for monitor in self.monitors {
-                monitor.queue.async { event(monitor) }
+    func performEvent(_ kind: EventMonitorEvents, _ event: @escaping (EventMonitor) -> Void) {
+        guard subscribedEvents.contains(kind) else { return }
+
+        let isFirstPendingEvent = $pendingEvents.write { (events: inout [PendingEvent]) -> Bool in
+            events.append((kind, event))
+            return events.count == 1
+        }
+
+        if isFirstPendingEvent {
+            queue.async { self.deliverPendingEvents() }
+        }
+    }
+
+    private func deliverPendingEvents() {
+        let events = $pendingEvents.write { (events: inout [PendingEvent]) -> [PendingEvent] in
+            defer { events = [] }
+            return events
+        }
+
+        for group in groups {
+            let groupEvents = events.filter { group.subscribedEvents.contains($0.kind) }
+            guard !groupEvents.isEmpty else { continue }
+
+            group.queue.async {
+                for pendingEvent in groupEvents {
+                    for monitor in group.monitors where monitor.subscribedEvents.contains(pendingEvent.kind) {
+                        pendingEvent.event(monitor)
+                    }
+                }
             }
         }
     }
 
     public func urlSession(_ session: URLSession, didBecomeInvalidWithError error: Error?) {
-        performEvent { $0.urlSession(session, didBecomeInvalidWithError: error) }
+        performEvent(.session) { $0.urlSession(session, didBecomeInvalidWithError: error) }
     }
 
     public func urlSession(_ session: URLSession,
                            task: URLSessionTask,
                            didReceive challenge: URLAuthenticationChallenge) {
-        performEvent { $0.urlSession(session, task: task, didReceive: challenge) }
+        performEvent(.task) { $0.urlSession(session, task: task, didReceive: challenge) }
     }
 
     public func urlSession(_ session: URLSession,
@@ -341,7 +433,7 @@ public final class CompositeEventMonitor: EventMonitor {
                            didSendBodyData bytesSent: Int64,
                            totalBytesSent: Int64,
                            totalBytesExpectedToSend: Int64) {
-        performEvent {
+        performEvent(.transferProgress) {
             $0.urlSession(session,
                           task: task,
                           didSendBodyData: bytesSent,
@@ -351,7 +443,7 @@ public final class CompositeEventMonitor: EventMonitor {
     }
 
     public func urlSession(_ session: URLSession, taskNeedsNewBodyStream task: URLSessionTask) {
-        performEvent {
+        performEvent(.task) {
             $0.urlSession(session, taskNeedsNewBodyStream: task)
         }
     }
@@ -360,7 +452,7 @@ public final class CompositeEventMonitor: EventMonitor {
                            task: URLSessionTask,
                            willPerformHTTPRedirection response: HTTPURLResponse,
                            newRequest request: URLRequest) {
-        performEvent {
+        performEvent(.task) {
             $0.urlSession(session,
                           task: task,
                           willPerformHTTPRedirection: response,
@@ -369,33 +461,33 @@ public final class CompositeEventMonitor: EventMonitor {
     }
 
     public func urlSession(_ session: URLSession, task: URLSessionTask, didFinishCollecting metrics: URLSessionTaskMetrics) {
-        performEvent { $0.urlSession(session, task: task, didFinishCollecting: metrics) }
+        performEvent(.metrics) { $0.urlSession(session, task: task, didFinishCollecting: metrics) }
     }
 
     public func urlSession(_ session: URLSession, task: URLSessionTask, didCompleteWithError error: Error?) {
-        performEvent { $0.urlSession(session, task: task, didCompleteWithError: error) }
+        performEvent(.task) { $0.urlSession(session, task: task, didCompleteWithError: error) }
     }
 
     @available(macOS 10.13, iOS 11.0, tvOS 11.0, watchOS 4.0, *)
     public func urlSession(_ session: URLSession, taskIsWaitingForConnectivity task: URLSessionTask) {
-        performEvent { $0.urlSession(session, taskIsWaitingForConnectivity: task) }
+        performEvent(.task) { $0.urlSession(session, taskIsWaitingForConnectivity: task) }
     }
 
     public func urlSession(_ session: URLSession, dataTask: URLSessionDataTask, didReceive data: Data) {
-        performEvent { $0.urlSession(session, dataTask: dataTask, didReceive: data) }
+        performEvent(.transferProgress) { $0.urlSession(session, dataTask: dataTask, didReceive: data) }
     }
 
     public func urlSession(_ session: URLSession,
                            dataTask: URLSessionDataTask,
                            willCacheResponse proposedResponse: CachedURLResponse) {
-        performEvent { $0.urlSession(session, dataTask: dataTask, willCacheResponse: proposedResponse) }
+        performEvent(.task) { $0.urlSession(session, dataTask: dataTask, willCacheResponse: proposedResponse) }
     }
 
     public func urlSession(_ session: URLSession,
                            downloadTask: URLSessionDownloadTask,
                            didResumeAtOffset fileOffset: Int64,
                            expectedTotalBytes: Int64) {
-        performEvent {
+        performEvent(.task) {
             $0.urlSession(session,
                           downloadTask: downloadTask,
                           didResumeAtOffset: fileOffset,
@@ -408,7 +500,7 @@ public final class CompositeEventMonitor: EventMonitor {
                            didWriteData bytesWritten: Int64,
                            totalBytesWritten: Int64,
                            totalBytesExpectedToWrite: Int64) {
-        performEvent {
+        performEvent(.transferProgress) {
             $0.urlSession(session,
                           downloadTask: downloadTask,
                           didWriteData: bytesWritten,
@@ -420,75 +512,75 @@ public final class CompositeEventMonitor: EventMonitor {
     public func urlSession(_ session: URLSession,
                            downloadTask: URLSessionDownloadTask,
                            didFinishDownloadingTo location: URL) {
-        performEvent { $0.urlSession(session, downloadTask: downloadTask, didFinishDownloadingTo: location) }
+        performEvent(.task) { $0.urlSession(session, downloadTask: downloadTask, didFinishDownloadingTo: location) }
     }
 
     public func request(_ request: Request, didCreateInitialURLRequest urlRequest: URLRequest) {
-        performEvent { $0.request(request, didCreateInitialURLRequest: urlRequest) }
+        performEvent(.requestLifecycle) { $0.request(request, didCreateInitialURLRequest: urlRequest) }
     }
 
     public func request(_ request: Request, didFailToCreateURLRequestWithError error: AFError) {
-        performEvent { $0.request(request, didFailToCreateURLRequestWithError: error) }
+        performEvent(.requestLifecycle) { $0.request(request, didFailToCreateURLRequestWithError: error) }
     }
 
     public func request(_ request: Request, didAdaptInitialRequest initialRequest: URLRequest, to adaptedRequest: URLRequest) {
-        performEvent { $0.request(request, didAdaptInitialRequest: initialRequest, to: adaptedRequest) }
+        performEvent(.requestLifecycle) { $0.request(request, didAdaptInitialRequest: initialRequest, to: adaptedRequest) }
     }
 
     public func request(_ request: Request, didFailToAdaptURLRequest initialRequest: URLRequest, withError error: AFError) {
-        performEvent { $0.request(request, didFailToAdaptURLRequest: initialRequest, withError: error) }
+        performEvent(.requestLifecycle) { $0.request(request, didFailToAdaptURLRequest: initialRequest, withError: error) }
     }
 
     public func request(_ request: Request, didCreateURLRequest urlRequest: URLRequest) {
-        performEvent { $0.request(request, didCreateURLRequest: urlRequest) }
+        performEvent(.requestLifecycle) { $0.request(request, didCreateURLRequest: urlRequest) }
     }
 
     public func request(_ request: Request, didCreateTask task: URLSessionTask) {
-        performEvent { $0.request(request, didCreateTask: task) }
+        performEvent(.requestLifecycle) { $0.request(request, didCreateTask: task) }
     }
 
     public func request(_ request: Request, didGatherMetrics metrics: URLSessionTaskMetrics) {
-        performEvent { $0.request(request, didGatherMetrics: metrics) }
+        performEvent(.metrics) { $0.request(request, didGatherMetrics: metrics) }
     }
 
     public func request(_ request: Request, didFailTask task: URLSessionTask, earlyWithError error: AFError) {
-        performEvent { $0.request(request, didFailTask: task, earlyWithError: error) }
+        performEvent(.requestLifecycle) { $0.request(request, didFailTask: task, earlyWithError: error) }
     }
 
     public func request(_ request: Request, didCompleteTask task: URLSessionTask, with error: AFError?) {
-        performEvent { $0.request(request, didCompleteTask: task, with: error) }
+        performEvent(.requestLifecycle) { $0.request(request, didCompleteTask: task, with: error) }
     }
 
     public func requestIsRetrying(_ request: Request) {
-        performEvent { $0.requestIsRetrying(request) }
+        performEvent(.requestLifecycle) { $0.requestIsRetrying(request) }
     }
 
     public func requestDidFinish(_ request: Request) {
-        performEvent { $0.requestDidFinish(request) }
+        performEvent(.requestLifecycle) { $0.requestDidFinish(request) }
     }
 
     public func requestDidResume(_ request: Request) {
-        performEvent { $0.requestDidResume(request) }
+        performEvent(.requestLifecycle) { $0.requestDidResume(request) }
     }
 
     public func request(_ request: Request, didResumeTask task: URLSessionTask) {
-        performEvent { $0.request(request, didResumeTask: task) }
+        performEvent(.requestLifecycle) { $0.request(request, didResumeTask: task) }
     }
 
     public func requestDidSuspend(_ request: Request) {
-        performEvent { $0.requestDidSuspend(request) }
+        performEvent(.requestLifecycle) { $0.requestDidSuspend(request) }
     }
 
     public func request(_ request: Request, didSuspendTask task: URLSessionTask) {
-        performEvent { $0.request(request, didSuspendTask: task) }
+        performEvent(.requestLifecycle) { $0.request(request, didSuspendTask: task) }
     }
 
     public func requestDidCancel(_ request: Request) {
-        performEvent { $0.requestDidCancel(request) }
+        performEvent(.requestLifecycle) { $0.requestDidCancel(request) }
     }
 
     public func request(_ request: Request, didCancelTask task: URLSessionTask) {
-        performEvent { $0.request(request, didCancelTask: task) }
+        performEvent(.requestLifecycle) { $0.request(request, didCancelTask: task) }
     }
 
     public func request(_ request: DataRequest,
@@ -496,55 +588,57 @@ public final class CompositeEventMonitor: EventMonitor {
                         response: HTTPURLResponse,
                         data: Data?,
                         withResult result: Request.ValidationResult) {
-        performEvent { $0.request(request,
-                                  didValidateRequest: urlRequest,
-                                  response: response,
-                                  data: data,
-                                  withResult: result)
+        performEvent(.validation) {
+            $0.request(request,
+                       didValidateRequest: urlRequest,
+                       response: response,
+                       data: data,
+                       withResult: result)
         }
     }
 
     public func request(_ request: DataRequest, didParseResponse response: DataResponse<Data?, AFError>) {
-        performEvent { $0.request(request, didParseResponse: response) }
+        performEvent(.serialization) { $0.request(request, didParseResponse: response) }
     }
 
     public func request<Value>(_ request: DataRequest, didParseResponse response: DataResponse<Value, AFError>) {
-        performEvent { $0.request(request, didParseResponse: response) }
+        performEvent(.serialization) { $0.request(request, didParseResponse: response) }
     }
 
     public func request(_ request: DataStreamRequest,
                         didValidateRequest urlRequest: URLRequest?,
                         response: HTTPURLResponse,
                         withResult result: Request.ValidationResult) {
-        performEvent { $0.request(request,
-                                  didValidateRequest: urlRequest,
-                                  response: response,
-                                  withResult: result)
+        performEvent(.validation) {
+            $0.request(request,
+                       didValidateRequest: urlRequest,
+                       response: response,
+                       withResult: result)
         }
     }
 
     public func request<Value>(_ request: DataStreamRequest, didParseStream result: Result<Value, AFError>) {
-        performEvent { $0.request(request, didParseStream: result) }
+        performEvent(.serialization) { $0.request(request, didParseStream: result) }
     }
 
     public func request(_ request: UploadRequest, didCreateUploadable uploadable: UploadRequest.Uploadable) {
-        performEvent { $0.request(request, didCreateUploadable: uploadable) }
+        performEvent(.requestLifecycle) { $0.request(request, didCreateUploadable: uploadable) }
     }
 
     public func request(_ request: UploadRequest, didFailToCreateUploadableWithError error: AFError) {
-        performEvent { $0.request(request, didFailToCreateUploadableWithError: error) }
+        performEvent(.requestLifecycle) { $0.request(request, didFailToCreateUploadableWithError: error) }
     }
 
     public func request(_ request: UploadRequest, didProvideInputStream stream: InputStream) {
-        performEvent { $0.request(request, didProvideInputStream: stream) }
+        performEvent(.requestLifecycle) { $0.request(request, didProvideInputStream: stream) }
     }
 
     public func request(_ request: DownloadRequest, didFinishDownloadingUsing task: URLSessionTask, with result: Result<URL, AFError>) {
-        performEvent { $0.request(request, didFinishDownloadingUsing: task, with: result) }
+        performEvent(.requestLifecycle) { $0.request(request, didFinishDownloadingUsing: task, with: result) }
     }
 
     public func request(_ request: DownloadRequest, didCreateDestinationURL url: URL) {
-        performEvent { $0.request(request, didCreateDestinationURL: url) }
+        performEvent(.requestLifecycle) { $0.request(request, didCreateDestinationURL: url) }
     }
 
     public func request(_ request: DownloadRequest,
@@ -552,19 +646,21 @@ public final class CompositeEventMonitor: EventMonitor {
                         response: HTTPURLResponse,
                         fileURL: URL?,
                         withResult result: Request.ValidationResult) {
-        performEvent { $0.request(request,
-                                  didValidateRequest: urlRequest,
-                                  response: response,
-                                  fileURL: fileURL,
-                                  withResult: result) }
+        performEvent(.validation) {
+            $0.request(request,
+                       didValidateRequest: urlRequest,
+                       response: response,
+                       fileURL: fileURL,
+                       withResult: result)
+        }
     }
 
     public func request(_ request: DownloadRequest, didParseResponse response: DownloadResponse<URL?, AFError>) {
-        performEvent { $0.request(request, didParseResponse: response) }
+        performEvent(.serialization) { $0.request(request, didParseResponse: response) }
     }
 
     public func request<Value>(_ request: DownloadRequest, didParseResponse response: DownloadResponse<Value, AFError>) {
-        performEvent { $0.request(request, didParseResponse: response) }
+        performEvent(.serialization) { $0.request(request, didParseResponse: response) }
     }
 }
 
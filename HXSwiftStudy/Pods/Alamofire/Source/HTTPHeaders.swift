@@ -27,6 +27,8 @@ import Foundation
 /// An order-preserving and case-insensitive representation of HTTP headers.
 public struct HTTPHeaders {
     private var headers: [HTTPHeader] = []
+    /// Position of each header in `headers`, keyed case-insensitively by name.
+    private var positions: [CaseInsensitiveHeaderName: Int] = [:]
 
     /// Creates an empty instance.
     public init() {}
@@ -76,26 +78,37 @@ public struct HTTPHeaders {
     ///
     /// - Parameter header: The `HTTPHeader` to update or append.
     public mutating func update(_ header: HTTPHeader) {
-        guard let index = headers.index(of: header.name) else {
+        let key = CaseInsensitiveHeaderName(header.name)
+        guard let index = positions[key] else {
+            positions[key] = headers.count
             headers.append(header)
             return
         }
 
-        headers.replaceSubrange(index...index, with: [header])
+        headers[index] = header
     }
 
     /// Case-insensitively removes an `HTTPHeader`, if it exists, from the instance.
     ///
     /// - Parameter name: The name of the `HTTPHeader` to remove.
     public mutating func remove(name: String) {
-        guard let index = headers.index(of: name) else { return }
+        guard let index = positions.removeValue(forKey: CaseInsensitiveHeaderName(name)) else { return }
 
         headers.remove(at: index)
+        reindex(from: index)
     }
 
     /// Sort the current instance by header name, case insensitively.
     public mutating func sort() {
         headers.sort { $0.name.lowercased() < $1.name.lowercased() }
+        reindex(from: 0)
+    }
+
+    /// Updates `positions` for every header at or after `index`, after headers have moved.
+    private mutating func reindex(from index: Int) {
+        for position in index..<headers.count {
+            positions[CaseInsensitiveHeaderName(headers[position].name)] = position
+        }
     }
 
     /// Returns an instance sorted by header name.
@@ -114,7 +127,7 @@ public struct HTTPHeaders {
     ///
     /// - Returns:        The value of header, if it exists.
     public func value(for name: String) -> String? {
-        guard let index = headers.index(of: name) else { return nil }
+        guard let index = positions[CaseInsensitiveHeaderName(name)] else { return nil }
 
         return headers[index].value
     }
@@ -322,11 +335,36 @@ extension HTTPHeader {
     }
 }
 
-extension Array where Element == HTTPHeader {
-    /// Case-insensitively finds the index of an `HTTPHeader` with the provided name, if it exists.
-    func index(of name: String) -> Int? {
-        let lowercasedName = name.lowercased()
-        return firstIndex { $0.name.lowercased() == lowercasedName }
+/// A header name which hashes and compares case-insensitively.
+///
+/// Header names are almost always ASCII, so letters are folded byte by byte rather than by allocating a lowercased copy
+/// of the name. Names containing other characters fall back to `lowercased()`, matching its Unicode case mapping.
+struct CaseInsensitiveHeaderName: Hashable {
+    let name: String
+    private let isASCII: Bool
+
+    init(_ name: String) {
+        self.name = name
+        isASCII = name.utf8.allSatisfy { $0 < 0x80 }
+    }
+
+    static func ==(lhs: CaseInsensitiveHeaderName, rhs: CaseInsensitiveHeaderName) -> Bool {
+        guard lhs.isASCII, rhs.isASCII else { return lhs.name.lowercased() == rhs.name.lowercased() }
+
+        return lhs.name.utf8.elementsEqual(rhs.name.utf8) { folded($0) == folded($1) }
+    }
+
+    func hash(into hasher: inout Hasher) {
+        // Both paths hash folded UTF-8 bytes, so names which are equal through either comparison hash identically.
+        if isASCII {
+            name.utf8.forEach { hasher.combine(Self.folded($0)) }
+        } else {
+            name.lowercased().utf8.forEach { hasher.combine(Self.folded($0)) }
+        }
+    }
+
+    private static func folded(_ byte: UInt8) -> UInt8 {
+        (byte >= UInt8(ascii: "A") && byte <= UInt8(ascii: "Z")) ? byte | 0x20 : byte
     }
 }
 
@@ -0,0 +1,351 @@
+//
+//  HTTPResponseCache.swift
+//
+//  Copyright (c) 2019 Alamofire Software Foundation (http://alamofire.org/)
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+import Foundation
+
+/// An on-disk HTTP response cache loading `GET` resources through a `Session`.
+///
+/// Unlike `URLCache`, which is consulted only when a request's cache policy allows it, `HTTPResponseCache` always
+/// serves stored responses while they are fresh, serves them immediately while revalidating them in the background
+/// during the stale-while-revalidate window, and otherwise revalidates them with `If-None-Match` and
+/// `If-Modified-Since` so unchanged resources cost a `304 Not Modified` instead of a full download. Concurrent loads of
+/// the same URL share a single request.
+open class HTTPResponseCache {
+    /// A stored response.
+    public struct Entry: Codable {
+        /// The URL of the stored response.
+        public let url: URL
+        /// The body of the stored response.
+        public let data: Data
+        /// The status code of the stored response.
+        public let statusCode: Int
+        /// The headers of the stored response, updated by each revalidation.
+        public internal(set) var headers: [String: String]
+        /// The date until which the entry is served without revalidation.
+        public internal(set) var freshUntil: Date
+        /// The date until which the entry is served while being revalidated in the background.
+        public internal(set) var staleUntil: Date
+
+        /// The `ETag` validator of the stored response, if any.
+        public var entityTag: String? { HTTPHeaders(headers).value(for: "ETag") }
+
+        /// The `Last-Modified` validator of the stored response, if any.
+        public var lastModified: String? { HTTPHeaders(headers).value(for: "Last-Modified") }
+    }
+
+    /// The directory storing the entries.
+    public let directory: URL
+
+    /// The freshness lifetime of responses not specifying `Cache-Control: max-age`.
+    public let defaultFreshnessLifetime: TimeInterval
+
+    /// The stale-while-revalidate window of responses not specifying `Cache-Control: stale-while-revalidate`.
+    public let defaultStaleWhileRevalidate: TimeInterval
+
+    /// The serial queue on which the cache performs all its work.
+    public let queue = DispatchQueue(label: "org.alamofire.httpResponseCache")
+
+    /// Identifies the instance whose `queue` the current code is running on.
+    private static let queueKey = DispatchSpecificKey<ObjectIdentifier>()
+
+    private final class EntryBox {
+        let entry: Entry
+
+        init(_ entry: Entry) {
+            self.entry = entry
+        }
+    }
+
+    private typealias Completion = (AFDataResponse<Data>) -> Void
+
+    private let fileManager: FileManager
+    private let memoryCache = NSCache<NSString, EntryBox>()
+    private let encoder = PropertyListEncoder()
+    private let decoder = PropertyListDecoder()
+    /// Completion handlers waiting on each in-flight load, keyed by URL. Only accessed on `queue`.
+    private var waiters: [String: [Completion]] = [:]
+
+    /// Creates an instance from the specified parameters.
+    ///
+    /// - Parameters:
+    ///   - directory:                   The directory storing the entries. `Caches/org.alamofire.httpResponseCache` by
+    ///                                  default.
+    ///   - defaultFreshnessLifetime:    The freshness lifetime of responses without `max-age`. `0` by default, so such
+    ///                                  responses are revalidated on every load.
+    ///   - defaultStaleWhileRevalidate: The stale-while-revalidate window of responses without one. `0` by default.
+    ///   - memoryCountLimit:            The number of entries kept in memory. `64` by default.
+    ///   - fileManager:                 The `FileManager` used to access `directory`. `.default` by default.
+    public init(directory: URL? = nil,
+                defaultFreshnessLifetime: TimeInterval = 0,
+                defaultStaleWhileRevalidate: TimeInterval = 0,
+                memoryCountLimit: Int = 64,
+                fileManager: FileManager = .default) {
+        let cachesDirectory = fileManager.urls(for: .cachesDirectory, in: .userDomainMask).first
+            ?? fileManager.temporaryDirectory
+        self.directory = directory ?? cachesDirectory.appendingPathComponent("org.alamofire.httpResponseCache", isDirectory: true)
+        self.defaultFreshnessLifetime = defaultFreshnessLifetime
+        self.defaultStaleWhileRevalidate = defaultStaleWhileRevalidate
+        self.fileManager = fileManager
+        encoder.outputFormat = .binary
+        memoryCache.countLimit = memoryCountLimit
+        queue.setSpecific(key: Self.queueKey, value: ObjectIdentifier(self))
+    }
+
+    // MARK: Loading
+
+    /// Loads the resource at the provided URL, from the cache when possible.
+    ///
+    /// Entries are keyed by URL only: `headers` are sent with origin requests but do not distinguish entries.
+    ///
+    /// - Parameters:
+    ///   - convertible:       `URLConvertible` value to be used as the `URLRequest`'s `URL`.
+    ///   - headers:           `HTTPHeaders` sent with origin requests. `nil` by default.
+    ///   - session:           `Session` performing origin requests. `.default` by default.
+    ///   - queue:             The queue on which the completion handler is dispatched. `.main` by default.
+    ///   - completionHandler: The code to be executed once the resource has been loaded. Responses served from the
+    ///                        cache have no `metrics`.
+    open func load(_ convertible: URLConvertible,
+                   headers: HTTPHeaders? = nil,
+                   using session: Session = .default,
+                   queue: DispatchQueue = .main,
+                   completionHandler: @escaping (AFDataResponse<Data>) -> Void) {
+        let url: URL
+        do {
+            url = try convertible.asURL()
+        } catch {
+            let result = AFResult<Data>.failure(error.asAFError(or: .invalidURL(url: convertible)))
+            let response = AFDataResponse<Data>(request: nil, response: nil, data: nil, metrics: nil, serializationDuration: 0, result: result)
+            queue.async { completionHandler(response) }
+            return
+        }
+
+        let completion: Completion = { response in queue.async { completionHandler(response) } }
+
+        self.queue.async {
+            let now = Date()
+            let entry = self.storedEntry(for: url)
+
+            if let entry = entry, now < entry.freshUntil {
+                completion(self.response(serving: entry, for: url))
+            } else if let entry = entry, now < entry.staleUntil {
+                completion(self.response(serving: entry, for: url))
+                self.revalidate(url, entry: entry, headers: headers, using: session, completion: nil)
+            } else {
+                self.revalidate(url, entry: entry, headers: headers, using: session, completion: completion)
+            }
+        }
+    }
+
+    /// Joins or starts the origin request for `url`. Must be called on `queue`.
+    private func revalidate(_ url: URL,
+                            entry: Entry?,
+                            headers: HTTPHeaders?,
+                            using session: Session,
+                            completion: Completion?) {
+        let key = url.absoluteString
+
+        if waiters[key] != nil {
+            if let completion = completion { waiters[key]?.append(completion) }
+            return
+        }
+
+        waiters[key] = completion.map { [$0] } ?? []
+
+        var request = URLRequest(url: url)
+        request.method = .get
+        request.cachePolicy = .reloadIgnoringLocalCacheData
+        headers?.forEach { request.setValue($0.value, forHTTPHeaderField: $0.name) }
+        if let entityTag = entry?.entityTag { request.setValue(entityTag, forHTTPHeaderField: "If-None-Match") }
+        if let lastModified = entry?.lastModified { request.setValue(lastModified, forHTTPHeaderField: "If-Modified-Since") }
+
+        session.request(request).response(queue: queue) { response in
+            let result = self.complete(url, entry: entry, with: response)
+            let waiters = self.waiters.removeValue(forKey: key) ?? []
+            waiters.forEach { $0(result) }
+        }
+    }
+
+    /// Stores or refreshes the entry for `url` from an origin response. Must be called on `queue`.
+    private func complete(_ url: URL, entry: Entry?, with response: AFDataResponse<Data?>) -> AFDataResponse<Data> {
+        func finished(_ result: AFResult<Data>, data: Data?) -> AFDataResponse<Data> {
+            AFDataResponse<Data>(request: response.request,
+                                 response: response.response,
+                                 data: data,
+                                 metrics: response.metrics,
+                                 serializationDuration: response.serializationDuration,
+                                 result: result)
+        }
+
+        if case let .failure(error) = response.result {
+            return finished(.failure(error), data: response.data)
+        }
+
+        guard let httpResponse = response.response else {
+            return finished(.failure(.responseSerializationFailed(reason: .inputDataNilOrZeroLength)), data: nil)
+        }
+
+        let responseHeaders = httpResponse.headers.dictionary
+
+        if httpResponse.statusCode == 304, var entry = entry {
+            entry.headers.merge(responseHeaders) { _, new in new }
+            (entry.freshUntil, entry.staleUntil) = lifetimes(for: entry.headers)
+            store(entry)
+            return finished(.success(entry.data), data: entry.data)
+        }
+
+        guard (200..<300).contains(httpResponse.statusCode) else {
+            let error = AFError.responseValidationFailed(reason: .unacceptableStatusCode(code: httpResponse.statusCode))
+            return finished(.failure(error), data: response.data)
+        }
+
+        let data = response.data ?? Data()
+        let cacheControl = HTTPHeaders(responseHeaders).value(for: "Cache-Control")?.lowercased() ?? ""
+        if cacheControl.contains("no-store") {
+            removeEntry(forKey: url.absoluteString)
+        } else {
+            let (freshUntil, staleUntil) = lifetimes(for: responseHeaders)
+            store(Entry(url: url,
+                        data: data,
+                        statusCode: httpResponse.statusCode,
+                        headers: responseHeaders,
+                        freshUntil: freshUntil,
+                        staleUntil: staleUntil))
+        }
+
+        return finished(.success(data), data: data)
+    }
+
+    private func response(serving entry: Entry, for url: URL) -> AFDataResponse<Data> {
+        AFDataResponse<Data>(request: URLRequest(url: url),
+                             response: HTTPURLResponse(url: url, statusCode: entry.statusCode, httpVersion: nil, headerFields: entry.headers),
+                             data: entry.data,
+                             metrics: nil,
+                             serializationDuration: 0,
+                             result: .success(entry.data))
+    }
+
+    /// Computes the fresh and stale deadlines of a response from its `Cache-Control` header.
+    private func lifetimes(for headers: [String: String]) -> (Date, Date) {
+        var freshness = defaultFreshnessLifetime
+        var staleWhileRevalidate = defaultStaleWhileRevalidate
+
+        var requiresRevalidation = false
+
+        let cacheControl = HTTPHeaders(headers).value(for: "Cache-Control") ?? ""
+        for directive in cacheControl.split(separator: ",") {
+            let parts = directive.split(separator: "=", maxSplits: 1).map { $0.trimmingCharacters(in: .whitespaces).lowercased() }
+            // A directive such as "=" has no name.
+            guard let name = parts.first else { continue }
+
+            switch name {
+            case "no-cache":
+                requiresRevalidation = true
+            case "max-age" where parts.count == 2:
+                freshness = TimeInterval(parts[1]) ?? freshness
+            case "stale-while-revalidate" where parts.count == 2:
+                staleWhileRevalidate = TimeInterval(parts[1]) ?? staleWhileRevalidate
+            default:
+                break
+            }
+        }
+
+        // `no-cache` responses must be revalidated before every use, whatever other directives say.
+        if requiresRevalidation {
+            freshness = 0
+            staleWhileRevalidate = 0
+        }
+
+        let freshUntil = Date().addingTimeInterval(freshness)
+        return (freshUntil, freshUntil.addingTimeInterval(staleWhileRevalidate))
+    }
+
+    // MARK: Storage
+
+    /// Returns the entry stored for the provided URL, if any.
+    ///
+    /// - Parameter url: The URL of the entry.
+    ///
+    /// - Returns:       The stored `Entry`, regardless of its freshness.
+    public func entry(for url: URL) -> Entry? {
+        // Completion handlers may be dispatched on `queue`, where a `sync` would deadlock.
+        guard DispatchQueue.getSpecific(key: Self.queueKey) != ObjectIdentifier(self) else { return storedEntry(for: url) }
+
+        return queue.sync { storedEntry(for: url) }
+    }
+
+    /// Removes the entry stored for the provided URL, if any.
+    ///
+    /// - Parameter url: The URL of the entry.
+    public func removeEntry(for url: URL) {
+        queue.async { self.removeEntry(forKey: url.absoluteString) }
+    }
+
+    /// Removes all stored entries.
+    public func removeAllEntries() {
+        queue.async {
+            self.memoryCache.removeAllObjects()
+            try? self.fileManager.removeItem(at: self.directory)
+        }
+    }
+
+    private func storedEntry(for url: URL) -> Entry? {
+        let key = url.absoluteString
+
+        if let box = memoryCache.object(forKey: key as NSString) { return box.entry }
+
+        guard let data = try? Data(contentsOf: fileURL(forKey: key)),
+              let entry = try? decoder.decode(Entry.self, from: data),
+              entry.url == url else { return nil }
+
+        memoryCache.setObject(EntryBox(entry), forKey: key as NSString)
+
+        return entry
+    }
+
+    private func store(_ entry: Entry) {
+        let key = entry.url.absoluteString
+        memoryCache.setObject(EntryBox(entry), forKey: key as NSString)
+
+        guard let data = try? encoder.encode(entry) else { return }
+
+        try? fileManager.createDirectory(at: directory, withIntermediateDirectories: true, attributes: nil)
+        try? data.write(to: fileURL(forKey: key), options: .atomic)
+    }
+
+    private func removeEntry(forKey key: String) {
+        memoryCache.removeObject(forKey: key as NSString)
+        try? fileManager.removeItem(at: fileURL(forKey: key))
+    }
+
+    /// Names entry files after the 64-bit FNV-1a hash of their key. Collisions are detected by comparing the stored URL.
+    private func fileURL(forKey key: String) -> URL {
+        var hash: UInt64 = 0xCBF2_9CE4_8422_2325
+        for byte in key.utf8 {
+            hash ^= UInt64(byte)
+            hash = hash &* 0x0000_0100_0000_01B3
+        }
+
+        return directory.appendingPathComponent(String(hash, radix: 16))
+    }
+}
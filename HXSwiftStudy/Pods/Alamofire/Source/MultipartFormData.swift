@@ -81,13 +81,19 @@ open class MultipartFormData {
         let headers: HTTPHeaders
         let bodyStream: InputStream
         let bodyContentLength: UInt64
+        /// Produces a new, unopened stream of the same content as `bodyStream`, if the source can be read again.
+        let bodyStreamProvider: (() -> InputStream?)?
         var hasInitialBoundary = false
         var hasFinalBoundary = false
 
-        init(headers: HTTPHeaders, bodyStream: InputStream, bodyContentLength: UInt64) {
+        init(headers: HTTPHeaders,
+             bodyStream: InputStream,
+             bodyContentLength: UInt64,
+             bodyStreamProvider: (() -> InputStream?)? = nil) {
             self.headers = headers
             self.bodyStream = bodyStream
             self.bodyContentLength = bodyContentLength
+            self.bodyStreamProvider = bodyStreamProvider
         }
     }
 
@@ -102,6 +108,29 @@ open class MultipartFormData {
     /// The content length of all body parts used to generate the `multipart/form-data` not including the boundaries.
     public var contentLength: UInt64 { bodyParts.reduce(0) { $0 + $1.bodyContentLength } }
 
+    /// The length of the fully encoded form data, including the boundaries and body part headers.
+    public var encodedContentLength: UInt64 {
+        bodyParts.enumerated().reduce(0) { length, element in
+            let (index, bodyPart) = element
+            let boundaryData = index == 0 ? initialBoundaryData() : encapsulatedBoundaryData()
+            let finalLength = index == bodyParts.count - 1 ? UInt64(finalBoundaryData().count) : 0
+
+            return length
+                + UInt64(boundaryData.count)
+                + UInt64(encodeHeaders(for: bodyPart).count)
+                + bodyPart.bodyContentLength
+                + finalLength
+        }
+    }
+
+    /// Whether uploads of this instance at or above the encoding memory threshold are streamed directly from the body
+    /// parts using `encodedInputStream(bufferSize:)`, rather than first being written to a temporary file. `false` by
+    /// default.
+    ///
+    /// - Note: Body parts appended as an `InputStream` can only be read once, so uploads containing them can't be
+    ///         retried when streamed. Parts appended from `Data` or a file `URL` are reopened for every attempt.
+    open var streamsEncodedBody = false
+
     /// The boundary used to separate the body parts in the encoded form data.
     public let boundary: String
 
@@ -152,7 +181,7 @@ open class MultipartFormData {
         let stream = InputStream(data: data)
         let length = UInt64(data.count)
 
-        append(stream, withLength: length, headers: headers)
+        append(stream, withLength: length, headers: headers) { InputStream(data: data) }
     }
 
     /// Creates a body part from the file and appends it to the instance.
@@ -263,7 +292,7 @@ open class MultipartFormData {
             return
         }
 
-        append(stream, withLength: bodyContentLength, headers: headers)
+        append(stream, withLength: bodyContentLength, headers: headers) { InputStream(url: fileURL) }
     }
 
     /// Creates a body part from the stream and appends it to the instance.
@@ -303,7 +332,17 @@ open class MultipartFormData {
     ///   - length:  Length, in bytes, of the stream.
     ///   - headers: `HTTPHeaders` for the body part.
     public func append(_ stream: InputStream, withLength length: UInt64, headers: HTTPHeaders) {
-        let bodyPart = BodyPart(headers: headers, bodyStream: stream, bodyContentLength: length)
+        append(stream, withLength: length, headers: headers, bodyStreamProvider: nil)
+    }
+
+    private func append(_ stream: InputStream,
+                        withLength length: UInt64,
+                        headers: HTTPHeaders,
+                        bodyStreamProvider: (() -> InputStream?)?) {
+        let bodyPart = BodyPart(headers: headers,
+                                bodyStream: stream,
+                                bodyContentLength: length,
+                                bodyStreamProvider: bodyStreamProvider)
         bodyParts.append(bodyPart)
     }
 
@@ -322,14 +361,13 @@ open class MultipartFormData {
             throw bodyPartError
         }
 
-        var encoded = Data()
+        var encoded = Data(capacity: Int(clamping: encodedContentLength))
 
         bodyParts.first?.hasInitialBoundary = true
         bodyParts.last?.hasFinalBoundary = true
 
         for bodyPart in bodyParts {
-            let encodedData = try encode(bodyPart)
-            encoded.append(encodedData)
+            try encode(bodyPart, into: &encoded)
         }
 
         return encoded
@@ -368,25 +406,229 @@ open class MultipartFormData {
         }
     }
 
-    // MARK: - Private - Body Part Encoding
+    /// Produces an `InputStream` of the encoded form data which reads from the appended body parts on demand.
+    ///
+    /// Boundaries, headers and body part content are written through a bound stream pair of `bufferSize` bytes as the
+    /// returned stream is read, so peak memory use is independent of the size of the form data. Parts appended from
+    /// `Data` or a file `URL` are reopened, so this method may be called more than once; parts appended as an
+    /// `InputStream` are consumed by the first stream produced.
+    ///
+    /// - Note: The writer feeding the returned stream keeps a thread until the stream has been read to its end or
+    ///         closed. Use `encodedStreamWriter(bufferSize:)` to be able to tear it down otherwise.
+    ///
+    /// - Parameter bufferSize: Size, in bytes, of the buffer between the body parts and the returned stream.
+    ///
+    /// - Returns: The unopened `InputStream`, which yields `encodedContentLength` bytes.
+    /// - Throws:  An `AFError` if a body part couldn't be appended.
+    public func encodedInputStream(bufferSize: Int = 64 * 1024) throws -> InputStream {
+        try encodedStreamWriter(bufferSize: bufferSize).inputStream
+    }
+
+    /// Starts a `StreamWriter` which writes the encoded form data into its `inputStream` as the stream is read.
+    ///
+    /// - Parameter bufferSize: Size, in bytes, of the buffer between the body parts and the writer's stream.
+    ///
+    /// - Returns: The running `StreamWriter`.
+    /// - Throws:  An `AFError` if a body part couldn't be appended.
+    func encodedStreamWriter(bufferSize: Int = 64 * 1024) throws -> StreamWriter {
+        if let bodyPartError = bodyPartError {
+            throw bodyPartError
+        }
+
+        // Only the small boundary and header prefixes are encoded up front; content is read by the writer.
+        let segments: [StreamWriter.Segment] = bodyParts.enumerated().map { index, bodyPart in
+            var prefix = index == 0 ? initialBoundaryData() : encapsulatedBoundaryData()
+            prefix.append(encodeHeaders(for: bodyPart))
+
+            return (prefix, bodyPart.bodyStreamProvider?() ?? bodyPart.bodyStream, bodyPart.bodyContentLength)
+        }
+        let suffix = segments.isEmpty ? Data() : finalBoundaryData()
+
+        let writer = StreamWriter(segments: segments, suffix: suffix, bufferSize: bufferSize)
+        writer.start()
+
+        return writer
+    }
+
+    /// Writes encoded form data into the output half of a bound stream pair whenever the reader makes room for it.
+    ///
+    /// Writing is driven by the output stream's events on a thread of the writer's own rather than by blocking writes,
+    /// so `cancel()` can tear the writer down even when the reader never reads or closes `inputStream`, as happens when
+    /// `URLSession` cancels a task or fails it before sending the body.
+    final class StreamWriter: NSObject, StreamDelegate {
+        typealias Segment = (prefix: Data, stream: InputStream, length: UInt64)
+
+        /// The stream from which the encoded form data is read.
+        let inputStream: InputStream
+
+        private let outputStream: OutputStream
+        private let bufferSize: Int
+        private let segments: [Segment]
+        private let suffix: Data
+        /// The writer thread, which retains the writer while it runs.
+        private weak var thread: Thread?
+
+        @Protected
+        private(set) var isFinished = false
+
+        // Only accessed on the writer thread.
+        /// Bytes waiting to be written, of which the first `pendingLength` are valid.
+        private var pending = Data()
+        private var pendingLength = 0
+        private var pendingOffset = 0
+        /// Storage reused for every read from a body part.
+        private var readBuffer: Data
+        private var segmentIndex = 0
+        private var bodyStream: InputStream?
+        private var bytesRemaining: UInt64 = 0
+        private var hasWrittenSuffix = false
+
+        init(segments: [Segment], suffix: Data, bufferSize: Int) {
+            var boundInputStream: InputStream?
+            var boundOutputStream: OutputStream?
+            Foundation.Stream.getBoundStreams(withBufferSize: bufferSize,
+                                              inputStream: &boundInputStream,
+                                              outputStream: &boundOutputStream)
+            guard let inputStream = boundInputStream, let outputStream = boundOutputStream else {
+                preconditionFailure("Failed to create bound streams for multipart encoding.")
+            }
+
+            self.inputStream = inputStream
+            self.outputStream = outputStream
+            self.bufferSize = bufferSize
+            self.segments = segments
+            self.suffix = suffix
+            readBuffer = Data(count: bufferSize)
+        }
+
+        func start() {
+            let thread = Thread { [self] in
+                outputStream.delegate = self
+                outputStream.schedule(in: .current, forMode: .default)
+                outputStream.open()
+
+                while !isFinished, RunLoop.current.run(mode: .default, before: .distantFuture) {}
+            }
+            thread.name = "org.alamofire.multipartFormData.streamWriter"
+            thread.qualityOfService = .utility
+            self.thread = thread
+            thread.start()
+        }
+
+        /// Stops writing and closes the output stream, releasing the writer thread. Safe to call from any thread, and
+        /// more than once.
+        func cancel() {
+            guard !isFinished, let thread = thread else { return }
 
-    private func encode(_ bodyPart: BodyPart) throws -> Data {
-        var encoded = Data()
+            perform(#selector(finish), on: thread, with: nil, waitUntilDone: false)
+        }
+
+        func stream(_ aStream: Foundation.Stream, handle eventCode: Foundation.Stream.Event) {
+            switch eventCode {
+            case .hasSpaceAvailable:
+                writeAvailable()
+            case .errorOccurred, .endEncountered:
+                // The reader went away.
+                finish()
+            default:
+                break
+            }
+        }
+
+        private func writeAvailable() {
+            while !isFinished, outputStream.hasSpaceAvailable {
+                guard pendingOffset < pendingLength || preparePending() else {
+                    finish()
+                    return
+                }
+
+                let bytesWritten = pending.withUnsafeBytes { (bytes: UnsafeRawBufferPointer) -> Int in
+                    let base = bytes.bindMemory(to: UInt8.self).baseAddress!
+                    return outputStream.write(base + pendingOffset, maxLength: pendingLength - pendingOffset)
+                }
+                guard bytesWritten > 0 else {
+                    finish()
+                    return
+                }
+
+                pendingOffset += bytesWritten
+            }
+        }
+
+        /// Loads the next bytes of the encoded form data into `pending`, returning `false` once there are none left or
+        /// a body part couldn't be read. A short body fails the upload, as it is sent with `encodedContentLength`.
+        private func preparePending() -> Bool {
+            pendingOffset = 0
+
+            if bytesRemaining > 0, let bodyStream = bodyStream {
+                // Drop the reference to the previous read so the buffer is refilled in place rather than copied.
+                pending = Data()
+                let bytesRead = readBuffer.withUnsafeMutableBytes { (bytes: UnsafeMutableRawBufferPointer) -> Int in
+                    let base = bytes.bindMemory(to: UInt8.self).baseAddress!
+                    return bodyStream.read(base, maxLength: Int(min(UInt64(bufferSize), bytesRemaining)))
+                }
+                guard bytesRead > 0 else { return false }
+
+                bytesRemaining -= UInt64(bytesRead)
+                pending = readBuffer
+                pendingLength = bytesRead
+                return true
+            }
+
+            bodyStream?.close()
+            bodyStream = nil
 
+            if segmentIndex < segments.count {
+                let segment = segments[segmentIndex]
+                segmentIndex += 1
+
+                segment.stream.open()
+                bodyStream = segment.stream
+                bytesRemaining = segment.length
+                return setPending(segment.prefix)
+            }
+
+            guard !hasWrittenSuffix else { return false }
+
+            hasWrittenSuffix = true
+            return setPending(suffix)
+        }
+
+        private func setPending(_ data: Data) -> Bool {
+            pending = data
+            pendingLength = data.count
+            // An empty prefix or suffix has nothing to write, so move on to what follows it.
+            return pendingLength > 0 || preparePending()
+        }
+
+        @objc
+        private func finish() {
+            guard !isFinished else { return }
+
+            isFinished = true
+            bodyStream?.close()
+            bodyStream = nil
+            pending = Data()
+            outputStream.delegate = nil
+            outputStream.close()
+            outputStream.remove(from: .current, forMode: .default)
+        }
+    }
+
+    // MARK: - Private - Body Part Encoding
+
+    private func encode(_ bodyPart: BodyPart, into encoded: inout Data) throws {
         let initialData = bodyPart.hasInitialBoundary ? initialBoundaryData() : encapsulatedBoundaryData()
         encoded.append(initialData)
 
         let headerData = encodeHeaders(for: bodyPart)
         encoded.append(headerData)
 
-        let bodyStreamData = try encodeBodyStream(for: bodyPart)
-        encoded.append(bodyStreamData)
+        try encodeBodyStream(for: bodyPart, into: &encoded)
 
         if bodyPart.hasFinalBoundary {
             encoded.append(finalBoundaryData())
         }
-
-        return encoded
     }
 
     private func encodeHeaders(for bodyPart: BodyPart) -> Data {
@@ -397,15 +639,15 @@ open class MultipartFormData {
         return Data(headerText.utf8)
     }
 
-    private func encodeBodyStream(for bodyPart: BodyPart) throws -> Data {
+    private func encodeBodyStream(for bodyPart: BodyPart, into encoded: inout Data) throws {
         let inputStream = bodyPart.bodyStream
         inputStream.open()
         defer { inputStream.close() }
 
-        var encoded = Data()
+        let initialCount = encoded.count
+        var buffer = [UInt8](repeating: 0, count: streamBufferSize)
 
         while inputStream.hasBytesAvailable {
-            var buffer = [UInt8](repeating: 0, count: streamBufferSize)
             let bytesRead = inputStream.read(&buffer, maxLength: streamBufferSize)
 
             if let error = inputStream.streamError {
@@ -419,13 +661,12 @@ open class MultipartFormData {
             }
         }
 
-        guard UInt64(encoded.count) == bodyPart.bodyContentLength else {
+        let bytesRead = UInt64(encoded.count - initialCount)
+        guard bytesRead == bodyPart.bodyContentLength else {
             let error = AFError.UnexpectedInputStreamLength(bytesExpected: bodyPart.bodyContentLength,
-                                                            bytesRead: UInt64(encoded.count))
+                                                            bytesRead: bytesRead)
             throw AFError.multipartEncodingFailed(reason: .inputStreamReadFailed(error: error))
         }
-
-        return encoded
     }
 
     // MARK: - Private - Writing Body Part to Output Stream
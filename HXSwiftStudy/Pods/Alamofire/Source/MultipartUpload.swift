@@ -34,6 +34,10 @@ final class MultipartUpload {
     let request: URLRequestConvertible
     let fileManager: FileManager
 
+    /// Writers of the streams built for streamed uploads, torn down when the attempt they were built for is over.
+    @Protected
+    private var streamWriters: [MultipartFormData.StreamWriter] = []
+
     init(encodingMemoryThreshold: UInt64,
          request: URLRequestConvertible,
          multipartFormData: MultipartFormData) {
@@ -43,12 +47,22 @@ final class MultipartUpload {
         self.multipartFormData = multipartFormData
     }
 
+    /// Whether the upload is streamed from the body parts rather than encoded in memory or on disk.
+    var isStreamed: Bool {
+        $multipartFormData.read { $0.streamsEncodedBody && $0.contentLength >= encodingMemoryThreshold }
+    }
+
     func build() throws -> UploadRequest.Uploadable {
         let uploadable: UploadRequest.Uploadable
         if multipartFormData.contentLength < encodingMemoryThreshold {
             let data = try multipartFormData.encode()
 
             uploadable = .data(data)
+        } else if multipartFormData.streamsEncodedBody {
+            let writer = try multipartFormData.encodedStreamWriter()
+            $streamWriters.write { $0.append(writer) }
+
+            uploadable = .stream(writer.inputStream)
         } else {
             let tempDirectoryURL = fileManager.temporaryDirectory
             let directoryURL = tempDirectoryURL.appendingPathComponent("org.alamofire.manager/multipart.form.data")
@@ -70,6 +84,16 @@ final class MultipartUpload {
 
         return uploadable
     }
+
+    /// Tears down the writers of any streams built so far. `URLSession` doesn't necessarily read or close a body stream
+    /// once its task is cancelled or fails, which would otherwise leave the writers waiting for the reader forever.
+    func cancelStreamWriters() {
+        let writers = $streamWriters.write { (writers: inout [MultipartFormData.StreamWriter]) -> [MultipartFormData.StreamWriter] in
+            defer { writers.removeAll() }
+            return writers
+        }
+        writers.forEach { $0.cancel() }
+    }
 }
 
 extension MultipartUpload: UploadConvertible {
@@ -80,10 +104,20 @@ extension MultipartUpload: UploadConvertible {
             urlRequest.headers.add(.contentType(multipartFormData.contentType))
         }
 
+        if isStreamed {
+            // Without an explicit length, streamed bodies are sent using chunked transfer encoding.
+            let contentLength = $multipartFormData.read { $0.encodedContentLength }
+            urlRequest.headers.update(name: "Content-Length", value: String(contentLength))
+        }
+
         return urlRequest
     }
 
     func createUploadable() throws -> UploadRequest.Uploadable {
-        try result.get()
+        // Streams can only be read once, so each attempt needs a new one. Any previous attempt is over by now.
+        guard isStreamed else { return try result.get() }
+
+        cancelStreamWriters()
+        return try build()
     }
 }
@@ -81,6 +81,9 @@ extension String {
 
 /// `EventMonitor` that provides Alamofire's notifications.
 public final class AlamofireNotifications: EventMonitor {
+    /// Notifications are only posted for `Request` lifecycle events.
+    public var subscribedEvents: EventMonitorEvents { .requestLifecycle }
+
     public func requestDidResume(_ request: Request) {
         NotificationCenter.default.postNotification(named: Request.didResumeNotification, with: request)
     }
@@ -1068,11 +1068,14 @@ public class DataRequest: Request {
     /// `URLRequestConvertible` value used to create `URLRequest`s for this instance.
     public let convertible: URLRequestConvertible
     /// `Data` read from the server so far.
-    public var data: Data? { mutableData }
+    ///
+    /// - Note: Received chunks are only joined into contiguous `Data` when this property is read, so avoid reading it
+    ///         repeatedly while the response is still streaming in.
+    public var data: Data? { $mutableData.write { $0?.contiguousData() } }
 
     /// Protected storage for the `Data` read by the instance.
     @Protected
-    private var mutableData: Data? = nil
+    private var mutableData: ResponseDataBuffer? = nil
 
     /// Creates a `DataRequest` using the provided parameters.
     ///
@@ -1114,13 +1117,17 @@ public class DataRequest: Request {
     ///
     /// - Parameter data: The `Data` received.
     func didReceive(data: Data) {
-        if self.data == nil {
-            mutableData = data
-        } else {
-            $mutableData.write { $0?.append(data) }
+        let totalBytesExpected = task?.response?.expectedContentLength ?? NSURLSessionTransferSizeUnknown
+        let totalBytesReceived = $mutableData.write { (buffer: inout ResponseDataBuffer?) -> Int in
+            if buffer == nil {
+                buffer = ResponseDataBuffer(expectedLength: totalBytesExpected)
+            }
+            buffer?.append(data)
+
+            return buffer?.count ?? 0
         }
 
-        updateDownloadProgress()
+        updateDownloadProgress(totalBytesReceived: Int64(totalBytesReceived), totalBytesExpected: totalBytesExpected)
     }
 
     override func task(for request: URLRequest, using session: URLSession) -> URLSessionTask {
@@ -1129,10 +1136,11 @@ public class DataRequest: Request {
     }
 
     /// Called to updated the `downloadProgress` of the instance.
-    func updateDownloadProgress() {
-        let totalBytesReceived = Int64(data?.count ?? 0)
-        let totalBytesExpected = task?.response?.expectedContentLength ?? NSURLSessionTransferSizeUnknown
-
+    ///
+    /// - Parameters:
+    ///   - totalBytesReceived: Total number of bytes received so far.
+    ///   - totalBytesExpected: Total number of bytes expected, or `NSURLSessionTransferSizeUnknown`.
+    func updateDownloadProgress(totalBytesReceived: Int64, totalBytesExpected: Int64) {
         downloadProgress.totalUnitCount = totalBytesExpected
         downloadProgress.completedUnitCount = totalBytesReceived
 
@@ -1168,6 +1176,77 @@ public class DataRequest: Request {
     }
 }
 
+// MARK: - ResponseDataBuffer
+
+/// Storage for the body received by a `DataRequest`.
+///
+/// Appending every chunk to a single `Data` reallocates and copies the body each time it outgrows its buffer, and
+/// copies it in full whenever a reader is holding onto the previous value. Instead, when the `Content-Length` is known
+/// the buffer is allocated once up front, and otherwise chunks are kept as received and only joined into contiguous
+/// `Data` when requested.
+struct ResponseDataBuffer {
+    /// Largest `Content-Length` for which storage is allocated up front, so a bogus header can't force a huge allocation.
+    static let maximumPreallocatedLength = 64 * 1024 * 1024
+
+    /// Total number of bytes appended.
+    private(set) var count = 0
+    /// Contiguous storage which chunks are copied into while it has room.
+    private var storage = Data()
+    /// Number of bytes `storage` may hold before chunks are kept separately.
+    private var storageCapacity = 0
+    /// Chunks received after `storage` filled up.
+    private var chunks: [Data] = []
+
+    /// Creates an instance for a body of the expected length.
+    ///
+    /// - Parameter expectedLength: Expected length of the body, or `NSURLSessionTransferSizeUnknown`.
+    init(expectedLength: Int64) {
+        if expectedLength > 0, expectedLength <= Int64(Self.maximumPreallocatedLength) {
+            storageCapacity = Int(expectedLength)
+            storage.reserveCapacity(storageCapacity)
+        }
+    }
+
+    /// Appends a chunk of the body.
+    ///
+    /// - Parameter data: The `Data` to append.
+    mutating func append(_ data: Data) {
+        guard !data.isEmpty else { return }
+
+        if count == 0, storageCapacity == 0 {
+            // Keep the first chunk as is, which avoids any copying for single chunk bodies.
+            storage = data
+            storageCapacity = data.count
+        } else if chunks.isEmpty, storage.count + data.count <= storageCapacity {
+            storage.append(data)
+        } else {
+            chunks.append(data)
+        }
+
+        count += data.count
+    }
+
+    /// Returns the appended bytes as contiguous `Data`, joining any outstanding chunks.
+    ///
+    /// The joined value replaces the chunks, so repeated calls don't copy again. The returned value is never mutated
+    /// afterwards, so callers holding onto it don't force a copy when more data arrives.
+    ///
+    /// - Returns: The body received so far.
+    mutating func contiguousData() -> Data {
+        if !chunks.isEmpty {
+            var joined = Data(capacity: count)
+            joined.append(storage)
+            chunks.forEach { joined.append($0) }
+
+            storage = joined
+            chunks.removeAll()
+        }
+        storageCapacity = storage.count
+
+        return storage
+    }
+}
+
 // MARK: - DataStreamRequest
 
 /// `Request` subclass which streams HTTP response `Data` through a `Handler` closure.
@@ -1761,6 +1840,9 @@ public class UploadRequest: DataRequest {
     /// `Uploadable` value used by the instance.
     public var uploadable: Uploadable?
 
+    /// Whether `inputStream()` has handed the stream of `uploadable` to `URLSession` already.
+    private var hasProvidedInputStream = false
+
     /// Creates an `UploadRequest` using the provided parameters.
     ///
     /// - Parameters:
@@ -1827,6 +1909,7 @@ public class UploadRequest: DataRequest {
     override func reset() {
         // Uploadable must be recreated on every retry.
         uploadable = nil
+        hasProvidedInputStream = false
 
         super.reset()
     }
@@ -1841,10 +1924,21 @@ public class UploadRequest: DataRequest {
             fatalError("Attempting to access the input stream but the uploadable doesn't exist.")
         }
 
-        guard case let .stream(stream) = uploadable else {
+        guard case var .stream(stream) = uploadable else {
             fatalError("Attempted to access the stream of an UploadRequest that wasn't created with one.")
         }
 
+        // URLSession asks again when it has to resend the body, e.g. after an authentication challenge, by which point
+        // the stream it was given has been read. Uploads which can produce a new stream, like streamed multipart form
+        // data, are asked for one.
+        if hasProvidedInputStream,
+           let newUploadable = try? upload.createUploadable(),
+           case let .stream(newStream) = newUploadable {
+            self.uploadable = newUploadable
+            stream = newStream
+        }
+        hasProvidedInputStream = true
+
         eventMonitor?.request(self, didProvideInputStream: stream)
 
         return stream
@@ -1853,6 +1947,8 @@ public class UploadRequest: DataRequest {
     override public func cleanup() {
         defer { super.cleanup() }
 
+        (upload as? MultipartUpload)?.cancelStreamWriters()
+
         guard
             let uploadable = self.uploadable,
             case let .file(url, shouldRemove) = uploadable,
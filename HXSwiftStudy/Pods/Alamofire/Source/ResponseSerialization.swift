@@ -1114,3 +1114,356 @@ extension DataStreamRequest {
                        stream: stream)
     }
 }
+
+// MARK: - Record Streams
+
+/// How individual records are delimited within a streamed response body.
+public enum DataStreamRecordFraming {
+    /// Each record is a single line, as in JSON Lines / NDJSON. Blank lines are skipped and a trailing record without
+    /// a final newline is delivered once the stream completes.
+    case newlineDelimited
+    /// The body is a single JSON array and each element is a record.
+    case jsonArray
+}
+
+/// Splits streamed `Data` into complete records, carrying partial records across chunk boundaries. Only the bytes of
+/// the record currently being received are retained between chunks.
+struct DataStreamRecordFramer {
+    let framing: DataStreamRecordFraming
+
+    /// Bytes which haven't been emitted as part of a record yet.
+    private var buffer = Data()
+    /// Offset in `buffer` at which scanning resumes.
+    private var scanOffset = 0
+    /// Offset in `buffer` of the first byte of the record being framed, if any.
+    private var recordOffset: Int?
+    /// Nesting depth within the top level JSON array, where `1` is the array itself.
+    private var depth = 0
+    private var isInString = false
+    private var isEscaped = false
+    private var isArrayClosed = false
+
+    init(framing: DataStreamRecordFraming) {
+        self.framing = framing
+    }
+
+    /// Appends a chunk of `Data` and returns the records it completed.
+    ///
+    /// - Parameter data: The `Data` received.
+    ///
+    /// - Returns:        The complete records, in order.
+    /// - Throws:         An `AFError` if the `Data` can't be framed.
+    mutating func append(_ data: Data) throws -> [Data] {
+        buffer.append(data)
+
+        var records: [Data] = []
+        switch framing {
+        case .newlineDelimited: frameLines(into: &records)
+        case .jsonArray: try frameArrayElements(into: &records)
+        }
+        discardConsumedBytes()
+
+        return records
+    }
+
+    /// Returns any record left once the stream has ended.
+    ///
+    /// - Returns: The remaining records.
+    /// - Throws:  An `AFError` if the stream ended within a record.
+    mutating func finish() throws -> [Data] {
+        defer {
+            buffer = Data()
+            scanOffset = 0
+            recordOffset = nil
+        }
+
+        switch framing {
+        case .newlineDelimited:
+            let start = recordOffset ?? 0
+            return Self.isBlank(buffer, in: start..<buffer.count) ? [] : [buffer.subdata(in: start..<buffer.count)]
+        case .jsonArray:
+            guard isArrayClosed || (depth == 0 && Self.isBlank(buffer, in: 0..<buffer.count)) else {
+                throw Self.framingError("The stream ended before the JSON array was closed.")
+            }
+
+            return []
+        }
+    }
+
+    private mutating func frameLines(into records: inout [Data]) {
+        let lineStart = recordOffset ?? 0
+        var newlineOffsets: [Int] = []
+        buffer.withUnsafeBytes { (bytes: UnsafeRawBufferPointer) in
+            for offset in scanOffset..<bytes.count where bytes[offset] == UInt8(ascii: "\n") {
+                newlineOffsets.append(offset)
+            }
+        }
+
+        var start = lineStart
+        for offset in newlineOffsets {
+            if !Self.isBlank(buffer, in: start..<offset) {
+                records.append(buffer.subdata(in: start..<offset))
+            }
+            start = offset + 1
+        }
+
+        recordOffset = start
+        scanOffset = buffer.count
+    }
+
+    private mutating func frameArrayElements(into records: inout [Data]) throws {
+        var ranges: [Range<Int>] = []
+        var failure: String?
+        // Scanner state is copied out so the closure doesn't capture `self` while `buffer` is being read.
+        var offset = scanOffset
+        var recordOffset = self.recordOffset
+        var depth = self.depth
+        var isInString = self.isInString
+        var isEscaped = self.isEscaped
+        var isArrayClosed = self.isArrayClosed
+
+        buffer.withUnsafeBytes { (bytes: UnsafeRawBufferPointer) in
+            while offset < bytes.count, failure == nil {
+                let byte = bytes[offset]
+                defer { offset += 1 }
+
+                if isInString {
+                    if isEscaped {
+                        isEscaped = false
+                    } else if byte == UInt8(ascii: "\\") {
+                        isEscaped = true
+                    } else if byte == UInt8(ascii: "\"") {
+                        isInString = false
+                    }
+                    continue
+                }
+
+                switch byte {
+                case UInt8(ascii: " "), UInt8(ascii: "\t"), UInt8(ascii: "\n"), UInt8(ascii: "\r"):
+                    continue
+                case _ where isArrayClosed:
+                    failure = "Unexpected content after the end of the JSON array."
+                case UInt8(ascii: "["), UInt8(ascii: "{"):
+                    if depth == 0 {
+                        guard byte == UInt8(ascii: "[") else { failure = "The stream is not a JSON array."; break }
+                    } else if depth == 1, recordOffset == nil {
+                        recordOffset = offset
+                    }
+                    depth += 1
+                case UInt8(ascii: "]"), UInt8(ascii: "}"):
+                    guard depth > 0 else { failure = "Unbalanced JSON array."; break }
+
+                    depth -= 1
+                    if depth == 0 {
+                        if let start = recordOffset { ranges.append(start..<offset) }
+                        recordOffset = nil
+                        isArrayClosed = true
+                    } else if depth == 1, let start = recordOffset {
+                        ranges.append(start..<(offset + 1))
+                        recordOffset = nil
+                    }
+                case UInt8(ascii: ","):
+                    if depth == 1, let start = recordOffset {
+                        ranges.append(start..<offset)
+                        recordOffset = nil
+                    }
+                default:
+                    guard depth > 0 else { failure = "The stream is not a JSON array."; break }
+
+                    if byte == UInt8(ascii: "\"") { isInString = true }
+                    if depth == 1, recordOffset == nil { recordOffset = offset }
+                }
+            }
+        }
+
+        scanOffset = offset
+        self.recordOffset = recordOffset
+        self.depth = depth
+        self.isInString = isInString
+        self.isEscaped = isEscaped
+        self.isArrayClosed = isArrayClosed
+
+        records.append(contentsOf: ranges.map { buffer.subdata(in: $0) })
+
+        if let failure = failure {
+            throw Self.framingError(failure)
+        }
+    }
+
+    /// Drops the bytes preceding the record being framed so the buffer only ever holds a partial record.
+    private mutating func discardConsumedBytes() {
+        let consumed = recordOffset ?? scanOffset
+        guard consumed > 0 else { return }
+
+        buffer = buffer.subdata(in: consumed..<buffer.count)
+        scanOffset -= consumed
+        recordOffset = recordOffset.map { $0 - consumed }
+    }
+
+    private static func isBlank(_ data: Data, in range: Range<Int>) -> Bool {
+        data.withUnsafeBytes { (bytes: UnsafeRawBufferPointer) in
+            bytes[range].allSatisfy { $0 == UInt8(ascii: " ") || $0 == UInt8(ascii: "\t") || $0 == UInt8(ascii: "\r") || $0 == UInt8(ascii: "\n") }
+        }
+    }
+
+    private static func framingError(_ description: String) -> AFError {
+        let error = DecodingError.dataCorrupted(.init(codingPath: [], debugDescription: description))
+        return AFError.responseSerializationFailed(reason: .decodingFailed(error: error))
+    }
+}
+
+extension DataStreamRequest {
+    /// Outstanding deliveries of a record stream, used to apply back-pressure to the underlying task.
+    private struct RecordStreamFlowState {
+        var pendingDeliveries = 0
+        var isThrottled = false
+    }
+
+    /// Adds a `StreamHandler` which frames incoming `Data` into records and decodes each one using the provided
+    /// `DataDecoder`.
+    ///
+    /// Records may span any number of received chunks. Framing and decoding are done on the `serializationQueue`, and
+    /// the records completed by each chunk are delivered together in batches of up to `maximumBatchSize` values.
+    ///
+    /// When the `stream` closure falls `maximumPendingDeliveries` deliveries behind the network, the underlying
+    /// `URLSessionTask` is suspended until half of them have been handled, so a slow consumer doesn't cause the whole
+    /// body to be buffered in memory.
+    ///
+    /// - Parameters:
+    ///   - type:                     `Decodable` type of each record.
+    ///   - framing:                  `DataStreamRecordFraming` of the response body. `.newlineDelimited` by default.
+    ///   - queue:                    `DispatchQueue` on which to perform `StreamHandler` closure.
+    ///   - decoder:                  `DataDecoder` used to decode each record.
+    ///   - maximumBatchSize:         Maximum number of records delivered in a single event. `64` by default.
+    ///   - maximumPendingDeliveries: Number of undelivered events after which the task is suspended. `8` by default.
+    ///   - stream:                   `StreamHandler` closure called as records are decoded. May be called multiple
+    ///                               times.
+    ///
+    /// - Returns: The `DataStreamRequest`.
+    @discardableResult
+    public func responseStreamRecords<T: Decodable>(of type: T.Type = T.self,
+                                                    framing: DataStreamRecordFraming = .newlineDelimited,
+                                                    on queue: DispatchQueue = .main,
+                                                    using decoder: DataDecoder = JSONDecoder(),
+                                                    maximumBatchSize: Int = 64,
+                                                    maximumPendingDeliveries: Int = 8,
+                                                    stream: @escaping Handler<[T], AFError>) -> Self {
+        precondition(maximumBatchSize > 0, "maximumBatchSize must be greater than zero.")
+
+        // Only accessed on the serialization queue.
+        var framer = DataStreamRecordFramer(framing: framing)
+        var isFailed = false
+        let flowState = Protected(RecordStreamFlowState())
+
+        let decode = { (records: Result<[Data], Error>) -> [Result<[T], AFError>] in
+            var results: [Result<[T], AFError>] = []
+            var batch: [T] = []
+            batch.reserveCapacity(maximumBatchSize)
+
+            do {
+                for record in try records.get() {
+                    do {
+                        batch.append(try decoder.decode(T.self, from: record))
+                    } catch {
+                        throw AFError.responseSerializationFailed(reason: .decodingFailed(error: error))
+                    }
+
+                    if batch.count == maximumBatchSize {
+                        results.append(.success(batch))
+                        batch.removeAll(keepingCapacity: true)
+                    }
+                }
+                if !batch.isEmpty { results.append(.success(batch)) }
+            } catch {
+                if !batch.isEmpty { results.append(.success(batch)) }
+                results.append(.failure(error.asAFError(or: .responseSerializationFailed(reason: .customSerializationFailed(error: error)))))
+                isFailed = true
+            }
+
+            return results
+        }
+
+        // Called on the serialization queue. Always ends with `updateAndCompleteIfPossible()`, balancing the execution
+        // count taken by `didReceive(data:)`.
+        let deliver = { [unowned self] (results: [Result<[T], AFError>]) in
+            guard !results.isEmpty else {
+                self.updateAndCompleteIfPossible()
+                return
+            }
+
+            let shouldThrottle = flowState.write { (state: inout RecordStreamFlowState) -> Bool in
+                state.pendingDeliveries += 1
+                guard !state.isThrottled, state.pendingDeliveries > maximumPendingDeliveries else { return false }
+
+                state.isThrottled = true
+                return true
+            }
+
+            self.underlyingQueue.async {
+                results.forEach { self.eventMonitor?.request(self, didParseStream: $0) }
+
+                if results.contains(where: { $0.isFailure }), self.automaticallyCancelOnStreamError {
+                    self.cancel()
+                }
+
+                if shouldThrottle, self.state == .resumed {
+                    self.task?.suspend()
+                }
+
+                queue.async {
+                    for result in results {
+                        self.capturingError {
+                            try stream(.init(event: .stream(result), token: .init(self)))
+                        }
+                    }
+
+                    let shouldResume = flowState.write { (state: inout RecordStreamFlowState) -> Bool in
+                        state.pendingDeliveries -= 1
+                        guard state.isThrottled, state.pendingDeliveries <= maximumPendingDeliveries / 2 else { return false }
+
+                        state.isThrottled = false
+                        return true
+                    }
+                    if shouldResume {
+                        self.underlyingQueue.async {
+                            if self.state == .resumed { self.task?.resume() }
+                        }
+                    }
+
+                    self.updateAndCompleteIfPossible()
+                }
+            }
+        }
+
+        let parser = { [unowned self] (data: Data) in
+            self.serializationQueue.async {
+                // Start work on serialization queue.
+                guard !isFailed else { deliver([]); return }
+
+                let results = decode(Result { try framer.append(data) })
+                // End work on serialization queue.
+                deliver(results)
+            }
+        }
+
+        $streamMutableState.write { $0.streams.append(parser) }
+
+        // Deliver any record left without a trailing delimiter before the completion event.
+        appendResponseSerializer {
+            self.serializationQueue.async {
+                let results = isFailed ? [] : decode(Result { try framer.finish() })
+                guard !results.isEmpty, self.error == nil else {
+                    self.underlyingQueue.async { self.responseSerializerDidComplete {} }
+                    return
+                }
+
+                self.$streamMutableState.write { $0.numberOfExecutingStreams += 1 }
+                deliver(results)
+                self.underlyingQueue.async { self.responseSerializerDidComplete {} }
+            }
+        }
+        appendStreamCompletion(on: queue, stream: stream)
+
+        return self
+    }
+}
@@ -277,6 +277,22 @@ open class RetryPolicy: RequestInterceptor {
     /// The URL error codes that are automatically retried by the policy.
     public let retryableURLErrorCodes: Set<URLError.Code>
 
+    /// The `Backoff` used to compute the delay before each retry.
+    public let backoff: Backoff
+
+    /// The `RetryBudget` bounding the number of retries issued per host, if any.
+    public let retryBudget: RetryBudget?
+
+    /// The `CircuitBreaker` failing requests to hosts that keep failing, if any.
+    public let circuitBreaker: CircuitBreaker?
+
+    /// The longest `Retry-After` delay the policy honors. `nil` ignores the header entirely. Responses asking for a
+    /// longer delay are not retried.
+    public let maximumRetryAfterDelay: TimeInterval?
+
+    /// The previous delay of each request retried with `.decorrelatedJitter` backoff.
+    private let previousDelays = Protected<[UUID: TimeInterval]>([:])
+
     /// Creates an `ExponentialBackoffRetryPolicy` from the specified parameters.
     ///
     /// - Parameters:
@@ -289,12 +305,22 @@ open class RetryPolicy: RequestInterceptor {
     ///                               `RetryPolicy.defaultRetryableHTTPStatusCodes` by default.
     ///   - retryableURLErrorCodes:   The URL error codes that are automatically retried by the policy.
     ///                               `RetryPolicy.defaultRetryableURLErrorCodes` by default.
+    ///   - backoff:                  The `Backoff` used to compute retry delays. `.exponential` by default.
+    ///   - retryBudget:              The `RetryBudget` bounding retries per host. Share one instance between policies
+    ///                               to bound them together. `nil` by default.
+    ///   - circuitBreaker:           The `CircuitBreaker` failing requests to failing hosts. `nil` by default.
+    ///   - maximumRetryAfterDelay:   The longest `Retry-After` delay to honor. `nil` by default, which ignores the
+    ///                               header.
     public init(retryLimit: UInt = RetryPolicy.defaultRetryLimit,
                 exponentialBackoffBase: UInt = RetryPolicy.defaultExponentialBackoffBase,
                 exponentialBackoffScale: Double = RetryPolicy.defaultExponentialBackoffScale,
                 retryableHTTPMethods: Set<HTTPMethod> = RetryPolicy.defaultRetryableHTTPMethods,
                 retryableHTTPStatusCodes: Set<Int> = RetryPolicy.defaultRetryableHTTPStatusCodes,
-                retryableURLErrorCodes: Set<URLError.Code> = RetryPolicy.defaultRetryableURLErrorCodes) {
+                retryableURLErrorCodes: Set<URLError.Code> = RetryPolicy.defaultRetryableURLErrorCodes,
+                backoff: Backoff = .exponential,
+                retryBudget: RetryBudget? = nil,
+                circuitBreaker: CircuitBreaker? = nil,
+                maximumRetryAfterDelay: TimeInterval? = nil) {
         precondition(exponentialBackoffBase >= 2, "The `exponentialBackoffBase` must be a minimum of 2.")
 
         self.retryLimit = retryLimit
@@ -303,19 +329,125 @@ open class RetryPolicy: RequestInterceptor {
         self.retryableHTTPMethods = retryableHTTPMethods
         self.retryableHTTPStatusCodes = retryableHTTPStatusCodes
         self.retryableURLErrorCodes = retryableURLErrorCodes
+        self.backoff = backoff
+        self.retryBudget = retryBudget
+        self.circuitBreaker = circuitBreaker
+        self.maximumRetryAfterDelay = maximumRetryAfterDelay
+    }
+
+    /// Fails requests to hosts whose `circuitBreaker` is open and deposits each attempt into the `retryBudget`.
+    ///
+    /// - Note: Both only observe traffic when the policy is installed as an adapter as well as a retrier, e.g. as a
+    ///         `Session` or `Request` interceptor.
+    open func adapt(_ urlRequest: URLRequest, for session: Session, completion: @escaping (Result<URLRequest, Error>) -> Void) {
+        let host = urlRequest.url?.host ?? ""
+
+        if let circuitBreaker = circuitBreaker, !circuitBreaker.allowsRequest(to: host) {
+            completion(.failure(CircuitBreaker.OpenCircuitError(host: host)))
+            return
+        }
+
+        retryBudget?.deposit(for: host)
+        completion(.success(urlRequest))
     }
 
     open func retry(_ request: Request,
                     for session: Session,
                     dueTo error: Error,
                     completion: @escaping (RetryResult) -> Void) {
-        if request.retryCount < retryLimit, shouldRetry(request: request, dueTo: error) {
-            completion(.retryWithDelay(pow(Double(exponentialBackoffBase), Double(request.retryCount)) * exponentialBackoffScale))
-        } else {
-            completion(.doNotRetry)
+        guard shouldRetry(request: request, dueTo: error) else {
+            finishRetrying(request, completion: completion)
+            return
+        }
+
+        let host = request.request?.url?.host ?? ""
+        circuitBreaker?.recordFailure(for: host)
+
+        guard request.retryCount < retryLimit, !(circuitBreaker?.isOpen(for: host) ?? false) else {
+            finishRetrying(request, completion: completion)
+            return
+        }
+
+        var delay = retryDelay(for: request)
+
+        if let maximumRetryAfterDelay = maximumRetryAfterDelay, let retryAfter = retryAfterDelay(for: request) {
+            guard retryAfter <= maximumRetryAfterDelay else {
+                finishRetrying(request, completion: completion)
+                return
+            }
+
+            delay = max(delay, retryAfter)
+        }
+
+        guard retryBudget?.withdraw(for: host) ?? true else {
+            finishRetrying(request, completion: completion)
+            return
+        }
+
+        completion(.retryWithDelay(delay))
+    }
+
+    /// Computes the delay before the next retry of the provided `Request` using the policy's `backoff`.
+    ///
+    /// - Parameter request: `Request` about to be retried.
+    ///
+    /// - Returns:           The delay, in seconds.
+    open func retryDelay(for request: Request) -> TimeInterval {
+        let exponentialDelay = pow(Double(exponentialBackoffBase), Double(request.retryCount)) * exponentialBackoffScale
+
+        switch backoff {
+        case .exponential:
+            return exponentialDelay
+        case let .decorrelatedJitter(maximumDelay):
+            let base = exponentialBackoffScale
+            return previousDelays.write { previousDelays -> TimeInterval in
+                // Requests that finish successfully after a retry never reach `finishRetrying`, so bound the table.
+                if previousDelays.count >= 1024 { previousDelays.removeAll(keepingCapacity: true) }
+
+                let previous = previousDelays[request.id] ?? base
+                let upperBound = max(base, previous * 3)
+                let delay = min(maximumDelay, Double.random(in: base...upperBound))
+                previousDelays[request.id] = delay
+
+                return delay
+            }
         }
     }
 
+    /// Parses the `Retry-After` header of the provided `Request`'s response, in either delay-seconds or HTTP-date form.
+    ///
+    /// - Parameter request: `Request` whose response should be inspected.
+    ///
+    /// - Returns:           The requested delay, in seconds, or `nil` if the header is missing or malformed.
+    open func retryAfterDelay(for request: Request) -> TimeInterval? {
+        guard let value = request.response?.headers["Retry-After"]?.trimmingCharacters(in: .whitespaces) else { return nil }
+
+        if let seconds = TimeInterval(value) {
+            return max(0, seconds)
+        }
+
+        guard let date = RetryPolicy.httpDateFormatter.date(from: value) else { return nil }
+
+        return max(0, date.timeIntervalSinceNow)
+    }
+
+    private func finishRetrying(_ request: Request, completion: (RetryResult) -> Void) {
+        if case .decorrelatedJitter = backoff {
+            previousDelays.write { $0[request.id] = nil }
+        }
+
+        completion(.doNotRetry)
+    }
+
+    private static let httpDateFormatter: DateFormatter = {
+        let formatter = DateFormatter()
+        formatter.locale = Locale(identifier: "en_US_POSIX")
+        formatter.timeZone = TimeZone(secondsFromGMT: 0)
+        formatter.dateFormat = "EEE, dd MMM yyyy HH:mm:ss zzz"
+
+        return formatter
+    }()
+
     /// Determines whether or not to retry the provided `Request`.
     ///
     /// - Parameters:
@@ -368,3 +500,276 @@ open class ConnectionLostRetryPolicy: RetryPolicy {
                    retryableURLErrorCodes: [.networkConnectionLost])
     }
 }
+
+// MARK: - Backoff
+
+extension RetryPolicy {
+    /// Strategy used to space out the retries of a single request.
+    public enum Backoff {
+        /// Waits `exponentialBackoffScale * exponentialBackoffBase ^ retryCount` seconds. Requests failing together retry
+        /// together.
+        case exponential
+        /// Waits a random delay between `exponentialBackoffScale` and three times the previous delay, capped at
+        /// `maximumDelay`. Spreads out retries of requests that failed at the same time.
+        case decorrelatedJitter(maximumDelay: TimeInterval)
+    }
+}
+
+// MARK: - RetryBudget
+
+/// A per-host token bucket bounding how many retries a `RetryPolicy` may issue.
+///
+/// Each request attempt deposits `depositPerAttempt` tokens into its host's bucket and each retry withdraws one, so
+/// retries stay a bounded fraction of regular traffic instead of multiplying it when a host fails. Buckets also
+/// refill at `minimumRetriesPerSecond` so hosts with little traffic can still retry.
+public final class RetryBudget {
+    private struct Bucket {
+        var tokens: Double
+        var lastRefill: TimeInterval
+    }
+
+    /// The maximum number of tokens each host's bucket may hold.
+    public let capacity: Double
+
+    /// The number of tokens deposited by each request attempt.
+    public let depositPerAttempt: Double
+
+    /// The number of tokens deposited into each bucket per second, regardless of traffic.
+    public let minimumRetriesPerSecond: Double
+
+    private let now: () -> TimeInterval
+    private let buckets = Protected<[String: Bucket]>([:])
+
+    /// Creates an instance from the specified parameters.
+    ///
+    /// - Parameters:
+    ///   - capacity:                The maximum number of tokens per host, which is also the initial balance. `10` by
+    ///                              default.
+    ///   - depositPerAttempt:       The number of tokens each request attempt deposits. `0.1` by default, allowing
+    ///                              roughly one retry per ten requests.
+    ///   - minimumRetriesPerSecond: The number of tokens deposited per second regardless of traffic. `1` by default.
+    ///   - now:                     Closure returning the current time, in seconds. Monotonic system uptime by default.
+    public init(capacity: Double = 10,
+                depositPerAttempt: Double = 0.1,
+                minimumRetriesPerSecond: Double = 1,
+                now: @escaping () -> TimeInterval = { ProcessInfo.processInfo.systemUptime }) {
+        precondition(capacity >= 1, "The `capacity` must be a minimum of 1.")
+
+        self.capacity = capacity
+        self.depositPerAttempt = depositPerAttempt
+        self.minimumRetriesPerSecond = minimumRetriesPerSecond
+        self.now = now
+    }
+
+    /// Current token balance of the provided host.
+    ///
+    /// - Parameter host: The host to inspect.
+    ///
+    /// - Returns:        The number of tokens available.
+    public func balance(for host: String) -> Double {
+        buckets.write { refilledBucket(for: host, in: &$0).tokens }
+    }
+
+    /// Deposits `depositPerAttempt` tokens into the provided host's bucket.
+    ///
+    /// - Parameter host: The host of the request attempt.
+    public func deposit(for host: String) {
+        buckets.write { buckets in
+            var bucket = refilledBucket(for: host, in: &buckets)
+            bucket.tokens = min(capacity, bucket.tokens + depositPerAttempt)
+            buckets[host] = bucket
+        }
+    }
+
+    /// Withdraws a single token from the provided host's bucket, if available.
+    ///
+    /// - Parameter host: The host of the request to retry.
+    ///
+    /// - Returns:        `true` if the retry may proceed, `false` if the budget is exhausted.
+    public func withdraw(for host: String) -> Bool {
+        buckets.write { buckets -> Bool in
+            var bucket = refilledBucket(for: host, in: &buckets)
+            guard bucket.tokens >= 1 else { return false }
+
+            bucket.tokens -= 1
+            buckets[host] = bucket
+
+            return true
+        }
+    }
+
+    private func refilledBucket(for host: String, in buckets: inout [String: Bucket]) -> Bucket {
+        let time = now()
+        var bucket = buckets[host] ?? Bucket(tokens: capacity, lastRefill: time)
+        bucket.tokens = min(capacity, bucket.tokens + max(0, time - bucket.lastRefill) * minimumRetriesPerSecond)
+        bucket.lastRefill = time
+        buckets[host] = bucket
+
+        return bucket
+    }
+}
+
+// MARK: - CircuitBreaker
+
+/// A per-host circuit breaker failing requests immediately while their host keeps failing.
+///
+/// A host's circuit opens once `failureThreshold` retryable failures are recorded within `failureWindow`. Requests to
+/// an open host fail with `OpenCircuitError` for `cooldown`, after which the circuit is half-open: up to
+/// `maximumProbes` requests may go through for another `cooldown`. Any failure during that period reopens the
+/// circuit, otherwise it closes again.
+public final class CircuitBreaker {
+    /// State of a host's circuit.
+    public enum State: Equatable {
+        /// Requests go through.
+        case closed
+        /// Requests fail immediately.
+        case open
+        /// A limited number of probe requests go through.
+        case halfOpen
+    }
+
+    /// Error produced when adapting a request to a host whose circuit is open.
+    public struct OpenCircuitError: Error {
+        /// The host whose circuit is open.
+        public let host: String
+    }
+
+    private struct Circuit {
+        var state: State = .closed
+        var failureCount = 0
+        var windowStart: TimeInterval = 0
+        var stateDeadline: TimeInterval = 0
+        var probes = 0
+    }
+
+    /// The number of failures within `failureWindow` opening a host's circuit.
+    public let failureThreshold: Int
+
+    /// The duration, in seconds, over which failures are counted.
+    public let failureWindow: TimeInterval
+
+    /// The duration, in seconds, of both the open and half-open states.
+    public let cooldown: TimeInterval
+
+    /// The number of requests allowed through while half-open.
+    public let maximumProbes: Int
+
+    private let now: () -> TimeInterval
+    private let circuits = Protected<[String: Circuit]>([:])
+
+    /// Creates an instance from the specified parameters.
+    ///
+    /// - Parameters:
+    ///   - failureThreshold: The number of failures within `failureWindow` opening a circuit. `5` by default.
+    ///   - failureWindow:    The duration over which failures are counted. `10` seconds by default.
+    ///   - cooldown:         The duration of the open and half-open states. `30` seconds by default.
+    ///   - maximumProbes:    The number of requests allowed through while half-open. `1` by default.
+    ///   - now:              Closure returning the current time, in seconds. Monotonic system uptime by default.
+    public init(failureThreshold: Int = 5,
+                failureWindow: TimeInterval = 10,
+                cooldown: TimeInterval = 30,
+                maximumProbes: Int = 1,
+                now: @escaping () -> TimeInterval = { ProcessInfo.processInfo.systemUptime }) {
+        precondition(failureThreshold >= 1, "The `failureThreshold` must be a minimum of 1.")
+
+        self.failureThreshold = failureThreshold
+        self.failureWindow = failureWindow
+        self.cooldown = cooldown
+        self.maximumProbes = maximumProbes
+        self.now = now
+    }
+
+    /// Current state of the provided host's circuit.
+    ///
+    /// - Parameter host: The host to inspect.
+    ///
+    /// - Returns:        The `State` of the circuit.
+    public func state(for host: String) -> State {
+        circuits.write { advancedCircuit(for: host, in: &$0).state }
+    }
+
+    /// Returns whether the provided host's circuit is open.
+    ///
+    /// - Parameter host: The host to inspect.
+    ///
+    /// - Returns:        `true` if requests to `host` currently fail immediately.
+    public func isOpen(for host: String) -> Bool {
+        state(for: host) == .open
+    }
+
+    /// Returns whether a new request to the provided host may go through, counting it as a probe when half-open.
+    ///
+    /// - Parameter host: The host of the request.
+    ///
+    /// - Returns:        `true` if the request may go through.
+    public func allowsRequest(to host: String) -> Bool {
+        circuits.write { circuits -> Bool in
+            var circuit = advancedCircuit(for: host, in: &circuits)
+
+            switch circuit.state {
+            case .closed:
+                return true
+            case .open:
+                return false
+            case .halfOpen:
+                guard circuit.probes < maximumProbes else { return false }
+
+                circuit.probes += 1
+                circuits[host] = circuit
+
+                return true
+            }
+        }
+    }
+
+    /// Records a retryable failure of a request to the provided host.
+    ///
+    /// - Parameter host: The host of the failed request.
+    public func recordFailure(for host: String) {
+        circuits.write { circuits in
+            var circuit = advancedCircuit(for: host, in: &circuits)
+            let time = now()
+
+            switch circuit.state {
+            case .closed:
+                if time - circuit.windowStart > failureWindow {
+                    circuit.windowStart = time
+                    circuit.failureCount = 0
+                }
+
+                circuit.failureCount += 1
+                if circuit.failureCount >= failureThreshold {
+                    circuit.state = .open
+                    circuit.stateDeadline = time + cooldown
+                }
+            case .halfOpen:
+                circuit.state = .open
+                circuit.stateDeadline = time + cooldown
+            case .open:
+                break
+            }
+
+            circuits[host] = circuit
+        }
+    }
+
+    /// Moves the host's circuit through any state whose deadline has passed.
+    private func advancedCircuit(for host: String, in circuits: inout [String: Circuit]) -> Circuit {
+        let time = now()
+        var circuit = circuits[host] ?? Circuit()
+
+        if circuit.state == .open, time >= circuit.stateDeadline {
+            circuit.state = .halfOpen
+            circuit.stateDeadline = time + cooldown
+            circuit.probes = 0
+        }
+
+        if circuit.state == .halfOpen, time >= circuit.stateDeadline {
+            circuit = Circuit()
+        }
+
+        circuits[host] = circuit
+
+        return circuit
+    }
+}
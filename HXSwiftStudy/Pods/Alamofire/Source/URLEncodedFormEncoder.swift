@@ -204,6 +204,14 @@ public final class URLEncodedFormEncoder {
             }
         }
 
+        /// Whether `encode(_:)` always produces the same output for the same key, so results may be cached.
+        var isCacheable: Bool {
+            switch self {
+            case .useDefaultKeys, .custom: return false
+            case .convertToSnakeCase, .convertToKebabCase, .capitalized, .uppercased, .lowercased: return true
+            }
+        }
+
         private func convertToSnakeCase(_ key: String) -> String {
             convert(key, usingSeparator: "_")
         }
@@ -321,6 +329,9 @@ public final class URLEncodedFormEncoder {
     /// The `CharacterSet` of allowed (non-escaped) characters.
     public var allowedCharacters: CharacterSet
 
+    /// Keys converted by `keyEncoding`, reused across encodings since the same model keys are encoded repeatedly.
+    private let encodedKeys = Protected<[String: String]>([:])
+
     /// Creates an instance from the supplied parameters.
     ///
     /// - Parameters:
@@ -369,22 +380,54 @@ public final class URLEncodedFormEncoder {
     /// - Returns:         The encoded `String`.
     /// - Throws:          An `Error` or `EncodingError` instance if encoding fails.
     public func encode(_ value: Encodable) throws -> String {
+        let serializer = URLEncodedFormSerializer(alphabetizeKeyValuePairs: alphabetizeKeyValuePairs,
+                                                  arrayEncoding: arrayEncoding,
+                                                  keyEncoding: keyEncoding,
+                                                  spaceEncoding: spaceEncoding,
+                                                  allowedCharacters: allowedCharacters,
+                                                  encodedKeys: keyEncoding.isCacheable ? encodedKeys : nil)
+
+        if let pairs = try encodeFlat(value) {
+            return serializer.serialize(pairs)
+        }
+
         let component: URLEncodedFormComponent = try encode(value)
 
         guard case let .object(object) = component else {
             throw Error.invalidRootObject("\(component)")
         }
 
-        let serializer = URLEncodedFormSerializer(alphabetizeKeyValuePairs: alphabetizeKeyValuePairs,
-                                                  arrayEncoding: arrayEncoding,
-                                                  keyEncoding: keyEncoding,
-                                                  spaceEncoding: spaceEncoding,
-                                                  allowedCharacters: allowedCharacters)
         let query = serializer.serialize(object)
 
         return query
     }
 
+    /// Encodes values made of a single keyed container of scalar values, such as typical query models, directly into
+    /// key value pairs without building a `URLEncodedFormComponent` tree.
+    ///
+    /// - Note: When this returns `nil`, `encode(_:)` calls `value.encode(to:)` a second time with the general encoder,
+    ///         so `encode(to:)` implementations must not have side effects. The flat pass stops at the first value it
+    ///         doesn't support, which for nested values is usually the first nested container, so the wasted work is
+    ///         at most one pass over the scalars preceding it.
+    ///
+    /// - Parameter value: The `Encodable` value.
+    ///
+    /// - Returns:         The pairs in encoding order, or `nil` if `value` requires the general encoder.
+    /// - Throws:          Any `Error` thrown by `value` or the configured encodings.
+    func encodeFlat(_ value: Encodable) throws -> [(key: String, value: String)]? {
+        let encoder = _URLEncodedFormFlatEncoder(mode: .root,
+                                                 boolEncoding: boolEncoding,
+                                                 dataEncoding: dataEncoding,
+                                                 dateEncoding: dateEncoding)
+        do {
+            try value.encode(to: encoder)
+        } catch is _URLEncodedFormFlatEncoder.Unavailable {
+            return nil
+        }
+
+        return encoder.pairs
+    }
+
     /// Encodes the value as `Data`. This is performed by first creating an encoded `String` and then returning the
     /// `.utf8` data.
     ///
@@ -881,23 +924,351 @@ extension _URLEncodedFormEncoder.UnkeyedContainer: UnkeyedEncodingContainer {
     }
 }
 
+// MARK: - Flat Encoding
+
+/// `Encoder` which writes a root keyed container of scalar values directly into key value pairs.
+///
+/// Anything which would produce nested components in `_URLEncodedFormEncoder`, such as arrays, nested containers, `nil`
+/// values or repeated keys, throws `Unavailable` so the caller can fall back to the general encoder. Scalars are
+/// converted exactly as `_URLEncodedFormEncoder.SingleValueContainer` converts them, so both paths produce the same
+/// output.
+final class _URLEncodedFormFlatEncoder {
+    /// Thrown when the value being encoded requires the general encoder.
+    struct Unavailable: Swift.Error {}
+
+    enum Mode {
+        /// Encodes the root keyed container into `pairs`.
+        case root
+        /// Encodes a single value into `scalar`.
+        case scalar
+        /// Encodes nothing.
+        case unavailable
+    }
+
+    var codingPath: [CodingKey] = []
+    // Returns an empty dictionary, as this encoder doesn't support userInfo.
+    var userInfo: [CodingUserInfoKey: Any] { [:] }
+
+    private(set) var pairs: [(key: String, value: String)] = []
+    private(set) var scalar: String?
+
+    private let mode: Mode
+    private var keys: Set<String> = []
+    private let boolEncoding: URLEncodedFormEncoder.BoolEncoding
+    private let dataEncoding: URLEncodedFormEncoder.DataEncoding
+    private let dateEncoding: URLEncodedFormEncoder.DateEncoding
+
+    init(mode: Mode,
+         boolEncoding: URLEncodedFormEncoder.BoolEncoding,
+         dataEncoding: URLEncodedFormEncoder.DataEncoding,
+         dateEncoding: URLEncodedFormEncoder.DateEncoding) {
+        self.mode = mode
+        self.boolEncoding = boolEncoding
+        self.dataEncoding = dataEncoding
+        self.dateEncoding = dateEncoding
+    }
+
+    func append(_ value: String, forKey key: String) throws {
+        guard keys.insert(key).inserted else { throw Unavailable() }
+
+        pairs.append((key: key, value: value))
+    }
+
+    func setScalar(_ value: String) throws {
+        guard scalar == nil else { throw Unavailable() }
+
+        scalar = value
+    }
+
+    /// Converts `value` to its encoded `String`, or throws `Unavailable` if it isn't a single value.
+    func string<T>(for value: T) throws -> String where T: Encodable {
+        switch value {
+        case let string as String:
+            return string
+        case let bool as Bool:
+            return boolEncoding.encode(bool)
+        // Bind the unwrapped value, as `value` may be an `Optional` and would be described as `Optional(…)`.
+        case let int as Int:
+            return String(int)
+        case let int8 as Int8:
+            return String(int8)
+        case let int16 as Int16:
+            return String(int16)
+        case let int32 as Int32:
+            return String(int32)
+        case let int64 as Int64:
+            return String(int64)
+        case let uint as UInt:
+            return String(uint)
+        case let uint8 as UInt8:
+            return String(uint8)
+        case let uint16 as UInt16:
+            return String(uint16)
+        case let uint32 as UInt32:
+            return String(uint32)
+        case let uint64 as UInt64:
+            return String(uint64)
+        case let double as Double:
+            return String(double)
+        case let float as Float:
+            return String(float)
+        case let date as Date:
+            return try dateEncoding.encode(date) ?? scalarEncoding(of: value)
+        case let data as Data:
+            return try dataEncoding.encode(data) ?? scalarEncoding(of: value)
+        case let decimal as Decimal:
+            return String(describing: decimal)
+        default:
+            return try scalarEncoding(of: value)
+        }
+    }
+
+    /// Lets `value` encode itself, which succeeds for types such as `RawRepresentable` enums that encode through a
+    /// single value container.
+    private func scalarEncoding<T>(of value: T) throws -> String where T: Encodable {
+        let encoder = _URLEncodedFormFlatEncoder(mode: .scalar,
+                                                 boolEncoding: boolEncoding,
+                                                 dataEncoding: dataEncoding,
+                                                 dateEncoding: dateEncoding)
+        try value.encode(to: encoder)
+
+        guard let scalar = encoder.scalar else { throw Unavailable() }
+
+        return scalar
+    }
+
+    fileprivate func unavailableEncoder() -> Encoder {
+        _URLEncodedFormFlatEncoder(mode: .unavailable,
+                                   boolEncoding: boolEncoding,
+                                   dataEncoding: dataEncoding,
+                                   dateEncoding: dateEncoding)
+    }
+}
+
+extension _URLEncodedFormFlatEncoder: Encoder {
+    func container<Key>(keyedBy type: Key.Type) -> KeyedEncodingContainer<Key> where Key: CodingKey {
+        guard case .root = mode else { return KeyedEncodingContainer(UnavailableContainer<Key>(encoder: self)) }
+
+        return KeyedEncodingContainer(KeyedContainer<Key>(encoder: self))
+    }
+
+    func unkeyedContainer() -> UnkeyedEncodingContainer {
+        UnavailableContainer<AnyCodingKey>(encoder: self)
+    }
+
+    func singleValueContainer() -> SingleValueEncodingContainer {
+        guard case .scalar = mode else { return UnavailableContainer<AnyCodingKey>(encoder: self) }
+
+        return SingleValueContainer(encoder: self)
+    }
+}
+
+extension _URLEncodedFormFlatEncoder {
+    final class KeyedContainer<Key> where Key: CodingKey {
+        var codingPath: [CodingKey] { encoder.codingPath }
+
+        private let encoder: _URLEncodedFormFlatEncoder
+
+        init(encoder: _URLEncodedFormFlatEncoder) {
+            self.encoder = encoder
+        }
+    }
+
+    final class SingleValueContainer {
+        var codingPath: [CodingKey] { encoder.codingPath }
+
+        private let encoder: _URLEncodedFormFlatEncoder
+
+        init(encoder: _URLEncodedFormFlatEncoder) {
+            self.encoder = encoder
+        }
+    }
+
+    /// Container returned for anything the flat encoder doesn't support. Every encoding throws `Unavailable`.
+    final class UnavailableContainer<Key> where Key: CodingKey {
+        var codingPath: [CodingKey] { encoder.codingPath }
+        var count: Int { 0 }
+
+        private let encoder: _URLEncodedFormFlatEncoder
+
+        init(encoder: _URLEncodedFormFlatEncoder) {
+            self.encoder = encoder
+        }
+    }
+}
+
+extension _URLEncodedFormFlatEncoder.KeyedContainer: KeyedEncodingContainerProtocol {
+    func encodeNil(forKey key: Key) throws {
+        throw _URLEncodedFormFlatEncoder.Unavailable()
+    }
+
+    func encode<T>(_ value: T, forKey key: Key) throws where T: Encodable {
+        try encoder.append(try encoder.string(for: value), forKey: key.stringValue)
+    }
+
+    func nestedContainer<NestedKey>(keyedBy keyType: NestedKey.Type, forKey key: Key) -> KeyedEncodingContainer<NestedKey> where NestedKey: CodingKey {
+        KeyedEncodingContainer(_URLEncodedFormFlatEncoder.UnavailableContainer<NestedKey>(encoder: encoder))
+    }
+
+    func nestedUnkeyedContainer(forKey key: Key) -> UnkeyedEncodingContainer {
+        _URLEncodedFormFlatEncoder.UnavailableContainer<AnyCodingKey>(encoder: encoder)
+    }
+
+    func superEncoder() -> Encoder {
+        encoder.unavailableEncoder()
+    }
+
+    func superEncoder(forKey key: Key) -> Encoder {
+        encoder.unavailableEncoder()
+    }
+}
+
+extension _URLEncodedFormFlatEncoder.SingleValueContainer: SingleValueEncodingContainer {
+    func encodeNil() throws {
+        throw _URLEncodedFormFlatEncoder.Unavailable()
+    }
+
+    func encode(_ value: Bool) throws { try encoder.setScalar(try encoder.string(for: value)) }
+    func encode(_ value: String) throws { try encoder.setScalar(value) }
+    func encode(_ value: Double) throws { try encoder.setScalar(String(value)) }
+    func encode(_ value: Float) throws { try encoder.setScalar(String(value)) }
+    func encode(_ value: Int) throws { try encoder.setScalar(String(value)) }
+    func encode(_ value: Int8) throws { try encoder.setScalar(String(value)) }
+    func encode(_ value: Int16) throws { try encoder.setScalar(String(value)) }
+    func encode(_ value: Int32) throws { try encoder.setScalar(String(value)) }
+    func encode(_ value: Int64) throws { try encoder.setScalar(String(value)) }
+    func encode(_ value: UInt) throws { try encoder.setScalar(String(value)) }
+    func encode(_ value: UInt8) throws { try encoder.setScalar(String(value)) }
+    func encode(_ value: UInt16) throws { try encoder.setScalar(String(value)) }
+    func encode(_ value: UInt32) throws { try encoder.setScalar(String(value)) }
+    func encode(_ value: UInt64) throws { try encoder.setScalar(String(value)) }
+
+    func encode<T>(_ value: T) throws where T: Encodable {
+        try encoder.setScalar(try encoder.string(for: value))
+    }
+}
+
+extension _URLEncodedFormFlatEncoder.UnavailableContainer: KeyedEncodingContainerProtocol {
+    func encodeNil(forKey key: Key) throws {
+        throw _URLEncodedFormFlatEncoder.Unavailable()
+    }
+
+    func encode<T>(_ value: T, forKey key: Key) throws where T: Encodable {
+        throw _URLEncodedFormFlatEncoder.Unavailable()
+    }
+
+    func nestedContainer<NestedKey>(keyedBy keyType: NestedKey.Type, forKey key: Key) -> KeyedEncodingContainer<NestedKey> where NestedKey: CodingKey {
+        KeyedEncodingContainer(_URLEncodedFormFlatEncoder.UnavailableContainer<NestedKey>(encoder: encoder))
+    }
+
+    func nestedUnkeyedContainer(forKey key: Key) -> UnkeyedEncodingContainer {
+        self
+    }
+
+    func superEncoder(forKey key: Key) -> Encoder {
+        encoder.unavailableEncoder()
+    }
+}
+
+extension _URLEncodedFormFlatEncoder.UnavailableContainer: UnkeyedEncodingContainer {
+    func encodeNil() throws {
+        throw _URLEncodedFormFlatEncoder.Unavailable()
+    }
+
+    func nestedContainer<NestedKey>(keyedBy keyType: NestedKey.Type) -> KeyedEncodingContainer<NestedKey> where NestedKey: CodingKey {
+        KeyedEncodingContainer(_URLEncodedFormFlatEncoder.UnavailableContainer<NestedKey>(encoder: encoder))
+    }
+
+    func nestedUnkeyedContainer() -> UnkeyedEncodingContainer {
+        self
+    }
+
+    func superEncoder() -> Encoder {
+        encoder.unavailableEncoder()
+    }
+}
+
+extension _URLEncodedFormFlatEncoder.UnavailableContainer: SingleValueEncodingContainer {
+    func encode(_ value: Bool) throws { throw _URLEncodedFormFlatEncoder.Unavailable() }
+    func encode(_ value: String) throws { throw _URLEncodedFormFlatEncoder.Unavailable() }
+    func encode(_ value: Double) throws { throw _URLEncodedFormFlatEncoder.Unavailable() }
+    func encode(_ value: Float) throws { throw _URLEncodedFormFlatEncoder.Unavailable() }
+    func encode(_ value: Int) throws { throw _URLEncodedFormFlatEncoder.Unavailable() }
+    func encode(_ value: Int8) throws { throw _URLEncodedFormFlatEncoder.Unavailable() }
+    func encode(_ value: Int16) throws { throw _URLEncodedFormFlatEncoder.Unavailable() }
+    func encode(_ value: Int32) throws { throw _URLEncodedFormFlatEncoder.Unavailable() }
+    func encode(_ value: Int64) throws { throw _URLEncodedFormFlatEncoder.Unavailable() }
+    func encode(_ value: UInt) throws { throw _URLEncodedFormFlatEncoder.Unavailable() }
+    func encode(_ value: UInt8) throws { throw _URLEncodedFormFlatEncoder.Unavailable() }
+    func encode(_ value: UInt16) throws { throw _URLEncodedFormFlatEncoder.Unavailable() }
+    func encode(_ value: UInt32) throws { throw _URLEncodedFormFlatEncoder.Unavailable() }
+    func encode(_ value: UInt64) throws { throw _URLEncodedFormFlatEncoder.Unavailable() }
+
+    func encode<T>(_ value: T) throws where T: Encodable {
+        throw _URLEncodedFormFlatEncoder.Unavailable()
+    }
+}
+
 final class URLEncodedFormSerializer {
+    /// Number of converted keys retained by the encoder before the cache is reset.
+    private static let encodedKeysLimit = 512
+
     private let alphabetizeKeyValuePairs: Bool
     private let arrayEncoding: URLEncodedFormEncoder.ArrayEncoding
     private let keyEncoding: URLEncodedFormEncoder.KeyEncoding
     private let spaceEncoding: URLEncodedFormEncoder.SpaceEncoding
-    private let allowedCharacters: CharacterSet
+    private let allowedCharactersWithSpace: CharacterSet
+    private let encodedKeys: Protected<[String: String]>?
 
     init(alphabetizeKeyValuePairs: Bool,
          arrayEncoding: URLEncodedFormEncoder.ArrayEncoding,
          keyEncoding: URLEncodedFormEncoder.KeyEncoding,
          spaceEncoding: URLEncodedFormEncoder.SpaceEncoding,
-         allowedCharacters: CharacterSet) {
+         allowedCharacters: CharacterSet,
+         encodedKeys: Protected<[String: String]>? = nil) {
         self.alphabetizeKeyValuePairs = alphabetizeKeyValuePairs
         self.arrayEncoding = arrayEncoding
         self.keyEncoding = keyEncoding
         self.spaceEncoding = spaceEncoding
-        self.allowedCharacters = allowedCharacters
+        self.encodedKeys = encodedKeys
+
+        var allowedCharactersWithSpace = allowedCharacters
+        allowedCharactersWithSpace.insert(charactersIn: " ")
+        self.allowedCharactersWithSpace = allowedCharactersWithSpace
+    }
+
+    /// Serializes flat key value pairs, producing the same output as serializing an `Object` of `.string` components.
+    func serialize(_ pairs: [(key: String, value: String)]) -> String {
+        guard !alphabetizeKeyValuePairs else {
+            return pairs.map { "\(escape(encode($0.key)))=\(escape($0.value))" }.sorted().joinedWithAmpersands()
+        }
+
+        var output = ""
+        for (index, pair) in pairs.enumerated() {
+            if index > 0 { output.append("&") }
+            output.append(escape(encode(pair.key)))
+            output.append("=")
+            output.append(escape(pair.value))
+        }
+
+        return output
+    }
+
+    /// Applies the `keyEncoding` to `key`, using previously converted keys when available.
+    func encode(_ key: String) -> String {
+        guard let encodedKeys = encodedKeys else { return keyEncoding.encode(key) }
+
+        if let encodedKey = encodedKeys.read({ $0[key] }) {
+            return encodedKey
+        }
+
+        let encodedKey = keyEncoding.encode(key)
+        encodedKeys.write { keys in
+            if keys.count >= Self.encodedKeysLimit { keys.removeAll(keepingCapacity: true) }
+            keys[key] = encodedKey
+        }
+
+        return encodedKey
     }
 
     func serialize(_ object: URLEncodedFormComponent.Object) -> String {
@@ -913,7 +1284,7 @@ final class URLEncodedFormSerializer {
 
     func serialize(_ component: URLEncodedFormComponent, forKey key: String) -> String {
         switch component {
-        case let .string(string): return "\(escape(keyEncoding.encode(key)))=\(escape(string))"
+        case let .string(string): return "\(escape(encode(key)))=\(escape(string))"
         case let .array(array): return serialize(array, forKey: key)
         case let .object(object): return serialize(object, forKey: key)
         }
@@ -940,8 +1311,6 @@ final class URLEncodedFormSerializer {
     }
 
     func escape(_ query: String) -> String {
-        var allowedCharactersWithSpace = allowedCharacters
-        allowedCharactersWithSpace.insert(charactersIn: " ")
         let escapedQuery = query.addingPercentEncoding(withAllowedCharacters: allowedCharactersWithSpace) ?? query
         let spaceEncodedQuery = spaceEncoding.encode(escapedQuery)
 
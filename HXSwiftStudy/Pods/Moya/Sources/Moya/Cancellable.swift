@@ -24,3 +24,28 @@ internal class SimpleCancellable: Cancellable {
         isCancelled = true
     }
 }
+
+internal class InflightCancellable: Cancellable {
+    private let lock = NSLock()
+    private var cancelAction: (() -> Void)?
+    private var cancelled = false
+
+    var isCancelled: Bool {
+        lock.lock(); defer { lock.unlock() }
+        return cancelled
+    }
+
+    init(cancelAction: @escaping () -> Void) {
+        self.cancelAction = cancelAction
+    }
+
+    internal func cancel() {
+        lock.lock()
+        let action = cancelled ? nil : cancelAction
+        cancelled = true
+        cancelAction = nil
+        lock.unlock()
+
+        action?()
+    }
+}
@@ -30,21 +30,38 @@ public extension MoyaProvider {
             completion(processedResult)
         }
 
+        var inflight: InflightRequest?
+        var callerToken: Cancellable = cancellableToken
+
         if trackInflights {
-            var inflightCompletionBlocks = self.inflightRequests[endpoint]
-            inflightCompletionBlocks?.append(pluginsWithCompletion)
-            self.internalInflightRequests[endpoint] = inflightCompletionBlocks
+            lock.lock()
+            if let existing = internalInflightRequests[endpoint] {
+                let token = joinInflight(existing, endpoint: endpoint, target: target, callbackQueue: callbackQueue, completion: pluginsWithCompletion)
+                lock.unlock()
+                return token
+            }
 
-            if inflightCompletionBlocks != nil {
-                return cancellableToken
+            let created = InflightRequest(cancellable: cancellableToken, callbackQueue: callbackQueue)
+            callerToken = joinInflight(created, endpoint: endpoint, target: target, callbackQueue: callbackQueue, completion: pluginsWithCompletion)
+            internalInflightRequests[endpoint] = created
+            inflight = created
+            lock.unlock()
+        }
+
+        let networkCompletion: Moya.Completion = { result in
+            if let inflight = inflight {
+                self.completeInflight(inflight, endpoint: endpoint, with: result)
             } else {
-                self.internalInflightRequests[endpoint] = [pluginsWithCompletion]
+                pluginsWithCompletion(result)
             }
         }
 
         let performNetworking = { (requestResult: Result<URLRequest, MoyaError>) in
             if cancellableToken.isCancelled {
-                self.cancelCompletion(pluginsWithCompletion, target: target)
+                // Cancelled shared requests have already notified each of their callers.
+                if inflight == nil {
+                    self.cancelCompletion(pluginsWithCompletion, target: target)
+                }
                 return
             }
 
@@ -54,25 +71,53 @@ public extension MoyaProvider {
             case .success(let urlRequest):
                 request = urlRequest
             case .failure(let error):
-                pluginsWithCompletion(.failure(error))
+                networkCompletion(.failure(error))
                 return
             }
 
-            let networkCompletion: Moya.Completion = { result in
-              if self.trackInflights {
-                self.inflightRequests[endpoint]?.forEach { $0(result) }
+            cancellableToken.innerCancellable = self.performRequest(target, request: request, callbackQueue: callbackQueue, progress: progress, completion: networkCompletion, endpoint: endpoint, stubBehavior: stubBehavior)
+        }
+
+        requestClosure(endpoint, performNetworking)
+
+        return callerToken
+    }
+
+    /// Adds a caller to a shared request. Must be called while holding `lock`.
+    private func joinInflight(_ inflight: InflightRequest, endpoint: Endpoint, target: Target, callbackQueue: DispatchQueue?, completion: @escaping Moya.Completion) -> Cancellable {
+        let id = inflight.addWaiter(callbackQueue: callbackQueue, completion: completion)
+
+        return InflightCancellable { [weak self, weak inflight] in
+            guard let self = self, let inflight = inflight else { return }
+
+            self.lock.lock()
+            let waiter = inflight.removeWaiter(id)
+            let isLastWaiter = waiter != nil && inflight.waiters.isEmpty
+            if isLastWaiter, self.internalInflightRequests[endpoint] === inflight {
                 self.internalInflightRequests.removeValue(forKey: endpoint)
-              } else {
-                pluginsWithCompletion(result)
-              }
             }
+            self.lock.unlock()
 
-            cancellableToken.innerCancellable = self.performRequest(target, request: request, callbackQueue: callbackQueue, progress: progress, completion: networkCompletion, endpoint: endpoint, stubBehavior: stubBehavior)
+            guard let cancelledWaiter = waiter else { return }
+
+            inflight.deliver(to: cancelledWaiter) { self.cancelCompletion($0, target: target) }
+            if isLastWaiter {
+                inflight.cancellable.cancel()
+            }
         }
+    }
 
-        requestClosure(endpoint, performNetworking)
+    /// Fans the result of a shared request out to all of its remaining callers.
+    private func completeInflight(_ inflight: InflightRequest, endpoint: Endpoint, with result: Result<Moya.Response, MoyaError>) {
+        lock.lock()
+        let waiters = inflight.waiters
+        inflight.waiters = []
+        if internalInflightRequests[endpoint] === inflight {
+            internalInflightRequests.removeValue(forKey: endpoint)
+        }
+        lock.unlock()
 
-        return cancellableToken
+        waiters.forEach { waiter in inflight.deliver(to: waiter) { $0(result) } }
     }
 
     // swiftlint:disable:next function_parameter_count
@@ -278,3 +323,52 @@ private extension MoyaProvider {
         return CancellableToken(request: progressAlamoRequest)
     }
 }
+
+// MARK: - Inflight requests
+
+/// A request shared by every caller of an `Endpoint` while `trackInflights` is enabled.
+final class InflightRequest {
+    struct Waiter {
+        let id: Int
+        let callbackQueue: DispatchQueue?
+        let completion: Moya.Completion
+    }
+
+    /// The token cancelling the underlying request.
+    let cancellable: Cancellable
+
+    /// The callback queue of the caller that started the request, on which its result is produced.
+    let callbackQueue: DispatchQueue?
+
+    var waiters: [Waiter] = []
+    private var nextID = 0
+
+    init(cancellable: Cancellable, callbackQueue: DispatchQueue?) {
+        self.cancellable = cancellable
+        self.callbackQueue = callbackQueue
+    }
+
+    func addWaiter(callbackQueue: DispatchQueue?, completion: @escaping Moya.Completion) -> Int {
+        nextID += 1
+        waiters.append(Waiter(id: nextID, callbackQueue: callbackQueue, completion: completion))
+        return nextID
+    }
+
+    func removeWaiter(_ id: Int) -> Waiter? {
+        guard let index = waiters.firstIndex(where: { $0.id == id }) else { return nil }
+        return waiters.remove(at: index)
+    }
+
+    /// Calls `body` with the waiter's completion, hopping to the waiter's callback queue when it differs from the one
+    /// the shared result is produced on.
+    func deliver(to waiter: Waiter, _ body: @escaping (Moya.Completion) -> Void) {
+        switch (waiter.callbackQueue, callbackQueue) {
+        case let (.some(queue), .some(producingQueue)) where queue === producingQueue:
+            body(waiter.completion)
+        case (.none, .none):
+            body(waiter.completion)
+        case let (queue, _):
+            (queue ?? .main).async { body(waiter.completion) }
+        }
+    }
+}
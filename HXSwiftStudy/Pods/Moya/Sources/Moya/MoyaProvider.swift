@@ -79,12 +79,19 @@ open class MoyaProvider<Target: TargetType>: MoyaProviderType {
     /// e.g. for logging, network activity indicator or credentials.
     public let plugins: [PluginType]
 
+    /// Whether requests for an `Endpoint` already in flight join that request instead of starting a new one.
+    /// Every caller receives the shared response and its own `Cancellable`; the shared request is only cancelled
+    /// once all of its callers have cancelled.
     public let trackInflights: Bool
 
-    open var inflightRequests: [Endpoint: [Moya.Completion]] { internalInflightRequests }
+    open var inflightRequests: [Endpoint: [Moya.Completion]] {
+        lock.lock(); defer { lock.unlock() }
+        return internalInflightRequests.mapValues { $0.waiters.map { $0.completion } }
+    }
 
+    /// In-flight shared requests, keyed by `Endpoint`. Compound updates are guarded by `lock`.
     @Atomic
-    var internalInflightRequests: [Endpoint: [Moya.Completion]] = [:]
+    var internalInflightRequests: [Endpoint: InflightRequest] = [:]
 
     /// Propagated to Alamofire as callback queue. If nil - the Alamofire default (as of their API in 2017 - the main queue) will be used.
     let callbackQueue: DispatchQueue?
@@ -13,13 +13,27 @@ public final class NetworkLoggerPlugin {
 
 // MARK: - PluginType
 extension NetworkLoggerPlugin: PluginType {
+    public func prepare(_ request: URLRequest, target: TargetType) -> URLRequest {
+        configuration.recorder?.prepare(request) ?? request
+    }
+
     public func willSend(_ request: RequestType, target: TargetType) {
+        if let recorder = configuration.recorder {
+            recorder.recordRequest(request, target: target, logOptions: configuration.logOptions)
+            return
+        }
+
         logNetworkRequest(request, target: target) { [weak self] output in
             self?.configuration.output(target, output)
         }
     }
 
     public func didReceive(_ result: Result<Moya.Response, MoyaError>, target: TargetType) {
+        if let recorder = configuration.recorder {
+            recorder.recordResult(result, target: target, logOptions: configuration.logOptions)
+            return
+        }
+
         switch result {
         case .success(let response):
             configuration.output(target, logNetworkResponse(response, target: target, isFromError: false))
@@ -127,6 +141,8 @@ public extension NetworkLoggerPlugin {
         public var formatter: Formatter
         public var output: OutputType
         public var logOptions: LogOptions
+        /// When set, structured records are handed to the recorder instead of being formatted and sent to `output`.
+        public var recorder: Recorder?
 
         /// The designated way to instantiate a Configuration.
         ///
@@ -135,12 +151,16 @@ public extension NetworkLoggerPlugin {
         ///   - output: A closure responsible for writing the given log entries into your log system.
         ///                    The default value writes entries to the debug console.
         ///   - logOptions: A set of options you can use to customize which request component is logged.
+        ///   - recorder: A recorder capturing structured records off the calling thread, replacing `formatter`
+        ///               and `output`. `formatRequestAscURL` is ignored in this mode.
         public init(formatter: Formatter = Formatter(),
                     output: @escaping OutputType = defaultOutput,
-                    logOptions: LogOptions = .default) {
+                    logOptions: LogOptions = .default,
+                    recorder: Recorder? = nil) {
             self.formatter = formatter
             self.output = output
             self.logOptions = logOptions
+            self.recorder = recorder
         }
 
         // MARK: - Defaults
@@ -235,3 +255,434 @@ public extension NetworkLoggerPlugin.Configuration {
         }()
     }
 }
+
+// MARK: - Recording
+public extension NetworkLoggerPlugin {
+    /// A structured log record captured without any string formatting.
+    struct Record: Codable {
+        // swiftlint:disable nesting
+        public enum Kind: String, Codable {
+            case request
+            case response
+            case error
+        }
+        // swiftlint:enable nesting
+
+        public var kind: Kind
+        /// Seconds since 1970.
+        public var timestamp: Double
+        public var path: String
+        public var method: String?
+        public var url: String?
+        public var statusCode: Int?
+        public var headers: [String: String]?
+        /// The body, truncated to the recorder's `maximumBodyLength`.
+        public var body: Data?
+        /// The length of the body before truncation.
+        public var bodyLength: Int?
+        public var error: String?
+    }
+
+    /// Captures `Record`s into an in-memory buffer and writes them to rotating files on a background queue.
+    final class Recorder {
+        // swiftlint:disable nesting
+        public enum Format {
+            /// One JSON object per line. Bodies are base64 encoded.
+            case jsonLines
+            /// Length-prefixed binary records, readable with `Recorder.decodeRecords(from:)`.
+            case binary
+        }
+        // swiftlint:enable nesting
+
+        public let directory: URL
+        public let format: Format
+        /// The fraction of requests recorded, between 0 and 1. A request and its response are sampled together,
+        /// except for failures without a response, which are sampled on their own.
+        public let sampleRate: Double
+        public let maximumBodyLength: Int
+        public let maximumFileSize: Int
+        public let maximumFileCount: Int
+        /// The number of records buffered before new ones are dropped.
+        public let bufferCapacity: Int
+        public let flushInterval: TimeInterval
+
+        /// The number of records dropped because the buffer was full.
+        public var droppedRecordCount: Int {
+            lock.lock(); defer { lock.unlock() }
+            return dropped
+        }
+
+        /// The file currently being written to.
+        public var currentFileURL: URL { fileURL(at: 0) }
+
+        private let queue = DispatchQueue(label: "com.moya.networkLoggerPlugin.recorder", qos: .utility)
+        private let lock = NSLock()
+        private var pending: [Record] = []
+        private var dropped = 0
+        private var isFlushScheduled = false
+        private var fileHandle: FileHandle?
+        private var fileSize = 0
+
+        static let binaryMagic = Data("MOYALOG1".utf8)
+
+        /// The `URLProtocol` property holding a request's sampling token, a random number in `0..<1`.
+        static let samplingTokenKey = "com.moya.networkLoggerPlugin.samplingToken"
+
+        /// Creates a recorder.
+        ///
+        /// - Parameters:
+        ///   - directory: The directory receiving the log files.
+        ///   - format: The on-disk format of the records. `.binary` by default.
+        ///   - sampleRate: The fraction of requests recorded. `1` by default.
+        ///   - maximumBodyLength: The number of body bytes kept per record. `1024` by default.
+        ///   - maximumFileSize: The size after which the current file is rotated. 5 MB by default.
+        ///   - maximumFileCount: The number of files kept, including the current one. `3` by default.
+        ///   - bufferCapacity: The number of records buffered before new ones are dropped. `4096` by default.
+        ///   - flushInterval: The delay between the first buffered record and the write. `1` second by default.
+        public init(directory: URL,
+                    format: Format = .binary,
+                    sampleRate: Double = 1,
+                    maximumBodyLength: Int = 1024,
+                    maximumFileSize: Int = 5 * 1024 * 1024,
+                    maximumFileCount: Int = 3,
+                    bufferCapacity: Int = 4096,
+                    flushInterval: TimeInterval = 1) {
+            self.directory = directory
+            self.format = format
+            self.sampleRate = min(max(sampleRate, 0), 1)
+            self.maximumBodyLength = maximumBodyLength
+            self.maximumFileSize = maximumFileSize
+            self.maximumFileCount = max(maximumFileCount, 1)
+            self.bufferCapacity = bufferCapacity
+            self.flushInterval = flushInterval
+        }
+
+        deinit {
+            fileHandle?.closeFile()
+        }
+
+        // MARK: Capturing
+
+        /// Tags the request with a sampling token, which its response carries back in `Response.request`.
+        func prepare(_ request: URLRequest) -> URLRequest {
+            guard sampleRate < 1, URLProtocol.property(forKey: Recorder.samplingTokenKey, in: request) == nil else { return request }
+
+            // swiftlint:disable:next force_cast
+            let taggedRequest = (request as NSURLRequest).mutableCopy() as! NSMutableURLRequest
+            URLProtocol.setProperty(Double.random(in: 0..<1), forKey: Recorder.samplingTokenKey, in: taggedRequest)
+            return taggedRequest as URLRequest
+        }
+
+        func recordRequest(_ request: RequestType, target: TargetType, logOptions: Configuration.LogOptions) {
+            let httpRequest = request.request
+            guard shouldSample(httpRequest) else { return }
+
+            var record = Record(kind: .request, timestamp: Date().timeIntervalSince1970, path: target.path)
+            record.method = httpRequest?.httpMethod
+            record.url = httpRequest?.url?.absoluteString
+
+            if logOptions.contains(.requestHeaders) {
+                var allHeaders = request.sessionHeaders
+                if let httpRequestHeaders = httpRequest?.allHTTPHeaderFields {
+                    allHeaders.merge(httpRequestHeaders) { $1 }
+                }
+                record.headers = allHeaders
+            }
+
+            if logOptions.contains(.requestBody), let body = httpRequest?.httpBody {
+                record.body = body.prefix(maximumBodyLength)
+                record.bodyLength = body.count
+            }
+
+            append(record)
+        }
+
+        func recordResult(_ result: Result<Moya.Response, MoyaError>, target: TargetType, logOptions: Configuration.LogOptions) {
+            let response: Response?
+            let error: MoyaError?
+            switch result {
+            case let .success(value):
+                response = value
+                error = nil
+            case let .failure(value):
+                response = value.response
+                error = value
+            }
+
+            guard shouldSample(response?.request) else { return }
+
+            var record = Record(kind: error == nil ? .response : .error, timestamp: Date().timeIntervalSince1970, path: target.path)
+            record.method = response?.request?.httpMethod
+            record.url = response?.request?.url?.absoluteString
+            record.error = error.map { "\($0)" }
+
+            if let response = response {
+                record.statusCode = response.statusCode
+                if logOptions.contains(.requestHeaders) {
+                    record.headers = response.response?.allHeaderFields as? [String: String]
+                }
+
+                let logsBody = error == nil ? logOptions.contains(.successResponseBody) : logOptions.contains(.errorResponseBody)
+                if logsBody {
+                    record.body = response.data.prefix(maximumBodyLength)
+                    record.bodyLength = response.data.count
+                }
+            }
+
+            append(record)
+        }
+
+        /// Samples by the request's token so that a request and its response get the same answer.
+        private func shouldSample(_ request: URLRequest?) -> Bool {
+            guard sampleRate < 1 else { return true }
+
+            let token = request.flatMap { URLProtocol.property(forKey: Recorder.samplingTokenKey, in: $0) as? Double }
+            return (token ?? Double.random(in: 0..<1)) < sampleRate
+        }
+
+        private func append(_ record: Record) {
+            lock.lock()
+            guard pending.count < bufferCapacity else {
+                dropped += 1
+                lock.unlock()
+                return
+            }
+
+            pending.append(record)
+            let needsFlush = !isFlushScheduled
+            isFlushScheduled = true
+            lock.unlock()
+
+            if needsFlush {
+                queue.asyncAfter(deadline: .now() + flushInterval) { [weak self] in self?.flush() }
+            }
+        }
+
+        // MARK: Writing
+
+        /// Writes all buffered records. Blocks until done.
+        public func flushSynchronously() {
+            queue.sync { flush() }
+        }
+
+        private func flush() {
+            lock.lock()
+            let records = pending
+            pending.removeAll(keepingCapacity: true)
+            isFlushScheduled = false
+            lock.unlock()
+
+            guard !records.isEmpty else { return }
+
+            var data = Data()
+            switch format {
+            case .jsonLines:
+                let encoder = JSONEncoder()
+                for record in records {
+                    guard let line = try? encoder.encode(record) else { continue }
+                    data.append(line)
+                    data.append(0x0A)
+                }
+            case .binary:
+                var writer = BinaryRecordWriter()
+                records.forEach { writer.write($0) }
+                data = writer.data
+            }
+
+            write(data)
+        }
+
+        private func write(_ data: Data) {
+            if fileHandle == nil || fileSize >= maximumFileSize {
+                openFile()
+            }
+            fileHandle?.write(data)
+            fileSize += data.count
+        }
+
+        private func openFile() {
+            let fileManager = FileManager.default
+            fileHandle?.closeFile()
+            fileHandle = nil
+            try? fileManager.createDirectory(at: directory, withIntermediateDirectories: true, attributes: nil)
+
+            let url = currentFileURL
+            let existingSize = (try? fileManager.attributesOfItem(atPath: url.path))?[.size] as? Int
+            if let size = existingSize, size >= maximumFileSize {
+                rotateFiles()
+            }
+
+            if !fileManager.fileExists(atPath: url.path) {
+                fileManager.createFile(atPath: url.path, contents: format == .binary ? Recorder.binaryMagic : nil, attributes: nil)
+            }
+
+            fileHandle = try? FileHandle(forWritingTo: url)
+            fileSize = Int(fileHandle?.seekToEndOfFile() ?? 0)
+        }
+
+        private func rotateFiles() {
+            let fileManager = FileManager.default
+            try? fileManager.removeItem(at: fileURL(at: maximumFileCount - 1))
+            for index in stride(from: maximumFileCount - 2, through: 0, by: -1) {
+                try? fileManager.moveItem(at: fileURL(at: index), to: fileURL(at: index + 1))
+            }
+        }
+
+        private func fileURL(at index: Int) -> URL {
+            let name = index == 0 ? "moya-network.log" : "moya-network.\(index).log"
+            return directory.appendingPathComponent(name)
+        }
+
+        // MARK: Decoding
+
+        /// Decodes the records of a log file written in either format.
+        public static func decodeRecords(from data: Data) throws -> [Record] {
+            if data.starts(with: binaryMagic) {
+                var reader = BinaryRecordReader(data: data.dropFirst(binaryMagic.count))
+                var records = [Record]()
+                while !reader.isAtEnd {
+                    records.append(try reader.readRecord())
+                }
+                return records
+            }
+
+            let decoder = JSONDecoder()
+            return try data.split(separator: 0x0A).map { try decoder.decode(Record.self, from: Data($0)) }
+        }
+    }
+}
+
+private extension NetworkLoggerPlugin.Record {
+    init(kind: Kind, timestamp: Double, path: String) {
+        self.kind = kind
+        self.timestamp = timestamp
+        self.path = path
+    }
+}
+
+// MARK: - Binary format
+
+/// Each record is a little-endian `UInt32` byte count followed by its fields. Optional fields are preceded by a
+/// presence byte; strings and data are `UInt32` length-prefixed.
+private struct BinaryRecordWriter {
+    private(set) var data = Data()
+    private var recordData = Data()
+
+    mutating func write(_ record: NetworkLoggerPlugin.Record) {
+        recordData.removeAll(keepingCapacity: true)
+        append(UInt8(record.kind == .request ? 0 : record.kind == .response ? 1 : 2))
+        append(record.timestamp.bitPattern)
+        append(record.path)
+        appendOptional(record.method) { $0.append($1) }
+        appendOptional(record.url) { $0.append($1) }
+        appendOptional(record.statusCode) { $0.append(Int64($1)) }
+        appendOptional(record.headers) { writer, headers in
+            writer.append(UInt32(headers.count))
+            headers.forEach { writer.append($0.key); writer.append($0.value) }
+        }
+        appendOptional(record.body) { $0.append($1) }
+        appendOptional(record.bodyLength) { $0.append(Int64($1)) }
+        appendOptional(record.error) { $0.append($1) }
+
+        var length = UInt32(recordData.count).littleEndian
+        withUnsafeBytes(of: &length) { data.append(contentsOf: $0) }
+        data.append(recordData)
+    }
+
+    private mutating func appendOptional<T>(_ value: T?, _ body: (inout BinaryRecordWriter, T) -> Void) {
+        guard let value = value else {
+            append(UInt8(0))
+            return
+        }
+        append(UInt8(1))
+        body(&self, value)
+    }
+
+    mutating func append<T: FixedWidthInteger>(_ value: T) {
+        var littleEndian = value.littleEndian
+        withUnsafeBytes(of: &littleEndian) { recordData.append(contentsOf: $0) }
+    }
+
+    mutating func append(_ string: String) {
+        append(Data(string.utf8))
+    }
+
+    mutating func append(_ bytes: Data) {
+        append(UInt32(bytes.count))
+        recordData.append(bytes)
+    }
+}
+
+private struct BinaryRecordReader {
+    struct CorruptedData: Error {}
+
+    let data: Data
+    private var offset: Data.Index
+
+    init(data: Data) {
+        self.data = data
+        self.offset = data.startIndex
+    }
+
+    var isAtEnd: Bool { offset >= data.endIndex }
+
+    mutating func readRecord() throws -> NetworkLoggerPlugin.Record {
+        let length = Int(try read(UInt32.self))
+        let end = offset + length
+        guard end <= data.endIndex else { throw CorruptedData() }
+
+        let kinds: [NetworkLoggerPlugin.Record.Kind] = [.request, .response, .error]
+        let kindIndex = Int(try read(UInt8.self))
+        guard kindIndex < kinds.count else { throw CorruptedData() }
+
+        var record = NetworkLoggerPlugin.Record(kind: kinds[kindIndex],
+                                                timestamp: Double(bitPattern: try read(UInt64.self)),
+                                                path: try readString())
+        record.method = try readOptional { try $0.readString() }
+        record.url = try readOptional { try $0.readString() }
+        record.statusCode = try readOptional { Int(try $0.read(Int64.self)) }
+        record.headers = try readOptional { reader in
+            var headers = [String: String]()
+            for _ in 0..<(try reader.read(UInt32.self)) {
+                let name = try reader.readString()
+                headers[name] = try reader.readString()
+            }
+            return headers
+        }
+        record.body = try readOptional { try $0.readData() }
+        record.bodyLength = try readOptional { Int(try $0.read(Int64.self)) }
+        record.error = try readOptional { try $0.readString() }
+
+        // Skip fields appended by newer writers.
+        offset = end
+        return record
+    }
+
+    private mutating func readOptional<T>(_ body: (inout BinaryRecordReader) throws -> T) throws -> T? {
+        guard try read(UInt8.self) != 0 else { return nil }
+        return try body(&self)
+    }
+
+    mutating func read<T: FixedWidthInteger>(_ type: T.Type) throws -> T {
+        let size = MemoryLayout<T>.size
+        guard offset + size <= data.endIndex else { throw CorruptedData() }
+
+        var value: T = 0
+        withUnsafeMutableBytes(of: &value) { data.copyBytes(to: $0, from: offset..<(offset + size)) }
+        offset += size
+        return T(littleEndian: value)
+    }
+
+    mutating func readData() throws -> Data {
+        let count = Int(try read(UInt32.self))
+        guard offset + count <= data.endIndex else { throw CorruptedData() }
+
+        let bytes = data.subdata(in: offset..<(offset + count))
+        offset += count
+        return bytes
+    }
+
+    mutating func readString() throws -> String {
+        String(decoding: try readData(), as: UTF8.self)
+    }
+}
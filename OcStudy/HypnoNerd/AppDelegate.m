@@ -7,6 +7,7 @@
 
 #import "AppDelegate.h"
 #import "BNRItemStore.h"
+#import "BNRBlobStore.h"
 #import "AppDelegateAndSceneDelegate.h"
 #import <UserNotifications/UserNotifications.h>
 
@@ -68,6 +69,8 @@ NSString * const BNRNextItemNamePrefsKey = @"NextItemName";
     else {
         NSLog(@"Could not save any of the BNRItems");
     }
+    // 图片索引的改动是延迟写盘的，进后台前写下去
+    [[BNRBlobStore sharedStore] synchronize];
 }
 
 @end
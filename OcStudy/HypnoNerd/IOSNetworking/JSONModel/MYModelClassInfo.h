@@ -0,0 +1,46 @@
+//
+//  MYModelClassInfo.h
+//  HypnoNerd
+//
+//  Created by HuXin on 2026/10/18.
+//
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+typedef NS_ENUM(NSUInteger, MYModelPropertyType) {
+    MYModelPropertyTypeUnknown,
+    MYModelPropertyTypeBool,
+    MYModelPropertyTypeInteger,
+    MYModelPropertyTypeFloatingPoint,
+    MYModelPropertyTypeObject,
+};
+
+/// 一个可写属性的元信息, 解析一次后缓存, 赋值时直接调用 setter, 不经过 KVC
+@interface MYModelPropertyInfo : NSObject
+
+@property (nonatomic, copy, readonly) NSString *name;
+@property (nonatomic, assign, readonly) MYModelPropertyType type;
+/// 属性为对象类型时的类, id 类型为 Nil
+@property (nonatomic, assign, readonly, nullable) Class objectClass;
+@property (nonatomic, assign, readonly) SEL setter;
+
+- (void)setBool:(BOOL)value forModel:(id)model;
+- (void)setInteger:(long long)value forModel:(id)model;
+- (void)setDouble:(double)value forModel:(id)model;
+- (void)setObject:(nullable id)value forModel:(id)model;
+
+@end
+
+/// 类的属性表, 每个类只用 runtime 解析一次
+@interface MYModelClassInfo : NSObject
+
+@property (nonatomic, assign, readonly) Class cls;
+@property (nonatomic, copy, readonly) NSDictionary<NSString *, MYModelPropertyInfo *> *propertiesByName;
+
++ (instancetype)classInfoWithClass:(Class)cls;
+
+@end
+
+NS_ASSUME_NONNULL_END
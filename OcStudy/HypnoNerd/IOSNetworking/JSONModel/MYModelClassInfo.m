@@ -0,0 +1,195 @@
+//
+//  MYModelClassInfo.m
+//  HypnoNerd
+//
+//  Created by HuXin on 2026/10/18.
+//
+
+#import "MYModelClassInfo.h"
+#import <objc/runtime.h>
+#import <objc/message.h>
+
+@interface MYModelPropertyInfo ()
+
+@property (nonatomic, copy, readwrite) NSString *name;
+@property (nonatomic, assign, readwrite) MYModelPropertyType type;
+@property (nonatomic, assign, readwrite) Class objectClass;
+@property (nonatomic, assign, readwrite) SEL setter;
+@property (nonatomic, assign) char encoding;
+
+@end
+
+@implementation MYModelPropertyInfo
+
+- (nullable instancetype)initWithProperty:(objc_property_t)property {
+    if (self = [self init]) {
+        self.name = [NSString stringWithUTF8String:property_getName(property)];
+
+        unsigned int attributeCount = 0;
+        objc_property_attribute_t *attributes = property_copyAttributeList(property, &attributeCount);
+        NSString *setterName = nil;
+        BOOL readonly = NO;
+        for (unsigned int i = 0; i < attributeCount; i++) {
+            const char *value = attributes[i].value;
+            switch (attributes[i].name[0]) {
+                case 'T':
+                    [self parseTypeEncoding:value];
+                    break;
+                case 'R':
+                    readonly = YES;
+                    break;
+                case 'S':
+                    setterName = [NSString stringWithUTF8String:value];
+                    break;
+                default:
+                    break;
+            }
+        }
+        free(attributes);
+
+        if (readonly || self.type == MYModelPropertyTypeUnknown) {
+            return nil;
+        }
+        if (!setterName) {
+            setterName = [NSString stringWithFormat:@"set%@%@:", [[self.name substringToIndex:1] uppercaseString], [self.name substringFromIndex:1]];
+        }
+        self.setter = NSSelectorFromString(setterName);
+    }
+    return self;
+}
+
+- (void)parseTypeEncoding:(const char *)typeEncoding {
+    // 跳过 r n N o O R V 等类型修饰符
+    while (*typeEncoding && strchr("rnNoORV", *typeEncoding)) {
+        typeEncoding++;
+    }
+    self.encoding = typeEncoding[0];
+    switch (typeEncoding[0]) {
+        case 'B':
+            self.type = MYModelPropertyTypeBool;
+            break;
+        case 'c': case 'C': case 's': case 'S': case 'i': case 'I':
+        case 'l': case 'L': case 'q': case 'Q':
+            self.type = MYModelPropertyTypeInteger;
+            break;
+        case 'f': case 'd':
+            self.type = MYModelPropertyTypeFloatingPoint;
+            break;
+        case '@': {
+            self.type = MYModelPropertyTypeObject;
+            // @"NSString" 形式带类名, 单独的 @ 是 id
+            size_t length = strlen(typeEncoding);
+            if (length > 3 && typeEncoding[1] == '"') {
+                NSString *className = [[NSString alloc] initWithBytes:typeEncoding + 2 length:length - 3 encoding:NSUTF8StringEncoding];
+                NSRange protocolRange = [className rangeOfString:@"<"];
+                if (protocolRange.location != NSNotFound) {
+                    className = [className substringToIndex:protocolRange.location];
+                }
+                self.objectClass = className.length > 0 ? NSClassFromString(className) : Nil;
+            }
+            break;
+        }
+        default:
+            self.type = MYModelPropertyTypeUnknown;
+            break;
+    }
+}
+
+- (void)setBool:(BOOL)value forModel:(id)model {
+    if (self.type == MYModelPropertyTypeBool) {
+        ((void (*)(id, SEL, BOOL))objc_msgSend)(model, self.setter, value);
+    } else {
+        [self setInteger:value ? 1 : 0 forModel:model];
+    }
+}
+
+- (void)setInteger:(long long)value forModel:(id)model {
+    SEL setter = self.setter;
+    switch (self.encoding) {
+        case 'B': ((void (*)(id, SEL, BOOL))objc_msgSend)(model, setter, value != 0); break;
+        case 'c': ((void (*)(id, SEL, char))objc_msgSend)(model, setter, (char)value); break;
+        case 'C': ((void (*)(id, SEL, unsigned char))objc_msgSend)(model, setter, (unsigned char)value); break;
+        case 's': ((void (*)(id, SEL, short))objc_msgSend)(model, setter, (short)value); break;
+        case 'S': ((void (*)(id, SEL, unsigned short))objc_msgSend)(model, setter, (unsigned short)value); break;
+        case 'i': ((void (*)(id, SEL, int))objc_msgSend)(model, setter, (int)value); break;
+        case 'I': ((void (*)(id, SEL, unsigned int))objc_msgSend)(model, setter, (unsigned int)value); break;
+        case 'l': ((void (*)(id, SEL, long))objc_msgSend)(model, setter, (long)value); break;
+        case 'L': ((void (*)(id, SEL, unsigned long))objc_msgSend)(model, setter, (unsigned long)value); break;
+        case 'q': ((void (*)(id, SEL, long long))objc_msgSend)(model, setter, value); break;
+        case 'Q': ((void (*)(id, SEL, unsigned long long))objc_msgSend)(model, setter, (unsigned long long)value); break;
+        case 'f': ((void (*)(id, SEL, float))objc_msgSend)(model, setter, (float)value); break;
+        case 'd': ((void (*)(id, SEL, double))objc_msgSend)(model, setter, (double)value); break;
+        case '@': [self setObject:@(value) forModel:model]; break;
+        default: break;
+    }
+}
+
+- (void)setDouble:(double)value forModel:(id)model {
+    switch (self.encoding) {
+        case 'f': ((void (*)(id, SEL, float))objc_msgSend)(model, self.setter, (float)value); break;
+        case 'd': ((void (*)(id, SEL, double))objc_msgSend)(model, self.setter, value); break;
+        case '@': [self setObject:@(value) forModel:model]; break;
+        default: [self setInteger:(long long)value forModel:model]; break;
+    }
+}
+
+- (void)setObject:(id)value forModel:(id)model {
+    if (self.type == MYModelPropertyTypeObject) {
+        ((void (*)(id, SEL, id))objc_msgSend)(model, self.setter, value);
+    }
+}
+
+@end
+
+@interface MYModelClassInfo ()
+
+@property (nonatomic, assign, readwrite) Class cls;
+@property (nonatomic, copy, readwrite) NSDictionary<NSString *, MYModelPropertyInfo *> *propertiesByName;
+
+@end
+
+@implementation MYModelClassInfo
+
++ (instancetype)classInfoWithClass:(Class)cls {
+    static NSMutableDictionary<NSString *, MYModelClassInfo *> *classInfos;
+    static dispatch_semaphore_t lock;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        classInfos = [NSMutableDictionary dictionary];
+        lock = dispatch_semaphore_create(1);
+    });
+
+    NSString *className = NSStringFromClass(cls);
+    dispatch_semaphore_wait(lock, DISPATCH_TIME_FOREVER);
+    MYModelClassInfo *info = classInfos[className];
+    if (!info) {
+        info = [[MYModelClassInfo alloc] initWithClass:cls];
+        classInfos[className] = info;
+    }
+    dispatch_semaphore_signal(lock);
+    return info;
+}
+
+- (instancetype)initWithClass:(Class)cls {
+    if (self = [self init]) {
+        self.cls = cls;
+
+        NSMutableDictionary *propertiesByName = [NSMutableDictionary dictionary];
+        // 子类的属性优先, 沿继承链向上直到 NSObject
+        for (Class currentClass = cls; currentClass && currentClass != [NSObject class]; currentClass = class_getSuperclass(currentClass)) {
+            unsigned int outCount = 0;
+            objc_property_t *properties = class_copyPropertyList(currentClass, &outCount);
+            for (unsigned int i = 0; i < outCount; i++) {
+                MYModelPropertyInfo *propertyInfo = [[MYModelPropertyInfo alloc] initWithProperty:properties[i]];
+                if (propertyInfo && !propertiesByName[propertyInfo.name]) {
+                    propertiesByName[propertyInfo.name] = propertyInfo;
+                }
+            }
+            free(properties);
+        }
+        self.propertiesByName = propertiesByName;
+    }
+    return self;
+}
+
+@end
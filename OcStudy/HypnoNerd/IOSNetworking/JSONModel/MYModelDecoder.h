@@ -0,0 +1,50 @@
+//
+//  MYModelDecoder.h
+//  HypnoNerd
+//
+//  Created by HuXin on 2026/10/18.
+//
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+@protocol MYModelDecoding <NSObject>
+
+@optional
+/// 每给一个属性赋值后调用
+- (void)modelDecoderDidDecodePropertyNamed:(NSString *)name;
+
+@end
+
+/// 直接从 JSON 字节流解码模型列表:
+/// 边接收边解析, 按 MYModelClassInfo 缓存的属性表调用 setter, 中间不生成 NSDictionary / NSArray
+@interface MYModelDecoder : NSObject
+
+/// @param listKeyPath 列表在 JSON 中的路径, 例如 data.list, nil 表示最外层就是数组
+/// @param modelKeyPath 模型在列表元素中的路径, 例如 video_info, nil 表示元素本身就是模型
+- (instancetype)initWithModelClass:(Class)modelClass
+                       listKeyPath:(nullable NSString *)listKeyPath
+                      modelKeyPath:(nullable NSString *)modelKeyPath;
+
+/// 设置后, 解码出的模型每凑满 batchSize 个就交给 modelsHandler, 不再保存在 models 中
+@property (nonatomic, assign) NSUInteger batchSize;
+@property (nonatomic, copy, nullable) void (^modelsHandler)(NSArray *models);
+
+@property (nonatomic, copy, readonly) NSArray *models;
+
+/// 列表中已解析的元素个数, 包括 modelKeyPath 缺失而没有解码出模型的元素
+@property (nonatomic, assign, readonly) NSUInteger listCount;
+
+- (BOOL)appendData:(NSData *)data error:(NSError **)error;
+- (BOOL)finishWithError:(NSError **)error;
+
++ (nullable NSArray *)modelsOfClass:(Class)modelClass
+                       fromJSONData:(NSData *)data
+                        listKeyPath:(nullable NSString *)listKeyPath
+                       modelKeyPath:(nullable NSString *)modelKeyPath
+                              error:(NSError **)error;
+
+@end
+
+NS_ASSUME_NONNULL_END
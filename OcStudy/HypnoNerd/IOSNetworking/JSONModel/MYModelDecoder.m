@@ -0,0 +1,297 @@
+//
+//  MYModelDecoder.m
+//  HypnoNerd
+//
+//  Created by HuXin on 2026/10/18.
+//
+
+#import "MYModelDecoder.h"
+#import "MYModelClassInfo.h"
+#import <AFNetworking/AFNetworking.h>
+
+typedef NS_ENUM(uint8_t, MYModelDecoderFrameRole) {
+    MYModelDecoderFrameRoleIgnored,
+    MYModelDecoderFrameRoleOutside,   // 正在匹配 listKeyPath
+    MYModelDecoderFrameRoleList,
+    MYModelDecoderFrameRoleElement,   // 正在匹配 modelKeyPath
+    MYModelDecoderFrameRoleModel,
+};
+
+typedef struct {
+    MYModelDecoderFrameRole role;
+    BOOL isObject;
+    NSUInteger depth;   // 已匹配的 key 个数
+} MYModelDecoderFrame;
+
+@interface MYModelDecoder () <AFJSONStreamParserDelegate>
+
+@property (nonatomic, strong) MYModelClassInfo *classInfo;
+@property (nonatomic, copy) NSArray<NSString *> *listKeys;
+@property (nonatomic, copy) NSArray<NSString *> *modelKeys;
+@property (nonatomic, strong) AFJSONStreamParser *parser;
+
+@property (nonatomic, strong) NSMutableData *frames;
+@property (nonatomic, copy) NSString *currentKey;
+@property (nonatomic, strong) id currentModel;
+@property (nonatomic, assign) BOOL notifiesDecodedProperties;
+@property (nonatomic, strong) NSMutableArray *decodedModels;
+@property (nonatomic, assign, readwrite) NSUInteger listCount;
+
+@end
+
+@implementation MYModelDecoder
+
+- (instancetype)initWithModelClass:(Class)modelClass listKeyPath:(NSString *)listKeyPath modelKeyPath:(NSString *)modelKeyPath {
+    if (self = [super init]) {
+        self.classInfo = [MYModelClassInfo classInfoWithClass:modelClass];
+        self.listKeys = listKeyPath.length > 0 ? [listKeyPath componentsSeparatedByString:@"."] : @[];
+        self.modelKeys = modelKeyPath.length > 0 ? [modelKeyPath componentsSeparatedByString:@"."] : @[];
+        self.notifiesDecodedProperties = [modelClass instancesRespondToSelector:@selector(modelDecoderDidDecodePropertyNamed:)];
+
+        self.parser = [[AFJSONStreamParser alloc] init];
+        self.parser.delegate = self;
+        self.frames = [NSMutableData data];
+        self.decodedModels = [NSMutableArray array];
+    }
+    return self;
+}
+
++ (NSArray *)modelsOfClass:(Class)modelClass fromJSONData:(NSData *)data listKeyPath:(NSString *)listKeyPath modelKeyPath:(NSString *)modelKeyPath error:(NSError **)error {
+    MYModelDecoder *decoder = [[MYModelDecoder alloc] initWithModelClass:modelClass listKeyPath:listKeyPath modelKeyPath:modelKeyPath];
+    if (![decoder appendData:data error:error] || ![decoder finishWithError:error]) {
+        return nil;
+    }
+    return decoder.models;
+}
+
+- (NSArray *)models {
+    return [self.decodedModels copy];
+}
+
+- (BOOL)appendData:(NSData *)data error:(NSError **)error {
+    return [self.parser parseData:data error:error];
+}
+
+- (BOOL)finishWithError:(NSError **)error {
+    if (![self.parser finishParsingWithError:error]) {
+        return NO;
+    }
+    [self flushModels];
+    return YES;
+}
+
+- (void)flushModels {
+    if (!self.modelsHandler || self.decodedModels.count == 0) {
+        return;
+    }
+    NSArray *models = self.decodedModels;
+    self.decodedModels = [NSMutableArray array];
+    self.modelsHandler(models);
+}
+
+#pragma mark - Frames
+
+- (MYModelDecoderFrame *)topFrame {
+    if (self.frames.length == 0) {
+        return NULL;
+    }
+    return (MYModelDecoderFrame *)self.frames.mutableBytes + (self.frames.length / sizeof(MYModelDecoderFrame) - 1);
+}
+
+- (void)pushContainerIsObject:(BOOL)isObject {
+    MYModelDecoderFrame *parent = [self topFrame];
+    NSString *key = self.currentKey;
+    self.currentKey = nil;
+
+    MYModelDecoderFrame frame = {MYModelDecoderFrameRoleIgnored, isObject, 0};
+    [self countListElementInFrame:parent];
+    if (!parent) {
+        if (self.listKeys.count == 0) {
+            frame.role = isObject ? MYModelDecoderFrameRoleIgnored : MYModelDecoderFrameRoleList;
+        } else {
+            frame.role = isObject ? MYModelDecoderFrameRoleOutside : MYModelDecoderFrameRoleIgnored;
+        }
+    } else {
+        switch (parent->role) {
+            case MYModelDecoderFrameRoleOutside:
+                if ([key isEqualToString:self.listKeys[parent->depth]]) {
+                    if (parent->depth + 1 == self.listKeys.count) {
+                        frame.role = isObject ? MYModelDecoderFrameRoleIgnored : MYModelDecoderFrameRoleList;
+                    } else if (isObject) {
+                        frame.role = MYModelDecoderFrameRoleOutside;
+                        frame.depth = parent->depth + 1;
+                    }
+                }
+                break;
+            case MYModelDecoderFrameRoleList:
+                if (isObject) {
+                    frame.role = self.modelKeys.count == 0 ? MYModelDecoderFrameRoleModel : MYModelDecoderFrameRoleElement;
+                }
+                break;
+            case MYModelDecoderFrameRoleElement:
+                if (isObject && [key isEqualToString:self.modelKeys[parent->depth]]) {
+                    if (parent->depth + 1 == self.modelKeys.count) {
+                        frame.role = MYModelDecoderFrameRoleModel;
+                    } else {
+                        frame.role = MYModelDecoderFrameRoleElement;
+                        frame.depth = parent->depth + 1;
+                    }
+                }
+                break;
+            default:
+                // 模型内部嵌套的容器不做映射
+                break;
+        }
+    }
+
+    if (frame.role == MYModelDecoderFrameRoleModel) {
+        self.currentModel = [[self.classInfo.cls alloc] init];
+    }
+    [self.frames appendBytes:&frame length:sizeof(frame)];
+}
+
+- (void)popContainer {
+    MYModelDecoderFrame *frame = [self topFrame];
+    if (frame->role == MYModelDecoderFrameRoleModel && self.currentModel) {
+        [self.decodedModels addObject:self.currentModel];
+        self.currentModel = nil;
+        if (self.batchSize > 0 && self.decodedModels.count >= self.batchSize) {
+            [self flushModels];
+        }
+    }
+    self.frames.length -= sizeof(MYModelDecoderFrame);
+    self.currentKey = nil;
+}
+
+- (void)countListElementInFrame:(MYModelDecoderFrame *)frame {
+    if (frame && frame->role == MYModelDecoderFrameRoleList) {
+        self.listCount += 1;
+    }
+}
+
+// 仅当值直接属于模型对象且 key 有对应属性时返回属性信息
+- (MYModelPropertyInfo *)consumePropertyForValue {
+    MYModelDecoderFrame *frame = [self topFrame];
+    NSString *key = self.currentKey;
+    self.currentKey = nil;
+    [self countListElementInFrame:frame];
+    if (!frame || frame->role != MYModelDecoderFrameRoleModel || !key) {
+        return nil;
+    }
+    return self.classInfo.propertiesByName[key];
+}
+
+- (void)didDecodeProperty:(MYModelPropertyInfo *)property {
+    if (self.notifiesDecodedProperties) {
+        [self.currentModel modelDecoderDidDecodePropertyNamed:property.name];
+    }
+}
+
+#pragma mark - AFJSONStreamParserDelegate
+
+- (void)parserDidStartObject:(AFJSONStreamParser *)parser {
+    [self pushContainerIsObject:YES];
+}
+
+- (void)parserDidEndObject:(AFJSONStreamParser *)parser {
+    [self popContainer];
+}
+
+- (void)parserDidStartArray:(AFJSONStreamParser *)parser {
+    [self pushContainerIsObject:NO];
+}
+
+- (void)parserDidEndArray:(AFJSONStreamParser *)parser {
+    [self popContainer];
+}
+
+- (void)parser:(AFJSONStreamParser *)parser foundKey:(NSString *)key {
+    self.currentKey = key;
+}
+
+- (void)parser:(AFJSONStreamParser *)parser foundString:(NSString *)string {
+    MYModelPropertyInfo *property = [self consumePropertyForValue];
+    if (!property) {
+        return;
+    }
+    switch (property.type) {
+        case MYModelPropertyTypeObject:
+            if (property.objectClass == [NSURL class]) {
+                [property setObject:[NSURL URLWithString:string] forModel:self.currentModel];
+            } else if (property.objectClass == [NSNumber class]) {
+                [property setObject:[NSDecimalNumber decimalNumberWithString:string] forModel:self.currentModel];
+            } else if (property.objectClass == [NSMutableString class]) {
+                [property setObject:[string mutableCopy] forModel:self.currentModel];
+            } else if (!property.objectClass || [string isKindOfClass:property.objectClass]) {
+                [property setObject:string forModel:self.currentModel];
+            } else {
+                return;
+            }
+            break;
+        case MYModelPropertyTypeBool:
+            [property setBool:[string boolValue] forModel:self.currentModel];
+            break;
+        case MYModelPropertyTypeInteger:
+            [property setInteger:[string longLongValue] forModel:self.currentModel];
+            break;
+        case MYModelPropertyTypeFloatingPoint:
+            [property setDouble:[string doubleValue] forModel:self.currentModel];
+            break;
+        default:
+            return;
+    }
+    [self didDecodeProperty:property];
+}
+
+- (void)parser:(AFJSONStreamParser *)parser foundNumber:(NSNumber *)number {
+    MYModelPropertyInfo *property = [self consumePropertyForValue];
+    if (!property) {
+        return;
+    }
+    switch (property.type) {
+        case MYModelPropertyTypeObject:
+            if (property.objectClass == [NSString class]) {
+                [property setObject:[number stringValue] forModel:self.currentModel];
+            } else if (!property.objectClass || [number isKindOfClass:property.objectClass]) {
+                [property setObject:number forModel:self.currentModel];
+            } else {
+                return;
+            }
+            break;
+        case MYModelPropertyTypeBool:
+            [property setBool:[number boolValue] forModel:self.currentModel];
+            break;
+        case MYModelPropertyTypeInteger:
+            [property setInteger:[number longLongValue] forModel:self.currentModel];
+            break;
+        case MYModelPropertyTypeFloatingPoint:
+            [property setDouble:[number doubleValue] forModel:self.currentModel];
+            break;
+        default:
+            return;
+    }
+    [self didDecodeProperty:property];
+}
+
+- (void)parser:(AFJSONStreamParser *)parser foundBoolean:(BOOL)boolean {
+    MYModelPropertyInfo *property = [self consumePropertyForValue];
+    if (!property) {
+        return;
+    }
+    if (property.type == MYModelPropertyTypeObject) {
+        if (property.objectClass && ![property.objectClass isSubclassOfClass:[NSNumber class]]) {
+            return;
+        }
+        [property setObject:@(boolean) forModel:self.currentModel];
+    } else {
+        [property setBool:boolean forModel:self.currentModel];
+    }
+    [self didDecodeProperty:property];
+}
+
+- (void)parserFoundNull:(AFJSONStreamParser *)parser {
+    // null 不覆盖属性的默认值, 与 initWithDict: 跳过缺失字段一致
+    [self consumePropertyForValue];
+}
+
+@end
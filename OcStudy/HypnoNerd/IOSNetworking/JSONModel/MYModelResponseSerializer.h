@@ -0,0 +1,33 @@
+//
+//  MYModelResponseSerializer.h
+//  HypnoNerd
+//
+//  Created by HuXin on 2026/10/18.
+//
+
+#import <AFNetworking/AFNetworking.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/// 在数据到达时用 MYModelDecoder 解码, 请求完成后 responseObject 是模型数组
+@interface MYModelResponseSerializer : AFJSONResponseSerializer <AFURLIncrementalResponseSerialization>
+
++ (instancetype)serializerWithModelClass:(Class)modelClass
+                             listKeyPath:(nullable NSString *)listKeyPath
+                            modelKeyPath:(nullable NSString *)modelKeyPath;
+
+@property (nonatomic, assign) Class modelClass;
+@property (nonatomic, copy, nullable) NSString *listKeyPath;
+@property (nonatomic, copy, nullable) NSString *modelKeyPath;
+
+/// 每解码出 batchSize 个模型就在主线程回调一次, 默认 20
+@property (nonatomic, assign) NSUInteger batchSize;
+@property (nonatomic, copy, nullable) void (^modelsHandler)(NSURLSessionDataTask *task, NSArray *models);
+
+@end
+
+/// 请求完成后, 响应中列表的原始元素个数, 包括 modelKeyPath 缺失而被跳过的元素; 分页应以此为准而不是模型个数
+/// 响应未经 MYModelResponseSerializer 流式解码时返回 NSNotFound
+FOUNDATION_EXPORT NSUInteger MYModelResponseListCount(NSURLSessionTask *task);
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,143 @@
+//
+//  MYModelResponseSerializer.m
+//  HypnoNerd
+//
+//  Created by HuXin on 2026/10/18.
+//
+
+#import "MYModelResponseSerializer.h"
+#import "MYModelDecoder.h"
+#import <objc/runtime.h>
+
+static char MYModelResponseListCountKey;
+
+NSUInteger MYModelResponseListCount(NSURLSessionTask *task) {
+    NSNumber *count = objc_getAssociatedObject(task, &MYModelResponseListCountKey);
+    return count ? count.unsignedIntegerValue : NSNotFound;
+}
+
+@interface MYModelResponseParser : NSObject <AFURLIncrementalResponseParsing>
+
+@property (nonatomic, strong) MYModelResponseSerializer *serializer;
+@property (nonatomic, weak) NSURLSessionDataTask *task;
+@property (nonatomic, strong) MYModelDecoder *decoder;
+@property (nonatomic, strong) NSMutableArray *models;
+@property (nonatomic, assign) BOOL didStart;
+@property (nonatomic, assign) BOOL disabled;
+@property (nonatomic, strong) NSError *decodeError;
+
+@end
+
+@implementation MYModelResponseParser
+
+- (instancetype)initWithSerializer:(MYModelResponseSerializer *)serializer task:(NSURLSessionDataTask *)task {
+    if (self = [super init]) {
+        self.serializer = serializer;
+        self.task = task;
+        self.models = [NSMutableArray array];
+        self.decoder = [[MYModelDecoder alloc] initWithModelClass:serializer.modelClass listKeyPath:serializer.listKeyPath modelKeyPath:serializer.modelKeyPath];
+        self.decoder.batchSize = MAX(serializer.batchSize, (NSUInteger)1);
+
+        __weak typeof(self) weakSelf = self;
+        self.decoder.modelsHandler = ^(NSArray *models) {
+            [weakSelf didDecodeModels:models];
+        };
+    }
+    return self;
+}
+
+- (void)didDecodeModels:(NSArray *)models {
+    [self.models addObjectsFromArray:models];
+
+    void (^modelsHandler)(NSURLSessionDataTask *, NSArray *) = self.serializer.modelsHandler;
+    NSURLSessionDataTask *task = self.task;
+    if (modelsHandler && task) {
+        dispatch_async(dispatch_get_main_queue(), ^{
+            modelsHandler(task, models);
+        });
+    }
+}
+
+- (BOOL)appendData:(NSData *)data {
+    if (self.disabled && !self.decodeError) {
+        return NO;
+    }
+    if (self.disabled || data.length == 0) {
+        return YES;
+    }
+    if (!self.didStart) {
+        self.didStart = YES;
+        // 错误响应交给完成时的默认校验处理, 需要保留响应体
+        if (![self.serializer validateResponse:(NSHTTPURLResponse *)self.task.response data:nil error:NULL]) {
+            self.disabled = YES;
+            return NO;
+        }
+    }
+
+    NSError *error = nil;
+    if (![self.decoder appendData:data error:&error]) {
+        self.decodeError = error;
+        self.disabled = YES;
+    }
+    return YES;
+}
+
+- (id)responseObjectForResponse:(NSURLResponse *)response data:(NSData *)data error:(NSError *__autoreleasing *)error {
+    if (![self.serializer validateResponse:(NSHTTPURLResponse *)response data:data error:error]) {
+        return nil;
+    }
+
+    NSError *decodeError = self.decodeError;
+    if (!decodeError && (!self.didStart || self.disabled || ![self.decoder finishWithError:&decodeError])) {
+        decodeError = decodeError ?: [NSError errorWithDomain:AFURLResponseSerializationErrorDomain code:NSURLErrorCannotParseResponse userInfo:nil];
+    }
+    if (decodeError) {
+        if (error) {
+            *error = decodeError;
+        }
+        return nil;
+    }
+
+    // 在成功回调之前记录, 回调里即可按原始个数分页
+    objc_setAssociatedObject(self.task, &MYModelResponseListCountKey, @(self.decoder.listCount), OBJC_ASSOCIATION_RETAIN_NONATOMIC);
+
+    return [self.models copy];
+}
+
+@end
+
+@implementation MYModelResponseSerializer
+
++ (instancetype)serializerWithModelClass:(Class)modelClass listKeyPath:(NSString *)listKeyPath modelKeyPath:(NSString *)modelKeyPath {
+    MYModelResponseSerializer *serializer = [self serializer];
+    serializer.modelClass = modelClass;
+    serializer.listKeyPath = listKeyPath;
+    serializer.modelKeyPath = modelKeyPath;
+    return serializer;
+}
+
+- (instancetype)init {
+    if (self = [super init]) {
+        self.batchSize = 20;
+    }
+    return self;
+}
+
+- (id<AFURLIncrementalResponseParsing>)incrementalResponseParserForDataTask:(NSURLSessionDataTask *)dataTask {
+    if (!self.modelClass) {
+        return nil;
+    }
+    return [[MYModelResponseParser alloc] initWithSerializer:self task:dataTask];
+}
+
+- (instancetype)copyWithZone:(NSZone *)zone {
+    MYModelResponseSerializer *serializer = [super copyWithZone:zone];
+    serializer.modelClass = self.modelClass;
+    serializer.listKeyPath = self.listKeyPath;
+    serializer.modelKeyPath = self.modelKeyPath;
+    serializer.batchSize = self.batchSize;
+    serializer.modelsHandler = self.modelsHandler;
+    return serializer;
+}
+
+@end
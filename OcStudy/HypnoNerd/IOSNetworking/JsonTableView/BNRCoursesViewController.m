@@ -72,15 +72,16 @@
     NSURLSessionDataTask *dataTask = [self.session dataTaskWithRequest:req
                                                      completionHandler:^(NSData * _Nullable data, NSURLResponse * _Nullable response, NSError * _Nullable error) {
         if (!error && data) {
-            NSDictionary *jsonObject = [NSJSONSerialization JSONObjectWithData:data options:0 error:nil];
-            NSLog(@"%@", jsonObject);
-
-            for (int i = 0; i < [jsonObject[@"data"][@"list"] count]; i++) {
-                course *cour = [[course alloc] initWithDict:jsonObject[@"data"][@"list"][i]];
-                [self.courses addObject:cour];
+            // 直接从 JSON 字节解码成 course, 不经过 NSDictionary
+            NSError *decodeError = nil;
+            NSArray<course *> *courses = [MYModelDecoder modelsOfClass:[course class] fromJSONData:data listKeyPath:@"data.list" modelKeyPath:nil error:&decodeError];
+            if (!courses) {
+                NSLog(@"ERROR: %@", decodeError);
+                return;
             }
-            
+
             dispatch_async(dispatch_get_main_queue(), ^{
+                [self.courses addObjectsFromArray:courses];
                 [self.tableView reloadData];
             });
         }
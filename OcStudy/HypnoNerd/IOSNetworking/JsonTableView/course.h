@@ -6,10 +6,11 @@
 //
 
 #import <Foundation/Foundation.h>
+#import "MYModelDecoder.h"
 
 NS_ASSUME_NONNULL_BEGIN
 
-@interface course : NSObject
+@interface course : NSObject <MYModelDecoding>
 
 @property (nonatomic) NSString *title;
 @property (nonatomic) NSString *create_time;
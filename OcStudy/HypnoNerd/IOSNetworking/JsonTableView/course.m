@@ -38,4 +38,10 @@
     return self;
 }
 
+#pragma mark - MYModelDecoding
+
+- (void)modelDecoderDidDecodePropertyNamed:(NSString *)name {
+    self.count += 1;
+}
+
 @end
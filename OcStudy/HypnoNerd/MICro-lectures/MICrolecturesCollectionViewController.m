@@ -8,6 +8,7 @@
 #import "MICrolecturesCollectionViewController.h"
 #import "MICrolectureCollectionViewCell.h"
 #import "MICrolecture.h"
+#import "MYModelResponseSerializer.h"
 #import <AFNetworking/AFNetworking.h>
 #import <MJRefresh/MJRefresh.h>
 #import <Masonry/Masonry.h>
@@ -20,6 +21,8 @@
 @property (nonatomic, strong) NSMutableArray<MICrolecture *> *microlectures;
 @property (nonatomic, strong) UIActivityIndicatorView *indicatorView;
 @property (nonatomic, strong) BJPUViewController *player;
+/// 每页都用这一个 manager，控制器释放时让 session 失效，session 不再持有 manager
+@property (nonatomic, strong) AFHTTPSessionManager *sessionManager;
 @property (nonatomic) int page;
 @property (nonatomic) int page_size;
 
@@ -38,6 +41,10 @@
     return self;
 }
 
+- (void)dealloc {
+    [_sessionManager invalidateSessionCancelingTasks:YES resetSession:NO];
+}
+
 - (void)viewDidLoad {
     [super viewDidLoad];
     self.view.backgroundColor = UIColor.whiteColor;
@@ -104,31 +111,51 @@
     [self getMicrolectures:dict];
 }
 
+- (AFHTTPSessionManager *)sessionManager {
+    if (!_sessionManager) {
+        _sessionManager = [AFHTTPSessionManager manager];
+        // Decode lectures batch by batch straight from the bytes of the play back list while it is still downloading
+        MYModelResponseSerializer *responseSerializer = [MYModelResponseSerializer serializerWithModelClass:[MICrolecture class] listKeyPath:@"data.list" modelKeyPath:@"video_info"];
+        // serializer 归 manager，manager 归 session，这里强引用 self 控制器就永远不会释放
+        __weak typeof(self) weakSelf = self;
+        responseSerializer.modelsHandler = ^(NSURLSessionDataTask * _Nonnull task, NSArray * _Nonnull models) {
+            __strong __typeof__(weakSelf) strongSelf = weakSelf;
+            if (!strongSelf) {
+                return;
+            }
+            [strongSelf.indicatorView stopAnimating];
+            [strongSelf.microlectures addObjectsFromArray:models];
+            [strongSelf.microCollectionView reloadData];
+            strongSelf.navigationItem.title = [NSString stringWithFormat:@"MicroLectures(%lu)",(unsigned long)strongSelf.microlectures.count];
+        };
+        _sessionManager.responseSerializer = responseSerializer;
+    }
+    return _sessionManager;
+}
+
 - (void)getMicrolectures:(NSDictionary *)dict {
-    AFHTTPSessionManager *sessionManager =[AFHTTPSessionManager manager];
     NSString *url = @"https://e83248690.test-at.baijiayun.com/orgapp/weclass/playbackList?auth_token=DH8md3l0aXZjdGV2eHNqd2RuaSc_PTg3OT48PzYyKHN1aG9yaylBOD8-PT09PT4-Pj80Knx7KkI5Pjo_Oz48Qj09NSt7eHVuK0Q7Nix9a3Z-LEQsZESCfEKCLYg&page=1&page_size=20&room_id=&signature=9994ecca48b733689563e919d0449eb8&timestamp=1627354203275&uuid=1726E699-6255-4ED4-A4E1-1E040F38673B";
     
-    [sessionManager GET:url parameters:dict headers:nil
+    __weak typeof(self) weakSelf = self;
+    [self.sessionManager GET:url parameters:dict headers:nil
                progress:^(NSProgress * _Nonnull downloadProgress) {
         //CGFloat downprogress = 1.0 * downloadProgress.completedUnitCount / downloadProgress.totalUnitCount;
         //NSLog(@"%f", downprogress);
     }
                 success:^(NSURLSessionDataTask * _Nonnull task, id  _Nullable responseObject) {
-        [self.indicatorView stopAnimating];
-        if ([responseObject[@"data"][@"list"] count] < self.page_size) {
-            [self.microCollectionView.mj_footer endRefreshingWithNoMoreData];
+        __strong __typeof__(weakSelf) strongSelf = weakSelf;
+        [strongSelf.indicatorView stopAnimating];
+        // 没有 video_info 的元素不会解码成模型, 按列表原始长度判断是否还有下一页
+        NSUInteger listCount = MYModelResponseListCount(task);
+        if (listCount == NSNotFound) {
+            listCount = [responseObject count];
         }
-        else {
-            self.page += 1;
+        if (listCount < strongSelf.page_size) {
+            [strongSelf.microCollectionView.mj_footer endRefreshingWithNoMoreData];
         }
-        for (int i = 0; i < [responseObject[@"data"][@"list"] count]; i++) {
-            MICrolecture *lecture = [[MICrolecture alloc] initWithDict:responseObject[@"data"][@"list"][i][@"video_info"]];
-            [self.microlectures addObject:lecture];
+        else {
+            strongSelf.page += 1;
         }
-        dispatch_async(dispatch_get_main_queue(), ^{
-            [self.microCollectionView reloadData];
-        });
-        self.navigationItem.title = [NSString stringWithFormat:@"MicroLectures(%lu)",(unsigned long)self.microlectures.count];
     }
                 failure:^(NSURLSessionDataTask * _Nullable task, NSError * _Nonnull error) {
         NSLog(@"ERROR: %@",error);
@@ -7,6 +7,7 @@
 
 #import "SceneDelegate.h"
 #import "BNRItemStore.h"
+#import "BNRBlobStore.h"
 #import "AppDelegateAndSceneDelegate.h"
 
 @interface SceneDelegate ()
@@ -67,6 +68,8 @@
     else {
         NSLog(@"Could not save any of the BNRItems");
     }
+    // 图片索引的改动是延迟写盘的，进后台前写下去
+    [[BNRBlobStore sharedStore] synchronize];
 }
 
 
@@ -0,0 +1,53 @@
+//
+//  BNRBlobStore.h
+//  HypnoNerd
+//
+//  Created by HuXin on 2026/10/18.
+//
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/// 按内容寻址的数据存储：文件名是内容的 SHA-256，同样的内容只存一份。
+/// 调用方用自己的 key（比如条目的 itemKey）引用数据，每份数据按引用它的 key 计数，
+/// 最后一个 key 被移除时删除文件。HypnoNerd 和 HXSwiftStudy 两个工程共用这份实现。
+/// 所有方法都是线程安全的。
+@interface BNRBlobStore : NSObject
+
+/// Application Support/Blobs 下的共享实例
++ (instancetype)sharedStore;
+
+- (instancetype)initWithDirectory:(NSString *)directory NS_DESIGNATED_INITIALIZER;
+
+- (instancetype)init NS_UNAVAILABLE;
+
+/// 让 key 指向 data，返回内容的哈希。key 原来指向的数据引用数减一
+- (NSString *)setData:(NSData *)data forKey:(NSString *)key;
+- (nullable NSData *)dataForKey:(NSString *)key;
+- (nullable NSString *)contentHashForKey:(NSString *)key;
+/// key 指向的文件路径，没有时返回 nil
+- (nullable NSString *)pathForKey:(NSString *)key;
+- (void)removeDataForKey:(NSString *)key;
+
+/// 移除以 prefix 开头、不在 liveKeys 里、并且在 date 之前设置的 key。
+/// 给没法逐个移除 key 的调用方用：从持久化的数据里收集还在用的 key，其余的都清掉；
+/// date 用来保护收集期间新设置的 key
+- (void)removeKeysWithPrefix:(NSString *)prefix notInSet:(NSSet<NSString *> *)liveKeys setBefore:(NSDate *)date;
+
+/// 索引的改动合并起来延迟写盘，这里立即写下去，进入后台时调用。写失败时返回 NO
+- (BOOL)synchronize;
+
+/// 删除目录里没有被任何 key 引用的文件（比如写完文件、还没记下索引时崩溃留下的），返回删除的文件数
+- (NSUInteger)collectGarbage;
+
+/// 实际占用的字节数
+@property (nonatomic, readonly) unsigned long long storedBytes;
+/// 如果每个 key 各存一份要占用的字节数
+@property (nonatomic, readonly) unsigned long long referencedBytes;
+/// 去重省下的字节数
+@property (nonatomic, readonly) unsigned long long bytesSaved;
+
+@end
+
+NS_ASSUME_NONNULL_END
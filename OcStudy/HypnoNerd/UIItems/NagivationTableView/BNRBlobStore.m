@@ -0,0 +1,287 @@
+//
+//  BNRBlobStore.m
+//  HypnoNerd
+//
+//  Created by HuXin on 2026/10/18.
+//
+
+#import "BNRBlobStore.h"
+#import <CommonCrypto/CommonDigest.h>
+
+// 索引：{ key : { hash, size, date } }，引用计数和每份数据的大小在加载时从索引里算出来
+static NSString * const BNRBlobIndexFileName = @"index.plist";
+static NSString * const BNRBlobHashKey = @"hash";
+static NSString * const BNRBlobSizeKey = @"size";
+static NSString * const BNRBlobDateKey = @"date";
+/// 索引改动后隔这么久才写盘，这段时间里的改动合并成一次写入
+static const NSTimeInterval BNRBlobIndexFlushDelay = 1.0;
+
+static NSString *BNRBlobHash(NSData *data) {
+    unsigned char digest[CC_SHA256_DIGEST_LENGTH];
+    CC_SHA256(data.bytes, (CC_LONG)data.length, digest);
+    
+    NSMutableString *hash = [NSMutableString stringWithCapacity:CC_SHA256_DIGEST_LENGTH * 2];
+    for (int i = 0; i < CC_SHA256_DIGEST_LENGTH; i++) {
+        [hash appendFormat:@"%02x", digest[i]];
+    }
+    return hash;
+}
+
+@interface BNRBlobStore ()
+
+@property (nonatomic, copy) NSString *directory;
+/// 下面的状态只在这个串行队列上访问
+@property (nonatomic, strong) dispatch_queue_t queue;
+@property (nonatomic, strong) NSMutableDictionary<NSString *, NSDictionary *> *entries;
+@property (nonatomic, strong) NSMutableDictionary<NSString *, NSNumber *> *referenceCounts;
+@property (nonatomic, strong) NSMutableDictionary<NSString *, NSNumber *> *sizes;
+/// 内存里的索引有还没写盘的改动
+@property (nonatomic) BOOL indexDirty;
+@property (nonatomic) BOOL indexFlushScheduled;
+/// 已经没有引用的文件，等索引写下去以后再删
+@property (nonatomic, strong) NSMutableSet<NSString *> *pendingDeadHashes;
+
+@end
+
+@implementation BNRBlobStore
+
++ (instancetype)sharedStore {
+    static BNRBlobStore *sharedStore = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        NSString *supportDirectory = [NSSearchPathForDirectoriesInDomains(NSApplicationSupportDirectory, NSUserDomainMask, YES) firstObject];
+        sharedStore = [[self alloc] initWithDirectory:[supportDirectory stringByAppendingPathComponent:@"Blobs"]];
+    });
+    return sharedStore;
+}
+
+- (instancetype)initWithDirectory:(NSString *)directory {
+    if (self = [super init]) {
+        _directory = [directory copy];
+        _queue = dispatch_queue_create("com.huxin.blobStore", DISPATCH_QUEUE_SERIAL);
+        _referenceCounts = [NSMutableDictionary dictionary];
+        _sizes = [NSMutableDictionary dictionary];
+        _pendingDeadHashes = [NSMutableSet set];
+        
+        [[NSFileManager defaultManager] createDirectoryAtPath:directory withIntermediateDirectories:YES attributes:nil error:nil];
+        [self loadIndex];
+    }
+    return self;
+}
+
+#pragma mark - Index
+
+- (NSString *)indexPath {
+    return [self.directory stringByAppendingPathComponent:BNRBlobIndexFileName];
+}
+
+- (NSString *)pathForHash:(NSString *)hash {
+    return [self.directory stringByAppendingPathComponent:hash];
+}
+
+- (void)loadIndex {
+    NSDictionary *index = [NSDictionary dictionaryWithContentsOfFile:[self indexPath]];
+    self.entries = index ? [index mutableCopy] : [NSMutableDictionary dictionary];
+    
+    for (NSDictionary *entry in self.entries.allValues) {
+        NSString *hash = entry[BNRBlobHashKey];
+        self.referenceCounts[hash] = @(self.referenceCounts[hash].unsignedIntegerValue + 1);
+        self.sizes[hash] = entry[BNRBlobSizeKey];
+    }
+}
+
+/// 引用数减一，返回已经没有引用、需要删除文件的哈希
+- (nullable NSString *)releaseHash:(NSString *)hash {
+    NSUInteger count = self.referenceCounts[hash].unsignedIntegerValue;
+    if (count > 1) {
+        self.referenceCounts[hash] = @(count - 1);
+        return nil;
+    }
+    [self.referenceCounts removeObjectForKey:hash];
+    [self.sizes removeObjectForKey:hash];
+    return hash;
+}
+
+/// 索引改过以后调用，不马上写盘：批量导入时每次改动都重写整个索引是 O(n²) 的。
+/// deadHashes 的文件等索引写下去以后再删
+- (void)scheduleIndexFlushRemovingHashes:(NSArray<NSString *> *)deadHashes {
+    [self.pendingDeadHashes addObjectsFromArray:deadHashes];
+    self.indexDirty = YES;
+    if (self.indexFlushScheduled) {
+        return;
+    }
+    self.indexFlushScheduled = YES;
+    
+    dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(BNRBlobIndexFlushDelay * NSEC_PER_SEC)), self.queue, ^{
+        self.indexFlushScheduled = NO;
+        [self flushIndex];
+    });
+}
+
+/// 先把索引写下去再删文件，中间崩溃只会留下没被引用的文件，由 collectGarbage 清理。
+/// 等待期间又被引用的文件不删。只在 queue 上调用
+- (BOOL)flushIndex {
+    if (!self.indexDirty) {
+        return YES;
+    }
+    if (![self.entries writeToFile:[self indexPath] atomically:YES]) {
+        NSLog(@"Could not write blob index");
+        return NO;
+    }
+    self.indexDirty = NO;
+    
+    for (NSString *hash in self.pendingDeadHashes) {
+        if (!self.referenceCounts[hash]) {
+            [[NSFileManager defaultManager] removeItemAtPath:[self pathForHash:hash] error:nil];
+        }
+    }
+    [self.pendingDeadHashes removeAllObjects];
+    return YES;
+}
+
+- (BOOL)synchronize {
+    __block BOOL success = NO;
+    dispatch_sync(self.queue, ^{
+        success = [self flushIndex];
+    });
+    return success;
+}
+
+#pragma mark - Access
+
+- (NSString *)setData:(NSData *)data forKey:(NSString *)key {
+    NSString *hash = BNRBlobHash(data);
+    
+    dispatch_sync(self.queue, ^{
+        NSString *previousHash = self.entries[key][BNRBlobHashKey];
+        if ([previousHash isEqualToString:hash]) {
+            return;
+        }
+        
+        NSString *path = [self pathForHash:hash];
+        if (!self.referenceCounts[hash] && ![[NSFileManager defaultManager] fileExistsAtPath:path]) {
+            if (![data writeToFile:path atomically:YES]) {
+                NSLog(@"Could not write blob %@", hash);
+            }
+        }
+        
+        self.entries[key] = @{BNRBlobHashKey : hash, BNRBlobSizeKey : @(data.length), BNRBlobDateKey : [NSDate date]};
+        self.referenceCounts[hash] = @(self.referenceCounts[hash].unsignedIntegerValue + 1);
+        self.sizes[hash] = @(data.length);
+        
+        NSString *deadHash = previousHash ? [self releaseHash:previousHash] : nil;
+        [self scheduleIndexFlushRemovingHashes:deadHash ? @[deadHash] : @[]];
+    });
+    return hash;
+}
+
+- (NSString *)contentHashForKey:(NSString *)key {
+    __block NSString *hash = nil;
+    dispatch_sync(self.queue, ^{
+        hash = self.entries[key][BNRBlobHashKey];
+    });
+    return hash;
+}
+
+- (NSString *)pathForKey:(NSString *)key {
+    NSString *hash = [self contentHashForKey:key];
+    return hash ? [self pathForHash:hash] : nil;
+}
+
+- (NSData *)dataForKey:(NSString *)key {
+    NSString *path = [self pathForKey:key];
+    return path ? [NSData dataWithContentsOfFile:path options:NSDataReadingMappedIfSafe error:nil] : nil;
+}
+
+- (void)removeDataForKey:(NSString *)key {
+    dispatch_sync(self.queue, ^{
+        NSString *hash = self.entries[key][BNRBlobHashKey];
+        if (!hash) {
+            return;
+        }
+        [self.entries removeObjectForKey:key];
+        NSString *deadHash = [self releaseHash:hash];
+        [self scheduleIndexFlushRemovingHashes:deadHash ? @[deadHash] : @[]];
+    });
+}
+
+#pragma mark - Garbage collection
+
+- (void)removeKeysWithPrefix:(NSString *)prefix notInSet:(NSSet<NSString *> *)liveKeys setBefore:(NSDate *)date {
+    dispatch_sync(self.queue, ^{
+        NSMutableArray<NSString *> *deadHashes = [NSMutableArray array];
+        BOOL removedKeys = NO;
+        for (NSString *key in self.entries.allKeys) {
+            NSDictionary *entry = self.entries[key];
+            if (![key hasPrefix:prefix] || [liveKeys containsObject:key]
+                || [entry[BNRBlobDateKey] compare:date] != NSOrderedAscending) {
+                continue;
+            }
+            [self.entries removeObjectForKey:key];
+            removedKeys = YES;
+            NSString *deadHash = [self releaseHash:entry[BNRBlobHashKey]];
+            if (deadHash) {
+                [deadHashes addObject:deadHash];
+            }
+        }
+        // 文件还被别的 key 引用时也要把去掉的 key 写下去
+        if (removedKeys) {
+            [self scheduleIndexFlushRemovingHashes:deadHashes];
+        }
+    });
+}
+
+- (NSUInteger)collectGarbage {
+    __block NSUInteger removed = 0;
+    dispatch_sync(self.queue, ^{
+        // 磁盘上的索引可能还引用着等待删除的文件，先写下去才能删
+        if (![self flushIndex]) {
+            return;
+        }
+        NSArray<NSString *> *files = [[NSFileManager defaultManager] contentsOfDirectoryAtPath:self.directory error:nil];
+        for (NSString *file in files) {
+            if ([file isEqualToString:BNRBlobIndexFileName] || self.referenceCounts[file]) {
+                continue;
+            }
+            if ([[NSFileManager defaultManager] removeItemAtPath:[self pathForHash:file] error:nil]) {
+                removed++;
+            }
+        }
+    });
+    return removed;
+}
+
+#pragma mark - Metrics
+
+- (unsigned long long)storedBytes {
+    __block unsigned long long bytes = 0;
+    dispatch_sync(self.queue, ^{
+        for (NSNumber *size in self.sizes.allValues) {
+            bytes += size.unsignedLongLongValue;
+        }
+    });
+    return bytes;
+}
+
+- (unsigned long long)referencedBytes {
+    __block unsigned long long bytes = 0;
+    dispatch_sync(self.queue, ^{
+        for (NSDictionary *entry in self.entries.allValues) {
+            bytes += [entry[BNRBlobSizeKey] unsignedLongLongValue];
+        }
+    });
+    return bytes;
+}
+
+- (unsigned long long)bytesSaved {
+    // 每份数据多出来的引用都是省下的
+    __block unsigned long long saved = 0;
+    dispatch_sync(self.queue, ^{
+        [self.referenceCounts enumerateKeysAndObjectsUsingBlock:^(NSString *hash, NSNumber *count, BOOL *stop) {
+            saved += (count.unsignedLongLongValue - 1) * self.sizes[hash].unsignedLongLongValue;
+        }];
+    });
+    return saved;
+}
+
+@end
@@ -182,7 +182,8 @@
 //        [defaults setInteger:newValue forKey:BNRNextItemValuePrefsKey];
 //    }
     item.valueInDollars = [self.valueField.text intValue];
-    item.itemImage.image = self.imageView.image;
+    
+    [[BNRItemStore sharedStore] itemDidChange:item];
 }
 
 - (void)setItem:(BNRTtem *)item {
@@ -197,6 +198,7 @@
     item.itemName = self.nameField.text;
     item.serialNumber = self.serialNumberField.text;
     item.valueInDollars = [self.valueField.text intValue];
+    [[BNRItemStore sharedStore] itemDidChange:item];
 
     if ([self.delegate respondsToSelector:@selector(addName:serial:value:)]) {
         [self.delegate addName:self.nameField.text serial:self.serialNumberField.text value:self.valueField.text];
@@ -250,8 +252,8 @@
     UIImage *image = info[UIImagePickerControllerOriginalImage];
     
     [[BNRImageStore sharedStore] setImage:image forKey:self.item.itemKey];
-    self.item.itemImage.image = image;
-    self.imageView.image = self.item.itemImage.image;
+    // 原图只交给 BNRImageStore 落盘，不再挂在条目上常驻内存
+    self.imageView.image = image;
     
     [self dismissViewControllerAnimated:YES completion:nil];
 }
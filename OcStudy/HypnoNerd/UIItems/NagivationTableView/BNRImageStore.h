@@ -10,15 +10,29 @@
 
 NS_ASSUME_NONNULL_BEGIN
 
+/// 缩略图的边长（point），和列表 cell 里的图片一样大
+extern const CGFloat BNRImageStoreThumbnailSide;
+
+/// 原图只放在磁盘上，内存里只缓存解码好的缩略图。
+/// 编码、写盘、生成缩略图都在后台串行队列上做，回调都在主线程。
 @interface BNRImageStore : NSObject
 
 + (instancetype)sharedStore;
 
+/// 缩略图缓存的内存上限（字节），默认 16MB
+@property (nonatomic) NSUInteger thumbnailCacheCostLimit;
+
 - (void)setImage:(UIImage *)image forKey:(NSString *)key;
-- (UIImage *)imageForKey:(NSString *)key;
+/// 同步从磁盘读原图，只在需要显示大图时用
+- (nullable UIImage *)imageForKey:(NSString *)key;
 - (void)deleteImageForKey:(NSString *)key;
+/// 原图文件的路径，已经存进 BNRBlobStore 的返回内容文件的路径
 - (NSString *)imagePathForKey:(NSString *)key;
 
+/// 缓存里有的话直接返回并且同步回调；否则返回 nil，在后台读取或生成后回调，没有图片时回调 nil。
+/// 同一个 key 同时发起的多次请求只读一次磁盘
+- (nullable UIImage *)thumbnailForKey:(NSString *)key completion:(void (^)(UIImage * _Nullable thumbnail))completion;
+
 @end
 
 NS_ASSUME_NONNULL_END
@@ -6,10 +6,21 @@
 //
 
 #import "BNRImageStore.h"
+#import "BNRBlobStore.h"
+
+const CGFloat BNRImageStoreThumbnailSide = 80;
 
 @interface BNRImageStore ()
 
-@property (nonatomic, strong) NSMutableDictionary *dictionary;
+/// 还没写完盘的原图，写完就移除，保证写盘期间 imageForKey: 也能拿到
+@property (nonatomic, strong) NSMutableDictionary<NSString *, UIImage *> *pendingImages;
+/// 解码好的缩略图，cost 是位图的字节数
+@property (nonatomic, strong) NSCache<NSString *, UIImage *> *thumbnails;
+/// 正在后台加载的缩略图和等待的回调，只在主线程访问
+@property (nonatomic, strong) NSMutableDictionary<NSString *, NSMutableArray *> *thumbnailWaiters;
+/// 磁盘读写都在这个串行队列上，删除排在写入之后，不会被之前的写入复活
+@property (nonatomic, strong) dispatch_queue_t ioQueue;
+@property (nonatomic) CGFloat screenScale;
 
 @end
 
@@ -33,54 +44,211 @@
     self = [super init];
     
     if (self) {
-        _dictionary = [[NSMutableDictionary alloc] init];
+        _pendingImages = [[NSMutableDictionary alloc] init];
+        _thumbnails = [[NSCache alloc] init];
+        _thumbnails.name = @"BNRImageStore.thumbnails";
+        _thumbnails.totalCostLimit = 16 * 1024 * 1024;
+        _thumbnailWaiters = [[NSMutableDictionary alloc] init];
+        _ioQueue = dispatch_queue_create("com.huxin.imageStore", DISPATCH_QUEUE_SERIAL);
+        _screenScale = [UIScreen mainScreen].scale;
+        
+        [[NSFileManager defaultManager] createDirectoryAtPath:[self thumbnailDirectory] withIntermediateDirectories:YES attributes:nil error:nil];
     }
     return  self;
 }
 
+- (NSUInteger)thumbnailCacheCostLimit {
+    return self.thumbnails.totalCostLimit;
+}
+
+- (void)setThumbnailCacheCostLimit:(NSUInteger)thumbnailCacheCostLimit {
+    self.thumbnails.totalCostLimit = thumbnailCacheCostLimit;
+}
+
+#pragma mark - Full-size images
+
 - (void)setImage:(UIImage *)image forKey:(NSString *)key {
-    self.dictionary[key] = image;
-    
-    NSString *imagePath = [self imagePathForKey:key];
+    self.pendingImages[key] = image;
+    [self.thumbnails removeObjectForKey:key];
     
-    NSData *data = UIImageJPEGRepresentation(image, 0.5);
+    NSString *thumbnailPath = [self thumbnailPathForKey:key];
     
-    [data writeToFile:imagePath atomically:YES];
+    dispatch_async(self.ioQueue, ^{
+        // 原图按内容存进 BNRBlobStore，同一张照片用在多个条目上只存一份
+        NSData *data = UIImageJPEGRepresentation(image, 0.5);
+        if (data) {
+            [[BNRBlobStore sharedStore] setData:data forKey:key];
+        }
+        [[NSFileManager defaultManager] removeItemAtPath:[self legacyImagePathForKey:key] error:nil];
+        
+        UIImage *thumbnail = [self renderThumbnailFromImage:image];
+        [UIImageJPEGRepresentation(thumbnail, 0.8) writeToFile:thumbnailPath atomically:YES];
+        
+        dispatch_async(dispatch_get_main_queue(), ^{
+            // 写盘期间又设置了新图片的话，留给新图片的写入来清理
+            if (self.pendingImages[key] == image) {
+                [self.pendingImages removeObjectForKey:key];
+                [self cacheThumbnail:thumbnail forKey:key];
+            }
+        });
+    });
 }
 
 - (UIImage *)imageForKey:(NSString *)key {
-    UIImage *result = self.dictionary[key];
+    UIImage *result = self.pendingImages[key];
     
     if (!result) {
-        NSString *imagePath = [self imagePathForKey:key];
+        result = [self storedImageForKey:key];
         
-        result = [UIImage imageWithContentsOfFile:imagePath];
-        
-        if (result) {
-            self.dictionary[key] = result;
-        }
-        else {
+        if (!result) {
             NSLog(@"Error: unable to find %@", [self imagePathForKey:key]);
         }
     }
     return result;
 }
 
+/// 旧版本把原图按 key 直接存在 Documents 下，读到时顺便挪进 BNRBlobStore
+- (UIImage *)storedImageForKey:(NSString *)key {
+    NSData *data = [[BNRBlobStore sharedStore] dataForKey:key];
+    if (!data) {
+        NSString *legacyPath = [self legacyImagePathForKey:key];
+        data = [NSData dataWithContentsOfFile:legacyPath];
+        if (data) {
+            [[BNRBlobStore sharedStore] setData:data forKey:key];
+            [[NSFileManager defaultManager] removeItemAtPath:legacyPath error:nil];
+        }
+    }
+    return data ? [UIImage imageWithData:data] : nil;
+}
+
 - (void)deleteImageForKey:(NSString *)key {
     if (!key) {
         return;
     }
-    [self.dictionary removeObjectForKey:key];
+    [self.pendingImages removeObjectForKey:key];
+    [self.thumbnails removeObjectForKey:key];
     
-    NSString *imagePath = [self imagePathForKey:key];
-    [[NSFileManager defaultManager] removeItemAtPath:imagePath error:nil];
+    NSArray *waiters = self.thumbnailWaiters[key];
+    [self.thumbnailWaiters removeObjectForKey:key];
+    for (void (^callback)(UIImage *) in waiters) {
+        callback(nil);
+    }
+    
+    NSString *thumbnailPath = [self thumbnailPathForKey:key];
+    dispatch_async(self.ioQueue, ^{
+        [[BNRBlobStore sharedStore] removeDataForKey:key];
+        [[NSFileManager defaultManager] removeItemAtPath:[self legacyImagePathForKey:key] error:nil];
+        [[NSFileManager defaultManager] removeItemAtPath:thumbnailPath error:nil];
+    });
 }
 
 - (NSString *)imagePathForKey:(NSString *)key {
+    return [[BNRBlobStore sharedStore] pathForKey:key] ?: [self legacyImagePathForKey:key];
+}
+
+- (NSString *)legacyImagePathForKey:(NSString *)key {
     NSArray *documentDirectories = NSSearchPathForDirectoriesInDomains(NSDocumentDirectory, NSUserDomainMask, YES);
     
     NSString *documentDirectory = [documentDirectories firstObject];
     
     return [documentDirectory stringByAppendingPathComponent:key];
 }
+
+#pragma mark - Thumbnails
+
+- (UIImage *)thumbnailForKey:(NSString *)key completion:(void (^)(UIImage *))completion {
+    UIImage *cached = [self.thumbnails objectForKey:key];
+    if (cached) {
+        completion(cached);
+        return cached;
+    }
+    
+    NSMutableArray *waiters = self.thumbnailWaiters[key];
+    if (waiters) {
+        [waiters addObject:[completion copy]];
+        return nil;
+    }
+    waiters = [NSMutableArray arrayWithObject:[completion copy]];
+    self.thumbnailWaiters[key] = waiters;
+    
+    // 原图还没写完时直接用内存里的原图生成
+    UIImage *pendingImage = self.pendingImages[key];
+    NSString *thumbnailPath = [self thumbnailPathForKey:key];
+    
+    dispatch_async(self.ioQueue, ^{
+        UIImage *thumbnail = nil;
+        // 文件名不带 @2x，按屏幕 scale 读回，和生成时的尺寸一致
+        NSData *storedData = [NSData dataWithContentsOfFile:thumbnailPath];
+        UIImage *stored = storedData ? [UIImage imageWithData:storedData scale:self.screenScale] : nil;
+        if (stored) {
+            thumbnail = [self decodedImage:stored];
+        } else {
+            // 旧版本只存了原图，第一次用到时补上缩略图
+            UIImage *image = pendingImage ?: [self storedImageForKey:key];
+            if (image) {
+                thumbnail = [self renderThumbnailFromImage:image];
+                [UIImageJPEGRepresentation(thumbnail, 0.8) writeToFile:thumbnailPath atomically:YES];
+            }
+        }
+        
+        dispatch_async(dispatch_get_main_queue(), ^{
+            // 加载期间图片被删除了，回调已经在删除时调过
+            if (self.thumbnailWaiters[key] != waiters) {
+                return;
+            }
+            [self.thumbnailWaiters removeObjectForKey:key];
+            if (thumbnail) {
+                [self cacheThumbnail:thumbnail forKey:key];
+            }
+            for (void (^callback)(UIImage *) in waiters) {
+                callback(thumbnail);
+            }
+        });
+    });
+    return nil;
+}
+
+- (void)cacheThumbnail:(UIImage *)thumbnail forKey:(NSString *)key {
+    CGImageRef cgImage = thumbnail.CGImage;
+    NSUInteger cost = cgImage ? CGImageGetBytesPerRow(cgImage) * CGImageGetHeight(cgImage) : 0;
+    [self.thumbnails setObject:thumbnail forKey:key cost:cost];
+}
+
+/// 按 aspect fill 缩放裁剪成正方形，结果已经是解码好的位图
+- (UIImage *)renderThumbnailFromImage:(UIImage *)image {
+    CGFloat side = BNRImageStoreThumbnailSide;
+    CGSize size = image.size;
+    CGFloat ratio = MAX(side / MAX(size.width, 1), side / MAX(size.height, 1));
+    CGRect drawRect = CGRectMake((side - size.width * ratio) / 2, (side - size.height * ratio) / 2, size.width * ratio, size.height * ratio);
+    
+    UIGraphicsImageRendererFormat *format = [UIGraphicsImageRendererFormat preferredFormat];
+    format.scale = self.screenScale;
+    format.opaque = YES;
+    UIGraphicsImageRenderer *renderer = [[UIGraphicsImageRenderer alloc] initWithSize:CGSizeMake(side, side) format:format];
+    return [renderer imageWithActions:^(UIGraphicsImageRendererContext *context) {
+        [image drawInRect:drawRect];
+    }];
+}
+
+/// 从文件读出的 JPEG 要到第一次显示时才在主线程解码，这里提前在后台画一遍
+- (UIImage *)decodedImage:(UIImage *)image {
+    UIGraphicsImageRendererFormat *format = [UIGraphicsImageRendererFormat preferredFormat];
+    format.scale = image.scale;
+    format.opaque = YES;
+    UIGraphicsImageRenderer *renderer = [[UIGraphicsImageRenderer alloc] initWithSize:image.size format:format];
+    return [renderer imageWithActions:^(UIGraphicsImageRendererContext *context) {
+        [image drawAtPoint:CGPointZero];
+    }];
+}
+
+/// 缩略图可以从原图重新生成，放在 Caches 里
+- (NSString *)thumbnailDirectory {
+    NSString *cachesDirectory = [NSSearchPathForDirectoriesInDomains(NSCachesDirectory, NSUserDomainMask, YES) firstObject];
+    return [cachesDirectory stringByAppendingPathComponent:@"Thumbnails"];
+}
+
+- (NSString *)thumbnailPathForKey:(NSString *)key {
+    return [[self thumbnailDirectory] stringByAppendingPathComponent:key];
+}
+
 @end
@@ -12,6 +12,9 @@
 
 @interface BNRItemCellTableViewCell ()
 
+/// cell 会被复用，缩略图异步回来时用它判断是不是还在显示同一个条目
+@property (nonatomic, copy) NSString *representedItemKey;
+
 @end
 
 @implementation BNRItemCellTableViewCell
@@ -66,10 +69,19 @@
 }
 
 - (void)setBNRItemLabel:(BNRTtem *)item {
-    NSString *imagePath = [[BNRImageStore sharedStore] imagePathForKey:item.itemKey];
     self.nameLabel.text = item.itemName;
     self.nameLabel.textAlignment = NSTextAlignmentCenter;
     self.valueLAbel.text = [NSString stringWithFormat:@"%d", item.valueInDollars];
-    self.cellImage.image = [UIImage imageWithContentsOfFile:imagePath];
+    
+    NSString *itemKey = item.itemKey;
+    self.representedItemKey = itemKey;
+    __weak typeof(self) weakSelf = self;
+    UIImage *thumbnail = [[BNRImageStore sharedStore] thumbnailForKey:itemKey completion:^(UIImage *image) {
+        if ([weakSelf.representedItemKey isEqualToString:itemKey]) {
+            weakSelf.cellImage.image = image;
+        }
+    }];
+    // 缓存没命中时先清掉复用前的图片，等异步回调
+    self.cellImage.image = thumbnail;
 }
 @end
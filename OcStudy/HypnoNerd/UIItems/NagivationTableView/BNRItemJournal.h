@@ -0,0 +1,41 @@
+//
+//  BNRItemJournal.h
+//  HypnoNerd
+//
+//  Created by HuXin on 2026/10/18.
+//
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/// 条目的持久化：一个压缩快照加一个只追加的操作日志。
+/// 每次修改只往日志末尾追加一条记录，日志变大后再合并成新的快照。
+/// 条目以归档后的 NSData 存取，是否解码由调用方决定。
+@interface BNRItemJournal : NSObject
+
+- (instancetype)initWithDirectory:(NSString *)directory;
+
+- (instancetype)init NS_UNAVAILABLE;
+
+/// 读取快照并重放日志，返回按顺序排列的条目归档数据。
+/// 日志末尾写了一半的记录会被丢弃并截掉。
+- (NSMutableArray<NSData *> *)loadItemData;
+
+- (void)appendInsertItemData:(NSData *)data atIndex:(NSUInteger)index;
+- (void)appendUpdateItemData:(NSData *)data atIndex:(NSUInteger)index;
+- (void)appendMoveFromIndex:(NSUInteger)fromIndex toIndex:(NSUInteger)toIndex;
+- (void)appendRemoveAtIndex:(NSUInteger)index;
+
+/// 把日志刷到磁盘
+- (BOOL)synchronize;
+
+/// 日志相对快照已经足够大，值得合并
+@property (nonatomic, readonly) BOOL needsCompaction;
+
+/// 用完整的条目数据写一个新快照并清空日志，写入过程中崩溃不会丢数据
+- (BOOL)compactWithItemData:(NSArray<NSData *> *)itemData;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,320 @@
+//
+//  BNRItemJournal.m
+//  HypnoNerd
+//
+//  Created by HuXin on 2026/10/18.
+//
+
+#import "BNRItemJournal.h"
+
+// 快照：magic(8) generation(8) count(4)，之后每个条目是 length(4) + 归档数据
+// 日志：magic(8) generation(8)，之后每条记录是 length(4) checksum(4) + payload
+// payload：op(1) first(4) second(4) + 可选的条目归档数据
+// 合并时先写 generation + 1 的快照再重置日志，两步之间崩溃的话，旧 generation 的日志在加载时会被忽略
+static const char *BNRItemSnapshotMagic = "BNRSNAP1";
+static const char *BNRItemJournalMagic = "BNRJRNL1";
+static const NSUInteger BNRItemFileHeaderLength = 16;
+static const NSUInteger BNRItemRecordHeaderLength = 8;
+static const NSUInteger BNRItemRecordPayloadHeaderLength = 9;
+
+typedef NS_ENUM(uint8_t, BNRItemJournalOperation) {
+    BNRItemJournalOperationInsert = 1,
+    BNRItemJournalOperationUpdate,
+    BNRItemJournalOperationMove,
+    BNRItemJournalOperationRemove,
+};
+
+static uint32_t BNRItemChecksum(const uint8_t *bytes, NSUInteger length) {
+    // FNV-1a，只用来发现写了一半的记录
+    uint32_t hash = 2166136261u;
+    for (NSUInteger i = 0; i < length; i++) {
+        hash ^= bytes[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+static uint32_t BNRItemReadUInt32(const uint8_t *bytes) {
+    uint32_t value;
+    memcpy(&value, bytes, sizeof(value));
+    return CFSwapInt32LittleToHost(value);
+}
+
+static uint64_t BNRItemReadUInt64(const uint8_t *bytes) {
+    uint64_t value;
+    memcpy(&value, bytes, sizeof(value));
+    return CFSwapInt64LittleToHost(value);
+}
+
+static void BNRItemAppendUInt32(NSMutableData *data, uint32_t value) {
+    uint32_t littleEndian = CFSwapInt32HostToLittle(value);
+    [data appendBytes:&littleEndian length:sizeof(littleEndian)];
+}
+
+static void BNRItemAppendUInt64(NSMutableData *data, uint64_t value) {
+    uint64_t littleEndian = CFSwapInt64HostToLittle(value);
+    [data appendBytes:&littleEndian length:sizeof(littleEndian)];
+}
+
+@interface BNRItemJournal ()
+
+@property (nonatomic, copy) NSString *snapshotPath;
+@property (nonatomic, copy) NSString *journalPath;
+@property (nonatomic, strong) NSFileHandle *journalHandle;
+@property (nonatomic) uint64_t generation;
+@property (nonatomic) NSUInteger snapshotLength;
+@property (nonatomic) NSUInteger journalLength;
+
+@end
+
+@implementation BNRItemJournal
+
+- (instancetype)initWithDirectory:(NSString *)directory {
+    if (self = [super init]) {
+        _snapshotPath = [directory stringByAppendingPathComponent:@"items.snapshot"];
+        _journalPath = [directory stringByAppendingPathComponent:@"items.journal"];
+    }
+    return self;
+}
+
+- (void)dealloc {
+    [_journalHandle closeFile];
+}
+
+#pragma mark - Loading
+
+- (NSMutableArray<NSData *> *)loadItemData {
+    NSMutableArray<NSData *> *items = [NSMutableArray array];
+
+    NSData *snapshot = [NSData dataWithContentsOfFile:self.snapshotPath options:NSDataReadingMappedIfSafe error:nil];
+    uint64_t generation = 0;
+    if (snapshot && ![self readSnapshot:snapshot intoItems:items generation:&generation]) {
+        NSLog(@"Discarding corrupted item snapshot");
+        [items removeAllObjects];
+        generation = 0;
+    }
+    self.generation = generation;
+    self.snapshotLength = snapshot.length;
+
+    NSData *journal = [NSData dataWithContentsOfFile:self.journalPath options:NSDataReadingMappedIfSafe error:nil];
+    NSUInteger validLength = 0;
+    if ([self isFile:journal withMagic:BNRItemJournalMagic]
+        && BNRItemReadUInt64((const uint8_t *)journal.bytes + 8) == generation) {
+        validLength = [self replayJournal:journal intoItems:items];
+    }
+    [self openJournalKeepingLength:validLength];
+
+    return items;
+}
+
+- (BOOL)isFile:(NSData *)data withMagic:(const char *)magic {
+    return data.length >= BNRItemFileHeaderLength && memcmp(data.bytes, magic, 8) == 0;
+}
+
+- (BOOL)readSnapshot:(NSData *)snapshot intoItems:(NSMutableArray<NSData *> *)items generation:(uint64_t *)generation {
+    if (![self isFile:snapshot withMagic:BNRItemSnapshotMagic] || snapshot.length < BNRItemFileHeaderLength + 4) {
+        return NO;
+    }
+
+    const uint8_t *bytes = snapshot.bytes;
+    NSUInteger length = snapshot.length;
+    *generation = BNRItemReadUInt64(bytes + 8);
+    uint32_t count = BNRItemReadUInt32(bytes + BNRItemFileHeaderLength);
+
+    NSUInteger offset = BNRItemFileHeaderLength + 4;
+    for (uint32_t i = 0; i < count; i++) {
+        if (offset + 4 > length) {
+            return NO;
+        }
+        uint32_t itemLength = BNRItemReadUInt32(bytes + offset);
+        offset += 4;
+        if (offset + itemLength > length) {
+            return NO;
+        }
+        [items addObject:[snapshot subdataWithRange:NSMakeRange(offset, itemLength)]];
+        offset += itemLength;
+    }
+    return YES;
+}
+
+/// 返回最后一条完整记录之后的偏移
+- (NSUInteger)replayJournal:(NSData *)journal intoItems:(NSMutableArray<NSData *> *)items {
+    const uint8_t *bytes = journal.bytes;
+    NSUInteger length = journal.length;
+    NSUInteger offset = BNRItemFileHeaderLength;
+
+    while (offset + BNRItemRecordHeaderLength <= length) {
+        uint32_t payloadLength = BNRItemReadUInt32(bytes + offset);
+        uint32_t checksum = BNRItemReadUInt32(bytes + offset + 4);
+        const uint8_t *payload = bytes + offset + BNRItemRecordHeaderLength;
+
+        if (payloadLength < BNRItemRecordPayloadHeaderLength
+            || offset + BNRItemRecordHeaderLength + payloadLength > length
+            || BNRItemChecksum(payload, payloadLength) != checksum) {
+            break;
+        }
+
+        BNRItemJournalOperation operation = payload[0];
+        NSUInteger first = BNRItemReadUInt32(payload + 1);
+        NSUInteger second = BNRItemReadUInt32(payload + 5);
+        NSRange dataRange = NSMakeRange(offset + BNRItemRecordHeaderLength + BNRItemRecordPayloadHeaderLength,
+                                        payloadLength - BNRItemRecordPayloadHeaderLength);
+
+        BOOL applied = NO;
+        switch (operation) {
+            case BNRItemJournalOperationInsert:
+                if (first <= items.count) {
+                    [items insertObject:[journal subdataWithRange:dataRange] atIndex:first];
+                    applied = YES;
+                }
+                break;
+            case BNRItemJournalOperationUpdate:
+                if (first < items.count) {
+                    items[first] = [journal subdataWithRange:dataRange];
+                    applied = YES;
+                }
+                break;
+            case BNRItemJournalOperationMove:
+                if (first < items.count && second < items.count) {
+                    NSData *item = items[first];
+                    [items removeObjectAtIndex:first];
+                    [items insertObject:item atIndex:second];
+                    applied = YES;
+                }
+                break;
+            case BNRItemJournalOperationRemove:
+                if (first < items.count) {
+                    [items removeObjectAtIndex:first];
+                    applied = YES;
+                }
+                break;
+        }
+
+        if (!applied) {
+            break;
+        }
+        offset += BNRItemRecordHeaderLength + payloadLength;
+    }
+
+    if (offset < length) {
+        NSLog(@"Dropping %lu bytes of incomplete item journal", (unsigned long)(length - offset));
+    }
+    return offset;
+}
+
+- (void)openJournalKeepingLength:(NSUInteger)length {
+    [self.journalHandle closeFile];
+    self.journalHandle = nil;
+
+    if (length < BNRItemFileHeaderLength) {
+        NSMutableData *header = [NSMutableData dataWithBytes:BNRItemJournalMagic length:8];
+        BNRItemAppendUInt64(header, self.generation);
+        [header writeToFile:self.journalPath atomically:YES];
+        length = header.length;
+    }
+
+    self.journalHandle = [NSFileHandle fileHandleForUpdatingAtPath:self.journalPath];
+    @try {
+        [self.journalHandle truncateFileAtOffset:length];
+        [self.journalHandle seekToEndOfFile];
+    } @catch (NSException *exception) {
+        NSLog(@"Could not open item journal: %@", exception);
+    }
+    self.journalLength = length;
+}
+
+#pragma mark - Appending
+
+- (void)appendInsertItemData:(NSData *)data atIndex:(NSUInteger)index {
+    [self appendOperation:BNRItemJournalOperationInsert first:index second:0 data:data];
+}
+
+- (void)appendUpdateItemData:(NSData *)data atIndex:(NSUInteger)index {
+    [self appendOperation:BNRItemJournalOperationUpdate first:index second:0 data:data];
+}
+
+- (void)appendMoveFromIndex:(NSUInteger)fromIndex toIndex:(NSUInteger)toIndex {
+    [self appendOperation:BNRItemJournalOperationMove first:fromIndex second:toIndex data:nil];
+}
+
+- (void)appendRemoveAtIndex:(NSUInteger)index {
+    [self appendOperation:BNRItemJournalOperationRemove first:index second:0 data:nil];
+}
+
+- (void)appendOperation:(BNRItemJournalOperation)operation first:(NSUInteger)first second:(NSUInteger)second data:(NSData *)data {
+    NSMutableData *record = [NSMutableData dataWithLength:BNRItemRecordHeaderLength];
+    uint8_t op = operation;
+    [record appendBytes:&op length:1];
+    BNRItemAppendUInt32(record, (uint32_t)first);
+    BNRItemAppendUInt32(record, (uint32_t)second);
+    if (data) {
+        [record appendData:data];
+    }
+
+    uint8_t *bytes = record.mutableBytes;
+    uint32_t payloadLength = (uint32_t)(record.length - BNRItemRecordHeaderLength);
+    uint32_t header[2] = {
+        CFSwapInt32HostToLittle(payloadLength),
+        CFSwapInt32HostToLittle(BNRItemChecksum(bytes + BNRItemRecordHeaderLength, payloadLength)),
+    };
+    memcpy(bytes, header, sizeof(header));
+
+    @try {
+        [self.journalHandle writeData:record];
+        self.journalLength += record.length;
+    } @catch (NSException *exception) {
+        NSLog(@"Could not append to item journal: %@", exception);
+    }
+}
+
+- (BOOL)synchronize {
+    @try {
+        [self.journalHandle synchronizeFile];
+    } @catch (NSException *exception) {
+        NSLog(@"Could not synchronize item journal: %@", exception);
+        return NO;
+    }
+    return self.journalHandle != nil;
+}
+
+#pragma mark - Compaction
+
+- (BOOL)needsCompaction {
+    // 还没 loadItemData 时 journalLength 是 0, 比文件头还短
+    if (self.journalLength < BNRItemFileHeaderLength) {
+        return NO;
+    }
+    NSUInteger journalRecords = self.journalLength - BNRItemFileHeaderLength;
+    return journalRecords > MAX(64 * 1024, self.snapshotLength / 2);
+}
+
+- (BOOL)compactWithItemData:(NSArray<NSData *> *)itemData {
+    uint64_t generation = self.generation + 1;
+
+    NSUInteger capacity = BNRItemFileHeaderLength + 4;
+    for (NSData *data in itemData) {
+        capacity += 4 + data.length;
+    }
+
+    NSMutableData *snapshot = [NSMutableData dataWithCapacity:capacity];
+    [snapshot appendBytes:BNRItemSnapshotMagic length:8];
+    BNRItemAppendUInt64(snapshot, generation);
+    BNRItemAppendUInt32(snapshot, (uint32_t)itemData.count);
+    for (NSData *data in itemData) {
+        BNRItemAppendUInt32(snapshot, (uint32_t)data.length);
+        [snapshot appendData:data];
+    }
+
+    NSError *error = nil;
+    if (![snapshot writeToFile:self.snapshotPath options:NSDataWritingAtomic error:&error]) {
+        NSLog(@"Could not write item snapshot: %@", error);
+        return NO;
+    }
+
+    self.generation = generation;
+    self.snapshotLength = snapshot.length;
+    [self openJournalKeepingLength:0];
+    return YES;
+}
+
+@end
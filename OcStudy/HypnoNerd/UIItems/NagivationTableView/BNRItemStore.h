@@ -11,6 +11,50 @@
 
 NS_ASSUME_NONNULL_BEGIN
 
+/// 条目有变化时发出，同一轮主线程 runloop 里的修改合并成一次，userInfo 里是 BNRItemStoreChangeSetKey
+extern NSNotificationName const BNRItemStoreDidChangeNotification;
+extern NSString * const BNRItemStoreChangeSetKey;
+
+typedef NS_ENUM(NSInteger, BNRItemStoreChangeType) {
+    BNRItemStoreChangeInsert,
+    BNRItemStoreChangeUpdate,
+    BNRItemStoreChangeMove,
+    BNRItemStoreChangeRemove,
+};
+
+/// 一次修改，index 是修改发生时的下标，移动时 toIndex 是目标下标
+@interface BNRItemStoreChange : NSObject
+
+@property (nonatomic, readonly) BNRItemStoreChangeType type;
+@property (nonatomic, readonly) NSUInteger index;
+@property (nonatomic, readonly) NSUInteger toIndex;
+
+@end
+
+/// 从 fromVersion 到 toVersion 之间按顺序发生的修改
+@interface BNRItemStoreChangeSet : NSObject
+
+@property (nonatomic, readonly) NSUInteger fromVersion;
+@property (nonatomic, readonly) NSUInteger toVersion;
+@property (nonatomic, readonly) NSArray<BNRItemStoreChange *> *changes;
+/// 有插入、删除或移动，这时只能整体刷新或者按顺序逐条应用
+@property (nonatomic, readonly) BOOL containsStructuralChanges;
+/// 只有内容修改时被改过的下标，可以直接 reloadRowsAtIndexPaths
+@property (nonatomic, readonly) NSIndexSet *updatedIndexes;
+
+@end
+
+/// 某个版本的只读视图，创建是 O(1) 的，和 store 共用同一个数组，
+/// store 下次修改时才把数组复制一份给自己（写时复制）
+@interface BNRItemStoreSnapshot : NSObject
+
+@property (nonatomic, readonly) NSUInteger version;
+@property (nonatomic, readonly) NSUInteger count;
+
+- (BNRTtem *)itemAtIndex:(NSUInteger)index;
+
+@end
+
 @interface BNRItemStore : NSObject
 
 + (instancetype)sharedStore;
@@ -18,7 +62,19 @@ NS_ASSUME_NONNULL_BEGIN
 - (BNRTtem *)createItem;
 
 - (BOOL)saveChanges;
+/// 条目内容被修改后调用，把修改记到日志里
+- (void)itemDidChange:(BNRTtem *)item;
+/// 会解码全部条目并复制整个数组，列表的数据源用 itemCount 和 itemAtIndex:
 - (NSArray *)allItems;
+
+/// 每次插入、修改、移动、删除都加一
+@property (nonatomic, readonly) NSUInteger version;
+@property (nonatomic, readonly) NSUInteger itemCount;
+/// 不复制数组，条目用到时才解码
+- (BNRTtem *)itemAtIndex:(NSUInteger)index;
+- (BNRItemStoreSnapshot *)snapshot;
+/// 从 version 到当前版本的修改，记录已经被丢弃时返回 nil，调用方应当整体刷新
+- (nullable BNRItemStoreChangeSet *)changesSinceVersion:(NSUInteger)version;
 - (void)removeItem:(BNRTtem *)item;
 - (void)moveItemAtIndex:(NSUInteger)fromInndex ToIndex:(NSUInteger)toIndex;
 
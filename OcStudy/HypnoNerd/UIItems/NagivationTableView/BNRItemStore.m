@@ -9,11 +9,116 @@
 #import "BNRTtem.h"
 #import "AppDelegate.h"
 #import "BNRImageStore.h"
+#import "BNRItemJournal.h"
+
+NSNotificationName const BNRItemStoreDidChangeNotification = @"BNRItemStoreDidChangeNotification";
+NSString * const BNRItemStoreChangeSetKey = @"BNRItemStoreChangeSetKey";
+
+/// 最多保留这么多条修改记录，更早的版本只能整体刷新
+static const NSUInteger BNRItemStoreMaxLoggedChanges = 512;
+
+/// 数组里还是归档数据时解码并放回原位。写时复制之后 store 和快照各有一个数组，
+/// 同一份归档数据先在 materializedItems 里找别的数组已经解出来的对象，两边拿到的还是同一个条目。
+/// 数据损坏解不出条目时用一个占位条目顶替，下标和 count 保持不变
+static BNRTtem *BNRMaterializeItem(NSMutableArray *items, NSUInteger index, NSMapTable *materializedItems) {
+    id item = items[index];
+    if ([item isKindOfClass:[NSData class]]) {
+        NSData *data = item;
+        id decoded = [materializedItems objectForKey:data];
+        if (!decoded) {
+            @try {
+                decoded = [NSKeyedUnarchiver unarchiveObjectWithData:data];
+            } @catch (NSException *exception) {
+                NSLog(@"Could not decode item at index %lu: %@", (unsigned long)index, exception);
+            }
+            if (![decoded isKindOfClass:[BNRTtem class]]) {
+                decoded = [[BNRTtem alloc] initWithItemName:@"Unreadable Item"];
+            }
+            [materializedItems setObject:decoded forKey:data];
+        }
+        item = decoded;
+        items[index] = item;
+    }
+    return item;
+}
+
+@interface BNRItemStoreChange ()
+
+@property (nonatomic, readwrite) BNRItemStoreChangeType type;
+@property (nonatomic, readwrite) NSUInteger index;
+@property (nonatomic, readwrite) NSUInteger toIndex;
+
+@end
+
+@implementation BNRItemStoreChange
+
+@end
+
+@implementation BNRItemStoreChangeSet
+
+- (instancetype)initWithFromVersion:(NSUInteger)fromVersion toVersion:(NSUInteger)toVersion changes:(NSArray<BNRItemStoreChange *> *)changes {
+    if (self = [super init]) {
+        _fromVersion = fromVersion;
+        _toVersion = toVersion;
+        _changes = [changes copy];
+        
+        NSMutableIndexSet *updatedIndexes = [NSMutableIndexSet indexSet];
+        for (BNRItemStoreChange *change in changes) {
+            if (change.type == BNRItemStoreChangeUpdate) {
+                [updatedIndexes addIndex:change.index];
+            } else {
+                _containsStructuralChanges = YES;
+            }
+        }
+        _updatedIndexes = _containsStructuralChanges ? [NSIndexSet indexSet] : [updatedIndexes copy];
+    }
+    return self;
+}
+
+@end
+
+@interface BNRItemStoreSnapshot ()
+
+@property (nonatomic, strong) NSMutableArray *items;
+@property (nonatomic, readwrite) NSUInteger version;
+/// 和 store 共用，见 BNRMaterializeItem
+@property (nonatomic, strong) NSMapTable *materializedItems;
+
+@end
+
+@implementation BNRItemStoreSnapshot
+
+- (NSUInteger)count {
+    return self.items.count;
+}
+
+- (BNRTtem *)itemAtIndex:(NSUInteger)index {
+    return BNRMaterializeItem(self.items, index, self.materializedItems);
+}
+
+@end
 
 
 @interface BNRItemStore()
 
+/// 快照、日志和旧版本的 items.archive 都放在这个目录下
+@property (nonatomic, copy) NSString *directory;
+/// 元素是 BNRTtem，或者还没用到、未解码的归档 NSData
 @property (nonatomic) NSMutableArray *privateItems;
+/// 归档数据到解出来的条目，键值都是弱引用：还有数组没解码这份数据时才用得到，
+/// 条目被所有数组放掉以后也就不用再给谁了
+@property (nonatomic, strong) NSMapTable<NSData *, BNRTtem *> *materializedItems;
+@property (nonatomic, strong) BNRItemJournal *journal;
+
+@property (nonatomic, readwrite) NSUInteger version;
+/// 最近的修改，最后一条对应当前版本
+@property (nonatomic, strong) NSMutableArray<BNRItemStoreChange *> *changeLog;
+/// 当前版本的快照，版本没变时重复使用
+@property (nonatomic, weak) BNRItemStoreSnapshot *sharedSnapshot;
+/// privateItems 交给过快照，下次插入、删除、移动前要先复制。
+/// 不看快照是否还活着，快照可能被别处持有，也可能已经不是 sharedSnapshot
+@property (nonatomic) BOOL privateItemsShared;
+@property (nonatomic) BOOL changeNotificationScheduled;
 
 @end
 
@@ -36,20 +141,73 @@
 }
 
 - (instancetype)initPrivate {
+    NSArray *documentDirectories = NSSearchPathForDirectoriesInDomains(NSDocumentDirectory, NSUserDomainMask, YES);
+    
+    return [self initWithDirectory:[documentDirectories firstObject]];
+}
+
+/// 所有文件都读写 directory 下的，测试时传临时目录
+- (instancetype)initWithDirectory:(NSString *)directory {
     self = [super init];
     
     if (self) {
-       // _privateItems = [[NSMutableArray alloc] init];
-        NSString *path = [self itemArchivePath];
-        _privateItems = [NSKeyedUnarchiver unarchiveObjectWithFile:path];
+        _directory = [directory copy];
+        _journal = [[BNRItemJournal alloc] initWithDirectory:directory];
+        _changeLog = [NSMutableArray array];
+        _materializedItems = [NSMapTable mapTableWithKeyOptions:NSPointerFunctionsWeakMemory | NSPointerFunctionsObjectPointerPersonality
+                                                   valueOptions:NSPointerFunctionsWeakMemory];
+        // 启动时只读出归档数据，条目用到时才解码
+        _privateItems = [_journal loadItemData];
         
-        if (!_privateItems) {
-            _privateItems = [[NSMutableArray alloc] init];
+        if (_privateItems.count == 0) {
+            [self migrateLegacyArchive];
         }
     }
     return self;
 }
 
+/// 把旧版本整个数组归档的 items.archive 转成快照
+- (void)migrateLegacyArchive {
+    NSString *path = [self itemArchivePath];
+    if (![[NSFileManager defaultManager] fileExistsAtPath:path]) {
+        return;
+    }
+    
+    NSArray *items = [NSKeyedUnarchiver unarchiveObjectWithFile:path];
+    if (items.count > 0) {
+        [self.privateItems addObjectsFromArray:items];
+        if (![self.journal compactWithItemData:[self archivedItemData]]) {
+            return;
+        }
+    }
+    [[NSFileManager defaultManager] removeItemAtPath:path error:nil];
+}
+
+- (BNRTtem *)materializedItemAtIndex:(NSUInteger)index {
+    return BNRMaterializeItem(self.privateItems, index, self.materializedItems);
+}
+
+/// 条目可能是快照解出来的，store 的数组里这一格还是它的归档数据，要从 materializedItems 认出来
+- (NSUInteger)indexOfItem:(BNRTtem *)item {
+    NSMapTable *materializedItems = self.materializedItems;
+    NSUInteger index = [self.privateItems indexOfObjectPassingTest:^BOOL(id obj, NSUInteger idx, BOOL *stop) {
+        return obj == item || ([obj isKindOfClass:[NSData class]] && [materializedItems objectForKey:obj] == item);
+    }];
+    if (index != NSNotFound) {
+        self.privateItems[index] = item;
+    }
+    return index;
+}
+
+- (NSArray<NSData *> *)archivedItemData {
+    NSMutableArray<NSData *> *itemData = [NSMutableArray arrayWithCapacity:self.privateItems.count];
+    for (id item in self.privateItems) {
+        // 没解码过的条目直接复用原来的数据
+        [itemData addObject:[item isKindOfClass:[NSData class]] ? item : [NSKeyedArchiver archivedDataWithRootObject:item]];
+    }
+    return itemData;
+}
+
 - (BNRTtem *)createItem {
     
     BNRTtem *item = [BNRTtem randomItem];
@@ -60,15 +218,35 @@
 //
 //    NSLog(@"defaults = %@", [defaults dictionaryRepresentation]);
     
+    [self prepareForMutation];
     [self.privateItems addObject:item];
+    [self.journal appendInsertItemData:[NSKeyedArchiver archivedDataWithRootObject:item] atIndex:self.privateItems.count - 1];
+    [self recordChange:BNRItemStoreChangeInsert index:self.privateItems.count - 1 toIndex:self.privateItems.count - 1];
     
      return item;
 }
 
+- (void)itemDidChange:(BNRTtem *)item {
+    NSUInteger index = [self indexOfItem:item];
+    if (index == NSNotFound) {
+        return;
+    }
+    [self.journal appendUpdateItemData:[NSKeyedArchiver archivedDataWithRootObject:item] atIndex:index];
+    [self recordChange:BNRItemStoreChangeUpdate index:index toIndex:index];
+}
+
 - (void)removeItem:(BNRTtem *)item {
-    NSString *key = item.itemKey;
-    [[BNRImageStore sharedStore] deleteImageForKey:key];
-    [self.privateItems removeObjectIdenticalTo:item];
+    NSUInteger index = [self indexOfItem:item];
+    if (index == NSNotFound) {
+        return;
+    }
+    // 确定条目在 store 里再删图片，不认识的条目不能把别人的图片删掉
+    [[BNRImageStore sharedStore] deleteImageForKey:item.itemKey];
+    
+    [self prepareForMutation];
+    [self.privateItems removeObjectAtIndex:index];
+    [self.journal appendRemoveAtIndex:index];
+    [self recordChange:BNRItemStoreChangeRemove index:index toIndex:index];
 }
 
 - (void)moveItemAtIndex:(NSUInteger)fromInndex ToIndex:(NSUInteger)toIndex {
@@ -77,31 +255,114 @@
         return;
     }
     
+    [self prepareForMutation];
+    
     BNRTtem *item = self.privateItems[fromInndex];
     
     [self.privateItems removeObjectAtIndex:fromInndex];
     
     [self.privateItems insertObject:item atIndex:toIndex];
     
-    
+    [self.journal appendMoveFromIndex:fromInndex toIndex:toIndex];
+    [self recordChange:BNRItemStoreChangeMove index:fromInndex toIndex:toIndex];
 }
 
 - (NSArray *)allItems {
+    for (NSUInteger i = 0; i < self.privateItems.count; i++) {
+        [self materializedItemAtIndex:i];
+    }
     return [self.privateItems copy];
 }
 
-- (NSString *)itemArchivePath {
-    NSArray *documentDirectories = NSSearchPathForDirectoriesInDomains(NSDocumentDirectory, NSUserDomainMask, YES);
+#pragma mark - Indexed access
+
+- (NSUInteger)itemCount {
+    return self.privateItems.count;
+}
+
+- (BNRTtem *)itemAtIndex:(NSUInteger)index {
+    return [self materializedItemAtIndex:index];
+}
+
+- (BNRItemStoreSnapshot *)snapshot {
+    BNRItemStoreSnapshot *snapshot = self.sharedSnapshot;
+    if (!snapshot) {
+        snapshot = [[BNRItemStoreSnapshot alloc] init];
+        snapshot.items = self.privateItems;
+        snapshot.version = self.version;
+        snapshot.materializedItems = self.materializedItems;
+        self.sharedSnapshot = snapshot;
+        self.privateItemsShared = YES;
+    }
+    return snapshot;
+}
+
+/// 插入、删除、移动之前调用，数组交给过快照时先复制一份，没有快照时不复制
+- (void)prepareForMutation {
+    if (self.privateItemsShared) {
+        self.privateItems = [self.privateItems mutableCopy];
+        self.privateItemsShared = NO;
+    }
+    self.sharedSnapshot = nil;
+}
+
+- (void)recordChange:(BNRItemStoreChangeType)type index:(NSUInteger)index toIndex:(NSUInteger)toIndex {
+    // 条目是原地修改的，内容修改不影响快照共用数组，但快照的版本号已经旧了。
+    // 数组仍然是共用的，privateItemsShared 保持不变，之后的结构修改照样会先复制
+    if (type == BNRItemStoreChangeUpdate) {
+        self.sharedSnapshot = nil;
+    }
     
-    NSString *documentDirectory = [documentDirectories firstObject];
+    BNRItemStoreChange *change = [[BNRItemStoreChange alloc] init];
+    change.type = type;
+    change.index = index;
+    change.toIndex = toIndex;
     
-    return [documentDirectory stringByAppendingPathComponent:@"items.archive"];
+    self.version += 1;
+    [self.changeLog addObject:change];
+    if (self.changeLog.count > BNRItemStoreMaxLoggedChanges) {
+        [self.changeLog removeObjectAtIndex:0];
+    }
+    
+    [self scheduleChangeNotificationFromVersion:self.version - 1];
 }
 
-- (BOOL)saveChanges {
-    NSString *path = [self itemArchivePath];
+- (void)scheduleChangeNotificationFromVersion:(NSUInteger)version {
+    if (self.changeNotificationScheduled) {
+        return;
+    }
+    self.changeNotificationScheduled = YES;
     
-    return [NSKeyedArchiver archiveRootObject:self.privateItems toFile:path];
+    dispatch_async(dispatch_get_main_queue(), ^{
+        self.changeNotificationScheduled = NO;
+        // 一轮里改得太多、记录已经被丢弃时不带修改集，观察者整体刷新
+        BNRItemStoreChangeSet *changes = [self changesSinceVersion:version];
+        [[NSNotificationCenter defaultCenter] postNotificationName:BNRItemStoreDidChangeNotification
+                                                            object:self
+                                                          userInfo:changes ? @{BNRItemStoreChangeSetKey : changes} : nil];
+    });
+}
+
+- (BNRItemStoreChangeSet *)changesSinceVersion:(NSUInteger)version {
+    if (version > self.version || self.version - version > self.changeLog.count) {
+        return nil;
+    }
+    
+    NSUInteger count = self.version - version;
+    NSArray *changes = [self.changeLog subarrayWithRange:NSMakeRange(self.changeLog.count - count, count)];
+    return [[BNRItemStoreChangeSet alloc] initWithFromVersion:version toVersion:self.version changes:changes];
+}
+
+- (NSString *)itemArchivePath {
+    return [self.directory stringByAppendingPathComponent:@"items.archive"];
+}
+
+- (BOOL)saveChanges {
+    // 修改在发生时已经追加到日志里，这里只需要落盘，日志太大时再合并成快照
+    if (self.journal.needsCompaction) {
+        return [self.journal compactWithItemData:[self archivedItemData]];
+    }
+    return [self.journal synchronize];
 }
 
 @end
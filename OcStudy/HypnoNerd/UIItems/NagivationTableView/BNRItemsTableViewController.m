@@ -14,6 +14,8 @@
 @interface BNRItemsTableViewController () <BNRDetailVCDelegate>
 
 //@property (nonatomic, strong) IBOutlet UIView *headerView;
+/// 表格当前显示的是 store 的哪个版本，NSNotFound 表示还没显示过
+@property (nonatomic) NSUInteger displayedVersion;
 
 @end
 
@@ -29,13 +31,17 @@
         UIBarButtonItem *bbi = [[UIBarButtonItem alloc] initWithBarButtonSystemItem:UIBarButtonSystemItemAdd target:self action:@selector(addNewItem:)];
         
         navItem.rightBarButtonItem = bbi;
+        
+        _displayedVersion = NSNotFound;
+        
+        [[NSNotificationCenter defaultCenter] addObserver:self selector:@selector(itemStoreDidChange:) name:BNRItemStoreDidChangeNotification object:[BNRItemStore sharedStore]];
     }
     
     return self;
 }
 
 - (NSInteger)tableView:(UITableView *)tableView numberOfRowsInSection:(NSInteger)section {
-    return [[[BNRItemStore sharedStore] allItems] count];
+    return [[BNRItemStore sharedStore] itemCount];
 }
 
 //
@@ -66,27 +72,30 @@
 }
 
 - (void)addName:(NSString *)name serial:(NSString *)serial value:(NSString *)value {
-    NSIndexPath *indexPath = [NSIndexPath indexPathForRow:[[BNRItemStore sharedStore] allItems].count - 1 inSection:0];
+    NSIndexPath *indexPath = [NSIndexPath indexPathForRow:[[BNRItemStore sharedStore] itemCount] - 1 inSection:0];
     
     [self.tableView insertRowsAtIndexPaths:@[indexPath] withRowAnimation:UITableViewRowAnimationTop];
+    self.displayedVersion = [BNRItemStore sharedStore].version;
 }
 
 
 //删除行
 - (void)tableView:(UITableView *)tableView commitEditingStyle:(UITableViewCellEditingStyle)editingStyle forRowAtIndexPath:(NSIndexPath *)indexPath {
     if (editingStyle == UITableViewCellEditingStyleDelete) {
-        NSArray *items = [[BNRItemStore sharedStore] allItems];
-        BNRTtem *item = items[indexPath.row];
+        BNRTtem *item = [[BNRItemStore sharedStore] itemAtIndex:indexPath.row];
         
         [[BNRItemStore sharedStore] removeItem:item];
         
         [tableView deleteRowsAtIndexPaths:@[indexPath] withRowAnimation:UITableViewRowAnimationFade];
+        self.displayedVersion = [BNRItemStore sharedStore].version;
     }
 }
 
 //移动行
 - (void)tableView:(UITableView *)tableView moveRowAtIndexPath:(NSIndexPath *)sourceIndexPath toIndexPath:(NSIndexPath *)destinationIndexPath {
     [[BNRItemStore sharedStore] moveItemAtIndex:sourceIndexPath.row ToIndex:destinationIndexPath.row];
+    // 表格已经自己移动过这一行了
+    self.displayedVersion = [BNRItemStore sharedStore].version;
 }
 
 - (void)tableView:(UITableView *)tableView didSelectRowAtIndexPath:(NSIndexPath *)indexPath {
@@ -94,9 +103,7 @@
     //BNRDetailViewController *detailViewController = [[BNRDetailViewController alloc] init];
     BNRDetailViewController *detailViewController = [[BNRDetailViewController alloc] initForNewItem:NO];
     
-    NSArray *items = [[BNRItemStore sharedStore] allItems];
-    
-    BNRTtem *itemSelected = items[indexPath.row];
+    BNRTtem *itemSelected = [[BNRItemStore sharedStore] itemAtIndex:indexPath.row];
     
     detailViewController.item = itemSelected;
     
@@ -107,7 +114,42 @@
 - (void)viewWillAppear:(BOOL)animated {
     [super viewWillAppear:animated];
     
-    [self.tableView reloadData];
+    // 从详情页回来时通常只改了几个条目的内容，只刷新这几行
+    BNRItemStore *store = [BNRItemStore sharedStore];
+    if (self.displayedVersion == store.version) {
+        return;
+    }
+    [self reloadRowsWithChanges:self.displayedVersion == NSNotFound ? nil : [store changesSinceVersion:self.displayedVersion]];
+}
+
+/// 表格在屏幕上时 store 被别处修改，按通知里的修改集刷新。
+/// 不在屏幕上时等 viewWillAppear 再一起刷新；新建条目的详情页 present 出来时由 addName:serial:value: 插入这一行
+- (void)itemStoreDidChange:(NSNotification *)notification {
+    BNRItemStore *store = [BNRItemStore sharedStore];
+    if (!self.isViewLoaded || !self.view.window || self.presentedViewController || self.displayedVersion == store.version) {
+        return;
+    }
+    
+    // 通知是合并后异步发的，表格自己删除、移动过的行已经算进 displayedVersion，这时修改集要从 displayedVersion 重新取
+    BNRItemStoreChangeSet *changes = notification.userInfo[BNRItemStoreChangeSetKey];
+    if (changes.fromVersion != self.displayedVersion || changes.toVersion != store.version) {
+        changes = self.displayedVersion == NSNotFound ? nil : [store changesSinceVersion:self.displayedVersion];
+    }
+    [self reloadRowsWithChanges:changes];
+}
+
+/// 只有内容修改时只刷新改过的行，其余情况（包括 changes 为 nil）整体刷新
+- (void)reloadRowsWithChanges:(BNRItemStoreChangeSet *)changes {
+    if (changes && !changes.containsStructuralChanges) {
+        NSMutableArray<NSIndexPath *> *indexPaths = [NSMutableArray array];
+        [changes.updatedIndexes enumerateIndexesUsingBlock:^(NSUInteger idx, BOOL *stop) {
+            [indexPaths addObject:[NSIndexPath indexPathForRow:idx inSection:0]];
+        }];
+        [self.tableView reloadRowsAtIndexPaths:indexPaths withRowAnimation:UITableViewRowAnimationNone];
+    } else {
+        [self.tableView reloadData];
+    }
+    self.displayedVersion = [BNRItemStore sharedStore].version;
 }
 
 #pragma mark - Table view data source
@@ -119,8 +161,7 @@
     if (!cell){
         cell = [[BNRItemCellTableViewCell alloc] initWithStyle:UITableViewCellStyleSubtitle reuseIdentifier:identifier];
     }
-    NSArray *items = [[BNRItemStore sharedStore] allItems];
-    BNRTtem *item = items[indexPath.row];
+    BNRTtem *item = [[BNRItemStore sharedStore] itemAtIndex:indexPath.row];
     
     [cell setBNRItemLabel:item];
     
@@ -0,0 +1,40 @@
+//
+//  BNRLineIndex.h
+//  TouchTracker
+//
+//  Created by HuXin on 2026/10/18.
+//
+
+#import <Foundation/Foundation.h>
+#import "UIKit/UIKit.h"
+
+@class BNRLine;
+
+NS_ASSUME_NONNULL_BEGIN
+
+/// 线条的空间索引：把画布划成均匀网格，每条线登记到它外接矩形覆盖的格子里。
+/// 点选时只检查点附近几个格子里的线，和线条总数无关。
+/// 线条按对象本身索引，移动线条后要调用 updateLine: 重新登记。
+@interface BNRLineIndex : NSObject
+
+- (instancetype)initWithCellSize:(CGFloat)cellSize NS_DESIGNATED_INITIALIZER;
+
+/// 默认格子边长 64pt
+- (instancetype)init;
+
+- (void)addLine:(BNRLine *)line;
+- (void)updateLine:(BNRLine *)line;
+- (void)removeLine:(BNRLine *)line;
+- (void)removeAllLines;
+
+/// 距离 point 不超过 distance 的线里最近的一条，按点到线段的精确距离计算
+- (nullable BNRLine *)lineNearestPoint:(CGPoint)point withinDistance:(CGFloat)distance;
+/// 外接矩形和 rect 相交的线，不算线宽，顺序不定
+- (NSArray<BNRLine *> *)linesInRect:(CGRect)rect;
+
+@end
+
+/// 点到线段的距离
+CGFloat BNRDistanceFromPointToSegment(CGPoint point, CGPoint begin, CGPoint end);
+
+NS_ASSUME_NONNULL_END
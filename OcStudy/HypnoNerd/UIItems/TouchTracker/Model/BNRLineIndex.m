@@ -0,0 +1,180 @@
+//
+//  BNRLineIndex.m
+//  TouchTracker
+//
+//  Created by HuXin on 2026/10/18.
+//
+
+#import "BNRLineIndex.h"
+#import "BNRLine.h"
+
+CGFloat BNRDistanceFromPointToSegment(CGPoint point, CGPoint begin, CGPoint end) {
+    CGFloat dx = end.x - begin.x;
+    CGFloat dy = end.y - begin.y;
+    CGFloat lengthSquared = dx * dx + dy * dy;
+    
+    // 投影到线段上，t 截到 [0, 1]，线段退化成点时直接算到端点的距离
+    CGFloat t = 0;
+    if (lengthSquared > 0) {
+        t = ((point.x - begin.x) * dx + (point.y - begin.y) * dy) / lengthSquared;
+        t = MAX(0, MIN(1, t));
+    }
+    return hypot(point.x - (begin.x + t * dx), point.y - (begin.y + t * dy));
+}
+
+/// 格子坐标范围，闭区间
+typedef struct {
+    NSInteger minX, minY, maxX, maxY;
+} BNRCellRange;
+
+static NSNumber *BNRCellKey(NSInteger x, NSInteger y) {
+    return @(((int64_t)(int32_t)x << 32) | (uint32_t)(int32_t)y);
+}
+
+@interface BNRLineIndex ()
+
+@property (nonatomic) CGFloat cellSize;
+/// 格子 -> 登记在里面的线
+@property (nonatomic, strong) NSMutableDictionary<NSNumber *, NSMutableArray<BNRLine *> *> *cells;
+/// 线 -> 登记时的格子范围，线移动后靠它找到原来的格子
+@property (nonatomic, strong) NSMapTable<BNRLine *, NSValue *> *ranges;
+
+@end
+
+@implementation BNRLineIndex
+
+- (instancetype)init {
+    return [self initWithCellSize:64];
+}
+
+- (instancetype)initWithCellSize:(CGFloat)cellSize {
+    if (self = [super init]) {
+        _cellSize = cellSize;
+        _cells = [NSMutableDictionary dictionary];
+        _ranges = [NSMapTable mapTableWithKeyOptions:NSMapTableStrongMemory | NSMapTableObjectPointerPersonality
+                                        valueOptions:NSMapTableStrongMemory];
+    }
+    return self;
+}
+
+- (BNRCellRange)cellRangeForRect:(CGRect)rect {
+    return (BNRCellRange){
+        (NSInteger)floor(CGRectGetMinX(rect) / self.cellSize),
+        (NSInteger)floor(CGRectGetMinY(rect) / self.cellSize),
+        (NSInteger)floor(CGRectGetMaxX(rect) / self.cellSize),
+        (NSInteger)floor(CGRectGetMaxY(rect) / self.cellSize),
+    };
+}
+
+- (BNRCellRange)cellRangeForLine:(BNRLine *)line {
+    CGRect bounds = CGRectMake(MIN(line.begin.x, line.end.x), MIN(line.begin.y, line.end.y),
+                               fabs(line.end.x - line.begin.x), fabs(line.end.y - line.begin.y));
+    return [self cellRangeForRect:bounds];
+}
+
+#pragma mark - Maintenance
+
+- (void)addLine:(BNRLine *)line {
+    if ([self.ranges objectForKey:line]) {
+        [self updateLine:line];
+        return;
+    }
+    
+    BNRCellRange range = [self cellRangeForLine:line];
+    for (NSInteger x = range.minX; x <= range.maxX; x++) {
+        for (NSInteger y = range.minY; y <= range.maxY; y++) {
+            NSNumber *key = BNRCellKey(x, y);
+            NSMutableArray *cell = self.cells[key];
+            if (!cell) {
+                cell = [NSMutableArray array];
+                self.cells[key] = cell;
+            }
+            [cell addObject:line];
+        }
+    }
+    [self.ranges setObject:[NSValue valueWithBytes:&range objCType:@encode(BNRCellRange)] forKey:line];
+}
+
+- (void)updateLine:(BNRLine *)line {
+    NSValue *value = [self.ranges objectForKey:line];
+    if (value) {
+        BNRCellRange oldRange;
+        [value getValue:&oldRange];
+        BNRCellRange newRange = [self cellRangeForLine:line];
+        // 拖动时大多还在原来的格子里
+        if (memcmp(&oldRange, &newRange, sizeof(BNRCellRange)) == 0) {
+            return;
+        }
+        [self removeLine:line];
+    }
+    [self addLine:line];
+}
+
+- (void)removeLine:(BNRLine *)line {
+    NSValue *value = [self.ranges objectForKey:line];
+    if (!value) {
+        return;
+    }
+    
+    BNRCellRange range;
+    [value getValue:&range];
+    for (NSInteger x = range.minX; x <= range.maxX; x++) {
+        for (NSInteger y = range.minY; y <= range.maxY; y++) {
+            NSNumber *key = BNRCellKey(x, y);
+            NSMutableArray *cell = self.cells[key];
+            [cell removeObjectIdenticalTo:line];
+            if (cell.count == 0) {
+                [self.cells removeObjectForKey:key];
+            }
+        }
+    }
+    [self.ranges removeObjectForKey:line];
+}
+
+- (void)removeAllLines {
+    [self.cells removeAllObjects];
+    [self.ranges removeAllObjects];
+}
+
+#pragma mark - Query
+
+- (BNRLine *)lineNearestPoint:(CGPoint)point withinDistance:(CGFloat)distance {
+    BNRCellRange range = [self cellRangeForRect:CGRectInset(CGRectMake(point.x, point.y, 0, 0), -distance, -distance)];
+    
+    BNRLine *nearest = nil;
+    CGFloat nearestDistance = distance;
+    for (NSInteger x = range.minX; x <= range.maxX; x++) {
+        for (NSInteger y = range.minY; y <= range.maxY; y++) {
+            // 跨多个格子的线会被检查多次，结果一样，不用去重
+            for (BNRLine *line in self.cells[BNRCellKey(x, y)]) {
+                CGFloat lineDistance = BNRDistanceFromPointToSegment(point, line.begin, line.end);
+                if (lineDistance < nearestDistance) {
+                    nearest = line;
+                    nearestDistance = lineDistance;
+                }
+            }
+        }
+    }
+    return nearest;
+}
+
+- (NSArray<BNRLine *> *)linesInRect:(CGRect)rect {
+    BNRCellRange range = [self cellRangeForRect:rect];
+    
+    // 跨多个格子的线只返回一次
+    NSHashTable<BNRLine *> *lines = [NSHashTable hashTableWithOptions:NSPointerFunctionsObjectPointerPersonality];
+    for (NSInteger x = range.minX; x <= range.maxX; x++) {
+        for (NSInteger y = range.minY; y <= range.maxY; y++) {
+            for (BNRLine *line in self.cells[BNRCellKey(x, y)]) {
+                // 水平、竖直的线外接矩形是扁的，CGRectIntersectsRect 会漏掉，直接比端点
+                if (MAX(line.begin.x, line.end.x) >= CGRectGetMinX(rect) && MIN(line.begin.x, line.end.x) <= CGRectGetMaxX(rect)
+                    && MAX(line.begin.y, line.end.y) >= CGRectGetMinY(rect) && MIN(line.begin.y, line.end.y) <= CGRectGetMaxY(rect)) {
+                    [lines addObject:line];
+                }
+            }
+        }
+    }
+    return lines.allObjects;
+}
+
+@end
@@ -0,0 +1,79 @@
+//
+//  BNRStrokeBuffer.h
+//  TouchTracker
+//
+//  Created by HuXin on 2026/10/18.
+//
+
+#import <Foundation/Foundation.h>
+#import "UIKit/UIKit.h"
+
+@class BNRLine;
+@class HWPoint;
+@class HWStroke;
+
+NS_ASSUME_NONNULL_BEGIN
+
+/// 采样点的字段，和 HWPoint 一一对应，每个字段都是 4 字节
+typedef NS_ENUM(NSUInteger, BNRStrokeField) {
+    BNRStrokeFieldBoardX,       // int32_t
+    BNRStrokeFieldBoardY,       // int32_t
+    BNRStrokeFieldSX,           // float，以下都是 float
+    BNRStrokeFieldSY,
+    BNRStrokeFieldTX,
+    BNRStrokeFieldTY,
+    BNRStrokeFieldPressure,
+    BNRStrokeFieldRelativeT,
+    BNRStrokeFieldCount,
+};
+
+typedef struct {
+    int32_t boardX;
+    int32_t boardY;
+    float sx;
+    float sy;
+    float tx;
+    float ty;
+    float pressure;
+    float relativeT;
+} BNRStrokeSample;
+
+/// 紧凑的笔迹存储：每个字段一段连续数组（struct-of-arrays），按块扩容，不为每个采样点创建对象。
+/// 多条笔画顺序存在同一组数组里，另外记每条笔画的起点。
+/// 用 valuesForField: 拿到的指针直接遍历，渲染和序列化都不用复制；指针在下一次追加之前有效。
+@interface BNRStrokeBuffer : NSObject
+
+@property (nonatomic, readonly) NSUInteger sampleCount;
+@property (nonatomic, readonly) NSUInteger strokeCount;
+
+- (instancetype)init;
+/// capacity 是预先分配的采样点数
+- (instancetype)initWithCapacity:(NSUInteger)capacity NS_DESIGNATED_INITIALIZER;
+/// 读回 serializedData 的结果，格式不对、长度不符或笔画起点不合法时返回 nil
+- (nullable instancetype)initWithSerializedData:(NSData *)data;
+
+/// 开始一条新笔画，之后追加的采样点都属于它
+- (void)beginStroke;
+- (void)appendSample:(BNRStrokeSample)sample;
+- (void)appendHWPoint:(HWPoint *)point;
+/// 把点阵笔 SDK 的一整条笔画作为新笔画追加进来
+- (void)appendHWStroke:(HWStroke *)stroke;
+/// 一条 BNRLine 作为两个点的新笔画，坐标记在 sx/sy 里
+- (void)appendLine:(BNRLine *)line;
+- (void)removeAllSamples;
+
+- (BNRStrokeSample)sampleAtIndex:(NSUInteger)index;
+/// 某个字段的连续数组，长度是 sampleCount，BoardX/BoardY 是 int32_t，其余是 float
+- (const void *)valuesForField:(BNRStrokeField)field NS_RETURNS_INNER_POINTER;
+- (NSRange)rangeOfStrokeAtIndex:(NSUInteger)index;
+- (void)enumerateStrokesUsingBlock:(void (NS_NOESCAPE ^)(NSRange range, BOOL *stop))block;
+
+/// 笔画的屏幕坐标路径（sx/sy），给渲染用
+- (UIBezierPath *)bezierPathForStrokeAtIndex:(NSUInteger)index;
+
+/// 小端的二进制格式：magic、采样数、笔画数、每条笔画的起点，然后按字段依次是各个数组
+- (NSData *)serializedData;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,292 @@
+//
+//  BNRStrokeBuffer.m
+//  TouchTracker
+//
+//  Created by HuXin on 2026/10/18.
+//
+
+#import "BNRStrokeBuffer.h"
+#import "BNRLine.h"
+
+// BaijiaYun 的头文件没有公开给工程，能找到时直接读属性，否则退回 KVC
+#if __has_include("HWPoint.h") && __has_include("HWStroke.h")
+#import "HWPoint.h"
+#import "HWStroke.h"
+#define BNR_HAS_HW_HEADERS 1
+#else
+#define BNR_HAS_HW_HEADERS 0
+#endif
+
+#if !TARGET_RT_LITTLE_ENDIAN
+#error "BNRStrokeBuffer serializes its arrays in host byte order, which must be little-endian"
+#endif
+
+static const char *BNRStrokeBufferMagic = "BNRSTRK1";
+static const NSUInteger BNRStrokeBufferHeaderLength = 16;
+/// 每次至少扩容这么多个采样点，200Hz 的笔大约 20 秒一块
+static const NSUInteger BNRStrokeBufferChunk = 4096;
+
+@interface BNRStrokeBuffer () {
+    // 每个字段一段连续内存，元素都是 4 字节
+    void *_fields[BNRStrokeFieldCount];
+    NSUInteger _capacity;
+}
+
+@property (nonatomic, readwrite) NSUInteger sampleCount;
+/// 每条笔画第一个采样点的下标，uint32_t 数组
+@property (nonatomic, strong) NSMutableData *strokeStarts;
+
+@end
+
+@implementation BNRStrokeBuffer
+
+- (instancetype)init {
+    return [self initWithCapacity:0];
+}
+
+- (instancetype)initWithCapacity:(NSUInteger)capacity {
+    if (self = [super init]) {
+        _strokeStarts = [NSMutableData data];
+        [self reserveCapacity:capacity];
+    }
+    return self;
+}
+
+- (instancetype)initWithSerializedData:(NSData *)data {
+    const uint8_t *bytes = data.bytes;
+    if (data.length < BNRStrokeBufferHeaderLength || memcmp(bytes, BNRStrokeBufferMagic, 8) != 0) {
+        return nil;
+    }
+    
+    uint32_t sampleCount, strokeCount;
+    memcpy(&sampleCount, bytes + 8, 4);
+    memcpy(&strokeCount, bytes + 12, 4);
+    
+    NSUInteger startsLength = (NSUInteger)strokeCount * 4;
+    NSUInteger fieldLength = (NSUInteger)sampleCount * 4;
+    if (data.length != BNRStrokeBufferHeaderLength + startsLength + fieldLength * BNRStrokeFieldCount) {
+        return nil;
+    }
+    
+    // 起点决定 rangeOfStrokeAtIndex: 的范围，必须从 0 开始、不递减、不超过采样数，有采样点就至少有一条笔画，否则后面会越界读
+    const uint8_t *starts = bytes + BNRStrokeBufferHeaderLength;
+    if (strokeCount == 0 && sampleCount > 0) {
+        return nil;
+    }
+    uint32_t previous = 0;
+    for (NSUInteger i = 0; i < strokeCount; i++) {
+        uint32_t start;
+        memcpy(&start, starts + i * 4, 4);
+        if ((i == 0 && start != 0) || start < previous || start > sampleCount) {
+            return nil;
+        }
+        previous = start;
+    }
+    
+    if (self = [self initWithCapacity:sampleCount]) {
+        const uint8_t *cursor = starts;
+        [_strokeStarts appendBytes:cursor length:startsLength];
+        cursor += startsLength;
+        
+        for (NSUInteger field = 0; field < BNRStrokeFieldCount && fieldLength > 0; field++) {
+            memcpy(_fields[field], cursor, fieldLength);
+            cursor += fieldLength;
+        }
+        _sampleCount = sampleCount;
+    }
+    return self;
+}
+
+- (void)dealloc {
+    for (NSUInteger field = 0; field < BNRStrokeFieldCount; field++) {
+        free(_fields[field]);
+    }
+}
+
+#pragma mark - Storage
+
+- (void)reserveCapacity:(NSUInteger)capacity {
+    if (capacity <= _capacity) {
+        return;
+    }
+    // 按块向上取整，并且至少增长一半，追加一百万个点也只扩容几十次
+    NSUInteger newCapacity = MAX(capacity, _capacity + _capacity / 2);
+    newCapacity = (newCapacity + BNRStrokeBufferChunk - 1) / BNRStrokeBufferChunk * BNRStrokeBufferChunk;
+    
+    for (NSUInteger field = 0; field < BNRStrokeFieldCount; field++) {
+        void *values = realloc(_fields[field], newCapacity * 4);
+        if (!values) {
+            @throw [NSException exceptionWithName:NSMallocException reason:@"Could not grow stroke buffer" userInfo:nil];
+        }
+        _fields[field] = values;
+    }
+    _capacity = newCapacity;
+}
+
+- (NSUInteger)strokeCount {
+    return self.strokeStarts.length / sizeof(uint32_t);
+}
+
+- (void)beginStroke {
+    uint32_t start = (uint32_t)self.sampleCount;
+    [self.strokeStarts appendBytes:&start length:sizeof(start)];
+}
+
+- (void)appendSample:(BNRStrokeSample)sample {
+    if (self.strokeCount == 0) {
+        [self beginStroke];
+    }
+    [self reserveCapacity:self.sampleCount + 1];
+    
+    NSUInteger i = self.sampleCount;
+    ((int32_t *)_fields[BNRStrokeFieldBoardX])[i] = sample.boardX;
+    ((int32_t *)_fields[BNRStrokeFieldBoardY])[i] = sample.boardY;
+    ((float *)_fields[BNRStrokeFieldSX])[i] = sample.sx;
+    ((float *)_fields[BNRStrokeFieldSY])[i] = sample.sy;
+    ((float *)_fields[BNRStrokeFieldTX])[i] = sample.tx;
+    ((float *)_fields[BNRStrokeFieldTY])[i] = sample.ty;
+    ((float *)_fields[BNRStrokeFieldPressure])[i] = sample.pressure;
+    ((float *)_fields[BNRStrokeFieldRelativeT])[i] = sample.relativeT;
+    self.sampleCount = i + 1;
+}
+
+- (void)removeAllSamples {
+    self.sampleCount = 0;
+    self.strokeStarts.length = 0;
+}
+
+#pragma mark - Adapters
+
+- (void)appendHWPoint:(HWPoint *)point {
+    BNRStrokeSample sample;
+#if BNR_HAS_HW_HEADERS
+    sample.boardX = point.boardX;
+    sample.boardY = point.boardY;
+    sample.sx = point.sx;
+    sample.sy = point.sy;
+    sample.tx = point.tx;
+    sample.ty = point.ty;
+    sample.pressure = point.pressure;
+    sample.relativeT = point.relativeT;
+#else
+    id object = point;
+    sample.boardX = [[object valueForKey:@"boardX"] intValue];
+    sample.boardY = [[object valueForKey:@"boardY"] intValue];
+    sample.sx = [[object valueForKey:@"sx"] floatValue];
+    sample.sy = [[object valueForKey:@"sy"] floatValue];
+    sample.tx = [[object valueForKey:@"tx"] floatValue];
+    sample.ty = [[object valueForKey:@"ty"] floatValue];
+    sample.pressure = [[object valueForKey:@"pressure"] floatValue];
+    sample.relativeT = [[object valueForKey:@"relativeT"] floatValue];
+#endif
+    [self appendSample:sample];
+}
+
+- (void)appendHWStroke:(HWStroke *)stroke {
+#if BNR_HAS_HW_HEADERS
+    NSArray *points = stroke.hwPoints;
+#else
+    NSArray *points = [(id)stroke valueForKey:@"hwPoints"];
+#endif
+    [self reserveCapacity:self.sampleCount + points.count];
+    [self beginStroke];
+    for (HWPoint *point in points) {
+        [self appendHWPoint:point];
+    }
+}
+
+- (void)appendLine:(BNRLine *)line {
+    [self reserveCapacity:self.sampleCount + 2];
+    [self beginStroke];
+    
+    CGPoint points[2] = {line.begin, line.end};
+    for (int i = 0; i < 2; i++) {
+        BNRStrokeSample sample = {0};
+        sample.boardX = (int32_t)lround(points[i].x);
+        sample.boardY = (int32_t)lround(points[i].y);
+        sample.sx = points[i].x;
+        sample.sy = points[i].y;
+        sample.tx = points[i].x;
+        sample.ty = points[i].y;
+        sample.pressure = 1;
+        sample.relativeT = i;
+        [self appendSample:sample];
+    }
+}
+
+#pragma mark - Access
+
+- (BNRStrokeSample)sampleAtIndex:(NSUInteger)index {
+    NSParameterAssert(index < self.sampleCount);
+    
+    BNRStrokeSample sample;
+    sample.boardX = ((const int32_t *)_fields[BNRStrokeFieldBoardX])[index];
+    sample.boardY = ((const int32_t *)_fields[BNRStrokeFieldBoardY])[index];
+    sample.sx = ((const float *)_fields[BNRStrokeFieldSX])[index];
+    sample.sy = ((const float *)_fields[BNRStrokeFieldSY])[index];
+    sample.tx = ((const float *)_fields[BNRStrokeFieldTX])[index];
+    sample.ty = ((const float *)_fields[BNRStrokeFieldTY])[index];
+    sample.pressure = ((const float *)_fields[BNRStrokeFieldPressure])[index];
+    sample.relativeT = ((const float *)_fields[BNRStrokeFieldRelativeT])[index];
+    return sample;
+}
+
+- (const void *)valuesForField:(BNRStrokeField)field {
+    NSParameterAssert(field < BNRStrokeFieldCount);
+    return _fields[field];
+}
+
+- (NSRange)rangeOfStrokeAtIndex:(NSUInteger)index {
+    NSParameterAssert(index < self.strokeCount);
+    
+    const uint32_t *starts = self.strokeStarts.bytes;
+    NSUInteger start = starts[index];
+    NSUInteger end = index + 1 < self.strokeCount ? starts[index + 1] : self.sampleCount;
+    return NSMakeRange(start, end - start);
+}
+
+- (void)enumerateStrokesUsingBlock:(void (NS_NOESCAPE ^)(NSRange, BOOL *))block {
+    BOOL stop = NO;
+    for (NSUInteger i = 0; i < self.strokeCount && !stop; i++) {
+        block([self rangeOfStrokeAtIndex:i], &stop);
+    }
+}
+
+- (UIBezierPath *)bezierPathForStrokeAtIndex:(NSUInteger)index {
+    NSRange range = [self rangeOfStrokeAtIndex:index];
+    const float *xs = _fields[BNRStrokeFieldSX];
+    const float *ys = _fields[BNRStrokeFieldSY];
+    
+    UIBezierPath *path = [UIBezierPath bezierPath];
+    for (NSUInteger i = range.location; i < NSMaxRange(range); i++) {
+        CGPoint point = CGPointMake(xs[i], ys[i]);
+        if (i == range.location) {
+            [path moveToPoint:point];
+        } else {
+            [path addLineToPoint:point];
+        }
+    }
+    return path;
+}
+
+#pragma mark - Serialization
+
+- (NSData *)serializedData {
+    NSUInteger fieldLength = self.sampleCount * 4;
+    NSMutableData *data = [NSMutableData dataWithCapacity:BNRStrokeBufferHeaderLength + self.strokeStarts.length + fieldLength * BNRStrokeFieldCount];
+    
+    uint32_t sampleCount = (uint32_t)self.sampleCount;
+    uint32_t strokeCount = (uint32_t)self.strokeCount;
+    [data appendBytes:BNRStrokeBufferMagic length:8];
+    [data appendBytes:&sampleCount length:4];
+    [data appendBytes:&strokeCount length:4];
+    [data appendData:self.strokeStarts];
+    
+    // 数组本身就是要写出去的格式，直接整段追加
+    for (NSUInteger field = 0; field < BNRStrokeFieldCount; field++) {
+        [data appendBytes:_fields[field] length:fieldLength];
+    }
+    return data;
+}
+
+@end
@@ -7,6 +7,7 @@
 
 #import "BNRDrawView.h"
 #import "BNRLine.h"
+#import "BNRLineIndex.h"
 
 @interface BNRDrawView () <UIGestureRecognizerDelegate>
 
@@ -14,10 +15,20 @@
 @property (nonatomic, strong) UIPanGestureRecognizer *moveRecognizer;
 @property (nonatomic, strong) NSMutableDictionary *linesProgress;
 @property (nonatomic, strong) NSMutableArray *finishedLines;
+/// finishedLines 的空间索引，增删和移动线条时同步维护
+@property (nonatomic, strong) BNRLineIndex *lineIndex;
 @property (nonatomic, weak) BNRLine *selectedLine;
 
+/// 已完成线条的位图缓存，不含选中的线，每帧只画进行中和选中的线
+@property (nonatomic) CGContextRef rasterContext;
+/// 从 rasterContext 取出来的图片，位图改动后置空
+@property (nonatomic, strong) UIImage *rasterImage;
+@property (nonatomic) BOOL rasterNeedsRebuild;
+
 @end
 
+static const CGFloat BNRLineWidth = 10;
+
 @implementation BNRDrawView
 
 - (instancetype)initWithFrame:(CGRect)frame {
@@ -27,6 +38,7 @@
         self.selectedLine = nil;
         self.linesProgress = [[NSMutableDictionary alloc] init];
         self.finishedLines = [[NSMutableArray alloc] init];
+        self.lineIndex = [[BNRLineIndex alloc] init];
         self.backgroundColor = [UIColor grayColor];
         self.multipleTouchEnabled = YES;
         
@@ -58,6 +70,10 @@
     return  self;
 }
 
+- (void)dealloc {
+    CGContextRelease(_rasterContext);
+}
+
 //拖动手势
 - (void)moveLine:(UIPanGestureRecognizer *)gr {
     //如果没有被选中的线条
@@ -77,6 +93,9 @@
         
         CGPoint begin = self.selectedLine.begin;
         CGPoint end = self.selectedLine.end;
+        
+        // 选中的线不在位图里，只要重画它移动前后的位置
+        [self setNeedsDisplayForLine:self.selectedLine];
             
         begin.x += translation.x;
         begin.y += translation.y;
@@ -85,7 +104,8 @@
             
         self.selectedLine.begin = begin;
         self.selectedLine.end = end;
-        [self setNeedsDisplay];
+        [self.lineIndex updateLine:self.selectedLine];
+        [self setNeedsDisplayForLine:self.selectedLine];
             
         [gr setTranslation:CGPointZero inView:self];
     }
@@ -99,13 +119,15 @@
         self.selectedLine = [self lineAtPoint:point];
         
         if (self.selectedLine) {
+            for (NSValue *key in self.linesProgress) {
+                [self setNeedsDisplayForLine:self.linesProgress[key]];
+            }
             [self.linesProgress removeAllObjects];
         }
     }
     else if (gr.state == UIGestureRecognizerStateEnded) {
         self.selectedLine = nil;
     }
-    [self setNeedsDisplay];
 }
 
 //双击手势
@@ -114,6 +136,8 @@
     
     [self.linesProgress removeAllObjects];
     [self.finishedLines removeAllObjects];
+    [self.lineIndex removeAllLines];
+    self.rasterNeedsRebuild = YES;
     [self setNeedsDisplay];
 }
 
@@ -137,13 +161,20 @@
     else {
         [[UIMenuController sharedMenuController] setMenuVisible:NO animated:YES];
     }
-    [self setNeedsDisplay];
 }
 
 
 - (void)deleteLine:(id)sender {
-    [self.finishedLines removeObject:self.selectedLine];
-    [self setNeedsDisplay];
+    BNRLine *line = self.selectedLine;
+    if (!line) {
+        return;
+    }
+    // 选中时已经从位图里擦掉了，删掉后位图不用变。
+    // 直接清空 _selectedLine，不走 setter，否则取消选中会把它画回位图
+    [self.finishedLines removeObject:line];
+    [self.lineIndex removeLine:line];
+    _selectedLine = nil;
+    [self setNeedsDisplayForLine:line];
 }
 
 //手指触碰屏幕记录degin和end
@@ -162,8 +193,8 @@
         
         NSValue *key = [NSValue valueWithNonretainedObject:t];
         self.linesProgress[key] = line;
+        [self setNeedsDisplayForLine:line];
     }
-    [self setNeedsDisplay];
 }
 
 //实时记录currentLine的end
@@ -177,10 +208,10 @@
         NSValue *key = [NSValue valueWithNonretainedObject:t];
         BNRLine *line = self.linesProgress[key];
         
+        [self setNeedsDisplayForLine:line];
         line.end = [t locationInView:self];
+        [self setNeedsDisplayForLine:line];
     }
-    
-    [self setNeedsDisplay];
 }
 
 //触碰结束记录
@@ -192,15 +223,17 @@
         BNRLine *line = self.linesProgress[key];
         
         [self.finishedLines addObject:line];
+        [self.lineIndex addLine:line];
+        [self rasterizeLine:line];
         
         [self.linesProgress removeObjectForKey:key];
+        [self setNeedsDisplayForLine:line];
     }
-    [self setNeedsDisplay];
 }
 
 - (void)strokeLine:(BNRLine *)line {
     UIBezierPath *bp = [UIBezierPath bezierPath];
-    bp.lineWidth = 10;
+    bp.lineWidth = BNRLineWidth;
     bp.lineCapStyle = kCGLineCapRound;
     
     [bp moveToPoint:line.begin];
@@ -209,14 +242,14 @@
 }
 
 - (void)drawRect:(CGRect)rect {
-    [[UIColor blackColor] set];
-    for (BNRLine *line in self.finishedLines) {
-        [self strokeLine:line];
-    }
+    [[self currentRasterImage] drawInRect:self.bounds];
     
     [[UIColor redColor] set];
     for (NSValue *key in self.linesProgress) {
-        [self strokeLine:self.linesProgress[key]];
+        BNRLine *line = self.linesProgress[key];
+        if (CGRectIntersectsRect(rect, [self displayRectForLine:line])) {
+            [self strokeLine:line];
+        }
     }
     
     if (self.selectedLine) {
@@ -225,24 +258,136 @@
     }
 }
 
-- (BOOL)canBecomeFirstResponder {
-    return YES;
+#pragma mark - Raster cache
+
+- (void)setSelectedLine:(BNRLine *)selectedLine {
+    BNRLine *previous = _selectedLine;
+    if (previous == selectedLine) {
+        return;
+    }
+    _selectedLine = selectedLine;
+    
+    // 选中的线不在位图里，单独画在最上面。取消选中的线画回位图，新选中的线只重画它所在的一块位图，
+    // 不用把所有线重描一遍；只有这两条线所在的区域需要重画
+    [self rasterizeLine:previous];
+    if (selectedLine) {
+        [self redrawRasterInRect:[self displayRectForLine:selectedLine]];
+    }
+    [self setNeedsDisplayForLine:previous];
+    [self setNeedsDisplayForLine:selectedLine];
 }
 
-- (BNRLine *)lineAtPoint:(CGPoint)p {
-    for (BNRLine *l in self.finishedLines) {
-        CGPoint start = l.begin;
-        CGPoint end = l.end;
-        for (float t = 0.0; t <= 1.0; t += 0.05) {
-            float x = start.x + t * (end.x - start.x);
-            float y = start.y + t * (end.y - start.y);
-            
-            if (hypot(x - p.x, y - p.y) < 20.0) {
-                return  l;
+- (CGRect)displayRectForLine:(BNRLine *)line {
+    CGRect bounds = CGRectMake(MIN(line.begin.x, line.end.x), MIN(line.begin.y, line.end.y),
+                               fabs(line.end.x - line.begin.x), fabs(line.end.y - line.begin.y));
+    // 圆头线帽会超出端点半个线宽，多留 1pt 给抗锯齿
+    return CGRectInset(bounds, -(BNRLineWidth / 2 + 1), -(BNRLineWidth / 2 + 1));
+}
+
+- (void)setNeedsDisplayForLine:(BNRLine *)line {
+    if (line) {
+        [self setNeedsDisplayInRect:[self displayRectForLine:line]];
+    }
+}
+
+- (void)layoutSubviews {
+    [super layoutSubviews];
+    
+    CGFloat scale = self.contentScaleFactor;
+    if (self.rasterContext
+        && (CGBitmapContextGetWidth(self.rasterContext) != (size_t)ceil(self.bounds.size.width * scale)
+            || CGBitmapContextGetHeight(self.rasterContext) != (size_t)ceil(self.bounds.size.height * scale))) {
+        CGContextRelease(self.rasterContext);
+        self.rasterContext = NULL;
+        self.rasterImage = nil;
+        [self setNeedsDisplay];
+    }
+}
+
+/// 需要时创建或重建位图，返回当前内容的图片
+- (UIImage *)currentRasterImage {
+    if (!self.rasterContext) {
+        CGFloat scale = self.contentScaleFactor;
+        size_t width = (size_t)ceil(self.bounds.size.width * scale);
+        size_t height = (size_t)ceil(self.bounds.size.height * scale);
+        if (width == 0 || height == 0) {
+            return nil;
+        }
+        
+        CGColorSpaceRef colorSpace = CGColorSpaceCreateDeviceRGB();
+        self.rasterContext = CGBitmapContextCreate(NULL, width, height, 8, 0, colorSpace,
+                                                   kCGImageAlphaPremultipliedFirst | kCGBitmapByteOrder32Host);
+        CGColorSpaceRelease(colorSpace);
+        // 和 UIKit 一样用左上角为原点的 point 坐标
+        CGContextTranslateCTM(self.rasterContext, 0, height);
+        CGContextScaleCTM(self.rasterContext, scale, -scale);
+        self.rasterNeedsRebuild = YES;
+    }
+    
+    if (self.rasterNeedsRebuild) {
+        self.rasterNeedsRebuild = NO;
+        CGContextClearRect(self.rasterContext, self.bounds);
+        UIGraphicsPushContext(self.rasterContext);
+        [[UIColor blackColor] set];
+        for (BNRLine *line in self.finishedLines) {
+            if (line != self.selectedLine) {
+                [self strokeLine:line];
             }
         }
+        UIGraphicsPopContext();
+        self.rasterImage = nil;
+    }
+    
+    if (!self.rasterImage) {
+        CGImageRef image = CGBitmapContextCreateImage(self.rasterContext);
+        self.rasterImage = [UIImage imageWithCGImage:image scale:self.contentScaleFactor orientation:UIImageOrientationUp];
+        CGImageRelease(image);
+    }
+    return self.rasterImage;
+}
+
+/// 新完成的线直接画进位图，不用重画已有的线
+- (void)rasterizeLine:(BNRLine *)line {
+    if (!line || !self.rasterContext || self.rasterNeedsRebuild) {
+        return;
+    }
+    UIGraphicsPushContext(self.rasterContext);
+    [[UIColor blackColor] set];
+    [self strokeLine:line];
+    UIGraphicsPopContext();
+    self.rasterImage = nil;
+}
+
+/// 清空位图里的 rect 这一块，再把经过这块的线（选中的除外）重描一遍，位图其余部分不动
+- (void)redrawRasterInRect:(CGRect)rect {
+    if (!self.rasterContext || self.rasterNeedsRebuild) {
+        return;
+    }
+    // 对齐到整点，scale 是整数时也就对齐到像素，清空的边缘不会留半透明的缝
+    rect = CGRectIntegral(rect);
+    
+    CGContextSaveGState(self.rasterContext);
+    CGContextClipToRect(self.rasterContext, rect);
+    CGContextClearRect(self.rasterContext, rect);
+    UIGraphicsPushContext(self.rasterContext);
+    [[UIColor blackColor] set];
+    // 线帽会伸出端点半个线宽，外接矩形在 rect 外面一点的线也画得进来
+    for (BNRLine *line in [self.lineIndex linesInRect:CGRectInset(rect, -(BNRLineWidth / 2 + 1), -(BNRLineWidth / 2 + 1))]) {
+        if (line != self.selectedLine) {
+            [self strokeLine:line];
+        }
     }
-    return  nil;
+    UIGraphicsPopContext();
+    CGContextRestoreGState(self.rasterContext);
+    self.rasterImage = nil;
+}
+
+- (BOOL)canBecomeFirstResponder {
+    return YES;
+}
+
+- (BNRLine *)lineAtPoint:(CGPoint)p {
+    return [self.lineIndex lineNearestPoint:p withinDistance:20.0];
 }
 
 - (BOOL)gestureRecognizer:(UIGestureRecognizer *)gestureRecognizer shouldRecognizeSimultaneouslyWithGestureRecognizer:(UIGestureRecognizer *)otherGestureRecognizer {
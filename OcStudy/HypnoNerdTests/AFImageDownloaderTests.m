@@ -0,0 +1,319 @@
+//
+//  AFImageDownloaderTests.m
+//  HypnoNerdTests
+//
+//  Created by HuXin on 2026/10/18.
+//
+
+#import <XCTest/XCTest.h>
+#import <AFNetworking/AFNetworking.h>
+#import <AFNetworking/AFImageDownloader.h>
+
+static NSString * const kAvatarHost = @"avatar.hypnonerd.local";
+static NSString * const kCoverHost = @"cover.hypnonerd.local";
+
+/// 本地模拟的图片服务器: 每个 host 一个固定延迟, 也可以把某个 host 的请求扣住直到测试放行
+@interface AFImageDownloaderTestURLProtocol : NSURLProtocol
+
++ (void)setLatency:(NSTimeInterval)latency forHost:(NSString *)host;
++ (void)holdRequestsForHost:(NSString *)host;
++ (void)releaseHeldRequests;
+/// 按开始加载的顺序记录的 URL path
++ (NSArray<NSString *> *)startedPaths;
++ (void)reset;
+
+@property (nonatomic, strong) NSThread *clientThread;
+@property (atomic) BOOL stopped;
+
+@end
+
+static NSMutableDictionary<NSString *, NSNumber *> *AFTestLatencies;
+static NSMutableSet<NSString *> *AFTestHeldHosts;
+static NSMutableArray<AFImageDownloaderTestURLProtocol *> *AFTestHeldProtocols;
+static NSMutableArray<NSString *> *AFTestStartedPaths;
+
+static NSData *AFTestImageData(void) {
+    static NSData *data;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        UIGraphicsImageRendererFormat *format = [UIGraphicsImageRendererFormat defaultFormat];
+        format.scale = 1;
+        UIImage *image = [[[UIGraphicsImageRenderer alloc] initWithSize:CGSizeMake(4, 4) format:format] imageWithActions:^(UIGraphicsImageRendererContext *context) {
+            [[UIColor orangeColor] setFill];
+            [context fillRect:CGRectMake(0, 0, 4, 4)];
+        }];
+        data = UIImagePNGRepresentation(image);
+    });
+    return data;
+}
+
+@implementation AFImageDownloaderTestURLProtocol
+
++ (void)initialize {
+    if (self == [AFImageDownloaderTestURLProtocol class]) {
+        AFTestLatencies = [NSMutableDictionary dictionary];
+        AFTestHeldHosts = [NSMutableSet set];
+        AFTestHeldProtocols = [NSMutableArray array];
+        AFTestStartedPaths = [NSMutableArray array];
+    }
+}
+
++ (void)setLatency:(NSTimeInterval)latency forHost:(NSString *)host {
+    @synchronized (self) {
+        AFTestLatencies[host] = @(latency);
+    }
+}
+
++ (void)holdRequestsForHost:(NSString *)host {
+    @synchronized (self) {
+        [AFTestHeldHosts addObject:host];
+    }
+}
+
++ (void)releaseHeldRequests {
+    NSArray *protocols;
+    @synchronized (self) {
+        [AFTestHeldHosts removeAllObjects];
+        protocols = [AFTestHeldProtocols copy];
+        [AFTestHeldProtocols removeAllObjects];
+    }
+    for (AFImageDownloaderTestURLProtocol *protocol in protocols) {
+        [protocol performSelector:@selector(finishLoading) onThread:protocol.clientThread withObject:nil waitUntilDone:NO];
+    }
+}
+
++ (NSArray<NSString *> *)startedPaths {
+    @synchronized (self) {
+        return [AFTestStartedPaths copy];
+    }
+}
+
++ (void)reset {
+    [self releaseHeldRequests];
+    @synchronized (self) {
+        [AFTestLatencies removeAllObjects];
+        [AFTestStartedPaths removeAllObjects];
+    }
+}
+
++ (BOOL)canInitWithRequest:(NSURLRequest *)request {
+    return YES;
+}
+
++ (NSURLRequest *)canonicalRequestForRequest:(NSURLRequest *)request {
+    return request;
+}
+
+- (void)startLoading {
+    self.clientThread = [NSThread currentThread];
+    NSString *host = self.request.URL.host;
+    NSTimeInterval latency;
+    @synchronized ([self class]) {
+        [AFTestStartedPaths addObject:self.request.URL.path];
+        if ([AFTestHeldHosts containsObject:host]) {
+            [AFTestHeldProtocols addObject:self];
+            return;
+        }
+        latency = AFTestLatencies[host].doubleValue;
+    }
+    // 客户端回调要回到开始加载的线程上
+    dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(latency * NSEC_PER_SEC)), dispatch_get_global_queue(QOS_CLASS_DEFAULT, 0), ^{
+        [self performSelector:@selector(finishLoading) onThread:self.clientThread withObject:nil waitUntilDone:NO];
+    });
+}
+
+- (void)finishLoading {
+    if (self.stopped) {
+        return;
+    }
+    NSHTTPURLResponse *response = [[NSHTTPURLResponse alloc] initWithURL:self.request.URL statusCode:200 HTTPVersion:@"HTTP/1.1" headerFields:@{@"Content-Type": @"image/png"}];
+    [self.client URLProtocol:self didReceiveResponse:response cacheStoragePolicy:NSURLCacheStorageNotAllowed];
+    [self.client URLProtocol:self didLoadData:AFTestImageData()];
+    [self.client URLProtocolDidFinishLoading:self];
+}
+
+- (void)stopLoading {
+    self.stopped = YES;
+}
+
+@end
+
+@interface AFImageDownloaderTests : XCTestCase
+
+@end
+
+@implementation AFImageDownloaderTests
+
+- (void)tearDown {
+    [AFImageDownloaderTestURLProtocol reset];
+}
+
+- (AFImageDownloader *)downloaderWithMaximumActiveDownloads:(NSInteger)maximumActiveDownloads {
+    NSURLSessionConfiguration *configuration = [NSURLSessionConfiguration ephemeralSessionConfiguration];
+    configuration.protocolClasses = @[[AFImageDownloaderTestURLProtocol class]];
+    configuration.URLCache = nil;
+    AFHTTPSessionManager *sessionManager = [[AFHTTPSessionManager alloc] initWithSessionConfiguration:configuration];
+    sessionManager.responseSerializer = [AFImageResponseSerializer serializer];
+
+    // 不用图片缓存, 每次都真正走下载
+    return [[AFImageDownloader alloc] initWithSessionManager:sessionManager
+                                      downloadPrioritization:AFImageDownloadPrioritizationFIFO
+                                      maximumActiveDownloads:maximumActiveDownloads
+                                                  imageCache:nil];
+}
+
+- (NSURLRequest *)requestForHost:(NSString *)host path:(NSString *)path {
+    return [NSURLRequest requestWithURL:[NSURL URLWithString:[NSString stringWithFormat:@"https://%@/%@", host, path]]];
+}
+
+- (AFImageDownloadReceipt *)download:(AFImageDownloader *)downloader host:(NSString *)host path:(NSString *)path priority:(AFImageDownloadPriority)priority expectation:(XCTestExpectation *)expectation {
+    return [downloader downloadImageForURLRequest:[self requestForHost:host path:path]
+                                    withReceiptID:[NSUUID UUID]
+                                         priority:priority
+                                          success:^(NSURLRequest *request, NSHTTPURLResponse *response, UIImage *responseObject) {
+        [expectation fulfill];
+    } failure:^(NSURLRequest *request, NSHTTPURLResponse *response, NSError *error) {
+        [expectation fulfill];
+    }];
+}
+
+- (void)downloadCount:(NSUInteger)count fromHost:(NSString *)host downloader:(AFImageDownloader *)downloader expectation:(XCTestExpectation *)expectation {
+    NSString *batch = [NSUUID UUID].UUIDString;
+    for (NSUInteger i = 0; i < count; i++) {
+        [self download:downloader host:host path:[NSString stringWithFormat:@"%@-%lu.png", batch, (unsigned long)i] priority:AFImageDownloadPriorityNormal expectation:expectation];
+    }
+}
+
+#pragma mark - 按 host 限流
+
+- (void)testSlowHostDoesNotStarveOtherHost {
+    AFImageDownloader *downloader = [self downloaderWithMaximumActiveDownloads:4];
+    downloader.maximumActiveDownloadsPerHost = 2;
+    [AFImageDownloaderTestURLProtocol holdRequestsForHost:kCoverHost];
+
+    XCTestExpectation *covers = [self expectationWithDescription:@"covers"];
+    covers.expectedFulfillmentCount = 8;
+    [self downloadCount:8 fromHost:kCoverHost downloader:downloader expectation:covers];
+
+    // 封面请求全被扣住, 头像还能用剩下的名额下载完
+    XCTestExpectation *avatars = [self expectationWithDescription:@"avatars"];
+    avatars.expectedFulfillmentCount = 4;
+    [self downloadCount:4 fromHost:kAvatarHost downloader:downloader expectation:avatars];
+    [self waitForExpectations:@[avatars] timeout:5];
+
+    [AFImageDownloaderTestURLProtocol releaseHeldRequests];
+    [self waitForExpectations:@[covers] timeout:5];
+}
+
+#pragma mark - 优先级
+
+- (void)testHigherPriorityStartsFirst {
+    AFImageDownloader *downloader = [self downloaderWithMaximumActiveDownloads:1];
+    [AFImageDownloaderTestURLProtocol holdRequestsForHost:kCoverHost];
+
+    XCTestExpectation *done = [self expectationWithDescription:@"downloads"];
+    done.expectedFulfillmentCount = 4;
+    // 第一个占住唯一的名额, 其余排队
+    [self download:downloader host:kCoverHost path:@"busy.png" priority:AFImageDownloadPriorityNormal expectation:done];
+    [self download:downloader host:kAvatarHost path:@"low.png" priority:AFImageDownloadPriorityLow expectation:done];
+    [self download:downloader host:kAvatarHost path:@"normal.png" priority:AFImageDownloadPriorityNormal expectation:done];
+    [self download:downloader host:kCoverHost path:@"high.png" priority:AFImageDownloadPriorityHigh expectation:done];
+
+    [AFImageDownloaderTestURLProtocol releaseHeldRequests];
+    [self waitForExpectations:@[done] timeout:5];
+    XCTAssertEqualObjects([AFImageDownloaderTestURLProtocol startedPaths], (@[@"/busy.png", @"/high.png", @"/normal.png", @"/low.png"]));
+}
+
+- (void)testNewReceiptPromotesQueuedTask {
+    AFImageDownloader *downloader = [self downloaderWithMaximumActiveDownloads:1];
+    [AFImageDownloaderTestURLProtocol holdRequestsForHost:kCoverHost];
+
+    XCTestExpectation *done = [self expectationWithDescription:@"downloads"];
+    done.expectedFulfillmentCount = 4;
+    [self download:downloader host:kCoverHost path:@"busy.png" priority:AFImageDownloadPriorityNormal expectation:done];
+    [self download:downloader host:kAvatarHost path:@"offscreen.png" priority:AFImageDownloadPriorityLow expectation:done];
+    [self download:downloader host:kAvatarHost path:@"other.png" priority:AFImageDownloadPriorityNormal expectation:done];
+    // 滑回来的 cell 又要这张图, 排队中的任务被提到前面
+    [self download:downloader host:kAvatarHost path:@"offscreen.png" priority:AFImageDownloadPriorityHigh expectation:done];
+
+    [AFImageDownloaderTestURLProtocol releaseHeldRequests];
+    [self waitForExpectations:@[done] timeout:5];
+    XCTAssertEqualObjects([AFImageDownloaderTestURLProtocol startedPaths], (@[@"/busy.png", @"/offscreen.png", @"/other.png"]));
+}
+
+- (void)testCancellingQueuedTaskKeepsSlotAccounting {
+    AFImageDownloader *downloader = [self downloaderWithMaximumActiveDownloads:1];
+    [AFImageDownloaderTestURLProtocol holdRequestsForHost:kCoverHost];
+
+    XCTestExpectation *done = [self expectationWithDescription:@"downloads"];
+    done.expectedFulfillmentCount = 4;
+    [self download:downloader host:kCoverHost path:@"busy.png" priority:AFImageDownloadPriorityNormal expectation:done];
+    AFImageDownloadReceipt *cancelled = [self download:downloader host:kAvatarHost path:@"cancelled.png" priority:AFImageDownloadPriorityNormal expectation:done];
+    [self download:downloader host:kAvatarHost path:@"first.png" priority:AFImageDownloadPriorityNormal expectation:done];
+    [self download:downloader host:kAvatarHost path:@"second.png" priority:AFImageDownloadPriorityNormal expectation:done];
+
+    // 排队中取消的任务没有占过名额, 不能多放出一个名额
+    [downloader cancelTaskForImageDownloadReceipt:cancelled];
+    [AFImageDownloaderTestURLProtocol releaseHeldRequests];
+    [self waitForExpectations:@[done] timeout:5];
+    XCTAssertEqualObjects([AFImageDownloaderTestURLProtocol startedPaths], (@[@"/busy.png", @"/first.png", @"/second.png"]));
+}
+
+#pragma mark - 模拟延迟下的首屏头像耗时
+
+/// 慢的封面 CDN 请求先排进来, 测一屏头像全部下载完的时间
+- (void)measureAvatarsBehindSlowCoversWithMaximumActiveDownloadsPerHost:(NSInteger)maximumActiveDownloadsPerHost {
+    [AFImageDownloaderTestURLProtocol setLatency:0.2 forHost:kCoverHost];
+    [AFImageDownloaderTestURLProtocol setLatency:0.01 forHost:kAvatarHost];
+    AFImageDownloader *downloader = [self downloaderWithMaximumActiveDownloads:4];
+    downloader.maximumActiveDownloadsPerHost = maximumActiveDownloadsPerHost;
+
+    [self measureMetrics:[[self class] defaultPerformanceMetrics] automaticallyStartMeasuring:NO forBlock:^{
+        XCTestExpectation *covers = [self expectationWithDescription:@"covers"];
+        covers.expectedFulfillmentCount = 8;
+        [self downloadCount:8 fromHost:kCoverHost downloader:downloader expectation:covers];
+
+        [self startMeasuring];
+        XCTestExpectation *avatars = [self expectationWithDescription:@"avatars"];
+        avatars.expectedFulfillmentCount = 8;
+        [self downloadCount:8 fromHost:kAvatarHost downloader:downloader expectation:avatars];
+        [self waitForExpectations:@[avatars] timeout:10];
+        [self stopMeasuring];
+
+        [self waitForExpectations:@[covers] timeout:10];
+    }];
+}
+
+- (void)testPerformanceAvatarsWithPerHostLimit {
+    [self measureAvatarsBehindSlowCoversWithMaximumActiveDownloadsPerHost:2];
+}
+
+- (void)testPerformanceAvatarsWithoutPerHostLimit {
+    [self measureAvatarsBehindSlowCoversWithMaximumActiveDownloadsPerHost:0];
+}
+
+#pragma mark - 调度
+
+- (void)testPerformanceSchedulingAcrossManyHosts {
+    // 所有请求都被扣住, 只测排队、提优先级、取消的开销
+    AFImageDownloader *downloader = [self downloaderWithMaximumActiveDownloads:4];
+    downloader.maximumActiveDownloadsPerHost = 1;
+
+    [self measureBlock:^{
+        NSMutableArray *receipts = [NSMutableArray array];
+        for (NSUInteger i = 0; i < 2000; i++) {
+            NSString *host = [NSString stringWithFormat:@"cdn%lu.hypnonerd.local", (unsigned long)(i % 100)];
+            [AFImageDownloaderTestURLProtocol holdRequestsForHost:host];
+            AFImageDownloadReceipt *receipt = [self download:downloader host:host path:[NSString stringWithFormat:@"%lu.png", (unsigned long)i] priority:i % 3 == 0 ? AFImageDownloadPriorityLow : AFImageDownloadPriorityNormal expectation:nil];
+            [receipts addObject:receipt];
+        }
+        for (AFImageDownloadReceipt *receipt in receipts) {
+            [downloader setPriority:AFImageDownloadPriorityHigh forImageDownloadReceipt:receipt];
+        }
+        for (AFImageDownloadReceipt *receipt in receipts) {
+            [downloader cancelTaskForImageDownloadReceipt:receipt];
+        }
+    }];
+}
+
+@end
@@ -0,0 +1,217 @@
+//
+//  AFJSONStreamingResponseSerializerTests.m
+//  HypnoNerdTests
+//
+//  Created by HuXin on 2026/10/18.
+//
+
+#import <XCTest/XCTest.h>
+#import <AFNetworking/AFNetworking.h>
+
+static NSUInteger const kElementCount = 20000;
+static NSUInteger const kChunkLength = 16 * 1024;
+
+@interface AFJSONStreamingResponseSerializerTests : XCTestCase
+
+@property (nonatomic, strong) NSData *body;
+@property (nonatomic, strong) NSArray<NSData *> *chunks;
+@property (nonatomic, strong) NSURLSessionDataTask *task;
+
+@end
+
+@implementation AFJSONStreamingResponseSerializerTests
+
+- (void)setUp {
+    NSMutableArray *list = [NSMutableArray arrayWithCapacity:kElementCount];
+    for (NSUInteger i = 0; i < kElementCount; i++) {
+        [list addObject:@{@"id": @(i),
+                          @"title": [NSString stringWithFormat:@"Lecture %lu", (unsigned long)i],
+                          @"video_info": @{@"url": [NSString stringWithFormat:@"https://example.com/%lu.mp4", (unsigned long)i], @"duration": @(i % 3600)}}];
+    }
+    self.body = [NSJSONSerialization dataWithJSONObject:@{@"code": @0, @"data": @{@"list": list}} options:0 error:NULL];
+
+    // 模拟网络按块到达
+    NSMutableArray *chunks = [NSMutableArray array];
+    for (NSUInteger offset = 0; offset < self.body.length; offset += kChunkLength) {
+        [chunks addObject:[self.body subdataWithRange:NSMakeRange(offset, MIN(kChunkLength, self.body.length - offset))]];
+    }
+    self.chunks = chunks;
+
+    // 未启动的任务, response 为 nil, 校验直接通过
+    self.task = [[NSURLSession sharedSession] dataTaskWithURL:[NSURL URLWithString:@"https://example.com/list"]];
+}
+
+- (void)tearDown {
+    self.body = nil;
+    self.chunks = nil;
+    self.task = nil;
+}
+
+- (AFJSONStreamingResponseSerializer *)streamingSerializer {
+    AFJSONStreamingResponseSerializer *serializer = [AFJSONStreamingResponseSerializer serializer];
+    serializer.elementKeyPath = @"data.list";
+    serializer.elementsQueue = dispatch_queue_create("HypnoNerdTests.elements", DISPATCH_QUEUE_SERIAL);
+    return serializer;
+}
+
+#pragma mark - 正确性
+
+- (void)testParserConsumesEveryChunkSoTheBodyIsNotBuffered {
+    AFJSONStreamingResponseSerializer *serializer = [self streamingSerializer];
+    id<AFURLIncrementalResponseParsing> parser = [serializer incrementalResponseParserForDataTask:self.task];
+
+    for (NSData *chunk in self.chunks) {
+        XCTAssertTrue([parser appendData:chunk]);
+    }
+
+    // 与 AFURLSessionManager 一致: 解析器接收了全部数据时, 完成时的 data 为空
+    NSError *error = nil;
+    id responseObject = [parser responseObjectForResponse:nil data:nil error:&error];
+    XCTAssertNil(error);
+
+    id expected = [[AFJSONResponseSerializer serializer] responseObjectForResponse:nil data:self.body error:NULL];
+    XCTAssertEqualObjects(responseObject, expected);
+}
+
+- (void)testInvalidJSONWhileStreamingFails {
+    id<AFURLIncrementalResponseParsing> parser = [[self streamingSerializer] incrementalResponseParserForDataTask:self.task];
+
+    XCTAssertTrue([parser appendData:[@"{\"data\":{\"list\":[{\"id\":1}," dataUsingEncoding:NSUTF8StringEncoding]]);
+    XCTAssertTrue([parser appendData:[@"}}" dataUsingEncoding:NSUTF8StringEncoding]]);
+
+    NSError *error = nil;
+    XCTAssertNil([parser responseObjectForResponse:nil data:nil error:&error]);
+    XCTAssertEqual(error.code, NSURLErrorCannotParseResponse);
+}
+
+- (void)testNonUTF8ResponseIsDeclinedAndDecodedAtCompletion {
+    id<AFURLIncrementalResponseParsing> parser = [[self streamingSerializer] incrementalResponseParserForDataTask:self.task];
+
+    NSData *data = [@"{\"data\":{\"list\":[1,2,3]}}" dataUsingEncoding:NSUTF16LittleEndianStringEncoding];
+    XCTAssertFalse([parser appendData:data]);
+
+    NSError *error = nil;
+    id responseObject = [parser responseObjectForResponse:nil data:data error:&error];
+    XCTAssertNil(error);
+    XCTAssertEqualObjects(responseObject[@"data"][@"list"], (@[@1, @2, @3]));
+}
+
+#pragma mark - 首条数据时间
+
+- (void)testFirstElementsAreDeliveredBeforeTheLastChunk {
+    AFJSONStreamingResponseSerializer *serializer = [self streamingSerializer];
+    NSMutableArray *delivered = [NSMutableArray array];
+    serializer.elementsHandler = ^(NSURLSessionDataTask *task, NSArray *elements) {
+        [delivered addObjectsFromArray:elements];
+    };
+    id<AFURLIncrementalResponseParsing> parser = [serializer incrementalResponseParserForDataTask:self.task];
+
+    // 最后一块还没到, 前面已经解析出的元素就该交付了
+    for (NSData *chunk in [self.chunks subarrayWithRange:NSMakeRange(0, self.chunks.count - 1)]) {
+        [parser appendData:chunk];
+    }
+    dispatch_sync(serializer.elementsQueue, ^{});
+    XCTAssertGreaterThan(delivered.count, 0);
+    XCTAssertLessThan(delivered.count, kElementCount);
+    XCTAssertEqualObjects(delivered.firstObject[@"id"], @0);
+
+    [parser appendData:self.chunks.lastObject];
+    XCTAssertNotNil([parser responseObjectForResponse:nil data:nil error:NULL]);
+    dispatch_sync(serializer.elementsQueue, ^{});
+    XCTAssertEqual(delivered.count, kElementCount);
+}
+
+- (void)testPerformanceTimeToFirstItemStreaming {
+    // 从第一块数据到第一批元素交给 elementsHandler 的时间
+    [self measureMetrics:[[self class] defaultPerformanceMetrics] automaticallyStartMeasuring:NO forBlock:^{
+        AFJSONStreamingResponseSerializer *serializer = [self streamingSerializer];
+        __block BOOL delivered = NO;
+        serializer.elementsHandler = ^(NSURLSessionDataTask *task, NSArray *elements) {
+            delivered = YES;
+        };
+        id<AFURLIncrementalResponseParsing> parser = [serializer incrementalResponseParserForDataTask:self.task];
+
+        [self startMeasuring];
+        for (NSData *chunk in self.chunks) {
+            [parser appendData:chunk];
+            dispatch_sync(serializer.elementsQueue, ^{});
+            if (delivered) {
+                break;
+            }
+        }
+        [self stopMeasuring];
+        XCTAssertTrue(delivered);
+    }];
+}
+
+- (void)testPerformanceTimeToFirstItemBuffered {
+    // 先缓冲整个响应体再解码, 解码完成才拿到第一条
+    [self measureBlock:^{
+        NSMutableData *buffer = [NSMutableData data];
+        for (NSData *chunk in self.chunks) {
+            [buffer appendData:chunk];
+        }
+        id responseObject = [[AFJSONResponseSerializer serializer] responseObjectForResponse:nil data:buffer error:NULL];
+        XCTAssertNotNil([responseObject[@"data"][@"list"] firstObject]);
+    }];
+}
+
+#pragma mark - 内存
+
+- (void)testStreamedElementsAreNotRetainedWhenDisabled {
+    AFJSONStreamingResponseSerializer *serializer = [self streamingSerializer];
+    serializer.retainsStreamedElements = NO;
+    __block NSUInteger count = 0;
+    serializer.elementsHandler = ^(NSURLSessionDataTask *task, NSArray *elements) {
+        count += elements.count;
+    };
+    id<AFURLIncrementalResponseParsing> parser = [serializer incrementalResponseParserForDataTask:self.task];
+    for (NSData *chunk in self.chunks) {
+        [parser appendData:chunk];
+    }
+
+    // 元素只交给 elementsHandler, 响应对象里的列表是空的
+    id responseObject = [parser responseObjectForResponse:nil data:nil error:NULL];
+    dispatch_sync(serializer.elementsQueue, ^{});
+    XCTAssertEqual(count, kElementCount);
+    XCTAssertEqualObjects(responseObject[@"data"][@"list"], @[]);
+    XCTAssertEqualObjects(responseObject[@"code"], @0);
+}
+
+- (void)testMemoryStreamingWithoutRetainingElements {
+    [self measureWithMetrics:@[[[XCTMemoryMetric alloc] init]] block:^{
+        AFJSONStreamingResponseSerializer *serializer = [self streamingSerializer];
+        serializer.retainsStreamedElements = NO;
+        serializer.elementsHandler = ^(NSURLSessionDataTask *task, NSArray *elements) {};
+        id<AFURLIncrementalResponseParsing> parser = [serializer incrementalResponseParserForDataTask:self.task];
+        for (NSData *chunk in self.chunks) {
+            @autoreleasepool {
+                [parser appendData:chunk];
+            }
+        }
+        [parser responseObjectForResponse:nil data:nil error:NULL];
+        dispatch_sync(serializer.elementsQueue, ^{});
+    }];
+}
+
+- (void)testMemoryBuffered {
+    [self measureWithMetrics:@[[[XCTMemoryMetric alloc] init]] block:^{
+        NSMutableData *buffer = [NSMutableData data];
+        for (NSData *chunk in self.chunks) {
+            [buffer appendData:chunk];
+        }
+        [[AFJSONResponseSerializer serializer] responseObjectForResponse:nil data:buffer error:NULL];
+    }];
+}
+
+- (void)testPerformanceStreaming {
+    [self measureBlock:^{
+        id<AFURLIncrementalResponseParsing> parser = [[self streamingSerializer] incrementalResponseParserForDataTask:self.task];
+        for (NSData *chunk in self.chunks) {
+            [parser appendData:chunk];
+        }
+        [parser responseObjectForResponse:nil data:nil error:NULL];
+    }];
+}
+
+@end
@@ -0,0 +1,154 @@
+//
+//  AFNetworkReachabilityReplayTests.m
+//  HypnoNerdTests
+//
+//  Created by HuXin on 2026/10/18.
+//
+
+#import <XCTest/XCTest.h>
+#import <AFNetworking/AFNetworking.h>
+
+/// 同时挂着的请求数, 断网时全部失败, 等网络恢复后重试
+static NSUInteger const kRequestCount = 10;
+
+typedef struct {
+    NSTimeInterval offset;
+    AFNetworkReachabilityStatus status;
+} AFTestReachabilityEvent;
+
+// 教室里录到的两种抖动, 时间单位秒
+// Wi-Fi 和蜂窝来回切换, 每次掉线不到 0.1 秒
+static const AFTestReachabilityEvent AFTestHandoffTrace[] = {
+    {0.00, AFNetworkReachabilityStatusReachableViaWiFi},
+    {0.20, AFNetworkReachabilityStatusNotReachable},
+    {0.25, AFNetworkReachabilityStatusReachableViaWiFi},
+    {0.40, AFNetworkReachabilityStatusReachableViaWWAN},
+    {0.46, AFNetworkReachabilityStatusReachableViaWiFi},
+    {0.60, AFNetworkReachabilityStatusNotReachable},
+    {0.68, AFNetworkReachabilityStatusReachableViaWiFi},
+    {0.80, AFNetworkReachabilityStatusReachableViaWWAN},
+    {0.84, AFNetworkReachabilityStatusNotReachable},
+    {0.90, AFNetworkReachabilityStatusReachableViaWiFi},
+    {1.10, AFNetworkReachabilityStatusNotReachable},
+    {1.15, AFNetworkReachabilityStatusReachableViaWiFi},
+};
+
+// 真断网, 恢复时先闪了两次才稳定
+static const AFTestReachabilityEvent AFTestOutageTrace[] = {
+    {0.00, AFNetworkReachabilityStatusReachableViaWiFi},
+    {0.10, AFNetworkReachabilityStatusNotReachable},
+    {0.60, AFNetworkReachabilityStatusReachableViaWiFi},
+    {0.65, AFNetworkReachabilityStatusNotReachable},
+    {0.80, AFNetworkReachabilityStatusReachableViaWiFi},
+    {0.86, AFNetworkReachabilityStatusNotReachable},
+    {1.00, AFNetworkReachabilityStatusReachableViaWiFi},
+};
+
+#define AFTestTrace(trace) trace, sizeof(trace) / sizeof(trace[0])
+
+@interface AFNetworkReachabilityManager (Testing)
+
+- (void)receiveNetworkReachabilityStatus:(AFNetworkReachabilityStatus)status;
+
+@end
+
+@interface AFNetworkReachabilityReplayTests : XCTestCase
+
+@property (nonatomic, strong) AFNetworkReachabilityManager *manager;
+/// 观察者收到的状态
+@property (nonatomic, strong) NSMutableArray<NSNumber *> *deliveredStatuses;
+/// 网络恢复后真正发出去的重试次数
+@property (nonatomic) NSUInteger retryCount;
+
+@end
+
+@implementation AFNetworkReachabilityReplayTests
+
+- (void)setUp {
+    // 不开始监听, 状态全部由回放喂进去
+    self.manager = [AFNetworkReachabilityManager managerForDomain:@"hypnonerd.local"];
+    self.deliveredStatuses = [NSMutableArray array];
+    self.retryCount = 0;
+
+    // 模拟请求层: 断网时挂着的请求都失败, 排到恢复后一起重试
+    __weak typeof(self) weakSelf = self;
+    [self.manager addReachabilityObserverWithQueue:nil usingBlock:^(AFNetworkReachabilityStatus status, AFNetworkReachabilityStatus previousStatus) {
+        __strong __typeof__(weakSelf) strongSelf = weakSelf;
+        [strongSelf.deliveredStatuses addObject:@(status)];
+        if (status != AFNetworkReachabilityStatusNotReachable) {
+            return;
+        }
+        for (NSUInteger i = 0; i < kRequestCount; i++) {
+            [strongSelf.manager performBlockWhenReachable:^{
+                weakSelf.retryCount += 1;
+            }];
+        }
+    }];
+}
+
+- (void)tearDown {
+    self.manager = nil;
+    self.deliveredStatuses = nil;
+}
+
+/// 按录下的时间把状态喂给 manager, 等最后一个状态稳定下来
+- (void)replayTrace:(const AFTestReachabilityEvent *)trace count:(NSUInteger)count {
+    XCTestExpectation *finished = [self expectationWithDescription:@"trace replayed"];
+    NSTimeInterval settle = MAX(self.manager.statusSettleInterval, self.manager.recoverySettleInterval);
+    for (NSUInteger i = 0; i < count; i++) {
+        AFTestReachabilityEvent event = trace[i];
+        dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(event.offset * NSEC_PER_SEC)), dispatch_get_main_queue(), ^{
+            [self.manager receiveNetworkReachabilityStatus:event.status];
+        });
+    }
+    NSTimeInterval end = trace[count - 1].offset + settle + 0.3;
+    dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(end * NSEC_PER_SEC)), dispatch_get_main_queue(), ^{
+        [finished fulfill];
+    });
+    [self waitForExpectations:@[finished] timeout:end + 5];
+
+    NSLog(@"%lu reachability callbacks -> %lu delivered, %lu retries", (unsigned long)count, (unsigned long)self.deliveredStatuses.count, (unsigned long)self.retryCount);
+}
+
+#pragma mark - Wi-Fi/蜂窝切换
+
+- (void)testHandoffTraceWithoutSettlingDeliversEveryCallback {
+    [self replayTrace:AFTestTrace(AFTestHandoffTrace)];
+
+    XCTAssertEqual(self.deliveredStatuses.count, 12);
+    // 每次掉线, 所有请求都重试一遍
+    XCTAssertEqual(self.retryCount, 4 * kRequestCount);
+}
+
+- (void)testHandoffTraceWithSettlingDeliversNothingAfterTheFirstStatus {
+    self.manager.statusSettleInterval = 0.3;
+    [self replayTrace:AFTestTrace(AFTestHandoffTrace)];
+
+    XCTAssertEqualObjects(self.deliveredStatuses, @[@(AFNetworkReachabilityStatusReachableViaWiFi)]);
+    XCTAssertEqual(self.retryCount, 0);
+    XCTAssertEqual(self.manager.networkReachabilityStatus, AFNetworkReachabilityStatusReachableViaWiFi);
+}
+
+#pragma mark - 断网后抖动恢复
+
+- (void)testOutageTraceWithoutSettlingRetriesOnEveryFlap {
+    [self replayTrace:AFTestTrace(AFTestOutageTrace)];
+
+    XCTAssertEqual(self.deliveredStatuses.count, 7);
+    XCTAssertEqual(self.retryCount, 3 * kRequestCount);
+}
+
+- (void)testOutageTraceWithHysteresisRetriesOnce {
+    // 掉线很快报告, 恢复要稳定更久
+    self.manager.statusSettleInterval = 0.05;
+    self.manager.recoverySettleInterval = 0.3;
+    [self replayTrace:AFTestTrace(AFTestOutageTrace)];
+
+    XCTAssertEqualObjects(self.deliveredStatuses, (@[@(AFNetworkReachabilityStatusReachableViaWiFi),
+                                                    @(AFNetworkReachabilityStatusNotReachable),
+                                                    @(AFNetworkReachabilityStatusReachableViaWiFi)]));
+    // 挂起的请求在恢复时作为一批重试一次
+    XCTAssertEqual(self.retryCount, kRequestCount);
+}
+
+@end
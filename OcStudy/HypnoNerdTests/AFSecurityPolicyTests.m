@@ -0,0 +1,194 @@
+//
+//  AFSecurityPolicyTests.m
+//  HypnoNerdTests
+//
+//  Created by HuXin on 2026/10/18.
+//
+
+#import <XCTest/XCTest.h>
+#import <AFNetworking/AFNetworking.h>
+
+// 本地用 openssl 生成的 P-256 证书, 有效期 100 年:
+// Root CA 自签, Leaf (CN=test.hypnonerd.local) 由 Root CA 签发, Other CA 与它们无关
+static NSString * const AFTestRootCertificate = @"MIIBqTCCAU+gAwIBAgIUN4vZp0rVL2XkU73o1tW9lkMdrwIwCgYIKoZIzj0EAwIwITEfMB0GA1UEAwwWSHlwbm9OZXJkIFRlc3QgUm9vdCBDQTAgFw0yNjEwMTgyMzEyMDNaGA8yMTI2MDkyNDIzMTIwM1owITEfMB0GA1UEAwwWSHlwbm9OZXJkIFRlc3QgUm9vdCBDQTBZMBMGByqGSM49AgEGCCqGSM49AwEHA0IABBQOa+JMgQlVWZhFkHwgxk7qAD2tR4QtIk3BZ9Yv90iEFDyO+M4HTk1ObviI5zVI+1cObi6vK7+nPv3/SRBQ2ZqjYzBhMB0GA1UdDgQWBBQ0SjJKEYoe/Bnlrvd8RIjh2YWpAzAfBgNVHSMEGDAWgBQ0SjJKEYoe/Bnlrvd8RIjh2YWpAzAPBgNVHRMBAf8EBTADAQH/MA4GA1UdDwEB/wQEAwIBBjAKBggqhkjOPQQDAgNIADBFAiEA4SCt4u17I26rC/2ZblqXwiTUUA5y0baNP7dX8aPhicYCIAtaED5MTBLbMJ10+oYUPerOd93ZySS6rl11e9uecB/K";
+static NSString * const AFTestLeafCertificate = @"MIIB2TCCAX+gAwIBAgIUKXcb7wjJ4Qe94YuhOrk7bgerVW0wCgYIKoZIzj0EAwIwITEfMB0GA1UEAwwWSHlwbm9OZXJkIFRlc3QgUm9vdCBDQTAgFw0yNjEwMTgyMzEyMDNaGA8yMTI2MDkyNDIzMTIwM1owHzEdMBsGA1UEAwwUdGVzdC5oeXBub25lcmQubG9jYWwwWTATBgcqhkjOPQIBBggqhkjOPQMBBwNCAAQwpQYugpUf61f2Vx1L9eUXuKkuig4lvrJi0jeFCU9oXFdZBckV7NfOejZUsCYvgajJIe1myYSfEfFiRPihCYRMo4GUMIGRMAkGA1UdEwQCMAAwDgYDVR0PAQH/BAQDAgeAMBMGA1UdJQQMMAoGCCsGAQUFBwMBMB8GA1UdEQQYMBaCFHRlc3QuaHlwbm9uZXJkLmxvY2FsMB0GA1UdDgQWBBQP4bc6hpedF781GUHeD4BzNr2E6jAfBgNVHSMEGDAWgBQ0SjJKEYoe/Bnlrvd8RIjh2YWpAzAKBggqhkjOPQQDAgNIADBFAiBgNBVWMVbHZ52q2CzLh9NmFTT9F52Xhk4Uqs2urJhG5gIhAMQwOTAXlg2NMIIFHjBYAG4neGrb7Z2jDSCcKD3SAmLj";
+static NSString * const AFTestOtherCertificate = @"MIIBmzCCAUGgAwIBAgIUJrJREExDqWc0Wc1QEGInKavVtxkwCgYIKoZIzj0EAwIwIjEgMB4GA1UEAwwXSHlwbm9OZXJkIFRlc3QgT3RoZXIgQ0EwIBcNMjYxMDE4MjMxMjAzWhgPMjEyNjA5MjQyMzEyMDNaMCIxIDAeBgNVBAMMF0h5cG5vTmVyZCBUZXN0IE90aGVyIENBMFkwEwYHKoZIzj0CAQYIKoZIzj0DAQcDQgAEM5TdgN5myJl+PgkQvfki9RxDALxD/wloUdiveQT3j3rfkM3aGuMb7kUS+5Ns3FRy2ZdgEco7UbyM4ln4ilfkaKNTMFEwHQYDVR0OBBYEFPgESG9wmPe/01AfSsaCbe2gx7/QMB8GA1UdIwQYMBaAFPgESG9wmPe/01AfSsaCbe2gx7/QMA8GA1UdEwEB/wQFMAMBAf8wCgYIKoZIzj0EAwIDSAAwRQIhAICZ+niie6ERqyp2GB//LPKgjKdsVE435fjoaD0RzuyxAiAOehhjhMyxxrird9asJ0SJ79wwoavrXKGYvt5FR5J3ow==";
+
+static NSString * const AFTestDomain = @"test.hypnonerd.local";
+
+static NSData * AFTestCertificateData(NSString *base64) {
+    return [[NSData alloc] initWithBase64EncodedString:base64 options:0];
+}
+
+@interface AFSecurityPolicyTests : XCTestCase
+
+@end
+
+@implementation AFSecurityPolicyTests
+
+/// 每次新建 SecTrust, 模拟每个连接各自收到的服务端证书链
+- (SecTrustRef)createServerTrust CF_RETURNS_RETAINED {
+    NSMutableArray *certificates = [NSMutableArray array];
+    for (NSString *base64 in @[AFTestLeafCertificate, AFTestRootCertificate]) {
+        [certificates addObject:(__bridge_transfer id)SecCertificateCreateWithData(NULL, (__bridge CFDataRef)AFTestCertificateData(base64))];
+    }
+
+    SecPolicyRef policy = SecPolicyCreateBasicX509();
+    SecTrustRef trust = NULL;
+    OSStatus status = SecTrustCreateWithCertificates((__bridge CFArrayRef)certificates, policy, &trust);
+    CFRelease(policy);
+    XCTAssertEqual(status, errSecSuccess);
+
+    return trust;
+}
+
+- (BOOL)evaluatePolicy:(AFSecurityPolicy *)policy domain:(NSString *)domain {
+    SecTrustRef trust = [self createServerTrust];
+    BOOL isTrusted = [policy evaluateServerTrust:trust forDomain:domain];
+    CFRelease(trust);
+    return isTrusted;
+}
+
+- (AFSecurityPolicy *)certificatePolicyPinning:(NSString *)base64 {
+    AFSecurityPolicy *policy = [AFSecurityPolicy policyWithPinningMode:AFSSLPinningModeCertificate withPinnedCertificates:[NSSet setWithObject:AFTestCertificateData(base64)]];
+    // 测试证书有效期超过 TLS 服务端证书的上限, 只校验证书链
+    policy.validatesDomainName = NO;
+    return policy;
+}
+
+- (AFSecurityPolicy *)publicKeyPolicyPinning:(NSString *)base64 {
+    AFSecurityPolicy *policy = [AFSecurityPolicy policyWithPinningMode:AFSSLPinningModePublicKey withPinnedCertificates:[NSSet setWithObject:AFTestCertificateData(base64)]];
+    // Root CA 不在系统信任列表里, 只比对公钥
+    policy.allowInvalidCertificates = YES;
+    policy.validatesDomainName = NO;
+    return policy;
+}
+
+#pragma mark - 固定证书 / 公钥
+
+- (void)testCertificatePinningMatchesPinnedRootInChain {
+    XCTAssertTrue([self evaluatePolicy:[self certificatePolicyPinning:AFTestRootCertificate] domain:AFTestDomain]);
+}
+
+- (void)testCertificatePinningRejectsUnrelatedCertificate {
+    XCTAssertFalse([self evaluatePolicy:[self certificatePolicyPinning:AFTestOtherCertificate] domain:AFTestDomain]);
+}
+
+- (void)testPublicKeyPinningMatchesLeafAndRootKeys {
+    XCTAssertTrue([self evaluatePolicy:[self publicKeyPolicyPinning:AFTestLeafCertificate] domain:AFTestDomain]);
+    XCTAssertTrue([self evaluatePolicy:[self publicKeyPolicyPinning:AFTestRootCertificate] domain:AFTestDomain]);
+}
+
+- (void)testPublicKeyPinningRejectsUnrelatedKey {
+    XCTAssertFalse([self evaluatePolicy:[self publicKeyPolicyPinning:AFTestOtherCertificate] domain:AFTestDomain]);
+}
+
+- (void)testPinningSeveralCertificatesMatchesAnyOfThem {
+    NSSet *pinnedCertificates = [NSSet setWithObjects:AFTestCertificateData(AFTestOtherCertificate), AFTestCertificateData(AFTestLeafCertificate), nil];
+    AFSecurityPolicy *policy = [AFSecurityPolicy policyWithPinningMode:AFSSLPinningModePublicKey withPinnedCertificates:pinnedCertificates];
+    policy.allowInvalidCertificates = YES;
+    policy.validatesDomainName = NO;
+
+    XCTAssertTrue([self evaluatePolicy:policy domain:AFTestDomain]);
+}
+
+#pragma mark - 缓存 TTL 与统计
+
+- (void)testCachingIsDisabledByDefault {
+    AFSecurityPolicy *policy = [self certificatePolicyPinning:AFTestRootCertificate];
+
+    XCTAssertTrue([self evaluatePolicy:policy domain:AFTestDomain]);
+    XCTAssertTrue([self evaluatePolicy:policy domain:AFTestDomain]);
+
+    XCTAssertEqual(policy.trustEvaluationCount, 2u);
+    XCTAssertEqual(policy.trustEvaluationCacheHitCount, 0u);
+}
+
+- (void)testSuccessfulEvaluationIsCachedUntilTimeout {
+    AFSecurityPolicy *policy = [self certificatePolicyPinning:AFTestRootCertificate];
+    policy.trustEvaluationCacheTimeout = 0.5;
+
+    XCTAssertTrue([self evaluatePolicy:policy domain:AFTestDomain]);
+    XCTAssertEqual(policy.trustEvaluationCount, 1u);
+    XCTAssertEqual(policy.trustEvaluationCacheHitCount, 0u);
+    XCTAssertGreaterThan(policy.trustEvaluationDuration, 0);
+
+    // 同一域名、同一叶子证书的新连接命中缓存, 不再计入耗时
+    NSTimeInterval duration = policy.trustEvaluationDuration;
+    XCTAssertTrue([self evaluatePolicy:policy domain:AFTestDomain]);
+    XCTAssertEqual(policy.trustEvaluationCount, 1u);
+    XCTAssertEqual(policy.trustEvaluationCacheHitCount, 1u);
+    XCTAssertEqual(policy.trustEvaluationDuration, duration);
+
+    // 超过 TTL 后重新完整校验
+    [NSThread sleepForTimeInterval:0.6];
+    XCTAssertTrue([self evaluatePolicy:policy domain:AFTestDomain]);
+    XCTAssertEqual(policy.trustEvaluationCount, 2u);
+    XCTAssertEqual(policy.trustEvaluationCacheHitCount, 1u);
+}
+
+- (void)testCacheIsKeyedByDomain {
+    AFSecurityPolicy *policy = [self certificatePolicyPinning:AFTestRootCertificate];
+    policy.trustEvaluationCacheTimeout = 60;
+
+    XCTAssertTrue([self evaluatePolicy:policy domain:AFTestDomain]);
+    XCTAssertTrue([self evaluatePolicy:policy domain:@"other.hypnonerd.local"]);
+    XCTAssertTrue([self evaluatePolicy:policy domain:[AFTestDomain uppercaseString]]);
+
+    XCTAssertEqual(policy.trustEvaluationCount, 2u);
+    XCTAssertEqual(policy.trustEvaluationCacheHitCount, 1u);
+}
+
+- (void)testFailedEvaluationIsNotCached {
+    AFSecurityPolicy *policy = [self certificatePolicyPinning:AFTestOtherCertificate];
+    policy.trustEvaluationCacheTimeout = 60;
+
+    XCTAssertFalse([self evaluatePolicy:policy domain:AFTestDomain]);
+    XCTAssertFalse([self evaluatePolicy:policy domain:AFTestDomain]);
+
+    XCTAssertEqual(policy.trustEvaluationCount, 2u);
+    XCTAssertEqual(policy.trustEvaluationCacheHitCount, 0u);
+}
+
+- (void)testChangingPolicyClearsCache {
+    AFSecurityPolicy *policy = [self certificatePolicyPinning:AFTestRootCertificate];
+    policy.trustEvaluationCacheTimeout = 60;
+
+    XCTAssertTrue([self evaluatePolicy:policy domain:AFTestDomain]);
+
+    // 换成不相关的证书后, 之前缓存的结果不能再放行
+    policy.pinnedCertificates = [NSSet setWithObject:AFTestCertificateData(AFTestOtherCertificate)];
+    XCTAssertFalse([self evaluatePolicy:policy domain:AFTestDomain]);
+    XCTAssertEqual(policy.trustEvaluationCount, 2u);
+    XCTAssertEqual(policy.trustEvaluationCacheHitCount, 0u);
+
+    policy.pinnedCertificates = [NSSet setWithObject:AFTestCertificateData(AFTestRootCertificate)];
+    XCTAssertTrue([self evaluatePolicy:policy domain:AFTestDomain]);
+    [policy removeAllCachedTrustEvaluations];
+    XCTAssertTrue([self evaluatePolicy:policy domain:AFTestDomain]);
+    XCTAssertEqual(policy.trustEvaluationCount, 4u);
+    XCTAssertEqual(policy.trustEvaluationCacheHitCount, 0u);
+}
+
+#pragma mark - 性能
+
+- (void)testPerformanceEvaluationWithoutCache {
+    AFSecurityPolicy *policy = [self publicKeyPolicyPinning:AFTestRootCertificate];
+    [self measureBlock:^{
+        for (NSUInteger i = 0; i < 100; i++) {
+            [self evaluatePolicy:policy domain:AFTestDomain];
+        }
+    }];
+}
+
+- (void)testPerformanceEvaluationWithCache {
+    AFSecurityPolicy *policy = [self publicKeyPolicyPinning:AFTestRootCertificate];
+    policy.trustEvaluationCacheTimeout = 60;
+    [self measureBlock:^{
+        for (NSUInteger i = 0; i < 100; i++) {
+            [self evaluatePolicy:policy domain:AFTestDomain];
+        }
+    }];
+}
+
+@end
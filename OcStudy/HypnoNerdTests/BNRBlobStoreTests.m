@@ -0,0 +1,119 @@
+//
+//  BNRBlobStoreTests.m
+//  HypnoNerdTests
+//
+//  Created by HuXin on 2026/10/18.
+//
+
+#import <XCTest/XCTest.h>
+#import "BNRBlobStore.h"
+
+/// 一次批量导入的数据份数
+static NSUInteger const kImportCount = 2000;
+
+@interface BNRBlobStoreTests : XCTestCase
+
+@property (nonatomic, copy) NSString *directory;
+@property (nonatomic, strong) BNRBlobStore *store;
+
+@end
+
+@implementation BNRBlobStoreTests
+
+- (void)setUp {
+    self.directory = [NSTemporaryDirectory() stringByAppendingPathComponent:[NSUUID UUID].UUIDString];
+    self.store = [[BNRBlobStore alloc] initWithDirectory:self.directory];
+}
+
+- (void)tearDown {
+    [self.store synchronize];
+    self.store = nil;
+    [[NSFileManager defaultManager] removeItemAtPath:self.directory error:NULL];
+}
+
+- (NSString *)indexPath {
+    return [self.directory stringByAppendingPathComponent:@"index.plist"];
+}
+
+- (NSData *)dataWithNumber:(NSUInteger)number {
+    return [[NSString stringWithFormat:@"blob %lu", (unsigned long)number] dataUsingEncoding:NSUTF8StringEncoding];
+}
+
+#pragma mark - 正确性
+
+- (void)testIndexIsWrittenOnSynchronize {
+    for (NSUInteger i = 0; i < 10; i++) {
+        [self.store setData:[self dataWithNumber:i] forKey:@(i).stringValue];
+    }
+    // 改动先只在内存里, 一次写下去
+    XCTAssertFalse([[NSFileManager defaultManager] fileExistsAtPath:[self indexPath]]);
+    XCTAssertTrue([self.store synchronize]);
+
+    BNRBlobStore *reloaded = [[BNRBlobStore alloc] initWithDirectory:self.directory];
+    XCTAssertEqualObjects([reloaded dataForKey:@"3"], [self dataWithNumber:3]);
+    XCTAssertEqual(reloaded.storedBytes, self.store.storedBytes);
+}
+
+- (void)testIndexIsWrittenAfterDelay {
+    [self.store setData:[self dataWithNumber:0] forKey:@"0"];
+
+    XCTNSPredicateExpectation *written = [[XCTNSPredicateExpectation alloc] initWithPredicate:[NSPredicate predicateWithBlock:^BOOL(id object, NSDictionary *bindings) {
+        return [[NSFileManager defaultManager] fileExistsAtPath:[self indexPath]];
+    }] object:nil];
+    [self waitForExpectations:@[written] timeout:5];
+}
+
+- (void)testDeadFileIsRemovedAfterIndexIsWritten {
+    [self.store setData:[self dataWithNumber:0] forKey:@"0"];
+    XCTAssertTrue([self.store synchronize]);
+    NSString *path = [self.store pathForKey:@"0"];
+
+    // 磁盘上的索引还引用着这个文件, 写下去之前不能删
+    [self.store removeDataForKey:@"0"];
+    XCTAssertTrue([[NSFileManager defaultManager] fileExistsAtPath:path]);
+
+    XCTAssertTrue([self.store synchronize]);
+    XCTAssertFalse([[NSFileManager defaultManager] fileExistsAtPath:path]);
+}
+
+- (void)testFileReferencedAgainBeforeFlushIsKept {
+    [self.store setData:[self dataWithNumber:0] forKey:@"0"];
+    NSString *path = [self.store pathForKey:@"0"];
+    [self.store removeDataForKey:@"0"];
+    [self.store setData:[self dataWithNumber:0] forKey:@"1"];
+
+    XCTAssertTrue([self.store synchronize]);
+    XCTAssertTrue([[NSFileManager defaultManager] fileExistsAtPath:path]);
+    XCTAssertEqualObjects([self.store dataForKey:@"1"], [self dataWithNumber:0]);
+}
+
+- (void)testGarbageCollectionKeepsIndexedFiles {
+    [self.store setData:[self dataWithNumber:0] forKey:@"0"];
+    [self.store setData:[self dataWithNumber:1] forKey:@"1"];
+    [self.store removeDataForKey:@"1"];
+
+    XCTAssertEqual([self.store collectGarbage], 0);
+    BNRBlobStore *reloaded = [[BNRBlobStore alloc] initWithDirectory:self.directory];
+    XCTAssertEqualObjects([reloaded dataForKey:@"0"], [self dataWithNumber:0]);
+    XCTAssertNil([reloaded dataForKey:@"1"]);
+}
+
+#pragma mark - 批量导入
+
+- (void)testPerformanceImport {
+    // 每轮导入到新的目录, 索引在最后写一次
+    [self measureMetrics:[[self class] defaultPerformanceMetrics] automaticallyStartMeasuring:NO forBlock:^{
+        [self.store synchronize];
+        [[NSFileManager defaultManager] removeItemAtPath:self.directory error:NULL];
+        self.store = [[BNRBlobStore alloc] initWithDirectory:self.directory];
+
+        [self startMeasuring];
+        for (NSUInteger i = 0; i < kImportCount; i++) {
+            [self.store setData:[self dataWithNumber:i] forKey:@(i).stringValue];
+        }
+        XCTAssertTrue([self.store synchronize]);
+        [self stopMeasuring];
+    }];
+}
+
+@end
@@ -0,0 +1,303 @@
+//
+//  BNRDrawViewFrameTests.m
+//  HypnoNerdTests
+//
+//  Created by HuXin on 2026/10/18.
+//
+
+#import <XCTest/XCTest.h>
+#import "BNRDrawView.h"
+#import "BNRLine.h"
+#import "BNRLineIndex.h"
+
+static CGFloat const kCanvasWidth = 1024;
+static CGFloat const kCanvasHeight = 768;
+/// 一笔的最大长度, 像手写或者涂鸦, 不是横贯整个画布的长线
+static CGFloat const kMaxLineLength = 80;
+/// 每次测量画的帧数, 相当于拖一秒手指
+static NSUInteger const kFrameCount = 60;
+
+@interface BNRDrawView (Testing)
+
+@property (nonatomic, strong) NSMutableDictionary *linesProgress;
+@property (nonatomic, strong) NSMutableArray *finishedLines;
+@property (nonatomic, strong) BNRLineIndex *lineIndex;
+@property (nonatomic, weak) BNRLine *selectedLine;
+@property (nonatomic, strong) UIImage *rasterImage;
+@property (nonatomic) BOOL rasterNeedsRebuild;
+@property (nonatomic) CGContextRef rasterContext;
+
+- (void)strokeLine:(BNRLine *)line;
+- (CGRect)displayRectForLine:(BNRLine *)line;
+- (void)rasterizeLine:(BNRLine *)line;
+- (void)deleteLine:(id)sender;
+
+@end
+
+@interface BNRDrawViewFrameTests : XCTestCase
+
+@property (nonatomic, strong) BNRDrawView *drawView;
+@property (nonatomic, strong) UIGraphicsImageRenderer *renderer;
+/// 正在画的线, 每帧终点移动一点
+@property (nonatomic, strong) BNRLine *currentLine;
+
+@end
+
+@implementation BNRDrawViewFrameTests
+
+- (void)setUp {
+    srand48(49);
+    self.drawView = [[BNRDrawView alloc] initWithFrame:CGRectMake(0, 0, kCanvasWidth, kCanvasHeight)];
+    [self addFinishedLinesWithCount:2000];
+
+    self.currentLine = [[BNRLine alloc] init];
+    self.currentLine.begin = CGPointMake(kCanvasWidth / 2, kCanvasHeight / 2);
+    self.currentLine.end = self.currentLine.begin;
+    self.drawView.linesProgress[@0] = self.currentLine;
+
+    UIGraphicsImageRendererFormat *format = [UIGraphicsImageRendererFormat defaultFormat];
+    format.scale = self.drawView.contentScaleFactor;
+    self.renderer = [[UIGraphicsImageRenderer alloc] initWithBounds:self.drawView.bounds format:format];
+}
+
+- (void)tearDown {
+    self.drawView = nil;
+    self.renderer = nil;
+    self.currentLine = nil;
+}
+
+- (void)addFinishedLine:(BNRLine *)line {
+    [self.drawView.finishedLines addObject:line];
+    [self.drawView.lineIndex addLine:line];
+}
+
+- (void)addFinishedLinesWithCount:(NSUInteger)count {
+    for (NSUInteger i = 0; i < count; i++) {
+        BNRLine *line = [[BNRLine alloc] init];
+        line.begin = CGPointMake(drand48() * kCanvasWidth, drand48() * kCanvasHeight);
+        line.end = CGPointMake(line.begin.x + (drand48() * 2 - 1) * kMaxLineLength / M_SQRT2,
+                               line.begin.y + (drand48() * 2 - 1) * kMaxLineLength / M_SQRT2);
+        [self addFinishedLine:line];
+    }
+}
+
+- (void)drawWholeView {
+    [self.renderer imageWithActions:^(UIGraphicsImageRendererContext *context) {
+        [self.drawView drawRect:self.drawView.bounds];
+    }];
+}
+
+/// 位图上 point 处像素的 alpha, 没画到的地方是 0
+- (uint8_t)rasterAlphaAtPoint:(CGPoint)point {
+    CGContextRef context = self.drawView.rasterContext;
+    CGFloat scale = self.drawView.contentScaleFactor;
+    // 位图的第一行是视图的顶部, 像素是 32 位主机字节序, alpha 在最高字节
+    const uint8_t *row = (const uint8_t *)CGBitmapContextGetData(context) + (size_t)(point.y * scale) * CGBitmapContextGetBytesPerRow(context);
+    return ((const uint32_t *)row)[(size_t)(point.x * scale)] >> 24;
+}
+
+/// 手指移动一帧, 返回 BNRDrawView 会标记的脏区域
+- (CGRect)moveCurrentLineForFrame:(NSUInteger)frame {
+    CGRect oldRect = [self.drawView displayRectForLine:self.currentLine];
+    self.currentLine.end = CGPointMake(self.currentLine.begin.x + frame * 3, self.currentLine.begin.y + frame * 2);
+    return CGRectUnion(oldRect, [self.drawView displayRectForLine:self.currentLine]);
+}
+
+#pragma mark - 正确性
+
+- (void)testFinishedLineIsRasterizedWithoutRebuild {
+    [self.renderer imageWithActions:^(UIGraphicsImageRendererContext *context) {
+        [self.drawView drawRect:self.drawView.bounds];
+    }];
+    XCTAssertFalse(self.drawView.rasterNeedsRebuild);
+    UIImage *image = self.drawView.rasterImage;
+    XCTAssertNotNil(image);
+
+    // 画完的线直接画进位图, 只换掉取出来的图片
+    [self.drawView.linesProgress removeAllObjects];
+    [self.drawView.finishedLines addObject:self.currentLine];
+    [self.drawView rasterizeLine:self.currentLine];
+    XCTAssertFalse(self.drawView.rasterNeedsRebuild);
+    XCTAssertNil(self.drawView.rasterImage);
+
+    [self.renderer imageWithActions:^(UIGraphicsImageRendererContext *context) {
+        [self.drawView drawRect:self.drawView.bounds];
+    }];
+    XCTAssertNotNil(self.drawView.rasterImage);
+    XCTAssertNotEqual(self.drawView.rasterImage, image);
+}
+
+- (void)testSelectingLineRedrawsOnlyItsRect {
+    // 两条互不相交的线, 看位图上各自中点的像素
+    [self.drawView.finishedLines removeAllObjects];
+    [self.drawView.lineIndex removeAllLines];
+    [self.drawView.linesProgress removeAllObjects];
+    BNRLine *top = [[BNRLine alloc] init];
+    top.begin = CGPointMake(100, 100);
+    top.end = CGPointMake(300, 100);
+    BNRLine *bottom = [[BNRLine alloc] init];
+    bottom.begin = CGPointMake(100, 300);
+    bottom.end = CGPointMake(300, 300);
+    [self addFinishedLine:top];
+    [self addFinishedLine:bottom];
+    [self drawWholeView];
+    XCTAssertGreaterThan([self rasterAlphaAtPoint:CGPointMake(200, 100)], 0);
+
+    // 选中的线从位图里擦掉, 不整张重建
+    self.drawView.selectedLine = top;
+    XCTAssertFalse(self.drawView.rasterNeedsRebuild);
+    XCTAssertNil(self.drawView.rasterImage);
+    XCTAssertEqual([self rasterAlphaAtPoint:CGPointMake(200, 100)], 0);
+    XCTAssertGreaterThan([self rasterAlphaAtPoint:CGPointMake(200, 300)], 0);
+
+    // 拖到别处再取消选中, 画回新的位置
+    top.begin = CGPointMake(100, 200);
+    top.end = CGPointMake(300, 200);
+    [self.drawView.lineIndex updateLine:top];
+    self.drawView.selectedLine = nil;
+    XCTAssertFalse(self.drawView.rasterNeedsRebuild);
+    XCTAssertEqual([self rasterAlphaAtPoint:CGPointMake(200, 100)], 0);
+    XCTAssertGreaterThan([self rasterAlphaAtPoint:CGPointMake(200, 200)], 0);
+}
+
+- (void)testSelectingLineKeepsCrossingLines {
+    [self.drawView.finishedLines removeAllObjects];
+    [self.drawView.lineIndex removeAllLines];
+    BNRLine *horizontal = [[BNRLine alloc] init];
+    horizontal.begin = CGPointMake(100, 200);
+    horizontal.end = CGPointMake(300, 200);
+    BNRLine *vertical = [[BNRLine alloc] init];
+    vertical.begin = CGPointMake(200, 100);
+    vertical.end = CGPointMake(200, 300);
+    [self addFinishedLine:horizontal];
+    [self addFinishedLine:vertical];
+    [self drawWholeView];
+
+    // 擦掉的那块里经过的别的线要重描回来
+    self.drawView.selectedLine = horizontal;
+    XCTAssertGreaterThan([self rasterAlphaAtPoint:CGPointMake(200, 200)], 0);
+    XCTAssertGreaterThan([self rasterAlphaAtPoint:CGPointMake(200, 120)], 0);
+    XCTAssertEqual([self rasterAlphaAtPoint:CGPointMake(120, 200)], 0);
+}
+
+- (void)testDeletedLineIsNotDrawnBack {
+    BNRLine *line = self.drawView.finishedLines.firstObject;
+    [self drawWholeView];
+
+    self.drawView.selectedLine = line;
+    [self.drawView deleteLine:nil];
+
+    XCTAssertNil(self.drawView.selectedLine);
+    XCTAssertFalse([self.drawView.finishedLines containsObject:line]);
+    XCTAssertFalse(self.drawView.rasterNeedsRebuild);
+}
+
+#pragma mark - Helpers
+
+/// 先建好位图, 之后每帧只画脏区域
+- (void)measureFramesWithRasterCacheWithLineCount:(NSUInteger)count {
+    [self addFinishedLinesWithCount:count - self.drawView.finishedLines.count];
+    [self drawWholeView];
+
+    [self measureBlock:^{
+        [self.renderer imageWithActions:^(UIGraphicsImageRendererContext *context) {
+            for (NSUInteger frame = 0; frame < kFrameCount; frame++) {
+                CGRect dirtyRect = [self moveCurrentLineForFrame:frame];
+                CGContextSaveGState(context.CGContext);
+                CGContextClipToRect(context.CGContext, dirtyRect);
+                [self.drawView drawRect:dirtyRect];
+                CGContextRestoreGState(context.CGContext);
+            }
+        }];
+    }];
+}
+
+/// 原来的 drawRect: 每帧整块重画, 所有画完的线都描一遍
+- (void)measureFramesRedrawingAllLinesWithLineCount:(NSUInteger)count {
+    [self addFinishedLinesWithCount:count - self.drawView.finishedLines.count];
+
+    [self measureBlock:^{
+        [self.renderer imageWithActions:^(UIGraphicsImageRendererContext *context) {
+            for (NSUInteger frame = 0; frame < kFrameCount; frame++) {
+                [self moveCurrentLineForFrame:frame];
+                [[UIColor blackColor] set];
+                for (BNRLine *line in self.drawView.finishedLines) {
+                    [self.drawView strokeLine:line];
+                }
+                [[UIColor redColor] set];
+                [self.drawView strokeLine:self.currentLine];
+            }
+        }];
+    }];
+}
+
+/// 每帧点选一条线, 画出前后两条线所在的脏区域。rebuildsRaster 模拟原来选中状态一变就整张重建位图
+- (void)measureSelectionWithLineCount:(NSUInteger)count rebuildsRaster:(BOOL)rebuildsRaster {
+    [self addFinishedLinesWithCount:count - self.drawView.finishedLines.count];
+    [self.drawView.linesProgress removeAllObjects];
+    [self drawWholeView];
+    NSArray<BNRLine *> *lines = [self.drawView.finishedLines subarrayWithRange:NSMakeRange(0, kFrameCount)];
+
+    [self measureBlock:^{
+        [self.renderer imageWithActions:^(UIGraphicsImageRendererContext *context) {
+            for (BNRLine *line in lines) {
+                CGRect dirtyRect = [self.drawView displayRectForLine:line];
+                if (self.drawView.selectedLine) {
+                    dirtyRect = CGRectUnion(dirtyRect, [self.drawView displayRectForLine:self.drawView.selectedLine]);
+                }
+                self.drawView.selectedLine = line;
+                if (rebuildsRaster) {
+                    self.drawView.rasterNeedsRebuild = YES;
+                }
+                CGContextSaveGState(context.CGContext);
+                CGContextClipToRect(context.CGContext, dirtyRect);
+                [self.drawView drawRect:dirtyRect];
+                CGContextRestoreGState(context.CGContext);
+            }
+            self.drawView.selectedLine = nil;
+        }];
+    }];
+}
+
+#pragma mark - 帧耗时
+
+- (void)testPerformanceFramesWithRasterCache {
+    [self measureFramesWithRasterCacheWithLineCount:2000];
+}
+
+- (void)testPerformanceFramesRedrawingAllLines {
+    [self measureFramesRedrawingAllLinesWithLineCount:2000];
+}
+
+- (void)testPerformanceFramesWithRasterCache10k {
+    [self measureFramesWithRasterCacheWithLineCount:10000];
+}
+
+- (void)testPerformanceFramesRedrawingAllLines10k {
+    [self measureFramesRedrawingAllLinesWithLineCount:10000];
+}
+
+- (void)testPerformanceFramesWithRasterCache100k {
+    // 每帧描 10 万条线太慢, 整块重画的不测 10 万
+    [self measureFramesWithRasterCacheWithLineCount:100000];
+}
+
+#pragma mark - 选中
+
+- (void)testPerformanceSelection10k {
+    [self measureSelectionWithLineCount:10000 rebuildsRaster:NO];
+}
+
+- (void)testPerformanceSelectionRebuildingRaster10k {
+    [self measureSelectionWithLineCount:10000 rebuildsRaster:YES];
+}
+
+- (void)testPerformanceSelection100k {
+    [self measureSelectionWithLineCount:100000 rebuildsRaster:NO];
+}
+
+- (void)testPerformanceSelectionRebuildingRaster100k {
+    [self measureSelectionWithLineCount:100000 rebuildsRaster:YES];
+}
+
+@end
@@ -0,0 +1,174 @@
+//
+//  BNRImageStoreThumbnailTests.m
+//  HypnoNerdTests
+//
+//  Created by HuXin on 2026/10/18.
+//
+
+#import <XCTest/XCTest.h>
+#import "BNRImageStore.h"
+
+/// 一屏大约能显示的行数
+static NSUInteger const kVisibleRowCount = 12;
+static CGFloat const kPhotoWidth = 2016;
+static CGFloat const kPhotoHeight = 1512;
+
+@interface BNRImageStore (Testing)
+
+@property (nonatomic, strong) NSCache<NSString *, UIImage *> *thumbnails;
+
+@end
+
+@interface BNRImageStoreThumbnailTests : XCTestCase
+
+@property (nonatomic, strong) BNRImageStore *store;
+@property (nonatomic, strong) NSArray<NSString *> *keys;
+
+@end
+
+@implementation BNRImageStoreThumbnailTests
+
+/// 相机拍出来大小的照片, 每张颜色不同, 不会被 BNRBlobStore 去重
+- (UIImage *)photoWithHue:(CGFloat)hue {
+    UIGraphicsImageRendererFormat *format = [UIGraphicsImageRendererFormat defaultFormat];
+    format.scale = 1;
+    UIGraphicsImageRenderer *renderer = [[UIGraphicsImageRenderer alloc] initWithSize:CGSizeMake(kPhotoWidth, kPhotoHeight) format:format];
+    return [renderer imageWithActions:^(UIGraphicsImageRendererContext *context) {
+        [[UIColor colorWithHue:hue saturation:0.6 brightness:0.9 alpha:1] setFill];
+        [context fillRect:CGRectMake(0, 0, kPhotoWidth, kPhotoHeight)];
+        [[UIColor whiteColor] setFill];
+        [context fillRect:CGRectMake(kPhotoWidth / 4, kPhotoHeight / 4, kPhotoWidth / 2, kPhotoHeight / 2)];
+    }];
+}
+
+- (void)setUp {
+    self.store = [BNRImageStore sharedStore];
+
+    NSMutableArray *keys = [NSMutableArray arrayWithCapacity:kVisibleRowCount];
+    self.keys = keys;
+    for (NSUInteger i = 0; i < kVisibleRowCount; i++) {
+        NSString *key = [NSUUID UUID].UUIDString;
+        [keys addObject:key];
+        // 缩略图请求排在写盘之后, 回调了说明这张已经写完, 内存里同时只留一张原图
+        @autoreleasepool {
+            [self.store setImage:[self photoWithHue:(CGFloat)i / kVisibleRowCount] forKey:key];
+            XCTestExpectation *written = [self expectationWithDescription:@"written"];
+            [self.store thumbnailForKey:key completion:^(UIImage *thumbnail) {
+                [written fulfill];
+            }];
+            [self waitForExpectations:@[written] timeout:30];
+        }
+    }
+}
+
+- (void)tearDown {
+    for (NSString *key in self.keys) {
+        [self.store deleteImageForKey:key];
+    }
+    self.keys = nil;
+}
+
+- (NSArray<UIImage *> *)loadThumbnails {
+    NSMutableArray *thumbnails = [NSMutableArray array];
+    XCTestExpectation *loaded = [self expectationWithDescription:@"thumbnails"];
+    loaded.expectedFulfillmentCount = self.keys.count;
+    for (NSString *key in self.keys) {
+        [self.store thumbnailForKey:key completion:^(UIImage *thumbnail) {
+            if (thumbnail) {
+                [thumbnails addObject:thumbnail];
+            }
+            [loaded fulfill];
+        }];
+    }
+    [self waitForExpectations:@[loaded] timeout:30];
+    return thumbnails;
+}
+
+#pragma mark - 正确性
+
+- (void)testThumbnailIsSmallDecodedBitmap {
+    NSArray<UIImage *> *thumbnails = [self loadThumbnails];
+    XCTAssertEqual(thumbnails.count, kVisibleRowCount);
+
+    UIImage *thumbnail = thumbnails.firstObject;
+    XCTAssertTrue(CGSizeEqualToSize(thumbnail.size, CGSizeMake(BNRImageStoreThumbnailSide, BNRImageStoreThumbnailSide)));
+
+    // 缓存的缩略图只占原图位图的很小一部分
+    CGImageRef cgImage = thumbnail.CGImage;
+    NSUInteger thumbnailBytes = CGImageGetBytesPerRow(cgImage) * CGImageGetHeight(cgImage);
+    NSUInteger photoBytes = (NSUInteger)(kPhotoWidth * kPhotoHeight) * 4;
+    NSLog(@"thumbnail %lu KB, full image %lu KB", (unsigned long)thumbnailBytes / 1024, (unsigned long)photoBytes / 1024);
+    XCTAssertLessThan(thumbnailBytes * 100, photoBytes);
+}
+
+- (void)testCachedThumbnailIsReturnedSynchronously {
+    __block BOOL calledBack = NO;
+    UIImage *thumbnail = [self.store thumbnailForKey:self.keys.firstObject completion:^(UIImage *image) {
+        calledBack = YES;
+    }];
+    XCTAssertNotNil(thumbnail);
+    XCTAssertTrue(calledBack);
+}
+
+- (void)testConcurrentRequestsShareOneLoad {
+    [self.store.thumbnails removeAllObjects];
+
+    NSMutableArray *results = [NSMutableArray array];
+    XCTestExpectation *loaded = [self expectationWithDescription:@"thumbnail"];
+    loaded.expectedFulfillmentCount = 3;
+    for (NSUInteger i = 0; i < 3; i++) {
+        UIImage *thumbnail = [self.store thumbnailForKey:self.keys.firstObject completion:^(UIImage *image) {
+            [results addObject:image];
+            [loaded fulfill];
+        }];
+        XCTAssertNil(thumbnail);
+    }
+    [self waitForExpectations:@[loaded] timeout:5];
+
+    XCTAssertEqual(results[0], results[1]);
+    XCTAssertEqual(results[1], results[2]);
+
+    // 从文件读回的缩略图和刚生成的一样大
+    UIImage *thumbnail = results[0];
+    XCTAssertTrue(CGSizeEqualToSize(thumbnail.size, CGSizeMake(BNRImageStoreThumbnailSide, BNRImageStoreThumbnailSide)));
+    XCTAssertEqual(thumbnail.scale, [UIScreen mainScreen].scale);
+}
+
+#pragma mark - 一屏 cell 的图片
+
+- (void)testPerformanceVisibleRowsFromThumbnailCache {
+    [self measureBlock:^{
+        for (NSString *key in self.keys) {
+            [self.store thumbnailForKey:key completion:^(UIImage *thumbnail) {}];
+        }
+    }];
+}
+
+- (void)testPerformanceVisibleRowsFromThumbnailFiles {
+    // 缓存被清空后从磁盘读缩略图, 解码在后台完成
+    [self measureMetrics:[[self class] defaultPerformanceMetrics] automaticallyStartMeasuring:NO forBlock:^{
+        [self.store.thumbnails removeAllObjects];
+
+        [self startMeasuring];
+        [self loadThumbnails];
+        [self stopMeasuring];
+    }];
+}
+
+- (void)testPerformanceVisibleRowsFromFullImages {
+    // 原来的 cell 在主线程读原图, 显示时再解码、缩到 80pt
+    UIGraphicsImageRendererFormat *format = [UIGraphicsImageRendererFormat preferredFormat];
+    CGSize size = CGSizeMake(BNRImageStoreThumbnailSide, BNRImageStoreThumbnailSide);
+    UIGraphicsImageRenderer *renderer = [[UIGraphicsImageRenderer alloc] initWithSize:size format:format];
+
+    [self measureBlock:^{
+        for (NSString *key in self.keys) {
+            UIImage *image = [UIImage imageWithContentsOfFile:[self.store imagePathForKey:key]];
+            [renderer imageWithActions:^(UIGraphicsImageRendererContext *context) {
+                [image drawInRect:CGRectMake(0, 0, size.width, size.height)];
+            }];
+        }
+    }];
+}
+
+@end
@@ -0,0 +1,265 @@
+//
+//  BNRItemStorePersistenceTests.m
+//  HypnoNerdTests
+//
+//  Created by HuXin on 2026/10/18.
+//
+
+#import <XCTest/XCTest.h>
+#import "BNRItemStore.h"
+#import "BNRItemJournal.h"
+#import "BNRTtem.h"
+
+/// 不同的条目数, 更多的条目循环复用这些归档数据, 免得造 50 万个 BNRTtem
+static NSUInteger const kItemPoolCount = 1000;
+/// 一屏大约能显示的行数
+static NSUInteger const kVisibleRowCount = 20;
+
+@interface BNRItemStore (Testing)
+
+- (instancetype)initWithDirectory:(NSString *)directory;
+
+@end
+
+@interface BNRItemStoreSnapshot (Testing)
+
+@property (nonatomic, strong) NSMutableArray *items;
+
+@end
+
+@interface BNRItemStorePersistenceTests : XCTestCase
+
+@property (nonatomic, copy) NSString *directory;
+@property (nonatomic, strong) NSArray<BNRTtem *> *items;
+@property (nonatomic, strong) NSArray<NSData *> *itemData;
+/// 测量中解码出的条目留到 tearDown 再释放, 不把 BNRTtem 的 dealloc 日志算进去
+@property (nonatomic, strong) NSMutableArray *decodedItems;
+
+@end
+
+@implementation BNRItemStorePersistenceTests
+
+- (void)setUp {
+    self.directory = [NSTemporaryDirectory() stringByAppendingPathComponent:[NSUUID UUID].UUIDString];
+    [[NSFileManager defaultManager] createDirectoryAtPath:self.directory withIntermediateDirectories:YES attributes:nil error:NULL];
+
+    NSMutableArray *items = [NSMutableArray arrayWithCapacity:kItemPoolCount];
+    NSMutableArray *itemData = [NSMutableArray arrayWithCapacity:kItemPoolCount];
+    for (NSUInteger i = 0; i < kItemPoolCount; i++) {
+        BNRTtem *item = [BNRTtem randomItem];
+        [items addObject:item];
+        [itemData addObject:[NSKeyedArchiver archivedDataWithRootObject:item]];
+    }
+    self.items = items;
+    self.itemData = itemData;
+    self.decodedItems = [NSMutableArray array];
+}
+
+- (void)tearDown {
+    [[NSFileManager defaultManager] removeItemAtPath:self.directory error:NULL];
+    self.items = nil;
+    self.itemData = nil;
+    self.decodedItems = nil;
+}
+
+- (NSString *)legacyArchivePath {
+    return [self.directory stringByAppendingPathComponent:@"items.archive"];
+}
+
+- (NSArray<NSData *> *)itemDataWithCount:(NSUInteger)count {
+    NSMutableArray<NSData *> *itemData = [NSMutableArray arrayWithCapacity:count];
+    for (NSUInteger i = 0; i < count; i++) {
+        [itemData addObject:self.itemData[i % kItemPoolCount]];
+    }
+    return itemData;
+}
+
+/// 旧版本归档的是对象图, 同一个对象只会存一次, 所以每个条目都得是不同的对象
+- (NSArray<BNRTtem *> *)itemsWithCount:(NSUInteger)count {
+    NSMutableArray<BNRTtem *> *items = [self.items mutableCopy];
+    while (items.count < count) {
+        [items addObject:[BNRTtem randomItem]];
+    }
+    [self.decodedItems addObject:items];
+    return [items subarrayWithRange:NSMakeRange(0, count)];
+}
+
+- (BNRItemJournal *)compactedJournalWithItemData:(NSArray<NSData *> *)itemData {
+    BNRItemJournal *journal = [[BNRItemJournal alloc] initWithDirectory:self.directory];
+    [journal loadItemData];
+    XCTAssertTrue([journal compactWithItemData:itemData]);
+    return journal;
+}
+
+#pragma mark - 正确性
+
+- (void)testJournalReloadsWhatWasWritten {
+    BNRItemJournal *journal = [self compactedJournalWithItemData:self.itemData];
+    [journal appendUpdateItemData:self.itemData[1] atIndex:0];
+    [journal appendMoveFromIndex:0 toIndex:2];
+    [journal appendRemoveAtIndex:1];
+    XCTAssertTrue([journal synchronize]);
+
+    NSMutableArray *expected = [self.itemData mutableCopy];
+    expected[0] = self.itemData[1];
+    NSData *moved = expected[0];
+    [expected removeObjectAtIndex:0];
+    [expected insertObject:moved atIndex:2];
+    [expected removeObjectAtIndex:1];
+
+    NSMutableArray *loaded = [[[BNRItemJournal alloc] initWithDirectory:self.directory] loadItemData];
+    XCTAssertEqualObjects(loaded, expected);
+}
+
+- (void)testUnloadedJournalDoesNotNeedCompaction {
+    // 还没打开日志时 journalLength 是 0, 不能减出一个很大的数
+    BNRItemJournal *journal = [[BNRItemJournal alloc] initWithDirectory:self.directory];
+    XCTAssertFalse(journal.needsCompaction);
+
+    [journal loadItemData];
+    XCTAssertFalse(journal.needsCompaction);
+}
+
+- (void)testStoreKeepsItsFilesInItsDirectory {
+    BNRItemStore *store = [[BNRItemStore alloc] initWithDirectory:self.directory];
+    NSString *itemKey = [store createItem].itemKey;
+    XCTAssertTrue([store saveChanges]);
+
+    XCTAssertTrue([[NSFileManager defaultManager] fileExistsAtPath:[self.directory stringByAppendingPathComponent:@"items.journal"]]);
+    BNRItemStore *reloaded = [[BNRItemStore alloc] initWithDirectory:self.directory];
+    XCTAssertEqual(reloaded.itemCount, 1);
+    XCTAssertEqualObjects([reloaded itemAtIndex:0].itemKey, itemKey);
+}
+
+- (void)testStoreMigratesLegacyArchiveInItsDirectory {
+    XCTAssertTrue([NSKeyedArchiver archiveRootObject:[self.items subarrayWithRange:NSMakeRange(0, 3)] toFile:[self legacyArchivePath]]);
+
+    BNRItemStore *store = [[BNRItemStore alloc] initWithDirectory:self.directory];
+
+    XCTAssertEqual(store.itemCount, 3);
+    XCTAssertEqualObjects([store itemAtIndex:2].itemKey, self.items[2].itemKey);
+    XCTAssertFalse([[NSFileManager defaultManager] fileExistsAtPath:[self legacyArchivePath]]);
+}
+
+- (void)testUndecodableItemDataBecomesPlaceholder {
+    BNRItemStoreSnapshot *snapshot = [[BNRItemStoreSnapshot alloc] init];
+    snapshot.items = [@[[@"not an archive" dataUsingEncoding:NSUTF8StringEncoding],
+                        [NSKeyedArchiver archivedDataWithRootObject:@"not an item"],
+                        self.itemData[0]] mutableCopy];
+
+    // 解不出来的条目用占位条目顶替, 下标和 count 不变
+    XCTAssertNotNil([snapshot itemAtIndex:0]);
+    XCTAssertNotNil([snapshot itemAtIndex:1]);
+    XCTAssertEqualObjects([snapshot itemAtIndex:2].itemKey, self.items[0].itemKey);
+    XCTAssertEqual(snapshot.count, 3);
+
+    // 占位条目放回原位, 再次访问拿到同一个对象
+    XCTAssertEqual([snapshot itemAtIndex:0], [snapshot itemAtIndex:0]);
+    XCTAssertTrue([snapshot itemAtIndex:0] != [snapshot itemAtIndex:1]);
+}
+
+#pragma mark - Helpers
+
+/// 冷启动到首屏: 读快照和日志, 只解码能看到的几行
+- (void)measureColdLoadFromJournalWithItemCount:(NSUInteger)count {
+    [self compactedJournalWithItemData:[self itemDataWithCount:count]];
+
+    [self measureBlock:^{
+        BNRItemStore *store = [[BNRItemStore alloc] initWithDirectory:self.directory];
+        XCTAssertEqual(store.itemCount, count);
+        for (NSUInteger row = 0; row < kVisibleRowCount; row++) {
+            [self.decodedItems addObject:[store itemAtIndex:row]];
+        }
+    }];
+}
+
+/// 旧版本启动时解码整个数组
+- (void)measureColdLoadFromLegacyArchiveWithItemCount:(NSUInteger)count {
+    XCTAssertTrue([NSKeyedArchiver archiveRootObject:[self itemsWithCount:count] toFile:[self legacyArchivePath]]);
+
+    [self measureBlock:^{
+        NSArray *items = [NSKeyedUnarchiver unarchiveObjectWithFile:[self legacyArchivePath]];
+        XCTAssertEqual(items.count, count);
+        [self.decodedItems addObject:items];
+    }];
+}
+
+/// 改一个条目再保存: 只追加一条记录并落盘
+- (void)measureSaveWithJournalWithItemCount:(NSUInteger)count {
+    [self compactedJournalWithItemData:[self itemDataWithCount:count]];
+    BNRItemStore *store = [[BNRItemStore alloc] initWithDirectory:self.directory];
+
+    [self measureBlock:^{
+        BNRTtem *item = [store itemAtIndex:count / 2];
+        item.valueInDollars += 1;
+        [store itemDidChange:item];
+        XCTAssertTrue([store saveChanges]);
+    }];
+}
+
+/// 旧版本每次保存都归档整个数组
+- (void)measureSaveWithLegacyArchiveWithItemCount:(NSUInteger)count {
+    NSArray<BNRTtem *> *items = [self itemsWithCount:count];
+
+    [self measureBlock:^{
+        XCTAssertTrue([NSKeyedArchiver archiveRootObject:items toFile:[self legacyArchivePath]]);
+    }];
+}
+
+#pragma mark - 冷启动加载
+
+- (void)testPerformanceColdLoadFromJournal1k {
+    [self measureColdLoadFromJournalWithItemCount:1000];
+}
+
+- (void)testPerformanceColdLoadFromLegacyArchive1k {
+    [self measureColdLoadFromLegacyArchiveWithItemCount:1000];
+}
+
+- (void)testPerformanceColdLoadFromJournal50k {
+    [self measureColdLoadFromJournalWithItemCount:50000];
+}
+
+- (void)testPerformanceColdLoadFromLegacyArchive50k {
+    [self measureColdLoadFromLegacyArchiveWithItemCount:50000];
+}
+
+- (void)testPerformanceColdLoadFromJournal500k {
+    // 旧格式不测 50 万: 每轮要解码 50 万个 BNRTtem, 它们释放时各打一行日志
+    [self measureColdLoadFromJournalWithItemCount:500000];
+}
+
+#pragma mark - 保存
+
+- (void)testPerformanceSaveOneChangeWithJournal1k {
+    [self measureSaveWithJournalWithItemCount:1000];
+}
+
+- (void)testPerformanceSaveOneChangeWithLegacyArchive1k {
+    [self measureSaveWithLegacyArchiveWithItemCount:1000];
+}
+
+- (void)testPerformanceSaveOneChangeWithJournal50k {
+    [self measureSaveWithJournalWithItemCount:50000];
+}
+
+- (void)testPerformanceSaveOneChangeWithLegacyArchive50k {
+    [self measureSaveWithLegacyArchiveWithItemCount:50000];
+}
+
+- (void)testPerformanceSaveOneChangeWithJournal500k {
+    [self measureSaveWithJournalWithItemCount:500000];
+}
+
+#pragma mark - 合并
+
+- (void)testPerformanceCompaction50k {
+    NSArray<NSData *> *itemData = [self itemDataWithCount:50000];
+    BNRItemJournal *journal = [self compactedJournalWithItemData:itemData];
+
+    [self measureBlock:^{
+        [journal compactWithItemData:itemData];
+    }];
+}
+
+@end
@@ -0,0 +1,222 @@
+//
+//  BNRItemStoreSnapshotTests.m
+//  HypnoNerdTests
+//
+//  Created by HuXin on 2026/10/18.
+//
+
+#import <XCTest/XCTest.h>
+#import "BNRItemStore.h"
+#import "BNRTtem.h"
+
+static NSUInteger const kItemCount = 5000;
+/// 一屏大约能显示的行数
+static NSUInteger const kVisibleRowCount = 20;
+/// 滑动测试的列表长度, 更多的条目循环复用 kItemCount 份归档数据
+static NSUInteger const kScrollItemCount = 100000;
+/// 一次滑动经过的行数
+static NSUInteger const kScrolledRowCount = 1000;
+
+@interface BNRItemStore (Testing)
+
+@property (nonatomic) NSMutableArray *privateItems;
+
+- (instancetype)initWithDirectory:(NSString *)directory;
+
+@end
+
+@interface BNRItemStoreSnapshotTests : XCTestCase
+
+@property (nonatomic, copy) NSString *directory;
+@property (nonatomic, strong) NSArray<NSData *> *itemData;
+@property (nonatomic, strong) BNRItemStore *store;
+
+@end
+
+@implementation BNRItemStoreSnapshotTests
+
+- (void)setUp {
+    self.directory = [NSTemporaryDirectory() stringByAppendingPathComponent:[NSUUID UUID].UUIDString];
+    [[NSFileManager defaultManager] createDirectoryAtPath:self.directory withIntermediateDirectories:YES attributes:nil error:NULL];
+
+    NSMutableArray *itemData = [NSMutableArray arrayWithCapacity:kItemCount];
+    for (NSUInteger i = 0; i < kItemCount; i++) {
+        [itemData addObject:[NSKeyedArchiver archivedDataWithRootObject:[BNRTtem randomItem]]];
+    }
+    self.itemData = itemData;
+
+    // 不动 sharedStore, 也不碰 Documents 里的文件, 快照和日志都在临时目录
+    self.store = [[BNRItemStore alloc] initWithDirectory:self.directory];
+    [self resetStore];
+}
+
+- (void)tearDown {
+    [[NSFileManager defaultManager] removeItemAtPath:self.directory error:NULL];
+    self.store = nil;
+    self.itemData = nil;
+}
+
+/// 回到刚启动的状态: 条目都是还没解码的归档数据
+- (void)resetStore {
+    self.store.privateItems = [self.itemData mutableCopy];
+}
+
+#pragma mark - 写时复制
+
+- (void)testSnapshotReusedUntilNextChange {
+    BNRItemStoreSnapshot *snapshot = [self.store snapshot];
+    XCTAssertEqual([self.store snapshot], snapshot);
+
+    [self.store itemDidChange:[self.store itemAtIndex:0]];
+    BNRItemStoreSnapshot *updated = [self.store snapshot];
+    XCTAssertNotEqual(updated, snapshot);
+    XCTAssertEqual(updated.version, snapshot.version + 1);
+}
+
+- (void)testOlderSnapshotSurvivesStructuralChangesAfterUpdate {
+    BNRItemStoreSnapshot *snapshot = [self.store snapshot];
+    BNRTtem *firstItem = [snapshot itemAtIndex:0];
+
+    // 内容修改让快照过期, 但数组仍和快照共用, 之后的结构修改必须先复制
+    [self.store itemDidChange:[self.store itemAtIndex:1]];
+    [self.store createItem];
+    [self.store moveItemAtIndex:0 ToIndex:2];
+    [self.store removeItem:[self.store itemAtIndex:kItemCount]];
+
+    XCTAssertEqual(self.store.itemCount, kItemCount);
+    XCTAssertNotEqual([self.store itemAtIndex:0], firstItem);
+    XCTAssertEqual(snapshot.count, kItemCount);
+    XCTAssertEqual([snapshot itemAtIndex:0], firstItem);
+}
+
+- (void)testSnapshotsSharingOneArraySurviveChanges {
+    BNRItemStoreSnapshot *first = [self.store snapshot];
+    [self.store itemDidChange:[self.store itemAtIndex:1]];
+    BNRItemStoreSnapshot *second = [self.store snapshot];
+    BNRTtem *firstItem = [second itemAtIndex:0];
+
+    [self.store removeItem:firstItem];
+
+    XCTAssertEqual(self.store.itemCount, kItemCount - 1);
+    for (BNRItemStoreSnapshot *snapshot in @[first, second]) {
+        XCTAssertEqual(snapshot.count, kItemCount);
+        XCTAssertEqual([snapshot itemAtIndex:0], firstItem);
+    }
+}
+
+- (void)testMutationWithoutSnapshotDoesNotCopy {
+    NSMutableArray *items = self.store.privateItems;
+    [self.store createItem];
+    XCTAssertEqual(self.store.privateItems, items);
+
+    [self.store snapshot];
+    [self.store createItem];
+    XCTAssertNotEqual(self.store.privateItems, items);
+
+    // 复制之后不再共用, 下一次修改原地进行
+    items = self.store.privateItems;
+    [self.store createItem];
+    XCTAssertEqual(self.store.privateItems, items);
+}
+
+#pragma mark - 写时复制之后的条目
+
+- (void)testItemDecodedBySnapshotIsFoundByStoreAfterCopy {
+    BNRItemStoreSnapshot *snapshot = [self.store snapshot];
+    [self.store createItem];
+
+    // 数组已经复制, 快照先解码, store 这一格还是归档数据
+    BNRTtem *item = [snapshot itemAtIndex:1];
+    NSUInteger version = self.store.version;
+    [self.store itemDidChange:item];
+    XCTAssertEqual(self.store.version, version + 1);
+    XCTAssertEqualObjects([self.store changesSinceVersion:version].updatedIndexes, [NSIndexSet indexSetWithIndex:1]);
+    XCTAssertEqual([self.store itemAtIndex:1], item);
+
+    [self.store removeItem:item];
+    XCTAssertEqual(self.store.itemCount, kItemCount);
+    XCTAssertNotEqual([self.store itemAtIndex:1], item);
+    XCTAssertEqual([snapshot itemAtIndex:1], item);
+}
+
+- (void)testStoreAndSnapshotDecodeTheSameItemAfterCopy {
+    BNRItemStoreSnapshot *snapshot = [self.store snapshot];
+    [self.store moveItemAtIndex:0 ToIndex:1];
+
+    // store 先解码, 快照后解码, 拿到的是同一个对象
+    BNRTtem *item = [self.store itemAtIndex:2];
+    XCTAssertEqual([snapshot itemAtIndex:2], item);
+}
+
+- (void)testUnknownItemIsIgnored {
+    NSUInteger version = self.store.version;
+    BNRTtem *item = [BNRTtem randomItem];
+
+    [self.store itemDidChange:item];
+    [self.store removeItem:item];
+
+    XCTAssertEqual(self.store.version, version);
+    XCTAssertEqual(self.store.itemCount, kItemCount);
+}
+
+#pragma mark - 按下标访问
+
+- (void)testPerformanceVisibleRowsWithItemAtIndex {
+    // 列表首屏只解码能看到的几行
+    [self measureMetrics:[[self class] defaultPerformanceMetrics] automaticallyStartMeasuring:NO forBlock:^{
+        [self resetStore];
+
+        [self startMeasuring];
+        NSUInteger count = self.store.itemCount;
+        for (NSUInteger row = 0; row < MIN(count, kVisibleRowCount); row++) {
+            [self.store itemAtIndex:row];
+        }
+        [self stopMeasuring];
+    }];
+}
+
+- (void)testPerformanceVisibleRowsWithAllItems {
+    // 原来的数据源每次取 allItems, 解码全部条目并复制数组
+    [self measureMetrics:[[self class] defaultPerformanceMetrics] automaticallyStartMeasuring:NO forBlock:^{
+        [self resetStore];
+
+        [self startMeasuring];
+        NSArray *items = [self.store allItems];
+        for (NSUInteger row = 0; row < MIN(items.count, kVisibleRowCount); row++) {
+            (void)items[row];
+        }
+        [self stopMeasuring];
+    }];
+}
+
+- (void)testPerformanceScroll100k {
+    // 10 万个条目的列表从中间往下滑, 每露出一行取一次 count 和这一行
+    NSMutableArray *itemData = [NSMutableArray arrayWithCapacity:kScrollItemCount];
+    for (NSUInteger i = 0; i < kScrollItemCount; i++) {
+        // 每个条目各有一份归档数据, 和从日志读出来的一样
+        [itemData addObject:[NSData dataWithData:self.itemData[i % kItemCount]]];
+    }
+    NSUInteger firstRow = kScrollItemCount / 2;
+
+    [self measureMetrics:[[self class] defaultPerformanceMetrics] automaticallyStartMeasuring:NO forBlock:^{
+        self.store.privateItems = [itemData mutableCopy];
+
+        [self startMeasuring];
+        for (NSUInteger row = firstRow; row < firstRow + kScrolledRowCount; row++) {
+            XCTAssertEqual(self.store.itemCount, kScrollItemCount);
+            [self.store itemAtIndex:row + kVisibleRowCount];
+        }
+        [self stopMeasuring];
+    }];
+}
+
+- (void)testPerformanceSnapshot {
+    [self measureBlock:^{
+        for (NSUInteger i = 0; i < 1000; i++) {
+            [self.store itemDidChange:[self.store itemAtIndex:0]];
+            [self.store snapshot];
+        }
+    }];
+}
+
+@end
@@ -0,0 +1,158 @@
+//
+//  BNRLineIndexTests.m
+//  HypnoNerdTests
+//
+//  Created by HuXin on 2026/10/18.
+//
+
+#import <XCTest/XCTest.h>
+#import "BNRLine.h"
+#import "BNRLineIndex.h"
+
+/// 和 BNRDrawView 一样的点选半径
+static CGFloat const kHitDistance = 20;
+/// 画布大约是一块 iPad 屏幕
+static CGFloat const kCanvasSide = 1024;
+static CGFloat const kMaxLineLength = 80;
+/// 每次测量点选的次数
+static NSUInteger const kQueryCount = 100;
+
+@interface BNRLineIndexTests : XCTestCase
+
+@property (nonatomic, strong) NSArray<BNRLine *> *lines;
+@property (nonatomic, strong) BNRLineIndex *index;
+@property (nonatomic) CGPoint *queries;
+
+@end
+
+@implementation BNRLineIndexTests
+
+- (void)setUp {
+    // 固定种子, 每次运行画出同样的线和点
+    srand48(48);
+    self.queries = malloc(sizeof(CGPoint) * kQueryCount);
+    for (NSUInteger i = 0; i < kQueryCount; i++) {
+        self.queries[i] = CGPointMake(drand48() * kCanvasSide, drand48() * kCanvasSide);
+    }
+}
+
+- (void)tearDown {
+    free(self.queries);
+    self.queries = NULL;
+    self.lines = nil;
+    self.index = nil;
+}
+
+/// 随机短线, 像手指画出来的笔画
+- (void)drawLineCount:(NSUInteger)count {
+    NSMutableArray *lines = [NSMutableArray arrayWithCapacity:count];
+    BNRLineIndex *index = [[BNRLineIndex alloc] init];
+    for (NSUInteger i = 0; i < count; i++) {
+        BNRLine *line = [[BNRLine alloc] init];
+        line.begin = CGPointMake(drand48() * kCanvasSide, drand48() * kCanvasSide);
+        line.end = CGPointMake(line.begin.x + (drand48() - 0.5) * kMaxLineLength,
+                               line.begin.y + (drand48() - 0.5) * kMaxLineLength);
+        [lines addObject:line];
+        [index addLine:line];
+    }
+    self.lines = lines;
+    self.index = index;
+}
+
+/// 原来 BNRDrawView 的做法: 逐条检查所有线
+- (BNRLine *)linearLineNearestPoint:(CGPoint)point {
+    BNRLine *nearest = nil;
+    CGFloat nearestDistance = kHitDistance;
+    for (BNRLine *line in self.lines) {
+        CGFloat distance = BNRDistanceFromPointToSegment(point, line.begin, line.end);
+        if (distance < nearestDistance) {
+            nearest = line;
+            nearestDistance = distance;
+        }
+    }
+    return nearest;
+}
+
+#pragma mark - 正确性
+
+- (void)testIndexFindsSameLineAsLinearScan {
+    [self drawLineCount:1000];
+
+    for (NSUInteger i = 0; i < kQueryCount; i++) {
+        CGPoint point = self.queries[i];
+        BNRLine *expected = [self linearLineNearestPoint:point];
+        BNRLine *found = [self.index lineNearestPoint:point withinDistance:kHitDistance];
+        // 距离一样时两边可能挑中不同的线, 比较距离
+        if (expected) {
+            XCTAssertNotNil(found);
+            XCTAssertEqualWithAccuracy(BNRDistanceFromPointToSegment(point, found.begin, found.end),
+                                       BNRDistanceFromPointToSegment(point, expected.begin, expected.end), 1e-9);
+        } else {
+            XCTAssertNil(found);
+        }
+    }
+}
+
+- (void)testMovedAndRemovedLinesAreFoundWhereTheyAre {
+    [self drawLineCount:0];
+    BNRLine *line = [[BNRLine alloc] init];
+    line.begin = CGPointMake(10, 10);
+    line.end = CGPointMake(50, 10);
+    [self.index addLine:line];
+    XCTAssertEqual([self.index lineNearestPoint:CGPointMake(30, 15) withinDistance:kHitDistance], line);
+
+    line.begin = CGPointMake(500, 500);
+    line.end = CGPointMake(540, 500);
+    [self.index updateLine:line];
+    XCTAssertNil([self.index lineNearestPoint:CGPointMake(30, 15) withinDistance:kHitDistance]);
+    XCTAssertEqual([self.index lineNearestPoint:CGPointMake(520, 505) withinDistance:kHitDistance], line);
+
+    [self.index removeLine:line];
+    XCTAssertNil([self.index lineNearestPoint:CGPointMake(520, 505) withinDistance:kHitDistance]);
+}
+
+#pragma mark - 点选
+
+- (void)measureIndexWithLineCount:(NSUInteger)count {
+    [self drawLineCount:count];
+    [self measureBlock:^{
+        for (NSUInteger i = 0; i < kQueryCount; i++) {
+            [self.index lineNearestPoint:self.queries[i] withinDistance:kHitDistance];
+        }
+    }];
+}
+
+- (void)measureLinearScanWithLineCount:(NSUInteger)count {
+    [self drawLineCount:count];
+    [self measureBlock:^{
+        for (NSUInteger i = 0; i < kQueryCount; i++) {
+            [self linearLineNearestPoint:self.queries[i]];
+        }
+    }];
+}
+
+- (void)testPerformanceHitTestIndex1k {
+    [self measureIndexWithLineCount:1000];
+}
+
+- (void)testPerformanceHitTestLinear1k {
+    [self measureLinearScanWithLineCount:1000];
+}
+
+- (void)testPerformanceHitTestIndex10k {
+    [self measureIndexWithLineCount:10000];
+}
+
+- (void)testPerformanceHitTestLinear10k {
+    [self measureLinearScanWithLineCount:10000];
+}
+
+- (void)testPerformanceHitTestIndex100k {
+    [self measureIndexWithLineCount:100000];
+}
+
+- (void)testPerformanceHitTestLinear100k {
+    [self measureLinearScanWithLineCount:100000];
+}
+
+@end
@@ -0,0 +1,318 @@
+//
+//  BNRStrokeBufferTests.m
+//  HypnoNerdTests
+//
+//  Created by HuXin on 2026/10/18.
+//
+
+#import <XCTest/XCTest.h>
+#import <mach/mach.h>
+#import "BNRStrokeBuffer.h"
+#import "BNRLine.h"
+
+static NSUInteger const kSampleCount = 1000000;
+/// 200Hz 的笔一秒一条笔画
+static NSUInteger const kSamplesPerStroke = 200;
+
+/// 当前进程的物理内存占用
+static uint64_t BNRTestPhysicalFootprint(void) {
+    task_vm_info_data_t info;
+    mach_msg_type_number_t count = TASK_VM_INFO_COUNT;
+    if (task_info(mach_task_self(), TASK_VM_INFO, (task_info_t)&info, &count) != KERN_SUCCESS) {
+        return 0;
+    }
+    return info.phys_footprint;
+}
+
+static BNRStrokeSample BNRTestSample(NSUInteger i) {
+    BNRStrokeSample sample;
+    sample.boardX = (int32_t)i;
+    sample.boardY = (int32_t)(i * 2);
+    sample.sx = i % 1024;
+    sample.sy = i % 768;
+    sample.tx = sample.sx;
+    sample.ty = sample.sy;
+    sample.pressure = 0.5;
+    sample.relativeT = i % kSamplesPerStroke;
+    return sample;
+}
+
+/// 和点阵笔 SDK 的 HWPoint 一样, 每个采样点一个对象
+@interface BNRTestPoint : NSObject
+
+@property (nonatomic) int32_t boardX;
+@property (nonatomic) int32_t boardY;
+@property (nonatomic) float sx;
+@property (nonatomic) float sy;
+@property (nonatomic) float tx;
+@property (nonatomic) float ty;
+@property (nonatomic) float pressure;
+@property (nonatomic) float relativeT;
+
+@end
+
+@implementation BNRTestPoint
+
+@end
+
+/// 和 HWStroke 一样, 采样点在 hwPoints 里
+@interface BNRTestStroke : NSObject
+
+@property (nonatomic, copy) NSArray<BNRTestPoint *> *hwPoints;
+
+@end
+
+@implementation BNRTestStroke
+
+@end
+
+@interface BNRStrokeBufferTests : XCTestCase
+
+@end
+
+@implementation BNRStrokeBufferTests
+
+- (BNRStrokeBuffer *)bufferWithSampleCount:(NSUInteger)count {
+    BNRStrokeBuffer *buffer = [[BNRStrokeBuffer alloc] init];
+    for (NSUInteger i = 0; i < count; i++) {
+        if (i % kSamplesPerStroke == 0) {
+            [buffer beginStroke];
+        }
+        [buffer appendSample:BNRTestSample(i)];
+    }
+    return buffer;
+}
+
+- (NSArray<BNRTestPoint *> *)pointsWithCount:(NSUInteger)count {
+    NSMutableArray *points = [NSMutableArray arrayWithCapacity:count];
+    for (NSUInteger i = 0; i < count; i++) {
+        BNRStrokeSample sample = BNRTestSample(i);
+        BNRTestPoint *point = [[BNRTestPoint alloc] init];
+        point.boardX = sample.boardX;
+        point.boardY = sample.boardY;
+        point.sx = sample.sx;
+        point.sy = sample.sy;
+        point.tx = sample.tx;
+        point.ty = sample.ty;
+        point.pressure = sample.pressure;
+        point.relativeT = sample.relativeT;
+        [points addObject:point];
+    }
+    return points;
+}
+
+/// 手工拼出序列化格式, 字段数组都填 0
+- (NSData *)serializedDataWithSampleCount:(uint32_t)sampleCount strokeStarts:(NSArray<NSNumber *> *)starts {
+    NSMutableData *data = [NSMutableData dataWithBytes:"BNRSTRK1" length:8];
+    uint32_t strokeCount = (uint32_t)starts.count;
+    [data appendBytes:&sampleCount length:4];
+    [data appendBytes:&strokeCount length:4];
+    for (NSNumber *start in starts) {
+        uint32_t value = start.unsignedIntValue;
+        [data appendBytes:&value length:4];
+    }
+    [data increaseLengthBy:(NSUInteger)sampleCount * 4 * BNRStrokeFieldCount];
+    return data;
+}
+
+- (void)assertSample:(BNRStrokeSample)sample equalsSample:(BNRStrokeSample)expected {
+    XCTAssertEqual(memcmp(&sample, &expected, sizeof(BNRStrokeSample)), 0);
+}
+
+#pragma mark - 适配
+
+- (void)testHWPointFieldsAreCopied {
+    // 工程里没有 SDK 的头文件, 走的是 KVC, 用同名属性的对象代替 HWPoint
+    BNRStrokeBuffer *buffer = [[BNRStrokeBuffer alloc] init];
+    NSArray<BNRTestPoint *> *points = [self pointsWithCount:3];
+    for (BNRTestPoint *point in points) {
+        [buffer appendHWPoint:(HWPoint *)point];
+    }
+
+    // 没有先 beginStroke 时自动开始第一条笔画
+    XCTAssertEqual(buffer.sampleCount, 3);
+    XCTAssertEqual(buffer.strokeCount, 1);
+    for (NSUInteger i = 0; i < points.count; i++) {
+        [self assertSample:[buffer sampleAtIndex:i] equalsSample:BNRTestSample(i)];
+    }
+}
+
+- (void)testEachHWStrokeBecomesOneStroke {
+    BNRStrokeBuffer *buffer = [[BNRStrokeBuffer alloc] init];
+    NSArray<BNRTestPoint *> *points = [self pointsWithCount:5];
+    BNRTestStroke *first = [[BNRTestStroke alloc] init];
+    first.hwPoints = [points subarrayWithRange:NSMakeRange(0, 2)];
+    BNRTestStroke *second = [[BNRTestStroke alloc] init];
+    second.hwPoints = [points subarrayWithRange:NSMakeRange(2, 3)];
+    BNRTestStroke *empty = [[BNRTestStroke alloc] init];
+    empty.hwPoints = @[];
+
+    [buffer appendHWStroke:(HWStroke *)first];
+    [buffer appendHWStroke:(HWStroke *)empty];
+    [buffer appendHWStroke:(HWStroke *)second];
+
+    XCTAssertEqual(buffer.sampleCount, 5);
+    XCTAssertEqual(buffer.strokeCount, 3);
+    XCTAssertTrue(NSEqualRanges([buffer rangeOfStrokeAtIndex:0], NSMakeRange(0, 2)));
+    XCTAssertTrue(NSEqualRanges([buffer rangeOfStrokeAtIndex:1], NSMakeRange(2, 0)));
+    XCTAssertTrue(NSEqualRanges([buffer rangeOfStrokeAtIndex:2], NSMakeRange(2, 3)));
+    for (NSUInteger i = 0; i < points.count; i++) {
+        [self assertSample:[buffer sampleAtIndex:i] equalsSample:BNRTestSample(i)];
+    }
+}
+
+- (void)testLineBecomesTwoPointStroke {
+    BNRStrokeBuffer *buffer = [[BNRStrokeBuffer alloc] init];
+    [buffer appendSample:BNRTestSample(0)];
+    BNRLine *line = [[BNRLine alloc] init];
+    line.begin = CGPointMake(10.4, 20.6);
+    line.end = CGPointMake(-30.5, 40);
+
+    [buffer appendLine:line];
+
+    XCTAssertEqual(buffer.strokeCount, 2);
+    XCTAssertTrue(NSEqualRanges([buffer rangeOfStrokeAtIndex:1], NSMakeRange(1, 2)));
+
+    BNRStrokeSample begin = [buffer sampleAtIndex:1];
+    XCTAssertEqual(begin.boardX, 10);
+    XCTAssertEqual(begin.boardY, 21);
+    XCTAssertEqual(begin.sx, 10.4f);
+    XCTAssertEqual(begin.sy, 20.6f);
+    XCTAssertEqual(begin.tx, 10.4f);
+    XCTAssertEqual(begin.ty, 20.6f);
+    XCTAssertEqual(begin.pressure, 1);
+    XCTAssertEqual(begin.relativeT, 0);
+
+    BNRStrokeSample end = [buffer sampleAtIndex:2];
+    // lround 远离 0 取整
+    XCTAssertEqual(end.boardX, -31);
+    XCTAssertEqual(end.boardY, 40);
+    XCTAssertEqual(end.sx, -30.5f);
+    XCTAssertEqual(end.sy, 40);
+    XCTAssertEqual(end.relativeT, 1);
+
+    UIBezierPath *path = [buffer bezierPathForStrokeAtIndex:1];
+    XCTAssertTrue(CGPointEqualToPoint(path.currentPoint, CGPointMake(-30.5, 40)));
+}
+
+#pragma mark - 序列化
+
+- (void)testSerializedDataRoundTrips {
+    BNRStrokeBuffer *buffer = [self bufferWithSampleCount:kSamplesPerStroke * 2 + 10];
+    [buffer beginStroke];
+
+    BNRStrokeBuffer *decoded = [[BNRStrokeBuffer alloc] initWithSerializedData:[buffer serializedData]];
+    XCTAssertNotNil(decoded);
+    XCTAssertEqual(decoded.sampleCount, buffer.sampleCount);
+    XCTAssertEqual(decoded.strokeCount, 4);
+    for (NSUInteger i = 0; i < buffer.strokeCount; i++) {
+        XCTAssertTrue(NSEqualRanges([decoded rangeOfStrokeAtIndex:i], [buffer rangeOfStrokeAtIndex:i]));
+    }
+    [self assertSample:[decoded sampleAtIndex:decoded.sampleCount - 1] equalsSample:[buffer sampleAtIndex:buffer.sampleCount - 1]];
+}
+
+- (void)testValidStrokeStartsAreAccepted {
+    XCTAssertNotNil([[BNRStrokeBuffer alloc] initWithSerializedData:[self serializedDataWithSampleCount:0 strokeStarts:@[]]]);
+    // 空笔画: 起点可以相等, 最后一条可以从 sampleCount 开始
+    XCTAssertNotNil([[BNRStrokeBuffer alloc] initWithSerializedData:[self serializedDataWithSampleCount:5 strokeStarts:@[@0, @2, @2, @5]]]);
+}
+
+- (void)testInvalidStrokeStartsAreRejected {
+    // 第一条笔画不从 0 开始
+    XCTAssertNil([[BNRStrokeBuffer alloc] initWithSerializedData:[self serializedDataWithSampleCount:5 strokeStarts:@[@1, @3]]]);
+    // 起点递减
+    XCTAssertNil([[BNRStrokeBuffer alloc] initWithSerializedData:[self serializedDataWithSampleCount:5 strokeStarts:@[@0, @3, @2]]]);
+    // 起点超过采样数
+    XCTAssertNil([[BNRStrokeBuffer alloc] initWithSerializedData:[self serializedDataWithSampleCount:5 strokeStarts:@[@0, @6]]]);
+    XCTAssertNil([[BNRStrokeBuffer alloc] initWithSerializedData:[self serializedDataWithSampleCount:5 strokeStarts:@[@0, @0xFFFFFFFF]]]);
+    // 有采样点却没有笔画
+    XCTAssertNil([[BNRStrokeBuffer alloc] initWithSerializedData:[self serializedDataWithSampleCount:5 strokeStarts:@[]]]);
+}
+
+- (void)testMalformedDataIsRejected {
+    NSMutableData *data = [[self serializedDataWithSampleCount:5 strokeStarts:@[@0]] mutableCopy];
+    XCTAssertNil([[BNRStrokeBuffer alloc] initWithSerializedData:[data subdataWithRange:NSMakeRange(0, data.length - 1)]]);
+    XCTAssertNil([[BNRStrokeBuffer alloc] initWithSerializedData:[data subdataWithRange:NSMakeRange(0, 12)]]);
+
+    [data replaceBytesInRange:NSMakeRange(0, 1) withBytes:"X"];
+    XCTAssertNil([[BNRStrokeBuffer alloc] initWithSerializedData:data]);
+}
+
+#pragma mark - 一百万个采样点的内存
+
+- (void)testMillionSamplesUseLessMemoryThanPointObjects {
+    uint64_t bufferFootprint = 0;
+    @autoreleasepool {
+        uint64_t baseline = BNRTestPhysicalFootprint();
+        BNRStrokeBuffer *buffer = [self bufferWithSampleCount:kSampleCount];
+        uint64_t footprint = BNRTestPhysicalFootprint();
+        bufferFootprint = footprint > baseline ? footprint - baseline : 0;
+        XCTAssertEqual(buffer.sampleCount, kSampleCount);
+    }
+
+    uint64_t objectsFootprint = 0;
+    @autoreleasepool {
+        uint64_t baseline = BNRTestPhysicalFootprint();
+        NSArray *points = [self pointsWithCount:kSampleCount];
+        uint64_t footprint = BNRTestPhysicalFootprint();
+        objectsFootprint = footprint > baseline ? footprint - baseline : 0;
+        XCTAssertEqual(points.count, kSampleCount);
+    }
+
+    NSLog(@"%lu samples: stroke buffer %llu KB, point objects %llu KB", (unsigned long)kSampleCount, bufferFootprint / 1024, objectsFootprint / 1024);
+    XCTAssertLessThan(bufferFootprint, objectsFootprint);
+}
+
+#pragma mark - 一百万个采样点的吞吐
+
+- (void)testPerformanceAppendMillionSamples {
+    [self measureBlock:^{
+        [self bufferWithSampleCount:kSampleCount];
+    }];
+}
+
+- (void)testPerformanceCreateMillionPointObjects {
+    [self measureBlock:^{
+        @autoreleasepool {
+            [self pointsWithCount:kSampleCount];
+        }
+    }];
+}
+
+- (void)testPerformanceScanMillionSamples {
+    BNRStrokeBuffer *buffer = [self bufferWithSampleCount:kSampleCount];
+
+    // 渲染时按字段连续读
+    [self measureBlock:^{
+        const float *xs = [buffer valuesForField:BNRStrokeFieldSX];
+        const float *ys = [buffer valuesForField:BNRStrokeFieldSY];
+        double sum = 0;
+        for (NSUInteger i = 0; i < buffer.sampleCount; i++) {
+            sum += xs[i] + ys[i];
+        }
+        XCTAssertGreaterThan(sum, 0);
+    }];
+}
+
+- (void)testPerformanceScanMillionPointObjects {
+    NSArray<BNRTestPoint *> *points = [self pointsWithCount:kSampleCount];
+
+    [self measureBlock:^{
+        double sum = 0;
+        for (BNRTestPoint *point in points) {
+            sum += point.sx + point.sy;
+        }
+        XCTAssertGreaterThan(sum, 0);
+    }];
+}
+
+- (void)testPerformanceSerializeMillionSamples {
+    BNRStrokeBuffer *buffer = [self bufferWithSampleCount:kSampleCount];
+
+    [self measureBlock:^{
+        NSData *data = [buffer serializedData];
+        XCTAssertNotNil([[BNRStrokeBuffer alloc] initWithSerializedData:data]);
+    }];
+}
+
+@end
@@ -64,6 +64,22 @@ NS_ASSUME_NONNULL_BEGIN
  */
 @property (readonly, nonatomic, assign, getter = isReachableViaWiFi) BOOL reachableViaWiFi;
 
+///----------------------------------------
+/// @name Coalescing Reachability Changes
+///----------------------------------------
+
+/**
+ The amount of time a new reachability status must remain unchanged before it is delivered to the status block, observers, and `AFNetworkingReachabilityDidChangeNotification`. A status that reverts to the currently delivered value before the interval elapses is dropped, so brief flapping between interfaces produces no callbacks at all. `0` by default, which delivers every `SCNetworkReachability` callback immediately.
+ */
+@property (nonatomic, assign) NSTimeInterval statusSettleInterval;
+
+/**
+ The amount of time a reachable status must remain unchanged before it is delivered while the currently delivered status is `AFNetworkReachabilityStatusNotReachable`. Set this higher than `statusSettleInterval` to make losing the network cheap to report but regaining it expensive, so that a connection that briefly comes back does not resume suspended work only to lose it again. `0` by default, in which case `statusSettleInterval` is used for every transition.
+
+ The first status delivered after monitoring starts is never delayed.
+ */
+@property (nonatomic, assign) NSTimeInterval recoverySettleInterval;
+
 ///---------------------
 /// @name Initialization
 ///---------------------
@@ -151,6 +167,37 @@ NS_ASSUME_NONNULL_BEGIN
  */
 - (void)setReachabilityStatusChangeBlock:(nullable void (^)(AFNetworkReachabilityStatus status))block;
 
+///------------------------------------------
+/// @name Subscribing to Reachability Changes
+///------------------------------------------
+
+/**
+ Registers a block to be executed each time a settled reachability status is delivered. Unlike `-setReachabilityStatusChangeBlock:`, any number of observers may be registered on a single manager.
+
+ @param queue The queue on which to execute `block`. If `nil`, the main queue is used.
+ @param block A block object to be executed when the delivered reachability status changes. This block has no return value and takes two arguments: the newly delivered status, and the status it replaces.
+
+ @return An opaque observer object, to be passed to `-removeReachabilityObserver:` in order to stop receiving changes.
+ */
+- (id)addReachabilityObserverWithQueue:(nullable dispatch_queue_t)queue
+                            usingBlock:(void (^)(AFNetworkReachabilityStatus status, AFNetworkReachabilityStatus previousStatus))block;
+
+/**
+ Unregisters an observer previously returned by `-addReachabilityObserverWithQueue:usingBlock:`.
+
+ @param observer The observer to remove.
+ */
+- (void)removeReachabilityObserver:(id)observer;
+
+/**
+ Enqueues a block to be executed once, on the main queue, the next time the delivered status becomes reachable. If the network is currently reachable, the block is executed on the next turn of the main queue.
+
+ All blocks enqueued while the network is unreachable are executed together, in the order they were enqueued, when reachability is restored. This allows request layers to suspend work while offline and resume it in a single batch rather than reacting individually to every status change.
+
+ @param block The block to be executed. This block has no return value and takes no arguments.
+ */
+- (void)performBlockWhenReachable:(void (^)(void))block;
+
 @end
 
 ///----------------
@@ -32,7 +32,8 @@ NSString * const AFNetworkingReachabilityDidChangeNotification = @"com.alamofire
 NSString * const AFNetworkingReachabilityNotificationStatusItem = @"AFNetworkingReachabilityNotificationStatusItem";
 
 typedef void (^AFNetworkReachabilityStatusBlock)(AFNetworkReachabilityStatus status);
-typedef AFNetworkReachabilityManager * (^AFNetworkReachabilityStatusCallback)(AFNetworkReachabilityStatus status);
+typedef void (^AFNetworkReachabilityStatusCallback)(AFNetworkReachabilityStatus status);
+typedef void (^AFNetworkReachabilityObserverBlock)(AFNetworkReachabilityStatus status, AFNetworkReachabilityStatus previousStatus);
 
 NSString * AFStringFromNetworkReachabilityStatus(AFNetworkReachabilityStatus status) {
     switch (status) {
@@ -82,16 +83,22 @@ static AFNetworkReachabilityStatus AFNetworkReachabilityStatusForFlags(SCNetwork
 static void AFPostReachabilityStatusChange(SCNetworkReachabilityFlags flags, AFNetworkReachabilityStatusCallback block) {
     AFNetworkReachabilityStatus status = AFNetworkReachabilityStatusForFlags(flags);
     dispatch_async(dispatch_get_main_queue(), ^{
-        AFNetworkReachabilityManager *manager = nil;
         if (block) {
-            manager = block(status);
+            block(status);
         }
-        NSNotificationCenter *notificationCenter = [NSNotificationCenter defaultCenter];
-        NSDictionary *userInfo = @{ AFNetworkingReachabilityNotificationStatusItem: @(status) };
-        [notificationCenter postNotificationName:AFNetworkingReachabilityDidChangeNotification object:manager userInfo:userInfo];
     });
 }
 
+static void AFPostReachabilityStatusNotification(AFNetworkReachabilityManager *manager, AFNetworkReachabilityStatus status) {
+    NSNotificationCenter *notificationCenter = [NSNotificationCenter defaultCenter];
+    NSDictionary *userInfo = @{ AFNetworkingReachabilityNotificationStatusItem: @(status) };
+    [notificationCenter postNotificationName:AFNetworkingReachabilityDidChangeNotification object:manager userInfo:userInfo];
+}
+
+static inline BOOL AFNetworkReachabilityStatusIsReachable(AFNetworkReachabilityStatus status) {
+    return status == AFNetworkReachabilityStatusReachableViaWWAN || status == AFNetworkReachabilityStatusReachableViaWiFi;
+}
+
 static void AFNetworkReachabilityCallback(SCNetworkReachabilityRef __unused target, SCNetworkReachabilityFlags flags, void *info) {
     AFPostReachabilityStatusChange(flags, (__bridge AFNetworkReachabilityStatusCallback)info);
 }
@@ -107,10 +114,41 @@ static void AFNetworkReachabilityReleaseCallback(const void *info) {
     }
 }
 
+#pragma mark -
+
+@interface _AFNetworkReachabilityObserver : NSObject
+@property (readonly, nonatomic, strong) dispatch_queue_t queue;
+@property (readonly, nonatomic, copy) AFNetworkReachabilityObserverBlock block;
+@end
+
+@implementation _AFNetworkReachabilityObserver
+
+- (instancetype)initWithQueue:(dispatch_queue_t)queue block:(AFNetworkReachabilityObserverBlock)block {
+    self = [super init];
+    if (!self) {
+        return nil;
+    }
+
+    _queue = queue ?: dispatch_get_main_queue();
+    _block = [block copy];
+
+    return self;
+}
+
+@end
+
+#pragma mark -
+
 @interface AFNetworkReachabilityManager ()
 @property (readonly, nonatomic, assign) SCNetworkReachabilityRef networkReachability;
 @property (readwrite, nonatomic, assign) AFNetworkReachabilityStatus networkReachabilityStatus;
 @property (readwrite, nonatomic, copy) AFNetworkReachabilityStatusBlock networkReachabilityStatusBlock;
+@property (readwrite, nonatomic, strong) NSLock *lock;
+@property (readwrite, nonatomic, strong) NSMutableArray <_AFNetworkReachabilityObserver *> *observers;
+@property (readwrite, nonatomic, strong) NSMutableArray *reachableBlocks;
+@property (readwrite, nonatomic, assign) AFNetworkReachabilityStatus pendingNetworkReachabilityStatus;
+@property (readwrite, nonatomic, assign) NSUInteger pendingStatusGeneration;
+@property (readwrite, nonatomic, assign) BOOL hasDeliveredStatus;
 @end
 
 @implementation AFNetworkReachabilityManager
@@ -168,6 +206,12 @@ static void AFNetworkReachabilityReleaseCallback(const void *info) {
 
     _networkReachability = CFRetain(reachability);
     self.networkReachabilityStatus = AFNetworkReachabilityStatusUnknown;
+    self.pendingNetworkReachabilityStatus = AFNetworkReachabilityStatusUnknown;
+
+    self.lock = [[NSLock alloc] init];
+    self.lock.name = @"com.alamofire.networking.reachability.lock";
+    self.observers = [[NSMutableArray alloc] init];
+    self.reachableBlocks = [[NSMutableArray alloc] init];
 
     return self;
 }
@@ -214,15 +258,16 @@ static void AFNetworkReachabilityReleaseCallback(const void *info) {
     __weak __typeof(self)weakSelf = self;
     AFNetworkReachabilityStatusCallback callback = ^(AFNetworkReachabilityStatus status) {
         __strong __typeof(weakSelf)strongSelf = weakSelf;
-
-        strongSelf.networkReachabilityStatus = status;
-        if (strongSelf.networkReachabilityStatusBlock) {
-            strongSelf.networkReachabilityStatusBlock(status);
+        if (!strongSelf) {
+            AFPostReachabilityStatusNotification(nil, status);
+            return;
         }
-        
-        return strongSelf;
+
+        [strongSelf receiveNetworkReachabilityStatus:status];
     };
 
+    self.hasDeliveredStatus = NO;
+
     SCNetworkReachabilityContext context = {0, (__bridge void *)callback, AFNetworkReachabilityRetainCallback, AFNetworkReachabilityReleaseCallback, NULL};
     SCNetworkReachabilitySetCallback(self.networkReachability, AFNetworkReachabilityCallback, &context);
     SCNetworkReachabilityScheduleWithRunLoop(self.networkReachability, CFRunLoopGetMain(), kCFRunLoopCommonModes);
@@ -241,6 +286,109 @@ static void AFNetworkReachabilityReleaseCallback(const void *info) {
     }
 
     SCNetworkReachabilityUnscheduleFromRunLoop(self.networkReachability, CFRunLoopGetMain(), kCFRunLoopCommonModes);
+
+    // May be called from `-dealloc` on any thread, so only invalidate the pending settle timer here rather than capturing `self`.
+    [self.lock lock];
+    self.pendingStatusGeneration++;
+    [self.lock unlock];
+}
+
+#pragma mark -
+
+- (NSTimeInterval)settleIntervalForTransitionToStatus:(AFNetworkReachabilityStatus)status {
+    if (!self.hasDeliveredStatus) {
+        return 0;
+    }
+
+    if (self.networkReachabilityStatus == AFNetworkReachabilityStatusNotReachable && AFNetworkReachabilityStatusIsReachable(status) && self.recoverySettleInterval > 0) {
+        return self.recoverySettleInterval;
+    }
+
+    return self.statusSettleInterval;
+}
+
+- (NSUInteger)cancelPendingNetworkReachabilityStatus {
+    self.pendingNetworkReachabilityStatus = AFNetworkReachabilityStatusUnknown;
+
+    [self.lock lock];
+    NSUInteger generation = ++self.pendingStatusGeneration;
+    [self.lock unlock];
+
+    return generation;
+}
+
+- (BOOL)isPendingStatusGenerationCurrent:(NSUInteger)generation {
+    [self.lock lock];
+    BOOL current = self.pendingStatusGeneration == generation;
+    [self.lock unlock];
+
+    return current;
+}
+
+// Always invoked on the main queue.
+- (void)receiveNetworkReachabilityStatus:(AFNetworkReachabilityStatus)status {
+    NSTimeInterval settleInterval = [self settleIntervalForTransitionToStatus:status];
+    if (settleInterval <= 0) {
+        [self cancelPendingNetworkReachabilityStatus];
+        [self deliverNetworkReachabilityStatus:status];
+        return;
+    }
+
+    if (status == self.networkReachabilityStatus) {
+        // The network flapped back to the delivered status before settling; nothing changed as far as observers are concerned.
+        [self cancelPendingNetworkReachabilityStatus];
+        return;
+    }
+
+    if (status == self.pendingNetworkReachabilityStatus) {
+        return;
+    }
+
+    NSUInteger generation = [self cancelPendingNetworkReachabilityStatus];
+    self.pendingNetworkReachabilityStatus = status;
+
+    __weak __typeof(self)weakSelf = self;
+    dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(settleInterval * NSEC_PER_SEC)), dispatch_get_main_queue(), ^{
+        __strong __typeof(weakSelf)strongSelf = weakSelf;
+        if (!strongSelf || ![strongSelf isPendingStatusGenerationCurrent:generation]) {
+            return;
+        }
+
+        [strongSelf cancelPendingNetworkReachabilityStatus];
+        [strongSelf deliverNetworkReachabilityStatus:status];
+    });
+}
+
+- (void)deliverNetworkReachabilityStatus:(AFNetworkReachabilityStatus)status {
+    AFNetworkReachabilityStatus previousStatus = self.networkReachabilityStatus;
+    self.hasDeliveredStatus = YES;
+    self.networkReachabilityStatus = status;
+
+    if (self.networkReachabilityStatusBlock) {
+        self.networkReachabilityStatusBlock(status);
+    }
+
+    [self.lock lock];
+    NSArray <_AFNetworkReachabilityObserver *> *observers = [self.observers copy];
+    NSArray *reachableBlocks = nil;
+    if (AFNetworkReachabilityStatusIsReachable(status) && self.reachableBlocks.count > 0) {
+        reachableBlocks = [self.reachableBlocks copy];
+        [self.reachableBlocks removeAllObjects];
+    }
+    [self.lock unlock];
+
+    for (_AFNetworkReachabilityObserver *observer in observers) {
+        AFNetworkReachabilityObserverBlock block = observer.block;
+        dispatch_async(observer.queue, ^{
+            block(status, previousStatus);
+        });
+    }
+
+    for (void (^block)(void) in reachableBlocks) {
+        block();
+    }
+
+    AFPostReachabilityStatusNotification(self, status);
 }
 
 #pragma mark -
@@ -255,6 +403,44 @@ static void AFNetworkReachabilityReleaseCallback(const void *info) {
     self.networkReachabilityStatusBlock = block;
 }
 
+- (id)addReachabilityObserverWithQueue:(dispatch_queue_t)queue
+                            usingBlock:(void (^)(AFNetworkReachabilityStatus status, AFNetworkReachabilityStatus previousStatus))block
+{
+    NSParameterAssert(block);
+
+    _AFNetworkReachabilityObserver *observer = [[_AFNetworkReachabilityObserver alloc] initWithQueue:queue block:block];
+    [self.lock lock];
+    [self.observers addObject:observer];
+    [self.lock unlock];
+
+    return observer;
+}
+
+- (void)removeReachabilityObserver:(id)observer {
+    if (!observer) {
+        return;
+    }
+
+    [self.lock lock];
+    [self.observers removeObjectIdenticalTo:observer];
+    [self.lock unlock];
+}
+
+- (void)performBlockWhenReachable:(void (^)(void))block {
+    NSParameterAssert(block);
+
+    [self.lock lock];
+    BOOL reachable = [self isReachable];
+    if (!reachable) {
+        [self.reachableBlocks addObject:[block copy]];
+    }
+    [self.lock unlock];
+
+    if (reachable) {
+        dispatch_async(dispatch_get_main_queue(), block);
+    }
+}
+
 #pragma mark - NSKeyValueObserving
 
 + (NSSet *)keyPathsForValuesAffectingValueForKey:(NSString *)key {
@@ -62,6 +62,35 @@ NS_ASSUME_NONNULL_BEGIN
  */
 @property (nonatomic, assign) BOOL validatesDomainName;
 
+///-----------------------------------------
+/// @name Caching Trust Evaluations
+///-----------------------------------------
+
+/**
+ How long a successful trust evaluation is remembered for the same domain and leaf certificate, in seconds. While a cached result is valid, `evaluateServerTrust:forDomain:` accepts the server trust without evaluating the certificate chain again. Failed evaluations are never cached, and changing any of the properties above clears the cache. Defaults to `0`, which disables caching.
+ */
+@property (nonatomic, assign) NSTimeInterval trustEvaluationCacheTimeout;
+
+/**
+ The number of server trusts fully evaluated by `evaluateServerTrust:forDomain:`.
+ */
+@property (readonly, nonatomic, assign) NSUInteger trustEvaluationCount;
+
+/**
+ The number of server trusts accepted from the trust evaluation cache.
+ */
+@property (readonly, nonatomic, assign) NSUInteger trustEvaluationCacheHitCount;
+
+/**
+ The total time spent in full trust evaluations, in seconds.
+ */
+@property (readonly, nonatomic, assign) NSTimeInterval trustEvaluationDuration;
+
+/**
+ Removes all cached trust evaluations.
+ */
+- (void)removeAllCachedTrustEvaluations;
+
 ///-----------------------------------------
 /// @name Getting Certificates from the Bundle
 ///-----------------------------------------
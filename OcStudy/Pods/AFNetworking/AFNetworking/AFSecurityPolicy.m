@@ -22,6 +22,9 @@
 #import "AFSecurityPolicy.h"
 
 #import <AssertMacros.h>
+#import <CommonCrypto/CommonDigest.h>
+
+static NSUInteger const AFTrustEvaluationCacheCapacity = 128;
 
 #if !TARGET_OS_IOS && !TARGET_OS_WATCH && !TARGET_OS_TV
 static NSData * AFSecKeyGetData(SecKeyRef key) {
@@ -48,6 +51,40 @@ static BOOL AFSecKeyIsEqualToKey(SecKeyRef key1, SecKeyRef key2) {
 #endif
 }
 
+static NSData * AFSHA256HashForData(NSData *data) {
+    unsigned char digest[CC_SHA256_DIGEST_LENGTH];
+    CC_SHA256(data.bytes, (CC_LONG)data.length, digest);
+
+    return [NSData dataWithBytes:digest length:CC_SHA256_DIGEST_LENGTH];
+}
+
+static NSData * AFHashForPublicKey(id publicKey) {
+    NSData *keyData = nil;
+#if TARGET_OS_IOS || TARGET_OS_WATCH || TARGET_OS_TV
+    if (@available(iOS 10, watchOS 3, tvOS 10, *)) {
+        keyData = (__bridge_transfer NSData *)SecKeyCopyExternalRepresentation((__bridge SecKeyRef)publicKey, NULL);
+    }
+#else
+    keyData = AFSecKeyGetData((__bridge SecKeyRef)publicKey);
+#endif
+
+    return keyData ? AFSHA256HashForData(keyData) : nil;
+}
+
+static NSString * AFTrustEvaluationCacheKey(SecTrustRef serverTrust, NSString *domain) {
+    if (SecTrustGetCertificateCount(serverTrust) == 0) {
+        return nil;
+    }
+
+    SecCertificateRef leafCertificate = SecTrustGetCertificateAtIndex(serverTrust, 0);
+    NSData *leafCertificateData = (__bridge_transfer NSData *)SecCertificateCopyData(leafCertificate);
+    if (!leafCertificateData) {
+        return nil;
+    }
+
+    return [NSString stringWithFormat:@"%@ %@", [domain lowercaseString] ?: @"", [AFSHA256HashForData(leafCertificateData) base64EncodedStringWithOptions:0]];
+}
+
 static id AFPublicKeyForCertificate(NSData *certificate) {
     id allowedPublicKey = nil;
     SecCertificateRef allowedCertificate;
@@ -149,6 +186,14 @@ static NSArray * AFPublicKeyTrustChainForServerTrust(SecTrustRef serverTrust) {
 @interface AFSecurityPolicy()
 @property (readwrite, nonatomic, assign) AFSSLPinningMode SSLPinningMode;
 @property (readwrite, nonatomic, strong) NSSet *pinnedPublicKeys;
+@property (readwrite, nonatomic, strong) NSSet <NSData *> *pinnedPublicKeyHashes;
+@property (readwrite, nonatomic, strong) NSSet <NSData *> *pinnedCertificateHashes;
+@property (readwrite, nonatomic, copy) NSArray *pinnedAnchorCertificates;
+@property (readwrite, nonatomic, strong) NSMutableDictionary <NSString *, NSDate *> *trustEvaluationCache;
+@property (readwrite, nonatomic, strong) NSLock *lock;
+@property (readwrite, nonatomic, assign) NSUInteger trustEvaluationCount;
+@property (readwrite, nonatomic, assign) NSUInteger trustEvaluationCacheHitCount;
+@property (readwrite, nonatomic, assign) NSTimeInterval trustEvaluationDuration;
 @end
 
 @implementation AFSecurityPolicy
@@ -192,6 +237,10 @@ static NSArray * AFPublicKeyTrustChainForServerTrust(SecTrustRef serverTrust) {
         return nil;
     }
 
+    self.trustEvaluationCache = [NSMutableDictionary dictionary];
+    self.lock = [[NSLock alloc] init];
+    self.lock.name = @"com.alamofire.networking.securitypolicy.lock";
+
     self.validatesDomainName = YES;
 
     return self;
@@ -200,25 +249,127 @@ static NSArray * AFPublicKeyTrustChainForServerTrust(SecTrustRef serverTrust) {
 - (void)setPinnedCertificates:(NSSet *)pinnedCertificates {
     _pinnedCertificates = pinnedCertificates;
 
+    // Everything derived from the pins is computed once here, so evaluations only perform set lookups
     if (self.pinnedCertificates) {
         NSMutableSet *mutablePinnedPublicKeys = [NSMutableSet setWithCapacity:[self.pinnedCertificates count]];
+        NSMutableSet *mutablePinnedPublicKeyHashes = [NSMutableSet setWithCapacity:[self.pinnedCertificates count]];
+        NSMutableSet *mutablePinnedCertificateHashes = [NSMutableSet setWithCapacity:[self.pinnedCertificates count]];
+        NSMutableArray *mutablePinnedAnchorCertificates = [NSMutableArray arrayWithCapacity:[self.pinnedCertificates count]];
+        BOOL hashedAllPublicKeys = YES;
         for (NSData *certificate in self.pinnedCertificates) {
+            [mutablePinnedCertificateHashes addObject:AFSHA256HashForData(certificate)];
+
+            id anchorCertificate = (__bridge_transfer id)SecCertificateCreateWithData(NULL, (__bridge CFDataRef)certificate);
+            if (anchorCertificate) {
+                [mutablePinnedAnchorCertificates addObject:anchorCertificate];
+            }
+
             id publicKey = AFPublicKeyForCertificate(certificate);
             if (!publicKey) {
                 continue;
             }
             [mutablePinnedPublicKeys addObject:publicKey];
+
+            NSData *publicKeyHash = AFHashForPublicKey(publicKey);
+            if (publicKeyHash) {
+                [mutablePinnedPublicKeyHashes addObject:publicKeyHash];
+            } else {
+                hashedAllPublicKeys = NO;
+            }
         }
         self.pinnedPublicKeys = [NSSet setWithSet:mutablePinnedPublicKeys];
+        self.pinnedPublicKeyHashes = hashedAllPublicKeys ? [NSSet setWithSet:mutablePinnedPublicKeyHashes] : nil;
+        self.pinnedCertificateHashes = [NSSet setWithSet:mutablePinnedCertificateHashes];
+        self.pinnedAnchorCertificates = mutablePinnedAnchorCertificates;
     } else {
         self.pinnedPublicKeys = nil;
+        self.pinnedPublicKeyHashes = nil;
+        self.pinnedCertificateHashes = nil;
+        self.pinnedAnchorCertificates = nil;
+    }
+
+    [self removeAllCachedTrustEvaluations];
+}
+
+- (void)setSSLPinningMode:(AFSSLPinningMode)SSLPinningMode {
+    _SSLPinningMode = SSLPinningMode;
+    [self removeAllCachedTrustEvaluations];
+}
+
+- (void)setAllowInvalidCertificates:(BOOL)allowInvalidCertificates {
+    _allowInvalidCertificates = allowInvalidCertificates;
+    [self removeAllCachedTrustEvaluations];
+}
+
+- (void)setValidatesDomainName:(BOOL)validatesDomainName {
+    _validatesDomainName = validatesDomainName;
+    [self removeAllCachedTrustEvaluations];
+}
+
+#pragma mark - Trust Evaluation Cache
+
+- (void)removeAllCachedTrustEvaluations {
+    [self.lock lock];
+    [self.trustEvaluationCache removeAllObjects];
+    [self.lock unlock];
+}
+
+// This method should only be called while holding the lock
+- (void)cacheTrustEvaluationForKey:(NSString *)key {
+    NSDate *now = [NSDate date];
+    if (self.trustEvaluationCache.count >= AFTrustEvaluationCacheCapacity) {
+        NSArray *expiredKeys = [self.trustEvaluationCache keysOfEntriesPassingTest:^BOOL(__unused NSString *cachedKey, NSDate *expirationDate, __unused BOOL *stop) {
+            return [expirationDate compare:now] != NSOrderedDescending;
+        }].allObjects;
+        [self.trustEvaluationCache removeObjectsForKeys:expiredKeys];
+        if (self.trustEvaluationCache.count >= AFTrustEvaluationCacheCapacity) {
+            [self.trustEvaluationCache removeAllObjects];
+        }
     }
+    self.trustEvaluationCache[key] = [now dateByAddingTimeInterval:self.trustEvaluationCacheTimeout];
 }
 
 #pragma mark -
 
 - (BOOL)evaluateServerTrust:(SecTrustRef)serverTrust
                   forDomain:(NSString *)domain
+{
+    NSString *cacheKey = nil;
+    if (self.trustEvaluationCacheTimeout > 0) {
+        cacheKey = AFTrustEvaluationCacheKey(serverTrust, domain);
+
+        [self.lock lock];
+        NSDate *expirationDate = cacheKey ? self.trustEvaluationCache[cacheKey] : nil;
+        BOOL isCached = expirationDate && [expirationDate timeIntervalSinceNow] > 0;
+        if (isCached) {
+            self.trustEvaluationCacheHitCount += 1;
+        } else if (expirationDate) {
+            [self.trustEvaluationCache removeObjectForKey:cacheKey];
+        }
+        [self.lock unlock];
+
+        if (isCached) {
+            return YES;
+        }
+    }
+
+    CFAbsoluteTime startTime = CFAbsoluteTimeGetCurrent();
+    BOOL isTrusted = [self evaluateServerTrustIgnoringCache:serverTrust forDomain:domain];
+    CFAbsoluteTime duration = CFAbsoluteTimeGetCurrent() - startTime;
+
+    [self.lock lock];
+    self.trustEvaluationCount += 1;
+    self.trustEvaluationDuration += duration;
+    if (isTrusted && cacheKey) {
+        [self cacheTrustEvaluationForKey:cacheKey];
+    }
+    [self.lock unlock];
+
+    return isTrusted;
+}
+
+- (BOOL)evaluateServerTrustIgnoringCache:(SecTrustRef)serverTrust
+                               forDomain:(NSString *)domain
 {
     if (domain && self.allowInvalidCertificates && self.validatesDomainName && (self.SSLPinningMode == AFSSLPinningModeNone || [self.pinnedCertificates count] == 0)) {
         // https://developer.apple.com/library/mac/documentation/NetworkingInternet/Conceptual/NetworkingTopics/Articles/OverridingSSLChainValidationCorrectly.html
@@ -250,11 +401,7 @@ static NSArray * AFPublicKeyTrustChainForServerTrust(SecTrustRef serverTrust) {
 
     switch (self.SSLPinningMode) {
         case AFSSLPinningModeCertificate: {
-            NSMutableArray *pinnedCertificates = [NSMutableArray array];
-            for (NSData *certificateData in self.pinnedCertificates) {
-                [pinnedCertificates addObject:(__bridge_transfer id)SecCertificateCreateWithData(NULL, (__bridge CFDataRef)certificateData)];
-            }
-            SecTrustSetAnchorCertificates(serverTrust, (__bridge CFArrayRef)pinnedCertificates);
+            SecTrustSetAnchorCertificates(serverTrust, (__bridge CFArrayRef)(self.pinnedAnchorCertificates ?: @[]));
 
             if (!AFServerTrustIsValid(serverTrust)) {
                 return NO;
@@ -264,7 +411,7 @@ static NSArray * AFPublicKeyTrustChainForServerTrust(SecTrustRef serverTrust) {
             NSArray *serverCertificates = AFCertificateTrustChainForServerTrust(serverTrust);
             
             for (NSData *trustChainCertificate in [serverCertificates reverseObjectEnumerator]) {
-                if ([self.pinnedCertificates containsObject:trustChainCertificate]) {
+                if ([self.pinnedCertificateHashes containsObject:AFSHA256HashForData(trustChainCertificate)]) {
                     return YES;
                 }
             }
@@ -275,6 +422,16 @@ static NSArray * AFPublicKeyTrustChainForServerTrust(SecTrustRef serverTrust) {
             NSUInteger trustedPublicKeyCount = 0;
             NSArray *publicKeys = AFPublicKeyTrustChainForServerTrust(serverTrust);
 
+            if (self.pinnedPublicKeyHashes) {
+                for (id trustChainPublicKey in publicKeys) {
+                    NSData *publicKeyHash = AFHashForPublicKey(trustChainPublicKey);
+                    if (publicKeyHash && [self.pinnedPublicKeyHashes containsObject:publicKeyHash]) {
+                        return YES;
+                    }
+                }
+                return NO;
+            }
+
             for (id trustChainPublicKey in publicKeys) {
                 for (id pinnedPublicKey in self.pinnedPublicKeys) {
                     if (AFSecKeyIsEqualToKey((__bridge SecKeyRef)trustChainPublicKey, (__bridge SecKeyRef)pinnedPublicKey)) {
@@ -315,6 +472,7 @@ static NSArray * AFPublicKeyTrustChainForServerTrust(SecTrustRef serverTrust) {
     self.allowInvalidCertificates = [decoder decodeBoolForKey:NSStringFromSelector(@selector(allowInvalidCertificates))];
     self.validatesDomainName = [decoder decodeBoolForKey:NSStringFromSelector(@selector(validatesDomainName))];
     self.pinnedCertificates = [decoder decodeObjectOfClass:[NSSet class] forKey:NSStringFromSelector(@selector(pinnedCertificates))];
+    self.trustEvaluationCacheTimeout = [decoder decodeDoubleForKey:NSStringFromSelector(@selector(trustEvaluationCacheTimeout))];
 
     return self;
 }
@@ -324,6 +482,7 @@ static NSArray * AFPublicKeyTrustChainForServerTrust(SecTrustRef serverTrust) {
     [coder encodeBool:self.allowInvalidCertificates forKey:NSStringFromSelector(@selector(allowInvalidCertificates))];
     [coder encodeBool:self.validatesDomainName forKey:NSStringFromSelector(@selector(validatesDomainName))];
     [coder encodeObject:self.pinnedCertificates forKey:NSStringFromSelector(@selector(pinnedCertificates))];
+    [coder encodeDouble:self.trustEvaluationCacheTimeout forKey:NSStringFromSelector(@selector(trustEvaluationCacheTimeout))];
 }
 
 #pragma mark - NSCopying
@@ -334,6 +493,7 @@ static NSArray * AFPublicKeyTrustChainForServerTrust(SecTrustRef serverTrust) {
     securityPolicy.allowInvalidCertificates = self.allowInvalidCertificates;
     securityPolicy.validatesDomainName = self.validatesDomainName;
     securityPolicy.pinnedCertificates = [self.pinnedCertificates copyWithZone:zone];
+    securityPolicy.trustEvaluationCacheTimeout = self.trustEvaluationCacheTimeout;
 
     return securityPolicy;
 }
@@ -139,6 +139,143 @@ FOUNDATION_EXPORT id AFJSONObjectByRemovingKeysWithNullValues(id JSONObject, NSJ
 
 #pragma mark -
 
+/**
+ The `AFURLIncrementalResponseParsing` protocol is adopted by an object that consumes the response data of a single data task as it arrives, rather than after the whole body has been received.
+ */
+@protocol AFURLIncrementalResponseParsing <NSObject>
+
+/**
+ Consumes the next chunk of response data. This is called on the session delegate queue in the order the data was received.
+
+ @param data The received chunk of data.
+
+ @return `YES` if the parser consumed the chunk, so the caller does not need to keep it. `NO` if the parser declined it, for example because the response is an error, in which case the caller buffers the chunk and passes it to `responseObjectForResponse:data:error:`.
+ */
+- (BOOL)appendData:(NSData *)data;
+
+/**
+ The response object decoded from the data received so far, once the task completed successfully.
+
+ @param response The response to be processed.
+ @param data The chunks the parser declined in `appendData:`, which implementations use to fall back to non-incremental decoding.
+ @param error The error that occurred while attempting to decode the response data.
+
+ @return The object decoded from the response data.
+ */
+- (nullable id)responseObjectForResponse:(nullable NSURLResponse *)response
+                                    data:(nullable NSData *)data
+                                   error:(NSError * _Nullable __autoreleasing *)error NS_SWIFT_NOTHROW;
+
+@end
+
+/**
+ The `AFURLIncrementalResponseSerialization` protocol is adopted by response serializers which are able to decode the response data of a data task while it is being received. `AFURLSessionManager` asks the serializer for an incremental parser when a data task is created, feeds it every received chunk, and uses it instead of `responseObjectForResponse:data:error:` once the task completes.
+ */
+@protocol AFURLIncrementalResponseSerialization <AFURLResponseSerialization>
+
+/**
+ Creates a parser for the response data of the specified data task.
+
+ @param dataTask The data task whose response will be parsed.
+
+ @return A new parser, or `nil` if the response of the task should be decoded all at once.
+ */
+- (nullable id <AFURLIncrementalResponseParsing>)incrementalResponseParserForDataTask:(NSURLSessionDataTask *)dataTask;
+
+@end
+
+#pragma mark -
+
+@class AFJSONStreamParser;
+
+/**
+ The `AFJSONStreamParserDelegate` protocol defines the events reported by an `AFJSONStreamParser`, in document order.
+ */
+@protocol AFJSONStreamParserDelegate <NSObject>
+
+- (void)parserDidStartObject:(AFJSONStreamParser *)parser;
+- (void)parserDidEndObject:(AFJSONStreamParser *)parser;
+- (void)parserDidStartArray:(AFJSONStreamParser *)parser;
+- (void)parserDidEndArray:(AFJSONStreamParser *)parser;
+- (void)parser:(AFJSONStreamParser *)parser foundKey:(NSString *)key;
+- (void)parser:(AFJSONStreamParser *)parser foundString:(NSString *)string;
+- (void)parser:(AFJSONStreamParser *)parser foundNumber:(NSNumber *)number;
+- (void)parser:(AFJSONStreamParser *)parser foundBoolean:(BOOL)boolean;
+- (void)parserFoundNull:(AFJSONStreamParser *)parser;
+
+@end
+
+/**
+ `AFJSONStreamParser` is an event driven (SAX-style) parser for UTF-8 encoded JSON. Data may be supplied in arbitrarily split chunks; tokens spanning chunk boundaries are buffered until they are complete, and the delegate is notified as soon as each token has been read.
+ */
+@interface AFJSONStreamParser : NSObject
+
+/**
+ The object notified of parsing events.
+ */
+@property (nonatomic, weak, nullable) id <AFJSONStreamParserDelegate> delegate;
+
+/**
+ Parses the next chunk of the document.
+
+ @param data The chunk to parse.
+ @param error The error that occurred if the document is not valid JSON.
+
+ @return `YES` if the chunk was consumed without error, otherwise `NO`. Once parsing failed, all further calls fail as well.
+ */
+- (BOOL)parseData:(NSData *)data error:(NSError * _Nullable __autoreleasing *)error;
+
+/**
+ Signals the end of the document, flushing a trailing top-level number.
+
+ @param error The error that occurred if the document is incomplete or not valid JSON.
+
+ @return `YES` if a complete document was parsed, otherwise `NO`.
+ */
+- (BOOL)finishParsingWithError:(NSError * _Nullable __autoreleasing *)error;
+
+@end
+
+#pragma mark -
+
+/**
+ `AFJSONStreamingResponseSerializer` is a subclass of `AFJSONResponseSerializer` that parses the response while it is being received, using an `AFJSONStreamParser`. Once the task completes, the response object is already built, so no separate `NSJSONSerialization` pass is needed.
+
+ Elements of the array at `elementKeyPath` are additionally delivered to `elementsHandler` in batches as soon as they have been parsed, which allows displaying the first items of a large list long before the response has been fully received.
+
+ While the parser accepts the response, `AFURLSessionManager` does not buffer the response body. If the response does not pass validation or is not UTF-8 encoded, the body is buffered instead and decoded at completion exactly like `AFJSONResponseSerializer` does, and the elements are delivered from the decoded object. If the body turns out not to be valid JSON while streaming, the task fails with an `NSURLErrorCannotParseResponse` error.
+ */
+@interface AFJSONStreamingResponseSerializer : AFJSONResponseSerializer <AFURLIncrementalResponseSerialization>
+
+/**
+ The dot separated key path of the array whose elements are streamed, for example `data.list`. `nil` streams the elements of a top-level array.
+ */
+@property (nonatomic, copy, nullable) NSString *elementKeyPath;
+
+/**
+ The maximum number of elements delivered to `elementsHandler` at once. `20` by default.
+ */
+@property (nonatomic, assign) NSUInteger elementsBatchSize;
+
+/**
+ Whether streamed elements are also kept in the array of the response object. `YES` by default. Set this to `NO` to bound memory usage when elements are only consumed through `elementsHandler`.
+ */
+@property (nonatomic, assign) BOOL retainsStreamedElements;
+
+/**
+ The dispatch queue for `elementsHandler`. If `NULL` (default), the main queue is used.
+ */
+@property (nonatomic, strong, nullable) dispatch_queue_t elementsQueue;
+
+/**
+ A block called with each batch of elements parsed from the array at `elementKeyPath`. Batches of a task are always delivered before its completion handler is called, provided the completion queue is the same as `elementsQueue`.
+ */
+@property (nonatomic, copy, nullable) void (^elementsHandler)(NSURLSessionDataTask *task, NSArray *elements);
+
+@end
+
+#pragma mark -
+
 /**
  `AFXMLParserResponseSerializer` is a subclass of `AFHTTPResponseSerializer` that validates and decodes XML responses as an `NSXMLParser` objects.
 
@@ -308,6 +308,819 @@ id AFJSONObjectByRemovingKeysWithNullValues(id JSONObject, NSJSONReadingOptions
 
 #pragma mark -
 
+typedef NS_ENUM(NSInteger, AFJSONStreamParserState) {
+    AFJSONStreamParserStateValue,
+    AFJSONStreamParserStateValueOrArrayEnd,
+    AFJSONStreamParserStateKey,
+    AFJSONStreamParserStateKeyOrObjectEnd,
+    AFJSONStreamParserStateColon,
+    AFJSONStreamParserStateCommaOrEnd,
+    AFJSONStreamParserStateDone,
+    AFJSONStreamParserStateFailed,
+};
+
+static NSUInteger const AFJSONStreamParserKeyCacheSize = 64;
+static NSUInteger const AFJSONStreamParserMaximumCachedKeyLength = 32;
+
+static inline BOOL AFJSONIsWhitespace(uint8_t c) {
+    return c == ' ' || c == '\n' || c == '\r' || c == '\t';
+}
+
+static inline int AFJSONHexValue(uint8_t c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+static inline void AFJSONAppendUTF8(NSMutableData *data, uint32_t codePoint) {
+    uint8_t bytes[4];
+    NSUInteger length;
+    if (codePoint < 0x80) {
+        bytes[0] = (uint8_t)codePoint;
+        length = 1;
+    } else if (codePoint < 0x800) {
+        bytes[0] = (uint8_t)(0xC0 | (codePoint >> 6));
+        bytes[1] = (uint8_t)(0x80 | (codePoint & 0x3F));
+        length = 2;
+    } else if (codePoint < 0x10000) {
+        bytes[0] = (uint8_t)(0xE0 | (codePoint >> 12));
+        bytes[1] = (uint8_t)(0x80 | ((codePoint >> 6) & 0x3F));
+        bytes[2] = (uint8_t)(0x80 | (codePoint & 0x3F));
+        length = 3;
+    } else {
+        bytes[0] = (uint8_t)(0xF0 | (codePoint >> 18));
+        bytes[1] = (uint8_t)(0x80 | ((codePoint >> 12) & 0x3F));
+        bytes[2] = (uint8_t)(0x80 | ((codePoint >> 6) & 0x3F));
+        bytes[3] = (uint8_t)(0x80 | (codePoint & 0x3F));
+        length = 4;
+    }
+    [data appendBytes:bytes length:length];
+}
+
+@interface AFJSONStreamParser ()
+@property (nonatomic, assign) AFJSONStreamParserState state;
+@property (nonatomic, strong) NSMutableData *buffer;
+@property (nonatomic, strong) NSMutableData *containers;
+@property (nonatomic, assign) NSUInteger offset;
+@property (nonatomic, strong) NSMutableArray *keyCacheStrings;
+@property (nonatomic, strong) NSMutableArray *keyCacheBytes;
+@end
+
+@implementation AFJSONStreamParser
+
+- (instancetype)init {
+    self = [super init];
+    if (!self) {
+        return nil;
+    }
+
+    self.state = AFJSONStreamParserStateValue;
+    self.buffer = [NSMutableData data];
+    self.containers = [NSMutableData data];
+    self.offset = 0;
+
+    self.keyCacheStrings = [NSMutableArray arrayWithCapacity:AFJSONStreamParserKeyCacheSize];
+    self.keyCacheBytes = [NSMutableArray arrayWithCapacity:AFJSONStreamParserKeyCacheSize];
+    for (NSUInteger i = 0; i < AFJSONStreamParserKeyCacheSize; i++) {
+        [self.keyCacheStrings addObject:[NSNull null]];
+        [self.keyCacheBytes addObject:[NSNull null]];
+    }
+
+    return self;
+}
+
+- (BOOL)parseData:(NSData *)data error:(NSError * __autoreleasing *)error {
+    if (self.state == AFJSONStreamParserStateFailed) {
+        return [self failWithError:error];
+    }
+    if (data.length == 0) {
+        return YES;
+    }
+
+    // Only buffer what could not be consumed, so that chunks made of complete tokens are never copied
+    if (self.buffer.length == 0) {
+        NSUInteger consumed = 0;
+        BOOL success = [self parseBytes:data.bytes length:data.length final:NO consumed:&consumed error:error];
+        if (success && consumed < data.length) {
+            [self.buffer appendBytes:(const uint8_t *)data.bytes + consumed length:data.length - consumed];
+        }
+        return success;
+    }
+
+    [self.buffer appendData:data];
+    return [self parseBufferFinal:NO error:error];
+}
+
+- (BOOL)finishParsingWithError:(NSError * __autoreleasing *)error {
+    if (self.state == AFJSONStreamParserStateFailed) {
+        return [self failWithError:error];
+    }
+    if (![self parseBufferFinal:YES error:error]) {
+        return NO;
+    }
+    if (self.state != AFJSONStreamParserStateDone || self.buffer.length > 0) {
+        self.state = AFJSONStreamParserStateFailed;
+        return [self failWithError:error];
+    }
+    return YES;
+}
+
+- (BOOL)parseBufferFinal:(BOOL)final error:(NSError * __autoreleasing *)error {
+    NSUInteger consumed = 0;
+    BOOL success = [self parseBytes:self.buffer.bytes length:self.buffer.length final:final consumed:&consumed error:error];
+    if (success && consumed > 0) {
+        [self.buffer replaceBytesInRange:NSMakeRange(0, consumed) withBytes:NULL length:0];
+    }
+    return success;
+}
+
+- (BOOL)failWithError:(NSError * __autoreleasing *)error {
+    self.state = AFJSONStreamParserStateFailed;
+    if (error) {
+        NSDictionary *userInfo = @{NSLocalizedDescriptionKey: [NSString stringWithFormat:NSLocalizedStringFromTable(@"Invalid JSON around byte %lu", @"AFNetworking", nil), (unsigned long)self.offset]};
+        *error = [NSError errorWithDomain:AFURLResponseSerializationErrorDomain code:NSURLErrorCannotParseResponse userInfo:userInfo];
+    }
+    return NO;
+}
+
+#pragma mark - Tokenizer
+
+- (BOOL)parseBytes:(const uint8_t *)bytes
+            length:(NSUInteger)length
+             final:(BOOL)final
+          consumed:(NSUInteger *)consumed
+             error:(NSError * __autoreleasing *)error
+{
+    id <AFJSONStreamParserDelegate> delegate = self.delegate;
+    NSUInteger i = 0;
+
+    while (i < length) {
+        uint8_t c = bytes[i];
+        if (AFJSONIsWhitespace(c)) {
+            i++;
+            continue;
+        }
+
+        AFJSONStreamParserState state = self.state;
+        if (state == AFJSONStreamParserStateDone) {
+            self.offset += i;
+            return [self failWithError:error];
+        }
+
+        if (state == AFJSONStreamParserStateColon) {
+            if (c != ':') {
+                self.offset += i;
+                return [self failWithError:error];
+            }
+            self.state = AFJSONStreamParserStateValue;
+            i++;
+            continue;
+        }
+
+        if (state == AFJSONStreamParserStateCommaOrEnd) {
+            uint8_t container = [self currentContainer];
+            if (c == ',') {
+                self.state = container == '{' ? AFJSONStreamParserStateKey : AFJSONStreamParserStateValue;
+            } else if (c == '}' && container == '{') {
+                [self popContainer];
+                [delegate parserDidEndObject:self];
+            } else if (c == ']' && container == '[') {
+                [self popContainer];
+                [delegate parserDidEndArray:self];
+            } else {
+                self.offset += i;
+                return [self failWithError:error];
+            }
+            i++;
+            continue;
+        }
+
+        if (state == AFJSONStreamParserStateKey || state == AFJSONStreamParserStateKeyOrObjectEnd) {
+            if (c == '}' && state == AFJSONStreamParserStateKeyOrObjectEnd) {
+                [self popContainer];
+                [delegate parserDidEndObject:self];
+                i++;
+                continue;
+            }
+            if (c != '"') {
+                self.offset += i;
+                return [self failWithError:error];
+            }
+            NSUInteger end = 0;
+            BOOL hasEscapes = NO;
+            if (![self scanStringInBytes:bytes length:length from:i end:&end hasEscapes:&hasEscapes]) {
+                break;
+            }
+            NSString *key = [self keyWithBytes:bytes + i + 1 length:end - i - 1 hasEscapes:hasEscapes];
+            if (!key) {
+                self.offset += i;
+                return [self failWithError:error];
+            }
+            [delegate parser:self foundKey:key];
+            self.state = AFJSONStreamParserStateColon;
+            i = end + 1;
+            continue;
+        }
+
+        // Expecting a value
+        if (c == ']' && state == AFJSONStreamParserStateValueOrArrayEnd) {
+            [self popContainer];
+            [delegate parserDidEndArray:self];
+            i++;
+        } else if (c == '{') {
+            [self pushContainer:'{'];
+            self.state = AFJSONStreamParserStateKeyOrObjectEnd;
+            [delegate parserDidStartObject:self];
+            i++;
+        } else if (c == '[') {
+            [self pushContainer:'['];
+            self.state = AFJSONStreamParserStateValueOrArrayEnd;
+            [delegate parserDidStartArray:self];
+            i++;
+        } else if (c == '"') {
+            NSUInteger end = 0;
+            BOOL hasEscapes = NO;
+            if (![self scanStringInBytes:bytes length:length from:i end:&end hasEscapes:&hasEscapes]) {
+                break;
+            }
+            NSString *string = [self stringWithBytes:bytes + i + 1 length:end - i - 1 hasEscapes:hasEscapes];
+            if (!string) {
+                self.offset += i;
+                return [self failWithError:error];
+            }
+            [delegate parser:self foundString:string];
+            [self didParseValue];
+            i = end + 1;
+        } else if (c == '-' || (c >= '0' && c <= '9')) {
+            NSUInteger end = i;
+            while (end < length && (bytes[end] == '-' || bytes[end] == '+' || bytes[end] == '.' || bytes[end] == 'e' || bytes[end] == 'E' || (bytes[end] >= '0' && bytes[end] <= '9'))) {
+                end++;
+            }
+            if (end == length && !final) {
+                break;
+            }
+            NSNumber *number = [self numberWithBytes:bytes + i length:end - i];
+            if (!number) {
+                self.offset += i;
+                return [self failWithError:error];
+            }
+            [delegate parser:self foundNumber:number];
+            [self didParseValue];
+            i = end;
+        } else if (c == 't' || c == 'f' || c == 'n') {
+            const char *literal = c == 't' ? "true" : (c == 'f' ? "false" : "null");
+            NSUInteger literalLength = strlen(literal);
+            if (length - i < literalLength) {
+                if (!final && memcmp(bytes + i, literal, length - i) == 0) {
+                    break;
+                }
+                self.offset += i;
+                return [self failWithError:error];
+            }
+            if (memcmp(bytes + i, literal, literalLength) != 0) {
+                self.offset += i;
+                return [self failWithError:error];
+            }
+            if (c == 'n') {
+                [delegate parserFoundNull:self];
+            } else {
+                [delegate parser:self foundBoolean:(c == 't')];
+            }
+            [self didParseValue];
+            i += literalLength;
+        } else {
+            self.offset += i;
+            return [self failWithError:error];
+        }
+    }
+
+    self.offset += i;
+    *consumed = i;
+    return YES;
+}
+
+- (void)didParseValue {
+    self.state = self.containers.length == 0 ? AFJSONStreamParserStateDone : AFJSONStreamParserStateCommaOrEnd;
+}
+
+- (void)pushContainer:(uint8_t)container {
+    [self.containers appendBytes:&container length:1];
+}
+
+- (void)popContainer {
+    self.containers.length -= 1;
+    [self didParseValue];
+}
+
+- (uint8_t)currentContainer {
+    return ((const uint8_t *)self.containers.bytes)[self.containers.length - 1];
+}
+
+// Finds the closing quote of the string starting at `start`. Returns `NO` if the string is not complete yet.
+- (BOOL)scanStringInBytes:(const uint8_t *)bytes
+                   length:(NSUInteger)length
+                     from:(NSUInteger)start
+                      end:(NSUInteger *)end
+               hasEscapes:(BOOL *)hasEscapes
+{
+    NSUInteger j = start + 1;
+    while (j < length) {
+        uint8_t c = bytes[j];
+        if (c == '"') {
+            *end = j;
+            return YES;
+        }
+        if (c == '\\') {
+            *hasEscapes = YES;
+            j += 2;
+            continue;
+        }
+        j++;
+    }
+    return NO;
+}
+
+- (NSString *)keyWithBytes:(const uint8_t *)bytes length:(NSUInteger)length hasEscapes:(BOOL)hasEscapes {
+    if (hasEscapes || length > AFJSONStreamParserMaximumCachedKeyLength) {
+        return [self stringWithBytes:bytes length:length hasEscapes:hasEscapes];
+    }
+
+    // Object keys repeat for every element of a list, so look them up in a small direct mapped cache first
+    NSUInteger hash = 5381;
+    for (NSUInteger i = 0; i < length; i++) {
+        hash = ((hash << 5) + hash) + bytes[i];
+    }
+    NSUInteger slot = hash % AFJSONStreamParserKeyCacheSize;
+    NSData *cachedBytes = self.keyCacheBytes[slot];
+    if ([cachedBytes isKindOfClass:[NSData class]] && cachedBytes.length == length && memcmp(cachedBytes.bytes, bytes, length) == 0) {
+        return self.keyCacheStrings[slot];
+    }
+
+    NSString *key = [self stringWithBytes:bytes length:length hasEscapes:NO];
+    if (key) {
+        self.keyCacheBytes[slot] = [NSData dataWithBytes:bytes length:length];
+        self.keyCacheStrings[slot] = key;
+    }
+    return key;
+}
+
+- (NSString *)stringWithBytes:(const uint8_t *)bytes length:(NSUInteger)length hasEscapes:(BOOL)hasEscapes {
+    for (NSUInteger i = 0; i < length; i++) {
+        if (bytes[i] < 0x20) {
+            return nil;
+        }
+    }
+    if (!hasEscapes) {
+        return [[NSString alloc] initWithBytes:bytes length:length encoding:NSUTF8StringEncoding];
+    }
+
+    NSMutableData *unescaped = [NSMutableData dataWithCapacity:length];
+    NSUInteger i = 0;
+    while (i < length) {
+        NSUInteger run = i;
+        while (run < length && bytes[run] != '\\') {
+            run++;
+        }
+        [unescaped appendBytes:bytes + i length:run - i];
+        i = run;
+        if (i >= length) {
+            break;
+        }
+        if (i + 1 >= length) {
+            return nil;
+        }
+
+        uint8_t escaped = bytes[i + 1];
+        uint8_t character = 0;
+        switch (escaped) {
+            case '"': character = '"'; break;
+            case '\\': character = '\\'; break;
+            case '/': character = '/'; break;
+            case 'b': character = '\b'; break;
+            case 'f': character = '\f'; break;
+            case 'n': character = '\n'; break;
+            case 'r': character = '\r'; break;
+            case 't': character = '\t'; break;
+            case 'u': {
+                uint32_t codePoint = 0;
+                if (![self readHexQuadInBytes:bytes length:length at:i + 2 value:&codePoint]) {
+                    return nil;
+                }
+                i += 6;
+                if (codePoint >= 0xD800 && codePoint <= 0xDBFF) {
+                    uint32_t lowSurrogate = 0;
+                    if (i + 1 < length && bytes[i] == '\\' && bytes[i + 1] == 'u' &&
+                        [self readHexQuadInBytes:bytes length:length at:i + 2 value:&lowSurrogate] &&
+                        lowSurrogate >= 0xDC00 && lowSurrogate <= 0xDFFF) {
+                        codePoint = 0x10000 + ((codePoint - 0xD800) << 10) + (lowSurrogate - 0xDC00);
+                        i += 6;
+                    } else {
+                        codePoint = 0xFFFD;
+                    }
+                } else if (codePoint >= 0xDC00 && codePoint <= 0xDFFF) {
+                    codePoint = 0xFFFD;
+                }
+                AFJSONAppendUTF8(unescaped, codePoint);
+                continue;
+            }
+            default:
+                return nil;
+        }
+        [unescaped appendBytes:&character length:1];
+        i += 2;
+    }
+
+    return [[NSString alloc] initWithData:unescaped encoding:NSUTF8StringEncoding];
+}
+
+- (BOOL)readHexQuadInBytes:(const uint8_t *)bytes length:(NSUInteger)length at:(NSUInteger)index value:(uint32_t *)value {
+    if (index + 4 > length) {
+        return NO;
+    }
+    uint32_t result = 0;
+    for (NSUInteger i = index; i < index + 4; i++) {
+        int digit = AFJSONHexValue(bytes[i]);
+        if (digit < 0) {
+            return NO;
+        }
+        result = (result << 4) | (uint32_t)digit;
+    }
+    *value = result;
+    return YES;
+}
+
+- (NSNumber *)numberWithBytes:(const uint8_t *)bytes length:(NSUInteger)length {
+    // Validate against the JSON number grammar: -?(0|[1-9][0-9]*)(\.[0-9]+)?([eE][+-]?[0-9]+)?
+    NSUInteger i = 0;
+    BOOL isInteger = YES;
+    if (i < length && bytes[i] == '-') i++;
+    if (i >= length) return nil;
+    if (bytes[i] == '0') {
+        i++;
+    } else if (bytes[i] >= '1' && bytes[i] <= '9') {
+        while (i < length && bytes[i] >= '0' && bytes[i] <= '9') i++;
+    } else {
+        return nil;
+    }
+    if (i < length && bytes[i] == '.') {
+        isInteger = NO;
+        i++;
+        NSUInteger digits = i;
+        while (i < length && bytes[i] >= '0' && bytes[i] <= '9') i++;
+        if (i == digits) return nil;
+    }
+    if (i < length && (bytes[i] == 'e' || bytes[i] == 'E')) {
+        isInteger = NO;
+        i++;
+        if (i < length && (bytes[i] == '+' || bytes[i] == '-')) i++;
+        NSUInteger digits = i;
+        while (i < length && bytes[i] >= '0' && bytes[i] <= '9') i++;
+        if (i == digits) return nil;
+    }
+    if (i != length) return nil;
+
+    char buffer[64];
+    if (length < sizeof(buffer)) {
+        memcpy(buffer, bytes, length);
+        buffer[length] = '\0';
+        errno = 0;
+        if (isInteger) {
+            long long value = strtoll(buffer, NULL, 10);
+            if (errno != ERANGE) {
+                return @(value);
+            }
+        } else {
+            double value = strtod(buffer, NULL);
+            if (errno != ERANGE) {
+                return @(value);
+            }
+        }
+    }
+
+    NSString *string = [[NSString alloc] initWithBytes:bytes length:length encoding:NSASCIIStringEncoding];
+    return [NSDecimalNumber decimalNumberWithString:string locale:@{NSLocaleDecimalSeparator: @"."}];
+}
+
+@end
+
+#pragma mark -
+
+@interface _AFJSONStreamFrame : NSObject
+@property (nonatomic, strong) id container;
+@property (nonatomic, copy) NSString *key;
+@property (nonatomic, assign) NSInteger keyPathDepth;
+@property (nonatomic, assign) BOOL streamsElements;
+@end
+
+@implementation _AFJSONStreamFrame
+@end
+
+@interface _AFJSONStreamResponseParser : NSObject <AFURLIncrementalResponseParsing, AFJSONStreamParserDelegate>
+@property (nonatomic, strong) AFJSONStreamingResponseSerializer *serializer;
+@property (nonatomic, weak) NSURLSessionDataTask *task;
+@property (nonatomic, strong) AFJSONStreamParser *parser;
+@property (nonatomic, copy) NSArray <NSString *> *keyPathComponents;
+@property (nonatomic, strong) NSMutableArray <_AFJSONStreamFrame *> *frames;
+@property (nonatomic, strong) id rootObject;
+@property (nonatomic, strong) NSMutableArray *pendingElements;
+@property (nonatomic, assign) BOOL didStart;
+@property (nonatomic, assign) BOOL disabled;
+@property (nonatomic, assign) BOOL didDeliverElements;
+@property (nonatomic, strong) NSError *parseError;
+@end
+
+@implementation _AFJSONStreamResponseParser
+
+- (instancetype)initWithSerializer:(AFJSONStreamingResponseSerializer *)serializer task:(NSURLSessionDataTask *)task {
+    self = [super init];
+    if (!self) {
+        return nil;
+    }
+
+    self.serializer = serializer;
+    self.task = task;
+    self.parser = [[AFJSONStreamParser alloc] init];
+    self.parser.delegate = self;
+    self.keyPathComponents = serializer.elementKeyPath.length > 0 ? [serializer.elementKeyPath componentsSeparatedByString:@"."] : @[];
+    self.frames = [NSMutableArray array];
+    self.pendingElements = [NSMutableArray array];
+
+    return self;
+}
+
+#pragma mark - AFURLIncrementalResponseParsing
+
+- (BOOL)appendData:(NSData *)data {
+    if (self.disabled) {
+        return NO;
+    }
+    if (self.parseError || data.length == 0) {
+        return YES;
+    }
+
+    if (!self.didStart) {
+        self.didStart = YES;
+        // Error bodies and non UTF-8 encodings are buffered by the caller and left to the regular serialization at completion
+        const uint8_t *bytes = data.bytes;
+        BOOL isUTF8 = !(bytes[0] == 0 || (data.length > 1 && bytes[1] == 0));
+        if (!isUTF8 || ![self.serializer validateResponse:(NSHTTPURLResponse *)self.task.response data:nil error:NULL]) {
+            self.disabled = YES;
+            return NO;
+        }
+        if (data.length >= 3 && bytes[0] == 0xEF && bytes[1] == 0xBB && bytes[2] == 0xBF) {
+            data = [data subdataWithRange:NSMakeRange(3, data.length - 3)];
+        }
+    }
+
+    // The chunks already consumed are not kept, so a document that turns out to be invalid is reported as such at completion
+    NSError *parseError = nil;
+    if (![self.parser parseData:data error:&parseError]) {
+        self.parseError = parseError;
+    }
+
+    return YES;
+}
+
+- (id)responseObjectForResponse:(NSURLResponse *)response
+                           data:(NSData *)data
+                          error:(NSError *__autoreleasing *)error
+{
+    if (self.disabled || !self.didStart) {
+        id responseObject = [self.serializer responseObjectForResponse:response data:data error:error];
+        if (!self.didDeliverElements && !(error && *error)) {
+            [self deliverElementsOfResponseObject:responseObject];
+        }
+        return responseObject;
+    }
+
+    if (![self.serializer validateResponse:(NSHTTPURLResponse *)response data:data error:error]) {
+        if (!error || AFErrorOrUnderlyingErrorHasCodeInDomain(*error, NSURLErrorCannotDecodeContentData, AFURLResponseSerializationErrorDomain)) {
+            return nil;
+        }
+    }
+
+    NSError *parseError = self.parseError;
+    if (!parseError) {
+        [self.parser finishParsingWithError:&parseError];
+    }
+    if (parseError) {
+        if (error) {
+            *error = AFErrorWithUnderlyingError(parseError, *error);
+        }
+        return nil;
+    }
+
+    [self flushPendingElements];
+
+    return self.rootObject;
+}
+
+#pragma mark - AFJSONStreamParserDelegate
+
+- (void)parserDidStartObject:(AFJSONStreamParser *)parser {
+    [self pushContainer:[NSMutableDictionary dictionary]];
+}
+
+- (void)parserDidEndObject:(AFJSONStreamParser *)parser {
+    [self popContainer];
+}
+
+- (void)parserDidStartArray:(AFJSONStreamParser *)parser {
+    [self pushContainer:[NSMutableArray array]];
+}
+
+- (void)parserDidEndArray:(AFJSONStreamParser *)parser {
+    [self popContainer];
+}
+
+- (void)parser:(AFJSONStreamParser *)parser foundKey:(NSString *)key {
+    self.frames.lastObject.key = key;
+}
+
+- (void)parser:(AFJSONStreamParser *)parser foundString:(NSString *)string {
+    [self addValue:string];
+}
+
+- (void)parser:(AFJSONStreamParser *)parser foundNumber:(NSNumber *)number {
+    [self addValue:number];
+}
+
+- (void)parser:(AFJSONStreamParser *)parser foundBoolean:(BOOL)boolean {
+    [self addValue:boolean ? (__bridge NSNumber *)kCFBooleanTrue : (__bridge NSNumber *)kCFBooleanFalse];
+}
+
+- (void)parserFoundNull:(AFJSONStreamParser *)parser {
+    [self addValue:[NSNull null]];
+}
+
+#pragma mark -
+
+- (void)pushContainer:(id)container {
+    _AFJSONStreamFrame *parent = self.frames.lastObject;
+    _AFJSONStreamFrame *frame = [[_AFJSONStreamFrame alloc] init];
+    frame.container = container;
+
+    NSInteger depth = -1;
+    if (!parent) {
+        depth = 0;
+    } else if ([parent.container isKindOfClass:[NSDictionary class]] && parent.keyPathDepth >= 0 &&
+               parent.keyPathDepth < (NSInteger)self.keyPathComponents.count &&
+               [self.keyPathComponents[parent.keyPathDepth] isEqualToString:parent.key]) {
+        depth = parent.keyPathDepth + 1;
+    }
+    frame.keyPathDepth = depth;
+    frame.streamsElements = [container isKindOfClass:[NSArray class]] && depth == (NSInteger)self.keyPathComponents.count;
+
+    [self.frames addObject:frame];
+}
+
+- (void)popContainer {
+    _AFJSONStreamFrame *frame = self.frames.lastObject;
+    [self.frames removeLastObject];
+    if (frame.streamsElements) {
+        [self flushPendingElements];
+    }
+    [self addValue:frame.container];
+}
+
+- (void)addValue:(id)value {
+    _AFJSONStreamFrame *frame = self.frames.lastObject;
+    if (!frame) {
+        self.rootObject = value;
+        return;
+    }
+
+    if (self.serializer.removesKeysWithNullValues && value == [NSNull null]) {
+        frame.key = nil;
+        return;
+    }
+
+    if ([frame.container isKindOfClass:[NSMutableDictionary class]]) {
+        if (frame.key) {
+            ((NSMutableDictionary *)frame.container)[frame.key] = value;
+        }
+        frame.key = nil;
+    } else if (frame.streamsElements) {
+        if (self.serializer.retainsStreamedElements) {
+            [(NSMutableArray *)frame.container addObject:value];
+        }
+        [self.pendingElements addObject:value];
+        if (self.pendingElements.count >= MAX(self.serializer.elementsBatchSize, (NSUInteger)1)) {
+            [self flushPendingElements];
+        }
+    } else {
+        [(NSMutableArray *)frame.container addObject:value];
+    }
+}
+
+- (void)deliverElementsOfResponseObject:(id)responseObject {
+    id elements = responseObject;
+    for (NSString *key in self.keyPathComponents) {
+        elements = [elements isKindOfClass:[NSDictionary class]] ? elements[key] : nil;
+    }
+    if (![elements isKindOfClass:[NSArray class]]) {
+        return;
+    }
+
+    NSUInteger batchSize = MAX(self.serializer.elementsBatchSize, (NSUInteger)1);
+    for (id element in (NSArray *)elements) {
+        [self.pendingElements addObject:element];
+        if (self.pendingElements.count >= batchSize) {
+            [self flushPendingElements];
+        }
+    }
+    [self flushPendingElements];
+}
+
+- (void)flushPendingElements {
+    if (self.pendingElements.count == 0) {
+        return;
+    }
+
+    NSArray *elements = self.pendingElements;
+    self.pendingElements = [NSMutableArray array];
+    self.didDeliverElements = YES;
+
+    void (^elementsHandler)(NSURLSessionDataTask *, NSArray *) = self.serializer.elementsHandler;
+    NSURLSessionDataTask *task = self.task;
+    if (elementsHandler && task) {
+        dispatch_async(self.serializer.elementsQueue ?: dispatch_get_main_queue(), ^{
+            elementsHandler(task, elements);
+        });
+    }
+}
+
+@end
+
+#pragma mark -
+
+@implementation AFJSONStreamingResponseSerializer
+
+- (instancetype)init {
+    self = [super init];
+    if (!self) {
+        return nil;
+    }
+
+    self.elementsBatchSize = 20;
+    self.retainsStreamedElements = YES;
+
+    return self;
+}
+
+#pragma mark - AFURLIncrementalResponseSerialization
+
+- (id <AFURLIncrementalResponseParsing>)incrementalResponseParserForDataTask:(NSURLSessionDataTask *)dataTask {
+    return [[_AFJSONStreamResponseParser alloc] initWithSerializer:self task:dataTask];
+}
+
+#pragma mark - NSSecureCoding
+
+- (instancetype)initWithCoder:(NSCoder *)decoder {
+    self = [super initWithCoder:decoder];
+    if (!self) {
+        return nil;
+    }
+
+    self.elementKeyPath = [decoder decodeObjectOfClass:[NSString class] forKey:NSStringFromSelector(@selector(elementKeyPath))];
+    NSNumber *elementsBatchSize = [decoder decodeObjectOfClass:[NSNumber class] forKey:NSStringFromSelector(@selector(elementsBatchSize))];
+    if (elementsBatchSize) {
+        self.elementsBatchSize = [elementsBatchSize unsignedIntegerValue];
+    }
+    NSNumber *retainsStreamedElements = [decoder decodeObjectOfClass:[NSNumber class] forKey:NSStringFromSelector(@selector(retainsStreamedElements))];
+    if (retainsStreamedElements) {
+        self.retainsStreamedElements = [retainsStreamedElements boolValue];
+    }
+
+    return self;
+}
+
+- (void)encodeWithCoder:(NSCoder *)coder {
+    [super encodeWithCoder:coder];
+
+    [coder encodeObject:self.elementKeyPath forKey:NSStringFromSelector(@selector(elementKeyPath))];
+    [coder encodeObject:@(self.elementsBatchSize) forKey:NSStringFromSelector(@selector(elementsBatchSize))];
+    [coder encodeObject:@(self.retainsStreamedElements) forKey:NSStringFromSelector(@selector(retainsStreamedElements))];
+}
+
+#pragma mark - NSCopying
+
+- (instancetype)copyWithZone:(NSZone *)zone {
+    AFJSONStreamingResponseSerializer *serializer = [super copyWithZone:zone];
+    serializer.elementKeyPath = self.elementKeyPath;
+    serializer.elementsBatchSize = self.elementsBatchSize;
+    serializer.retainsStreamedElements = self.retainsStreamedElements;
+    serializer.elementsQueue = self.elementsQueue;
+    serializer.elementsHandler = self.elementsHandler;
+
+    return serializer;
+}
+
+@end
+
+#pragma mark -
+
 @implementation AFXMLParserResponseSerializer
 
 + (instancetype)serializer {
@@ -91,6 +91,7 @@ typedef void (^AFURLSessionTaskCompletionHandler)(NSURLResponse *response, id re
 - (instancetype)initWithTask:(NSURLSessionTask *)task;
 @property (nonatomic, weak) AFURLSessionManager *manager;
 @property (nonatomic, strong) NSMutableData *mutableData;
+@property (nonatomic, strong) id <AFURLIncrementalResponseParsing> incrementalResponseParser;
 @property (nonatomic, strong) NSProgress *uploadProgress;
 @property (nonatomic, strong) NSProgress *downloadProgress;
 @property (nonatomic, copy) NSURL *downloadFileURL;
@@ -219,7 +220,12 @@ didCompleteWithError:(NSError *)error
     } else {
         dispatch_async(url_session_manager_processing_queue(), ^{
             NSError *serializationError = nil;
-            responseObject = [manager.responseSerializer responseObjectForResponse:task.response data:data error:&serializationError];
+            if (self.incrementalResponseParser) {
+                responseObject = [self.incrementalResponseParser responseObjectForResponse:task.response data:data error:&serializationError];
+                self.incrementalResponseParser = nil;
+            } else {
+                responseObject = [manager.responseSerializer responseObjectForResponse:task.response data:data error:&serializationError];
+            }
 
             if (self.downloadFileURL) {
                 responseObject = self.downloadFileURL;
@@ -263,7 +269,10 @@ didFinishCollectingMetrics:(NSURLSessionTaskMetrics *)metrics AF_API_AVAILABLE(i
     self.downloadProgress.totalUnitCount = dataTask.countOfBytesExpectedToReceive;
     self.downloadProgress.completedUnitCount = dataTask.countOfBytesReceived;
 
-    [self.mutableData appendData:data];
+    // Only buffer the body when there is no incremental parser, or it declined the data
+    if (![self.incrementalResponseParser appendData:data]) {
+        [self.mutableData appendData:data];
+    }
 }
 
 - (void)URLSession:(NSURLSession *)session task:(NSURLSessionTask *)task
@@ -601,6 +610,9 @@ static NSString * const AFNSURLSessionTaskDidSuspendNotification = @"com.alamofi
     AFURLSessionManagerTaskDelegate *delegate = [[AFURLSessionManagerTaskDelegate alloc] initWithTask:dataTask];
     delegate.manager = self;
     delegate.completionHandler = completionHandler;
+    if ([self.responseSerializer conformsToProtocol:@protocol(AFURLIncrementalResponseSerialization)]) {
+        delegate.incrementalResponseParser = [(id <AFURLIncrementalResponseSerialization>)self.responseSerializer incrementalResponseParserForDataTask:dataTask];
+    }
 
     dataTask.taskDescription = self.taskDescriptionForSessionTasks;
     [self setDelegate:delegate forTask:dataTask];
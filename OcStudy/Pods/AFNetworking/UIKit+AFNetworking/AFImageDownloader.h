@@ -34,6 +34,17 @@ typedef NS_ENUM(NSInteger, AFImageDownloadPrioritization) {
     AFImageDownloadPrioritizationLIFO
 };
 
+/**
+ The relative priority of a download request. Queued downloads with a higher priority are always started before downloads with a lower priority; downloads with the same priority are ordered according to the `downloadPrioritization` of the downloader.
+ */
+typedef NS_ENUM(NSInteger, AFImageDownloadPriority) {
+    AFImageDownloadPriorityVeryLow = -8,
+    AFImageDownloadPriorityLow = -4,
+    AFImageDownloadPriorityNormal = 0,
+    AFImageDownloadPriorityHigh = 4,
+    AFImageDownloadPriorityVeryHigh = 8
+};
+
 /**
  The `AFImageDownloadReceipt` is an object vended by the `AFImageDownloader` when starting a data task. It can be used to cancel active tasks running on the `AFImageDownloader` session. As a general rule, image data tasks should be cancelled using the `AFImageDownloadReceipt` instead of calling `cancel` directly on the `task` itself. The `AFImageDownloader` is optimized to handle duplicate task scenarios as well as pending versus active downloads.
  */
@@ -69,6 +80,11 @@ typedef NS_ENUM(NSInteger, AFImageDownloadPrioritization) {
  */
 @property (nonatomic, assign) AFImageDownloadPrioritization downloadPrioritization;
 
+/**
+ The maximum number of active downloads allowed for a single host at any given time. Queued downloads for a host that reached this limit do not block downloads for other hosts. `0` by default, which means only `maximumActiveDownloads` applies.
+ */
+@property (nonatomic, assign) NSInteger maximumActiveDownloadsPerHost;
+
 /**
  The shared default instance of `AFImageDownloader` initialized with default values.
  */
@@ -155,6 +171,33 @@ typedef NS_ENUM(NSInteger, AFImageDownloadPrioritization) {
                                                         success:(nullable void (^)(NSURLRequest *request, NSHTTPURLResponse  * _Nullable response, UIImage *responseObject))success
                                                         failure:(nullable void (^)(NSURLRequest *request, NSHTTPURLResponse * _Nullable response, NSError *error))failure;
 
+/**
+ Creates a data task using the `sessionManager` instance for the specified URL request with the given priority.
+
+ If the same data task is already in the queue, it is promoted to the highest priority of all its receipts. This allows a visible cell to bump a download previously requested by an offscreen cell.
+
+ @param request The URL request.
+ @param receiptID The identifier to use for the download receipt that will be created for this request. This must be a unique identifier that does not represent any other request.
+ @param priority The priority of the download request.
+ @param success A block to be executed when the image data task finishes successfully. This block has no return value and takes three arguments: the request sent from the client, the response received from the server, and the image created from the response data of request. If the image was returned from cache, the response parameter will be `nil`.
+ @param failure A block object to be executed when the image data task finishes unsuccessfully, or that finishes successfully. This block has no return value and takes three arguments: the request sent from the client, the response received from the server, and the error object describing the network or parsing error that occurred.
+
+ @return The image download receipt for the data task if available. `nil` if the image is stored in the cache.
+ */
+- (nullable AFImageDownloadReceipt *)downloadImageForURLRequest:(NSURLRequest *)request
+                                                  withReceiptID:(NSUUID *)receiptID
+                                                       priority:(AFImageDownloadPriority)priority
+                                                        success:(nullable void (^)(NSURLRequest *request, NSHTTPURLResponse  * _Nullable response, UIImage *responseObject))success
+                                                        failure:(nullable void (^)(NSURLRequest *request, NSHTTPURLResponse * _Nullable response, NSError *error))failure;
+
+/**
+ Changes the priority of the receipt. The data task is rescheduled with the highest priority of all the receipts attached to it. This has no effect if the data task is already running or completed.
+
+ @param priority The new priority of the receipt.
+ @param imageDownloadReceipt The image download receipt to update.
+ */
+- (void)setPriority:(AFImageDownloadPriority)priority forImageDownloadReceipt:(AFImageDownloadReceipt *)imageDownloadReceipt;
+
 /**
  Cancels the data task in the receipt by removing the corresponding success and failure blocks and cancelling the data task if necessary.
 
@@ -28,6 +28,7 @@
 
 @interface AFImageDownloaderResponseHandler : NSObject
 @property (nonatomic, strong) NSUUID *uuid;
+@property (nonatomic, assign) AFImageDownloadPriority priority;
 @property (nonatomic, copy) void (^successBlock)(NSURLRequest *, NSHTTPURLResponse *, UIImage *);
 @property (nonatomic, copy) void (^failureBlock)(NSURLRequest *, NSHTTPURLResponse *, NSError *);
 @end
@@ -35,10 +36,12 @@
 @implementation AFImageDownloaderResponseHandler
 
 - (instancetype)initWithUUID:(NSUUID *)uuid
+                    priority:(AFImageDownloadPriority)priority
                      success:(nullable void (^)(NSURLRequest *request, NSHTTPURLResponse * _Nullable response, UIImage *responseObject))success
                      failure:(nullable void (^)(NSURLRequest *request, NSHTTPURLResponse * _Nullable response, NSError *error))failure {
     if (self = [self init]) {
         self.uuid = uuid;
+        self.priority = priority;
         self.successBlock = success;
         self.failureBlock = failure;
     }
@@ -51,26 +54,55 @@
 
 @end
 
-@interface AFImageDownloaderMergedTask : NSObject
+/**
+ An element of an `AFImageDownloaderTaskQueue`. Elements are ordered by priority, then by sequence number, and remember their position in the queue.
+ */
+@protocol AFImageDownloaderQueueElement <NSObject>
+@property (nonatomic, readonly) AFImageDownloadPriority priority;
+@property (nonatomic, readonly) int64_t sequenceNumber;
+@property (nonatomic, assign) NSUInteger queueIndex;
+@end
+
+@interface AFImageDownloaderMergedTask : NSObject <AFImageDownloaderQueueElement>
 @property (nonatomic, strong) NSString *URLIdentifier;
+@property (nonatomic, strong) NSString *host;
 @property (nonatomic, strong) NSUUID *identifier;
 @property (nonatomic, strong) NSURLSessionDataTask *task;
 @property (nonatomic, strong) NSMutableArray <AFImageDownloaderResponseHandler*> *responseHandlers;
 
+// Scheduling state, only accessed from within the synchronizationQueue
+@property (nonatomic, assign) AFImageDownloadPriority priority;
+@property (nonatomic, assign) int64_t sequenceNumber;
+@property (nonatomic, assign) NSUInteger queueIndex;
+
 @end
 
 @implementation AFImageDownloaderMergedTask
 
-- (instancetype)initWithURLIdentifier:(NSString *)URLIdentifier identifier:(NSUUID *)identifier task:(NSURLSessionDataTask *)task {
+- (instancetype)initWithURLIdentifier:(NSString *)URLIdentifier host:(NSString *)host identifier:(NSUUID *)identifier task:(NSURLSessionDataTask *)task {
     if (self = [self init]) {
         self.URLIdentifier = URLIdentifier;
+        self.host = host;
         self.task = task;
         self.identifier = identifier;
         self.responseHandlers = [[NSMutableArray alloc] init];
+        self.priority = AFImageDownloadPriorityNormal;
+        self.queueIndex = NSNotFound;
     }
     return self;
 }
 
+- (AFImageDownloadPriority)highestResponseHandlerPriority {
+    if (self.responseHandlers.count == 0) {
+        return AFImageDownloadPriorityNormal;
+    }
+    AFImageDownloadPriority priority = self.responseHandlers.firstObject.priority;
+    for (AFImageDownloaderResponseHandler *handler in self.responseHandlers) {
+        priority = MAX(priority, handler.priority);
+    }
+    return priority;
+}
+
 - (void)addResponseHandler:(AFImageDownloaderResponseHandler *)handler {
     [self.responseHandlers addObject:handler];
 }
@@ -81,6 +113,136 @@
 
 @end
 
+/**
+ A binary heap ordered by priority, then by sequence number. Each element stores its position in the heap so it can be removed or rescheduled in O(log n).
+
+ The downloader keeps one queue of merged tasks per host. A queue is itself an element ordered by its first task, so the host queues that may start a download are kept in another heap and the next task is found without scanning every host.
+ */
+@interface AFImageDownloaderTaskQueue : NSObject <AFImageDownloaderQueueElement>
+@property (nonatomic, strong) NSString *host;
+@property (nonatomic, strong) NSMutableArray <id<AFImageDownloaderQueueElement>> *heap;
+@property (nonatomic, assign) NSUInteger queueIndex;
+@end
+
+@implementation AFImageDownloaderTaskQueue
+
+- (instancetype)init {
+    return [self initWithHost:nil];
+}
+
+- (instancetype)initWithHost:(NSString *)host {
+    if (self = [super init]) {
+        self.host = host;
+        self.heap = [[NSMutableArray alloc] init];
+        self.queueIndex = NSNotFound;
+    }
+    return self;
+}
+
+- (AFImageDownloadPriority)priority {
+    return self.heap.firstObject.priority;
+}
+
+- (int64_t)sequenceNumber {
+    return self.heap.firstObject.sequenceNumber;
+}
+
+- (NSUInteger)count {
+    return self.heap.count;
+}
+
+- (id<AFImageDownloaderQueueElement>)firstTask {
+    return self.heap.firstObject;
+}
+
+- (BOOL)containsTask:(id<AFImageDownloaderQueueElement>)task {
+    return task.queueIndex < self.heap.count && self.heap[task.queueIndex] == task;
+}
+
+- (void)addTask:(id<AFImageDownloaderQueueElement>)task {
+    task.queueIndex = self.heap.count;
+    [self.heap addObject:task];
+    [self siftUpFromIndex:task.queueIndex];
+}
+
+- (id<AFImageDownloaderQueueElement>)removeFirstTask {
+    id<AFImageDownloaderQueueElement> task = self.heap.firstObject;
+    if (task) {
+        [self removeTask:task];
+    }
+    return task;
+}
+
+- (void)removeTask:(id<AFImageDownloaderQueueElement>)task {
+    if (![self containsTask:task]) {
+        return;
+    }
+    NSUInteger index = task.queueIndex;
+    NSUInteger lastIndex = self.heap.count - 1;
+    if (index != lastIndex) {
+        [self swapTaskAtIndex:index withTaskAtIndex:lastIndex];
+    }
+    [self.heap removeLastObject];
+    task.queueIndex = NSNotFound;
+    if (index < self.heap.count) {
+        [self updateTask:self.heap[index]];
+    }
+}
+
+- (void)updateTask:(id<AFImageDownloaderQueueElement>)task {
+    if (![self containsTask:task]) {
+        return;
+    }
+    [self siftUpFromIndex:task.queueIndex];
+    [self siftDownFromIndex:task.queueIndex];
+}
+
+- (BOOL)task:(id<AFImageDownloaderQueueElement>)task precedesTask:(id<AFImageDownloaderQueueElement>)otherTask {
+    if (task.priority != otherTask.priority) {
+        return task.priority > otherTask.priority;
+    }
+    return task.sequenceNumber < otherTask.sequenceNumber;
+}
+
+- (void)siftUpFromIndex:(NSUInteger)index {
+    while (index > 0) {
+        NSUInteger parentIndex = (index - 1) / 2;
+        if (![self task:self.heap[index] precedesTask:self.heap[parentIndex]]) {
+            break;
+        }
+        [self swapTaskAtIndex:index withTaskAtIndex:parentIndex];
+        index = parentIndex;
+    }
+}
+
+- (void)siftDownFromIndex:(NSUInteger)index {
+    NSUInteger count = self.heap.count;
+    while (YES) {
+        NSUInteger leftIndex = 2 * index + 1;
+        NSUInteger rightIndex = leftIndex + 1;
+        NSUInteger firstIndex = index;
+        if (leftIndex < count && [self task:self.heap[leftIndex] precedesTask:self.heap[firstIndex]]) {
+            firstIndex = leftIndex;
+        }
+        if (rightIndex < count && [self task:self.heap[rightIndex] precedesTask:self.heap[firstIndex]]) {
+            firstIndex = rightIndex;
+        }
+        if (firstIndex == index) {
+            break;
+        }
+        [self swapTaskAtIndex:index withTaskAtIndex:firstIndex];
+        index = firstIndex;
+    }
+}
+
+- (void)swapTaskAtIndex:(NSUInteger)index withTaskAtIndex:(NSUInteger)otherIndex {
+    [self.heap exchangeObjectAtIndex:index withObjectAtIndex:otherIndex];
+    self.heap[index].queueIndex = index;
+    self.heap[otherIndex].queueIndex = otherIndex;
+}
+
+@end
+
 @implementation AFImageDownloadReceipt
 
 - (instancetype)initWithReceiptID:(NSUUID *)receiptID task:(NSURLSessionDataTask *)task {
@@ -101,8 +263,12 @@
 @property (nonatomic, assign) NSInteger maximumActiveDownloads;
 @property (nonatomic, assign) NSInteger activeRequestCount;
 
-@property (nonatomic, strong) NSMutableArray *queuedMergedTasks;
+@property (nonatomic, strong) NSMutableDictionary <NSString*, AFImageDownloaderTaskQueue*> *queuedMergedTasks;
+@property (nonatomic, strong) AFImageDownloaderTaskQueue *readyHostQueues;
 @property (nonatomic, strong) NSMutableDictionary *mergedTasks;
+@property (nonatomic, strong) NSMutableDictionary <NSUUID*, NSString*> *activeMergedTaskHosts;
+@property (nonatomic, strong) NSCountedSet <NSString*> *activeHosts;
+@property (nonatomic, assign) int64_t enqueuedTaskCount;
 
 @end
 
@@ -171,9 +337,15 @@
         self.maximumActiveDownloads = maximumActiveDownloads;
         self.imageCache = imageCache;
 
-        self.queuedMergedTasks = [[NSMutableArray alloc] init];
+        _maximumActiveDownloadsPerHost = 0;
+
+        self.queuedMergedTasks = [[NSMutableDictionary alloc] init];
+        self.readyHostQueues = [[AFImageDownloaderTaskQueue alloc] init];
         self.mergedTasks = [[NSMutableDictionary alloc] init];
+        self.activeMergedTaskHosts = [[NSMutableDictionary alloc] init];
+        self.activeHosts = [[NSCountedSet alloc] init];
         self.activeRequestCount = 0;
+        self.enqueuedTaskCount = 0;
 
         NSString *name = [NSString stringWithFormat:@"com.alamofire.imagedownloader.synchronizationqueue-%@", [[NSUUID UUID] UUIDString]];
         self.synchronizationQueue = dispatch_queue_create([name cStringUsingEncoding:NSASCIIStringEncoding], DISPATCH_QUEUE_SERIAL);
@@ -204,6 +376,14 @@
                                                   withReceiptID:(nonnull NSUUID *)receiptID
                                                         success:(nullable void (^)(NSURLRequest *request, NSHTTPURLResponse  * _Nullable response, UIImage *responseObject))success
                                                         failure:(nullable void (^)(NSURLRequest *request, NSHTTPURLResponse * _Nullable response, NSError *error))failure {
+    return [self downloadImageForURLRequest:request withReceiptID:receiptID priority:AFImageDownloadPriorityNormal success:success failure:failure];
+}
+
+- (nullable AFImageDownloadReceipt *)downloadImageForURLRequest:(NSURLRequest *)request
+                                                  withReceiptID:(nonnull NSUUID *)receiptID
+                                                       priority:(AFImageDownloadPriority)priority
+                                                        success:(nullable void (^)(NSURLRequest *request, NSHTTPURLResponse  * _Nullable response, UIImage *responseObject))success
+                                                        failure:(nullable void (^)(NSURLRequest *request, NSHTTPURLResponse * _Nullable response, NSError *error))failure {
     __block NSURLSessionDataTask *task = nil;
     dispatch_sync(self.synchronizationQueue, ^{
         NSString *URLIdentifier = request.URL.absoluteString;
@@ -217,11 +397,13 @@
             return;
         }
 
-        // 1) Append the success and failure blocks to a pre-existing request if it already exists
+        // 1) Append the success and failure blocks to a pre-existing request if it already exists,
+        //    promoting it in the queue if the new receipt has a higher priority
         AFImageDownloaderMergedTask *existingMergedTask = self.mergedTasks[URLIdentifier];
         if (existingMergedTask != nil) {
-            AFImageDownloaderResponseHandler *handler = [[AFImageDownloaderResponseHandler alloc] initWithUUID:receiptID success:success failure:failure];
+            AFImageDownloaderResponseHandler *handler = [[AFImageDownloaderResponseHandler alloc] initWithUUID:receiptID priority:priority success:success failure:failure];
             [existingMergedTask addResponseHandler:handler];
+            [self updatePriorityOfMergedTask:existingMergedTask];
             task = existingMergedTask.task;
             return;
         }
@@ -248,6 +430,7 @@
 
         // 3) Create the request and set up authentication, validation and response serialization
         NSUUID *mergedTaskIdentifier = [NSUUID UUID];
+        NSString *host = request.URL.host.lowercaseString ?: @"";
         NSURLSessionDataTask *createdTask;
         __weak __typeof__(self) weakSelf = self;
 
@@ -284,24 +467,27 @@
                                        
                                    }
                                }
-                               [strongSelf safelyDecrementActiveTaskCount];
+                               [strongSelf safelyDecrementActiveTaskCountForMergedTaskIdentifier:mergedTaskIdentifier];
                                [strongSelf safelyStartNextTaskIfNecessary];
                            });
                        }];
 
         // 4) Store the response handler for use when the request completes
         AFImageDownloaderResponseHandler *handler = [[AFImageDownloaderResponseHandler alloc] initWithUUID:receiptID
+                                                                                                  priority:priority
                                                                                                    success:success
                                                                                                    failure:failure];
         AFImageDownloaderMergedTask *mergedTask = [[AFImageDownloaderMergedTask alloc]
                                                    initWithURLIdentifier:URLIdentifier
+                                                   host:host
                                                    identifier:mergedTaskIdentifier
                                                    task:createdTask];
         [mergedTask addResponseHandler:handler];
+        mergedTask.priority = priority;
         self.mergedTasks[URLIdentifier] = mergedTask;
 
-        // 5) Either start the request or enqueue it depending on the current active request count
-        if ([self isActiveRequestCountBelowMaximumLimit]) {
+        // 5) Either start the request or enqueue it depending on the current active request counts
+        if ([self isActiveRequestCountBelowMaximumLimit] && [self isActiveRequestCountBelowMaximumLimitForHost:host]) {
             [self startMergedTask:mergedTask];
         } else {
             [self enqueueMergedTask:mergedTask];
@@ -338,8 +524,25 @@
         }
 
         if (mergedTask.responseHandlers.count == 0) {
+            [self removeQueuedMergedTask:mergedTask];
             [mergedTask.task cancel];
             [self removeMergedTaskWithURLIdentifier:URLIdentifier];
+        } else {
+            [self updatePriorityOfMergedTask:mergedTask];
+        }
+    });
+}
+
+- (void)setPriority:(AFImageDownloadPriority)priority forImageDownloadReceipt:(AFImageDownloadReceipt *)imageDownloadReceipt {
+    dispatch_sync(self.synchronizationQueue, ^{
+        NSString *URLIdentifier = imageDownloadReceipt.task.originalRequest.URL.absoluteString;
+        AFImageDownloaderMergedTask *mergedTask = self.mergedTasks[URLIdentifier];
+        for (AFImageDownloaderResponseHandler *handler in mergedTask.responseHandlers) {
+            if (handler.uuid == imageDownloadReceipt.receiptID) {
+                handler.priority = priority;
+                [self updatePriorityOfMergedTask:mergedTask];
+                break;
+            }
         }
     });
 }
@@ -359,23 +562,31 @@
     return mergedTask;
 }
 
-- (void)safelyDecrementActiveTaskCount {
+- (void)safelyDecrementActiveTaskCountForMergedTaskIdentifier:(NSUUID *)mergedTaskIdentifier {
     dispatch_sync(self.synchronizationQueue, ^{
+        // Tasks cancelled while still queued were never started and must not release a slot
+        NSString *host = self.activeMergedTaskHosts[mergedTaskIdentifier];
+        if (host == nil) {
+            return;
+        }
+        [self.activeMergedTaskHosts removeObjectForKey:mergedTaskIdentifier];
+        [self.activeHosts removeObject:host];
         if (self.activeRequestCount > 0) {
             self.activeRequestCount -= 1;
         }
+        [self updateReadinessOfHost:host];
     });
 }
 
 - (void)safelyStartNextTaskIfNecessary {
     dispatch_sync(self.synchronizationQueue, ^{
-        if ([self isActiveRequestCountBelowMaximumLimit]) {
-            while (self.queuedMergedTasks.count > 0) {
-                AFImageDownloaderMergedTask *mergedTask = [self dequeueMergedTask];
-                if (mergedTask.task.state == NSURLSessionTaskStateSuspended) {
-                    [self startMergedTask:mergedTask];
-                    break;
-                }
+        while ([self isActiveRequestCountBelowMaximumLimit]) {
+            AFImageDownloaderMergedTask *mergedTask = [self dequeueMergedTask];
+            if (mergedTask == nil) {
+                break;
+            }
+            if (mergedTask.task.state == NSURLSessionTaskStateSuspended) {
+                [self startMergedTask:mergedTask];
             }
         }
     });
@@ -383,31 +594,106 @@
 
 - (void)startMergedTask:(AFImageDownloaderMergedTask *)mergedTask {
     [mergedTask.task resume];
+    self.activeMergedTaskHosts[mergedTask.identifier] = mergedTask.host;
+    [self.activeHosts addObject:mergedTask.host];
     ++self.activeRequestCount;
+    [self updateReadinessOfHost:mergedTask.host];
 }
 
 - (void)enqueueMergedTask:(AFImageDownloaderMergedTask *)mergedTask {
+    ++self.enqueuedTaskCount;
     switch (self.downloadPrioritization) {
         case AFImageDownloadPrioritizationFIFO:
-            [self.queuedMergedTasks addObject:mergedTask];
+            mergedTask.sequenceNumber = self.enqueuedTaskCount;
             break;
         case AFImageDownloadPrioritizationLIFO:
-            [self.queuedMergedTasks insertObject:mergedTask atIndex:0];
+            mergedTask.sequenceNumber = -self.enqueuedTaskCount;
             break;
     }
+
+    AFImageDownloaderTaskQueue *queue = self.queuedMergedTasks[mergedTask.host];
+    if (queue == nil) {
+        queue = [[AFImageDownloaderTaskQueue alloc] initWithHost:mergedTask.host];
+        self.queuedMergedTasks[mergedTask.host] = queue;
+    }
+    [queue addTask:mergedTask];
+    [self updateReadinessOfHost:mergedTask.host];
 }
 
+// Takes the first task of the first host queue whose host is below its active download limit
 - (AFImageDownloaderMergedTask *)dequeueMergedTask {
-    AFImageDownloaderMergedTask *mergedTask = nil;
-    mergedTask = [self.queuedMergedTasks firstObject];
-    [self.queuedMergedTasks removeObject:mergedTask];
+    AFImageDownloaderTaskQueue *queue = [self.readyHostQueues firstTask];
+    AFImageDownloaderMergedTask *mergedTask = [queue removeFirstTask];
+    if (mergedTask != nil) {
+        [self removeHostQueueIfEmpty:queue];
+    }
     return mergedTask;
 }
 
+- (void)removeQueuedMergedTask:(AFImageDownloaderMergedTask *)mergedTask {
+    AFImageDownloaderTaskQueue *queue = self.queuedMergedTasks[mergedTask.host];
+    if (queue != nil && [queue containsTask:mergedTask]) {
+        [queue removeTask:mergedTask];
+        [self removeHostQueueIfEmpty:queue];
+    }
+}
+
+- (void)removeHostQueueIfEmpty:(AFImageDownloaderTaskQueue *)queue {
+    if (queue.count == 0) {
+        [self.readyHostQueues removeTask:queue];
+        [self.queuedMergedTasks removeObjectForKey:queue.host];
+    } else {
+        [self updateReadinessOfHost:queue.host];
+    }
+}
+
+- (void)updatePriorityOfMergedTask:(AFImageDownloaderMergedTask *)mergedTask {
+    AFImageDownloadPriority priority = [mergedTask highestResponseHandlerPriority];
+    if (priority == mergedTask.priority) {
+        return;
+    }
+    mergedTask.priority = priority;
+    [self.queuedMergedTasks[mergedTask.host] updateTask:mergedTask];
+    [self updateReadinessOfHost:mergedTask.host];
+}
+
+// Keeps readyHostQueues in sync with a host's queue and active download count. Called whenever either changes.
+- (void)updateReadinessOfHost:(NSString *)host {
+    AFImageDownloaderTaskQueue *queue = self.queuedMergedTasks[host];
+    if (queue == nil) {
+        return;
+    }
+    if ([self isActiveRequestCountBelowMaximumLimitForHost:host]) {
+        if ([self.readyHostQueues containsTask:queue]) {
+            [self.readyHostQueues updateTask:queue];
+        } else {
+            [self.readyHostQueues addTask:queue];
+        }
+    } else {
+        [self.readyHostQueues removeTask:queue];
+    }
+}
+
+- (void)setMaximumActiveDownloadsPerHost:(NSInteger)maximumActiveDownloadsPerHost {
+    dispatch_sync(self.synchronizationQueue, ^{
+        self->_maximumActiveDownloadsPerHost = maximumActiveDownloadsPerHost;
+        for (NSString *host in self.queuedMergedTasks.allKeys) {
+            [self updateReadinessOfHost:host];
+        }
+    });
+}
+
 - (BOOL)isActiveRequestCountBelowMaximumLimit {
     return self.activeRequestCount < self.maximumActiveDownloads;
 }
 
+- (BOOL)isActiveRequestCountBelowMaximumLimitForHost:(NSString *)host {
+    if (self.maximumActiveDownloadsPerHost <= 0) {
+        return YES;
+    }
+    return (NSInteger)[self.activeHosts countForObject:host] < self.maximumActiveDownloadsPerHost;
+}
+
 - (AFImageDownloaderMergedTask *)safelyGetMergedTask:(NSString *)URLIdentifier {
     __block AFImageDownloaderMergedTask *mergedTask;
     dispatch_sync(self.synchronizationQueue, ^(){